@@ -0,0 +1,56 @@
+/*
+ *  Utilitários dos bakers de texturas - ver include/BakeUtils.h
+ */
+
+#include "BakeUtils.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+void rasterizeUVs(const vector<glm::vec2>& uvs, const vector<unsigned int>& indices,
+                  int size, vector<TexelSample>& texels)
+{
+    texels.assign((size_t)size * size, TexelSample());
+    for (size_t tri = 0; tri + 2 < indices.size(); tri += 3)
+    {
+        glm::vec2 a = uvs[indices[tri]] * (float)size;
+        glm::vec2 b = uvs[indices[tri + 1]] * (float)size;
+        glm::vec2 c = uvs[indices[tri + 2]] * (float)size;
+
+        float area = (b.x - a.x) * (c.y - a.y) - (c.x - a.x) * (b.y - a.y);
+        if (fabsf(area) < 1e-12f) continue;
+
+        int x0 = max(0, (int)floorf(min(a.x, min(b.x, c.x))));
+        int x1 = min(size - 1, (int)ceilf(max(a.x, max(b.x, c.x))));
+        int y0 = max(0, (int)floorf(min(a.y, min(b.y, c.y))));
+        int y1 = min(size - 1, (int)ceilf(max(a.y, max(b.y, c.y))));
+
+        // Centro do texel dentro do triângulo (funções de aresta)
+        for (int y = y0; y <= y1; y++)
+            for (int x = x0; x <= x1; x++)
+            {
+                glm::vec2 p(x + 0.5f, y + 0.5f);
+                float w0 = ((b.x - p.x) * (c.y - p.y) - (c.x - p.x) * (b.y - p.y)) / area;
+                float w1 = ((c.x - p.x) * (a.y - p.y) - (a.x - p.x) * (c.y - p.y)) / area;
+                float w2 = 1.0f - w0 - w1;
+                if (w0 < -1e-4f || w1 < -1e-4f || w2 < -1e-4f) continue;
+
+                TexelSample& s = texels[(size_t)y * size + x];
+                s.triangle = (int)(tri / 3);
+                s.b0 = w0; s.b1 = w1; s.b2 = w2;
+            }
+    }
+}
+
+glm::vec3 cosineSampleHemisphere(const glm::vec3& n, BakeRandom& rng)
+{
+    // Base ortonormal em torno da normal
+    glm::vec3 t = glm::normalize(glm::cross(n, fabsf(n.x) < 0.9f ? glm::vec3(1, 0, 0) : glm::vec3(0, 1, 0)));
+    glm::vec3 b = glm::cross(n, t);
+
+    float r = sqrtf(rng.next());
+    float phi = 6.2831853f * rng.next();
+    return t * (r * cosf(phi)) + b * (r * sinf(phi)) + n * sqrtf(max(0.0f, 1.0f - r * r));
+}
@@ -0,0 +1,135 @@
+/*
+ *  Listas de comandos de desenho - ver include/CommandBuffer.h
+ */
+
+#include "CommandBuffer.h"
+#include "GLExtensions.h"
+
+using namespace std;
+
+void* LinearAllocator::allocate(size_t size, size_t alignment)
+{
+    if (!blocks.empty())
+    {
+        Block& block = blocks[current];
+        size_t offset = (block.used + alignment - 1) & ~(alignment - 1);
+        if (offset + size <= blockSize)
+        {
+            block.used = offset + size;
+            return block.data.get() + offset;
+        }
+        current++;
+    }
+
+    // Próximo bloco (reaproveitado depois de um reset, ou novo)
+    if (current == blocks.size())
+    {
+        blocks.emplace_back();
+        blocks.back().data.reset(new unsigned char[blockSize]);
+    }
+    Block& block = blocks[current];
+    block.used = size;
+    return block.data.get();
+}
+
+void LinearAllocator::reset()
+{
+    for (Block& block : blocks)
+        block.used = 0;
+    current = 0;
+}
+
+size_t LinearAllocator::used() const
+{
+    size_t total = 0;
+    for (const Block& block : blocks)
+        total += block.used;
+    return total;
+}
+
+void CommandBuffer::bindBufferRange(BufferBindingTarget target, uint32_t index, uint32_t buffer, uint64_t offset,
+                                    uint64_t size)
+{
+    BindBufferRangeCommand& command = add<BindBufferRangeCommand>();
+    command.target = target;
+    command.index = index;
+    command.buffer = buffer;
+    command.offset = offset;
+    command.size = size;
+}
+
+void CommandBuffer::bindTexture(uint32_t unit, uint32_t texture)
+{
+    BindTextureCommand& command = add<BindTextureCommand>();
+    command.unit = unit;
+    command.texture = texture;
+}
+
+void CommandBuffer::drawIndexed(uint32_t indexCount, uint32_t firstIndex, int32_t baseVertex, uint32_t instanceCount,
+                                uint32_t baseInstance, PrimitiveTopology topology)
+{
+    DrawIndexedCommand& command = add<DrawIndexedCommand>();
+    command.topology = topology;
+    command.indexCount = indexCount;
+    command.firstIndex = firstIndex;
+    command.baseVertex = baseVertex;
+    command.instanceCount = instanceCount;
+    command.baseInstance = baseInstance;
+}
+
+static GLenum glTopology(PrimitiveTopology topology)
+{
+    switch (topology)
+    {
+    case TOPOLOGY_LINES: return GL_LINES;
+    case TOPOLOGY_LINE_STRIP: return GL_LINE_STRIP;
+    case TOPOLOGY_POINTS: return GL_POINTS;
+    default: return GL_TRIANGLES;
+    }
+}
+
+ReplayStats replayCommands(const CommandBuffer& buffer, const vector<const PipelineState*>& pipelines)
+{
+    ReplayStats stats;
+    buffer.forEach([&](const RenderCommandHeader& header) {
+        stats.commands++;
+        switch (header.type)
+        {
+        case RENDER_COMMAND_BIND_PIPELINE:
+        {
+            const BindPipelineCommand& c = (const BindPipelineCommand&)header;
+            if (c.pipeline < pipelines.size() && pipelines[c.pipeline])
+                glState().bindPipeline(*pipelines[c.pipeline]);
+            break;
+        }
+        case RENDER_COMMAND_BIND_BUFFER_RANGE:
+        {
+            const BindBufferRangeCommand& c = (const BindBufferRangeCommand&)header;
+            GLenum target = c.target == BUFFER_BINDING_STORAGE ? GL_SHADER_STORAGE_BUFFER : GL_UNIFORM_BUFFER;
+            glState().bindBufferRange(target, c.index, c.buffer, (GLintptr)c.offset, (GLsizeiptr)c.size);
+            break;
+        }
+        case RENDER_COMMAND_BIND_TEXTURE:
+        {
+            const BindTextureCommand& c = (const BindTextureCommand&)header;
+            glState().bindTexture(c.unit, c.texture);
+            break;
+        }
+        case RENDER_COMMAND_DRAW_INDEXED:
+        {
+            const DrawIndexedCommand& c = (const DrawIndexedCommand&)header;
+            const void* indices = (const void*)(uintptr_t)(c.firstIndex * sizeof(GLuint));
+            if (c.baseInstance == 0)
+                glDrawElementsInstancedBaseVertex(glTopology(c.topology), c.indexCount, GL_UNSIGNED_INT, indices,
+                                                  c.instanceCount, c.baseVertex);
+            else
+                glDrawElementsInstancedBaseVertexBaseInstance(glTopology(c.topology), c.indexCount, GL_UNSIGNED_INT,
+                                                              indices, c.instanceCount, c.baseVertex,
+                                                              c.baseInstance);
+            stats.draws++;
+            break;
+        }
+        }
+    });
+    return stats;
+}
@@ -0,0 +1,361 @@
+/*
+ *  Árvore dinâmica de AABBs - ver include/DynamicBVH.h
+ */
+
+#include "DynamicBVH.h"
+
+#include <utility>
+#include <algorithm>
+
+using namespace std;
+
+int DynamicBVH::allocateNode()
+{
+    if (freeList < 0)
+    {
+        nodes.emplace_back();
+        return (int)nodes.size() - 1;
+    }
+    int node = freeList;
+    freeList = nodes[node].parent;
+    nodes[node] = Node();
+    return node;
+}
+
+void DynamicBVH::freeNode(int node)
+{
+    nodes[node] = Node();
+    nodes[node].parent = freeList;
+    freeList = node;
+}
+
+int DynamicBVH::insert(const AABB& box, int userData)
+{
+    int leaf = allocateNode();
+    nodes[leaf].box = AABB(box.min - glm::vec3(margin), box.max + glm::vec3(margin));
+    nodes[leaf].userData = userData;
+    insertLeaf(leaf);
+    leaves++;
+    return leaf;
+}
+
+void DynamicBVH::remove(int proxy)
+{
+    removeLeaf(proxy);
+    freeNode(proxy);
+    leaves--;
+}
+
+bool DynamicBVH::move(int proxy, const AABB& box)
+{
+    if (nodes[proxy].box.contains(box)) return false;
+
+    removeLeaf(proxy);
+    nodes[proxy].box = AABB(box.min - glm::vec3(margin), box.max + glm::vec3(margin));
+    insertLeaf(proxy);
+    return true;
+}
+
+void DynamicBVH::refit(int proxy, const AABB& box)
+{
+    nodes[proxy].box = AABB(box.min - glm::vec3(margin), box.max + glm::vec3(margin));
+    for (int node = nodes[proxy].parent; node >= 0; node = nodes[node].parent)
+    {
+        AABB merged = merge(nodes[nodes[node].child1].box, nodes[nodes[node].child2].box);
+        if (merged.min == nodes[node].box.min && merged.max == nodes[node].box.max)
+            break;   // daqui para cima nada muda
+        nodes[node].box = merged;
+    }
+}
+
+// Branch-and-bound: o custo de pôr a folha ao lado de um nó é a área da
+// união mais o quanto os ancestrais crescem (herdado). Os filhos nunca
+// custam menos que área(folha) + herdado, o que permite descartar subárvores.
+int DynamicBVH::findBestSibling(const AABB& box) const
+{
+    float leafArea = box.area();
+    int best = root;
+    float bestCost = merge(box, nodes[root].box).area();
+
+    vector<pair<int, float>> stack;   // nó, custo herdado
+    stack.reserve(64);
+    stack.emplace_back(root, 0.0f);
+    while (!stack.empty())
+    {
+        auto [node, inherited] = stack.back();
+        stack.pop_back();
+
+        float direct = merge(box, nodes[node].box).area();
+        float cost = direct + inherited;
+        if (cost < bestCost)
+        {
+            best = node;
+            bestCost = cost;
+        }
+
+        if (nodes[node].isLeaf()) continue;
+        float childInherited = inherited + direct - nodes[node].box.area();
+        if (leafArea + childInherited < bestCost)
+        {
+            stack.emplace_back(nodes[node].child1, childInherited);
+            stack.emplace_back(nodes[node].child2, childInherited);
+        }
+    }
+    return best;
+}
+
+void DynamicBVH::insertLeaf(int leaf)
+{
+    if (root < 0)
+    {
+        root = leaf;
+        nodes[leaf].parent = -1;
+        return;
+    }
+
+    int sibling = findBestSibling(nodes[leaf].box);
+    int oldParent = nodes[sibling].parent;
+    int newParent = allocateNode();   // pode realocar nodes: só índices daqui em diante
+    nodes[newParent].parent = oldParent;
+    nodes[newParent].box = merge(nodes[leaf].box, nodes[sibling].box);
+    nodes[newParent].child1 = sibling;
+    nodes[newParent].child2 = leaf;
+    nodes[sibling].parent = newParent;
+    nodes[leaf].parent = newParent;
+
+    if (oldParent < 0)
+        root = newParent;
+    else if (nodes[oldParent].child1 == sibling)
+        nodes[oldParent].child1 = newParent;
+    else
+        nodes[oldParent].child2 = newParent;
+
+    for (int node = oldParent; node >= 0; node = nodes[node].parent)
+    {
+        nodes[node].box = merge(nodes[nodes[node].child1].box, nodes[nodes[node].child2].box);
+        rotate(node);
+    }
+}
+
+void DynamicBVH::removeLeaf(int leaf)
+{
+    if (leaf == root)
+    {
+        root = -1;
+        return;
+    }
+
+    int parent = nodes[leaf].parent;
+    int grandParent = nodes[parent].parent;
+    int sibling = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+    freeNode(parent);
+    nodes[leaf].parent = -1;
+
+    if (grandParent < 0)
+    {
+        root = sibling;
+        nodes[sibling].parent = -1;
+        return;
+    }
+
+    if (nodes[grandParent].child1 == parent)
+        nodes[grandParent].child1 = sibling;
+    else
+        nodes[grandParent].child2 = sibling;
+    nodes[sibling].parent = grandParent;
+
+    for (int node = grandParent; node >= 0; node = nodes[node].parent)
+    {
+        nodes[node].box = merge(nodes[nodes[node].child1].box, nodes[nodes[node].child2].box);
+        rotate(node);
+    }
+}
+
+// Nó A com filhos B e C: troca B com um filho de C (ou C com um filho de B)
+// se a caixa do filho que recebe o neto fica com área menor. A caixa de A
+// não muda (as mesmas folhas continuam embaixo dele).
+void DynamicBVH::rotate(int a)
+{
+    int b = nodes[a].child1, c = nodes[a].child2;
+    if (nodes[b].isLeaf() && nodes[c].isLeaf()) return;
+
+    // Melhor troca: (filho de A que desce, neto que sobe, pai do neto)
+    float bestGain = 0.0f;
+    int down = -1, up = -1, into = -1;
+    auto consider = [&](int child, int other) {
+        if (nodes[other].isLeaf()) return;
+        int g1 = nodes[other].child1, g2 = nodes[other].child2;
+        float otherArea = nodes[other].box.area();
+        float gain1 = otherArea - merge(nodes[child].box, nodes[g2].box).area();   // child <-> g1
+        float gain2 = otherArea - merge(nodes[child].box, nodes[g1].box).area();   // child <-> g2
+        if (gain1 > bestGain) bestGain = gain1, down = child, up = g1, into = other;
+        if (gain2 > bestGain) bestGain = gain2, down = child, up = g2, into = other;
+    };
+    consider(b, c);
+    consider(c, b);
+    if (down < 0) return;
+
+    if (nodes[a].child1 == down) nodes[a].child1 = up; else nodes[a].child2 = up;
+    if (nodes[into].child1 == up) nodes[into].child1 = down; else nodes[into].child2 = down;
+    nodes[up].parent = a;
+    nodes[down].parent = into;
+    nodes[into].box = merge(nodes[nodes[into].child1].box, nodes[nodes[into].child2].box);
+}
+
+void DynamicBVH::queryFrustum(const Frustum& frustum, vector<int>& out) const
+{
+    out.clear();
+    if (root < 0) return;
+
+    vector<int> stack = { root };
+    while (!stack.empty())
+    {
+        const Node& node = nodes[stack.back()];
+        stack.pop_back();
+        if (!boxInFrustum(frustum, node.box.min, node.box.max)) continue;
+        if (node.isLeaf())
+            out.push_back(node.userData);
+        else
+        {
+            stack.push_back(node.child1);
+            stack.push_back(node.child2);
+        }
+    }
+}
+
+void DynamicBVH::queryBox(const AABB& box, vector<int>& out) const
+{
+    out.clear();
+    if (root < 0) return;
+
+    vector<int> stack = { root };
+    while (!stack.empty())
+    {
+        const Node& node = nodes[stack.back()];
+        stack.pop_back();
+        if (!node.box.overlaps(box)) continue;
+        if (node.isLeaf())
+            out.push_back(node.userData);
+        else
+        {
+            stack.push_back(node.child1);
+            stack.push_back(node.child2);
+        }
+    }
+}
+
+// Teste de slabs; tEnter = entrada do raio na caixa (0 se começa dentro)
+static bool rayHitsBox(const glm::vec3& origin, const glm::vec3& invDir, float tMax, const AABB& box, float& tEnter)
+{
+    glm::vec3 t0 = (box.min - origin) * invDir;
+    glm::vec3 t1 = (box.max - origin) * invDir;
+    glm::vec3 tNear = glm::min(t0, t1), tFar = glm::max(t0, t1);
+    tEnter = max(max(tNear.x, tNear.y), max(tNear.z, 0.0f));
+    float tExit = min(min(tFar.x, tFar.y), min(tFar.z, tMax));
+    return tEnter <= tExit;
+}
+
+void DynamicBVH::queryRay(const glm::vec3& origin, const glm::vec3& dir, float tMax, vector<int>& out) const
+{
+    out.clear();
+    if (root < 0) return;
+
+    glm::vec3 invDir = 1.0f / dir;
+    vector<int> stack = { root };
+    while (!stack.empty())
+    {
+        const Node& node = nodes[stack.back()];
+        stack.pop_back();
+        float tEnter;
+        if (!rayHitsBox(origin, invDir, tMax, node.box, tEnter)) continue;
+        if (node.isLeaf())
+            out.push_back(node.userData);
+        else
+        {
+            stack.push_back(node.child1);
+            stack.push_back(node.child2);
+        }
+    }
+}
+
+int DynamicBVH::raycast(const glm::vec3& origin, const glm::vec3& dir, float tMax, const function<float(int)>& hit,
+                        float* tHit) const
+{
+    if (root < 0) return -1;
+
+    glm::vec3 invDir = 1.0f / dir;
+    float best = tMax;
+    int result = -1;
+    vector<int> stack = { root };
+    while (!stack.empty())
+    {
+        const Node& node = nodes[stack.back()];
+        stack.pop_back();
+        float tEnter;
+        if (!rayHitsBox(origin, invDir, best, node.box, tEnter)) continue;
+        if (node.isLeaf())
+        {
+            float t = hit(node.userData);
+            if (t >= 0.0f && t < best)
+            {
+                best = t;
+                result = node.userData;
+            }
+            continue;
+        }
+
+        // O filho mais próximo sai primeiro da pilha e encurta o raio para o outro
+        float t1, t2;
+        bool hit1 = rayHitsBox(origin, invDir, best, nodes[node.child1].box, t1);
+        bool hit2 = rayHitsBox(origin, invDir, best, nodes[node.child2].box, t2);
+        if (hit1 && hit2)
+        {
+            stack.push_back(t1 <= t2 ? node.child2 : node.child1);
+            stack.push_back(t1 <= t2 ? node.child1 : node.child2);
+        }
+        else if (hit1)
+            stack.push_back(node.child1);
+        else if (hit2)
+            stack.push_back(node.child2);
+    }
+    if (tHit && result >= 0) *tHit = best;
+    return result;
+}
+
+int DynamicBVH::height() const
+{
+    if (root < 0) return 0;
+
+    int result = 0;
+    vector<pair<int, int>> stack = { { root, 1 } };
+    while (!stack.empty())
+    {
+        auto [node, depth] = stack.back();
+        stack.pop_back();
+        result = max(result, depth);
+        if (!nodes[node].isLeaf())
+        {
+            stack.emplace_back(nodes[node].child1, depth + 1);
+            stack.emplace_back(nodes[node].child2, depth + 1);
+        }
+    }
+    return result;
+}
+
+float DynamicBVH::areaRatio() const
+{
+    if (root < 0 || nodes[root].box.area() <= 0.0f) return 0.0f;
+
+    float total = 0.0f;
+    vector<int> stack = { root };
+    while (!stack.empty())
+    {
+        const Node& node = nodes[stack.back()];
+        stack.pop_back();
+        if (node.isLeaf()) continue;
+        total += node.box.area();
+        stack.push_back(node.child1);
+        stack.push_back(node.child2);
+    }
+    return total / nodes[root].box.area();
+}
@@ -0,0 +1,130 @@
+/*
+ *  Observação de arquivos - ver include/FileWatcher.h
+ */
+
+#include "FileWatcher.h"
+
+#include <iostream>
+#include <filesystem>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+namespace fs = std::filesystem;
+
+string FileWatcher::normalize(const string& path)
+{
+    error_code ec;
+    fs::path p = fs::weakly_canonical(path, ec);
+    if (ec) p = fs::absolute(path, ec).lexically_normal();
+    return p.string();
+}
+
+#ifdef __linux__
+
+FileWatcher::FileWatcher()
+{
+    inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd < 0)
+        cout << "FileWatcher: inotify indisponível, arquivos não serão recarregados" << endl;
+}
+
+FileWatcher::~FileWatcher()
+{
+    if (inotifyFd >= 0) close(inotifyFd);
+}
+
+void FileWatcher::watch(const string& path)
+{
+    string file = normalize(path);
+    if (!files.insert(file).second || inotifyFd < 0) return;
+
+    string directory = fs::path(file).parent_path().string();
+    for (const auto& entry : directories)
+        if (entry.second == directory) return;
+
+    // Salvar pode ser escrita direta (CLOSE_WRITE) ou temporário + rename (MOVED_TO/CREATE)
+    int wd = inotify_add_watch(inotifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+    if (wd < 0)
+    {
+        cout << "FileWatcher: não foi possível observar " << directory << endl;
+        return;
+    }
+    directories[wd] = directory;
+}
+
+vector<string> FileWatcher::poll()
+{
+    set<string> changed;
+    if (inotifyFd >= 0)
+    {
+        alignas(inotify_event) char buffer[4096];
+        ssize_t length;
+        while ((length = read(inotifyFd, buffer, sizeof(buffer))) > 0)
+        {
+            for (char* p = buffer; p < buffer + length; )
+            {
+                const inotify_event* event = (const inotify_event*)p;
+                p += sizeof(inotify_event) + event->len;
+
+                auto dir = directories.find(event->wd);
+                if (event->len == 0 || dir == directories.end()) continue;
+
+                string file = (fs::path(dir->second) / event->name).string();
+                if (files.count(file))
+                    changed.insert(file);
+            }
+        }
+    }
+    return vector<string>(changed.begin(), changed.end());
+}
+
+#else
+
+static long long modificationTime(const string& path)
+{
+    error_code ec;
+    auto time = fs::last_write_time(path, ec);
+    return ec ? 0 : (long long)time.time_since_epoch().count();
+}
+
+FileWatcher::FileWatcher()
+    : lastPoll(chrono::steady_clock::now())
+{
+}
+
+FileWatcher::~FileWatcher()
+{
+}
+
+void FileWatcher::watch(const string& path)
+{
+    string file = normalize(path);
+    if (files.insert(file).second)
+        modified[file] = modificationTime(file);
+}
+
+vector<string> FileWatcher::poll()
+{
+    vector<string> changed;
+    auto now = chrono::steady_clock::now();
+    if (chrono::duration<float>(now - lastPoll).count() < pollInterval)
+        return changed;
+    lastPoll = now;
+
+    for (auto& entry : modified)
+    {
+        long long time = modificationTime(entry.first);
+        if (time != 0 && time != entry.second)
+        {
+            entry.second = time;
+            changed.push_back(entry.first);
+        }
+    }
+    return changed;
+}
+
+#endif
@@ -0,0 +1,368 @@
+/*
+ *  Frustum culling na CPU com SIMD - ver include/FrustumCulling.h
+ */
+
+#include "FrustumCulling.h"
+
+#include <cstring>
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define CG_CULLING_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define CG_TARGET_AVX2
+#else
+#define CG_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+using namespace std;
+
+// --- Escalar ----------------------------------------------------------------
+
+static size_t cullSpheresScalar(const Frustum& f, const SphereBoundsSoA& s, size_t begin, size_t end, uint32_t* out)
+{
+    size_t n = 0;
+    for (size_t i = begin; i < end; i++)
+    {
+        bool inside = true;
+        for (const glm::vec4& p : f.planes)
+            inside &= p.x * s.x[i] + p.y * s.y[i] + p.z * s.z[i] + p.w >= -s.radius[i];
+        out[n] = (uint32_t)i;
+        n += inside;
+    }
+    return n;
+}
+
+static size_t cullBoxesScalar(const Frustum& f, const BoxBoundsSoA& b, size_t begin, size_t end, uint32_t* out)
+{
+    size_t n = 0;
+    for (size_t i = begin; i < end; i++)
+    {
+        bool inside = true;
+        for (const glm::vec4& p : f.planes)
+        {
+            float x = p.x >= 0.0f ? b.maxX[i] : b.minX[i];
+            float y = p.y >= 0.0f ? b.maxY[i] : b.minY[i];
+            float z = p.z >= 0.0f ? b.maxZ[i] : b.minZ[i];
+            inside &= p.x * x + p.y * y + p.z * z + p.w >= 0.0f;
+        }
+        out[n] = (uint32_t)i;
+        n += inside;
+    }
+    return n;
+}
+
+#ifdef CG_CULLING_X86
+
+// --- SSE: 4 objetos por vez -------------------------------------------------
+
+// Escreve os 4 índices e avança só pelos visíveis (sem desvios)
+static inline size_t appendMask4(int mask, uint32_t base, uint32_t* out, size_t n)
+{
+    for (int k = 0; k < 4; k++)
+    {
+        out[n] = base + k;
+        n += (mask >> k) & 1;
+    }
+    return n;
+}
+
+static size_t cullSpheresSSE(const Frustum& f, const SphereBoundsSoA& s, size_t begin, size_t end, uint32_t* out)
+{
+    __m128 px[6], py[6], pz[6], pw[6];
+    for (int p = 0; p < 6; p++)
+    {
+        px[p] = _mm_set1_ps(f.planes[p].x);
+        py[p] = _mm_set1_ps(f.planes[p].y);
+        pz[p] = _mm_set1_ps(f.planes[p].z);
+        pw[p] = _mm_set1_ps(f.planes[p].w);
+    }
+
+    size_t n = 0, i = begin;
+    for (; i + 4 <= end; i += 4)
+    {
+        __m128 x = _mm_loadu_ps(&s.x[i]);
+        __m128 y = _mm_loadu_ps(&s.y[i]);
+        __m128 z = _mm_loadu_ps(&s.z[i]);
+        __m128 negRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(&s.radius[i]));
+
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (int p = 0; p < 6; p++)
+        {
+            __m128 d = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(px[p], x), _mm_mul_ps(py[p], y)),
+                                             _mm_mul_ps(pz[p], z)), pw[p]);
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(d, negRadius));
+        }
+        n = appendMask4(_mm_movemask_ps(inside), (uint32_t)i, out, n);
+    }
+    return n + cullSpheresScalar(f, s, i, end, out + n);
+}
+
+static size_t cullBoxesSSE(const Frustum& f, const BoxBoundsSoA& b, size_t begin, size_t end, uint32_t* out)
+{
+    // Canto mais avançado de cada plano: a escolha min/max depende só do sinal
+    // da normal, igual para todos os objetos
+    const float* cx[6];
+    const float* cy[6];
+    const float* cz[6];
+    __m128 px[6], py[6], pz[6], pw[6];
+    for (int p = 0; p < 6; p++)
+    {
+        const glm::vec4& plane = f.planes[p];
+        cx[p] = plane.x >= 0.0f ? b.maxX.data() : b.minX.data();
+        cy[p] = plane.y >= 0.0f ? b.maxY.data() : b.minY.data();
+        cz[p] = plane.z >= 0.0f ? b.maxZ.data() : b.minZ.data();
+        px[p] = _mm_set1_ps(plane.x);
+        py[p] = _mm_set1_ps(plane.y);
+        pz[p] = _mm_set1_ps(plane.z);
+        pw[p] = _mm_set1_ps(plane.w);
+    }
+
+    size_t n = 0, i = begin;
+    for (; i + 4 <= end; i += 4)
+    {
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (int p = 0; p < 6; p++)
+        {
+            __m128 d = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(px[p], _mm_loadu_ps(cx[p] + i)),
+                                                        _mm_mul_ps(py[p], _mm_loadu_ps(cy[p] + i))),
+                                             _mm_mul_ps(pz[p], _mm_loadu_ps(cz[p] + i))), pw[p]);
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(d, _mm_setzero_ps()));
+        }
+        n = appendMask4(_mm_movemask_ps(inside), (uint32_t)i, out, n);
+    }
+    return n + cullBoxesScalar(f, b, i, end, out + n);
+}
+
+// --- AVX2: 8 objetos por vez ------------------------------------------------
+
+// Para cada máscara de 8 bits, a permutação que leva as lanes visíveis para
+// o começo e quantas são. A escrita é sempre de 8 índices, mas começa no
+// último visível: nunca passa do fim do grupo testado.
+struct CompactTable
+{
+    alignas(32) uint32_t lanes[256][8];
+    uint8_t counts[256];
+
+    CompactTable()
+    {
+        for (int mask = 0; mask < 256; mask++)
+        {
+            int n = 0;
+            for (int k = 0; k < 8; k++)
+                if (mask & (1 << k)) lanes[mask][n++] = k;
+            counts[mask] = (uint8_t)n;
+            for (int k = n; k < 8; k++) lanes[mask][k] = 0;
+        }
+    }
+};
+
+static const CompactTable compactTable;
+
+CG_TARGET_AVX2 static inline size_t appendMask8(int mask, __m256i indices, uint32_t* out, size_t n)
+{
+    __m256i permutation = _mm256_load_si256((const __m256i*)compactTable.lanes[mask]);
+    _mm256_storeu_si256((__m256i*)(out + n), _mm256_permutevar8x32_epi32(indices, permutation));
+    return n + compactTable.counts[mask];
+}
+
+CG_TARGET_AVX2 static size_t cullSpheresAVX2(const Frustum& f, const SphereBoundsSoA& s, size_t begin, size_t end,
+                                             uint32_t* out)
+{
+    __m256 px[6], py[6], pz[6], pw[6];
+    for (int p = 0; p < 6; p++)
+    {
+        px[p] = _mm256_set1_ps(f.planes[p].x);
+        py[p] = _mm256_set1_ps(f.planes[p].y);
+        pz[p] = _mm256_set1_ps(f.planes[p].z);
+        pw[p] = _mm256_set1_ps(f.planes[p].w);
+    }
+    const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+    size_t n = 0, i = begin;
+    for (; i + 8 <= end; i += 8)
+    {
+        __m256 x = _mm256_loadu_ps(&s.x[i]);
+        __m256 y = _mm256_loadu_ps(&s.y[i]);
+        __m256 z = _mm256_loadu_ps(&s.z[i]);
+        __m256 negRadius = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(&s.radius[i]));
+
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (int p = 0; p < 6; p++)
+        {
+            __m256 d = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(px[p], x), _mm256_mul_ps(py[p], y)),
+                                                   _mm256_mul_ps(pz[p], z)), pw[p]);
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(d, negRadius, _CMP_GE_OQ));
+        }
+        __m256i indices = _mm256_add_epi32(_mm256_set1_epi32((int)i), lane);
+        n = appendMask8(_mm256_movemask_ps(inside), indices, out, n);
+    }
+    return n + cullSpheresScalar(f, s, i, end, out + n);
+}
+
+CG_TARGET_AVX2 static size_t cullBoxesAVX2(const Frustum& f, const BoxBoundsSoA& b, size_t begin, size_t end,
+                                           uint32_t* out)
+{
+    const float* cx[6];
+    const float* cy[6];
+    const float* cz[6];
+    __m256 px[6], py[6], pz[6], pw[6];
+    for (int p = 0; p < 6; p++)
+    {
+        const glm::vec4& plane = f.planes[p];
+        cx[p] = plane.x >= 0.0f ? b.maxX.data() : b.minX.data();
+        cy[p] = plane.y >= 0.0f ? b.maxY.data() : b.minY.data();
+        cz[p] = plane.z >= 0.0f ? b.maxZ.data() : b.minZ.data();
+        px[p] = _mm256_set1_ps(plane.x);
+        py[p] = _mm256_set1_ps(plane.y);
+        pz[p] = _mm256_set1_ps(plane.z);
+        pw[p] = _mm256_set1_ps(plane.w);
+    }
+    const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+    size_t n = 0, i = begin;
+    for (; i + 8 <= end; i += 8)
+    {
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (int p = 0; p < 6; p++)
+        {
+            __m256 d = _mm256_add_ps(
+                _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(px[p], _mm256_loadu_ps(cx[p] + i)),
+                                            _mm256_mul_ps(py[p], _mm256_loadu_ps(cy[p] + i))),
+                              _mm256_mul_ps(pz[p], _mm256_loadu_ps(cz[p] + i))), pw[p]);
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(d, _mm256_setzero_ps(), _CMP_GE_OQ));
+        }
+        __m256i indices = _mm256_add_epi32(_mm256_set1_epi32((int)i), lane);
+        n = appendMask8(_mm256_movemask_ps(inside), indices, out, n);
+    }
+    return n + cullBoxesScalar(f, b, i, end, out + n);
+}
+
+static bool cpuHasAVX2()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 6) != 6) return false;   // registradores YMM salvos pelo sistema
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif
+
+bool cullingPathSupported(CullingPath path)
+{
+#ifdef CG_CULLING_X86
+    static const bool avx2 = cpuHasAVX2();
+    return path != CULLING_AVX2 || avx2;
+#else
+    return path == CULLING_SCALAR;
+#endif
+}
+
+CullingPath bestCullingPath()
+{
+    if (cullingPathSupported(CULLING_AVX2)) return CULLING_AVX2;
+    if (cullingPathSupported(CULLING_SSE)) return CULLING_SSE;
+    return CULLING_SCALAR;
+}
+
+const char* cullingPathName(CullingPath path)
+{
+    switch (path)
+    {
+    case CULLING_SSE: return "SSE";
+    case CULLING_AVX2: return "AVX2";
+    default: return "escalar";
+    }
+}
+
+size_t cullRange(CullingPath path, const Frustum& frustum, const SphereBoundsSoA& spheres, size_t begin, size_t end,
+                 uint32_t* out)
+{
+#ifdef CG_CULLING_X86
+    if (path == CULLING_AVX2) return cullSpheresAVX2(frustum, spheres, begin, end, out);
+    if (path == CULLING_SSE) return cullSpheresSSE(frustum, spheres, begin, end, out);
+#endif
+    return cullSpheresScalar(frustum, spheres, begin, end, out);
+}
+
+size_t cullRange(CullingPath path, const Frustum& frustum, const BoxBoundsSoA& boxes, size_t begin, size_t end,
+                 uint32_t* out)
+{
+#ifdef CG_CULLING_X86
+    if (path == CULLING_AVX2) return cullBoxesAVX2(frustum, boxes, begin, end, out);
+    if (path == CULLING_SSE) return cullBoxesSSE(frustum, boxes, begin, end, out);
+#endif
+    return cullBoxesScalar(frustum, boxes, begin, end, out);
+}
+
+// --- FrustumCuller ----------------------------------------------------------
+
+FrustumCuller::FrustumCuller(ThreadPool* threads, size_t chunkSize)
+    : threads(threads), chunkSize(max<size_t>(8, (chunkSize + 7) / 8 * 8)), selected(bestCullingPath())
+{
+}
+
+void FrustumCuller::setPath(CullingPath path)
+{
+    if (cullingPathSupported(path))
+        selected = path;
+}
+
+const vector<uint32_t>& FrustumCuller::cull(const Frustum& frustum, const SphereBoundsSoA& spheres)
+{
+    return run(frustum, spheres);
+}
+
+const vector<uint32_t>& FrustumCuller::cull(const Frustum& frustum, const BoxBoundsSoA& boxes)
+{
+    return run(frustum, boxes);
+}
+
+template <typename Bounds>
+const vector<uint32_t>& FrustumCuller::run(const Frustum& frustum, const Bounds& bounds)
+{
+    size_t count = bounds.size();
+    size_t chunks = (count + chunkSize - 1) / chunkSize;
+
+    // Cada bloco escreve só dentro da sua faixa de scratch
+    if (scratch.size() < count) scratch.resize(count);
+    chunkCounts.assign(chunks, 0);
+
+    auto testChunk = [&](int c) {
+        size_t begin = c * chunkSize;
+        size_t end = min(count, begin + chunkSize);
+        chunkCounts[c] = cullRange(selected, frustum, bounds, begin, end, scratch.data() + begin);
+    };
+    if (threads && chunks > 1)
+        threads->parallelFor(0, (int)chunks, testChunk);
+    else
+        for (size_t c = 0; c < chunks; c++) testChunk((int)c);
+
+    // Junta na ordem dos blocos
+    vector<size_t> offsets(chunks + 1, 0);
+    for (size_t c = 0; c < chunks; c++)
+        offsets[c + 1] = offsets[c] + chunkCounts[c];
+    result.resize(offsets[chunks]);
+
+    auto copyChunk = [&](int c) {
+        if (chunkCounts[c])
+            memcpy(result.data() + offsets[c], scratch.data() + c * chunkSize, chunkCounts[c] * sizeof(uint32_t));
+    };
+    if (threads && chunks > 1)
+        threads->parallelFor(0, (int)chunks, copyChunk);
+    else
+        for (size_t c = 0; c < chunks; c++) copyChunk((int)c);
+    return result;
+}
@@ -0,0 +1,236 @@
+/*
+ *  Gravação e reprodução do fluxo de chamadas OpenGL - ver include/GLCapture.h
+ */
+
+#include "GLCapture.h"
+#include "GLCaptureCodec.h"
+
+#include <cstdlib>
+#include <iostream>
+
+using namespace std;
+
+bool glCaptureActive = false;
+
+static GLCaptureWriter writer;
+static FILE* captureFile = nullptr;
+static string capturePath;
+static uint32_t captureFrame = 0;
+static uint32_t captureLastFrame = 0;
+
+glcapture::CaptureState& glcapture::captureState()
+{
+    static CaptureState state;
+    return state;
+}
+
+GLCaptureWriter& glCaptureWriter()
+{
+    return writer;
+}
+
+bool GLCaptureWriter::flush(FILE* file)
+{
+    bool ok = fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+    written += buffer.size();
+    buffer.clear();
+    return ok;
+}
+
+bool glCaptureRequested()
+{
+    const char* value = getenv("CG_GL_CAPTURE");
+    return value && *value;
+}
+
+static void stopAtExit()
+{
+    stopGLCapture();
+}
+
+bool startGLCapture(const string& path, uint32_t firstFrame, uint32_t lastFrame)
+{
+    if (glCaptureActive || !glTraceInstalled()) return false;
+
+    captureFile = fopen(path.c_str(), "wb");
+    if (!captureFile)
+    {
+        cout << "GL capture: não foi possível criar " << path << endl;
+        return false;
+    }
+    capturePath = path;
+    captureFrame = 0;
+    captureLastFrame = lastFrame;
+
+    // Estado inicial do contexto, lido antes de a gravação começar
+    GLint viewport[4] = { 0, 0, 0, 0 };
+    GLint major = 0, minor = 0;
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    glGetIntegerv(GL_MAJOR_VERSION, &major);
+    glGetIntegerv(GL_MINOR_VERSION, &minor);
+    GLint profile = 0;
+    if (major > 3 || (major == 3 && minor >= 2))
+        glGetIntegerv(GL_CONTEXT_PROFILE_MASK, &profile);
+
+    glcapture::CaptureState& state = glcapture::captureState();
+    state = glcapture::CaptureState();
+    GLint unpackBuffer = 0;
+    glGetIntegerv(GL_PIXEL_UNPACK_BUFFER_BINDING, &unpackBuffer);
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &state.unpackAlignment);
+    state.unpackBuffer = (GLuint)unpackBuffer;
+
+    writer.put(GLCAPTURE_MAGIC);
+    writer.put(GLCAPTURE_VERSION);
+    writer.put(firstFrame);
+    writer.put(lastFrame);
+    writer.put<int32_t>(viewport[2]);
+    writer.put<int32_t>(viewport[3]);
+    writer.put<int32_t>(major);
+    writer.put<int32_t>(minor);
+    writer.put<int32_t>((profile & GL_CONTEXT_CORE_PROFILE_BIT) ? 1 : 0);
+    writer.put<uint32_t>(GL_ENTRY_COUNT);
+    for (int i = 0; i < GL_ENTRY_COUNT; i++)
+    {
+        const char* name = glEntryPointName((GLEntryPoint)i);
+        writer.put<uint16_t>((uint16_t)strlen(name));
+        writer.put(name, strlen(name));
+    }
+    writer.flush(captureFile);
+
+    static bool registered = false;
+    if (!registered) atexit(stopAtExit);
+    registered = true;
+
+    glCaptureActive = true;
+    cout << "GL capture: gravando em " << path << " (frames medidos " << firstFrame << "-" << lastFrame << ")" << endl;
+    return true;
+}
+
+bool startGLCaptureFromEnvironment()
+{
+    if (!glCaptureRequested()) return false;
+
+    uint32_t first = 0, last = 299;
+    const char* frames = getenv("CG_GL_CAPTURE_FRAMES");
+    if (frames && *frames)
+    {
+        unsigned a = 0, b = 0;
+        if (sscanf(frames, "%u-%u", &a, &b) == 2 && a <= b)
+        {
+            first = a;
+            last = b;
+        }
+        else
+            cout << "GL capture: CG_GL_CAPTURE_FRAMES inválida (use inicio-fim), usando 0-299" << endl;
+    }
+    return startGLCapture(getenv("CG_GL_CAPTURE"), first, last);
+}
+
+void stopGLCapture()
+{
+    if (!captureFile) return;
+    glCaptureActive = false;
+    bool ok = writer.flush(captureFile);
+    ok = fclose(captureFile) == 0 && ok;
+    captureFile = nullptr;
+
+    cout << "GL capture: " << captureFrame << " frames, " << writer.offset() / (1024 * 1024) << " MB em "
+         << capturePath << (ok ? "" : " (erro de escrita)") << endl;
+}
+
+void glCaptureEndFrame()
+{
+    if (!glCaptureActive) return;
+    writer.put(GLCAPTURE_FRAME_MARKER);
+    writer.put(captureFrame);
+    writer.flush(captureFile);
+    if (captureFrame++ >= captureLastFrame)
+        stopGLCapture();
+}
+
+// --- Reprodução -----------------------------------------------------------
+
+bool GLCaptureReader::open(const string& path, GLCaptureHeader& header)
+{
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) return false;
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    storage.assign((size_t)max(length, 0L) / sizeof(uint64_t) + 1, 0);
+    size = fread(storage.data(), 1, (size_t)max(length, 0L), file);
+    fclose(file);
+    position = 0;
+
+    if (get<uint32_t>() != GLCAPTURE_MAGIC || get<uint32_t>() != GLCAPTURE_VERSION)
+        return false;
+    header.firstFrame = get<uint32_t>();
+    header.lastFrame = get<uint32_t>();
+    header.width = get<int32_t>();
+    header.height = get<int32_t>();
+    header.glMajor = get<int32_t>();
+    header.glMinor = get<int32_t>();
+    header.coreProfile = get<int32_t>();
+
+    uint32_t count = get<uint32_t>();
+    header.entryNames.clear();
+    for (uint32_t i = 0; i < count && !overrun(); i++)
+    {
+        uint16_t length = get<uint16_t>();
+        if (position + length > size) return false;
+        header.entryNames.emplace_back((const char*)bytes() + position, length);
+        skip(length);
+    }
+    return !overrun();
+}
+
+typedef GLReplayStep (*ReplayFunction)(GLCaptureReader&, GLReplayState&);
+
+// Uma função por ponto de entrada, com o ponteiro carregado no momento da chamada
+static const ReplayFunction replayFunctions[GL_ENTRY_COUNT] = {
+#define CG_GL_ENTRY(name)                                                                   \
+    [](GLCaptureReader& r, GLReplayState& s) {                                              \
+        return glcapture::Replay<GL_ENTRY_##name, decltype(glad_##name)>::run(r, s, glad_##name); \
+    },
+#include "GLTraceEntryPoints.h"
+#undef CG_GL_ENTRY
+};
+
+GLReplayer::GLReplayer(GLCaptureReader& reader, const GLCaptureHeader& header)
+    : reader(reader), names(header.entryNames)
+{
+    unordered_map<string, int> local;
+    for (int i = 0; i < GL_ENTRY_COUNT; i++)
+        local[glEntryPointName((GLEntryPoint)i)] = i;
+
+    translation.assign(names.size(), -1);
+    for (size_t i = 0; i < names.size(); i++)
+    {
+        auto it = local.find(names[i]);
+        if (it != local.end()) translation[i] = it->second;
+    }
+}
+
+GLReplayStep GLReplayer::step(uint32_t& frame)
+{
+    if (reader.atEnd()) return GL_REPLAY_END;
+
+    uint16_t id = reader.get<uint16_t>();
+    if (id == GLCAPTURE_FRAME_MARKER)
+    {
+        frame = reader.get<uint32_t>();
+        return reader.overrun() ? GL_REPLAY_ERROR : GL_REPLAY_FRAME;
+    }
+
+    // Sem a assinatura não dá para saber onde os argumentos terminam
+    lastEntry = id;
+    if (id >= translation.size() || translation[id] < 0) return GL_REPLAY_ERROR;
+
+    GLReplayStep result = replayFunctions[translation[id]](reader, replayState);
+    return reader.overrun() ? GL_REPLAY_ERROR : result;
+}
+
+const char* GLReplayer::lastEntryName() const
+{
+    return lastEntry >= 0 && lastEntry < (int)names.size() ? names[lastEntry].c_str() : "?";
+}
@@ -0,0 +1,285 @@
+/*
+ *  Mensagens do driver (KHR_debug) - ver include/GLDebug.h
+ */
+
+#include "GLDebug.h"
+#include "GLState.h"
+
+#include <map>
+#include <set>
+#include <tuple>
+#include <vector>
+#include <fstream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+using namespace std;
+
+struct MessageKey
+{
+    GLenum source, type, severity;
+    GLuint id;
+    string objects;   // fragmento JSON com os rótulos dos objetos ativos
+
+    bool operator<(const MessageKey& o) const
+    {
+        return tie(source, type, severity, id, objects) < tie(o.source, o.type, o.severity, o.id, o.objects);
+    }
+};
+
+struct MessageTotals
+{
+    GLenum type, severity;
+    unsigned long long count = 0;
+    unsigned long long frames = 0;
+    unsigned long long firstFrame = 0, lastFrame = 0;
+    string message;
+};
+
+static bool installed = false;
+static ofstream logFile;
+static string logPath;
+static unsigned long long frame = 0;
+
+static map<pair<GLenum, GLuint>, string> labels;
+static map<MessageKey, pair<unsigned long long, string>> frameMessages;   // contagem, texto
+static map<tuple<GLenum, GLenum, GLuint>, MessageTotals> totals;          // fonte, tipo, id
+static unsigned long long lastFrameCounts[3];                              // desempenho, erro, outros
+
+static const char* sourceName(GLenum source)
+{
+    switch (source)
+    {
+    case GL_DEBUG_SOURCE_API: return "api";
+    case GL_DEBUG_SOURCE_WINDOW_SYSTEM: return "window";
+    case GL_DEBUG_SOURCE_SHADER_COMPILER: return "shader";
+    case GL_DEBUG_SOURCE_THIRD_PARTY: return "third_party";
+    case GL_DEBUG_SOURCE_APPLICATION: return "application";
+    }
+    return "other";
+}
+
+static const char* typeName(GLenum type)
+{
+    switch (type)
+    {
+    case GL_DEBUG_TYPE_ERROR: return "error";
+    case GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR: return "deprecated";
+    case GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR: return "undefined";
+    case GL_DEBUG_TYPE_PORTABILITY: return "portability";
+    case GL_DEBUG_TYPE_PERFORMANCE: return "performance";
+    case GL_DEBUG_TYPE_MARKER: return "marker";
+    }
+    return "other";
+}
+
+static const char* severityName(GLenum severity)
+{
+    switch (severity)
+    {
+    case GL_DEBUG_SEVERITY_HIGH: return "high";
+    case GL_DEBUG_SEVERITY_MEDIUM: return "medium";
+    case GL_DEBUG_SEVERITY_LOW: return "low";
+    }
+    return "notification";
+}
+
+static string jsonString(const string& text)
+{
+    string out = "\"";
+    for (char c : text)
+    {
+        switch (c)
+        {
+        case '"': out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': break;
+        case '\t': out += "\\t"; break;
+        default:
+            if ((unsigned char)c < 0x20)
+            {
+                char escaped[8];
+                snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                out += escaped;
+            }
+            else
+                out += c;
+        }
+    }
+    return out + "\"";
+}
+
+// Rótulos do programa, VAO e texturas vinculados, pelo cache de estado
+static string activeObjects()
+{
+    const GLStateCache& state = glState();
+    string out;
+    if (const char* label = glObjectLabelOf(GL_PROGRAM, state.boundProgram()))
+        out += "\"program\":" + jsonString(label) + ",";
+    if (const char* label = glObjectLabelOf(GL_VERTEX_ARRAY, state.boundVertexArray()))
+        out += "\"vertexArray\":" + jsonString(label) + ",";
+
+    string textures;
+    for (GLuint unit = 0; unit < state.textureUnits(); unit++)
+        if (const char* label = glObjectLabelOf(GL_TEXTURE, state.boundTexture(unit)))
+            textures += (textures.empty() ? "" : ",") + jsonString(label);
+    if (!textures.empty())
+        out += "\"textures\":[" + textures + "],";
+    return out;
+}
+
+static void APIENTRY onDebugMessage(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length,
+                                    const GLchar* message, const void*)
+{
+    string text = length >= 0 ? string(message, length) : string(message);
+    while (!text.empty() && (text.back() == '\n' || text.back() == ' '))
+        text.pop_back();
+
+    MessageKey key = { source, type, severity, id, activeObjects() };
+    auto& bucket = frameMessages[key];
+    if (bucket.first++ == 0) bucket.second = text;
+
+    MessageTotals& total = totals[make_tuple(source, type, id)];
+    bool first = total.count++ == 0;
+    if (first)
+    {
+        total.type = type;
+        total.severity = severity;
+        total.message = text;
+        total.firstFrame = frame;
+    }
+
+    // No console: todo erro, e cada aviso de desempenho uma vez
+    if (type == GL_DEBUG_TYPE_ERROR)
+        cout << "GL erro [" << id << "] no frame " << frame << ": " << text << endl;
+    else if (type == GL_DEBUG_TYPE_PERFORMANCE && first)
+        cout << "GL desempenho [" << id << "] no frame " << frame << ": " << text << endl;
+}
+
+bool glDebugRequested()
+{
+    const char* value = getenv("CG_GL_DEBUG");
+    return value && *value && strcmp(value, "0") != 0;
+}
+
+static void reportAtExit()
+{
+    if (!frameMessages.empty()) glDebugEndFrame();   // mensagens depois do último frame (limpeza)
+    glDebugReport(cout);
+}
+
+bool installGLDebug()
+{
+    if (installed) return true;
+    if (!GLAD_GL_KHR_debug)
+    {
+        cout << "GL debug: KHR_debug indisponível neste contexto" << endl;
+        return false;
+    }
+
+    GLint flags = 0;
+    glGetIntegerv(GL_CONTEXT_FLAGS, &flags);
+    if (!(flags & GL_CONTEXT_FLAG_DEBUG_BIT))
+        cout << "GL debug: contexto sem GLFW_OPENGL_DEBUG_CONTEXT; o driver pode omitir mensagens" << endl;
+
+    const char* path = getenv("CG_GL_DEBUG_LOG");
+    logPath = path && *path ? path : "gl_debug.jsonl";
+    logFile.open(logPath);
+    if (!logFile.is_open())
+        cout << "GL debug: não foi possível criar " << logPath << endl;
+
+    glEnable(GL_DEBUG_OUTPUT);
+    glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+    glDebugMessageCallback(onDebugMessage, nullptr);
+    glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DONT_CARE, 0, nullptr, GL_TRUE);
+    glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DEBUG_SEVERITY_NOTIFICATION, 0, nullptr, GL_FALSE);
+
+    installed = true;
+    atexit(reportAtExit);
+    cout << "GL debug: mensagens do driver em " << logPath << endl;
+    return true;
+}
+
+bool glDebugInstalled()
+{
+    return installed;
+}
+
+void labelGLObject(GLenum identifier, GLuint name, const string& label)
+{
+    if (!name) return;
+    labels[make_pair(identifier, name)] = label;
+    if (GLAD_GL_KHR_debug)
+        glObjectLabel(identifier, name, (GLsizei)label.size(), label.c_str());
+}
+
+const char* glObjectLabelOf(GLenum identifier, GLuint name)
+{
+    auto it = labels.find(make_pair(identifier, name));
+    return it == labels.end() ? nullptr : it->second.c_str();
+}
+
+void forgetGLObjectLabel(GLenum identifier, GLuint name)
+{
+    labels.erase(make_pair(identifier, name));
+}
+
+void glDebugEndFrame()
+{
+    if (!installed) return;
+
+    fill(begin(lastFrameCounts), end(lastFrameCounts), 0ull);
+    set<tuple<GLenum, GLenum, GLuint>> seen;
+    for (const auto& entry : frameMessages)
+    {
+        const MessageKey& key = entry.first;
+        unsigned long long count = entry.second.first;
+        lastFrameCounts[key.type == GL_DEBUG_TYPE_PERFORMANCE ? 0 : key.type == GL_DEBUG_TYPE_ERROR ? 1 : 2] += count;
+
+        auto id = make_tuple(key.source, key.type, key.id);
+        if (seen.insert(id).second)
+        {
+            MessageTotals& total = totals[id];
+            total.frames++;
+            total.lastFrame = frame;
+        }
+
+        if (logFile.is_open())
+            logFile << "{\"frame\":" << frame << ",\"source\":\"" << sourceName(key.source) << "\",\"type\":\""
+                    << typeName(key.type) << "\",\"severity\":\"" << severityName(key.severity) << "\",\"id\":"
+                    << key.id << ",\"count\":" << count << "," << key.objects
+                    << "\"message\":" << jsonString(entry.second.second) << "}\n";
+    }
+    if (logFile.is_open() && !frameMessages.empty())
+        logFile.flush();
+
+    frameMessages.clear();
+    frame++;
+}
+
+void glDebugPrintFrame()
+{
+    cout << "GL debug: " << lastFrameCounts[0] << " avisos de desempenho, " << lastFrameCounts[1] << " erros, "
+         << lastFrameCounts[2] << " outras mensagens no último frame" << endl;
+}
+
+void glDebugReport(ostream& out)
+{
+    if (!installed) return;
+
+    vector<pair<tuple<GLenum, GLenum, GLuint>, MessageTotals>> list(totals.begin(), totals.end());
+    sort(list.begin(), list.end(), [](const auto& a, const auto& b) { return a.second.count > b.second.count; });
+
+    out << "\n=== GL debug: " << list.size() << " mensagens distintas em " << frame << " frames (" << logPath
+        << ") ===" << endl;
+    for (const auto& entry : list)
+    {
+        const MessageTotals& t = entry.second;
+        out << "  [" << typeName(t.type) << "/" << severityName(t.severity) << "] " << get<2>(entry.first) << ": "
+            << t.count << " vezes em " << t.frames << " frames (" << t.firstFrame << "-" << t.lastFrame << ") "
+            << t.message << endl;
+    }
+}
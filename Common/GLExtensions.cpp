@@ -0,0 +1,197 @@
+/*
+ *  Carregamento das funções OpenGL posteriores à 4.0 - ver include/GLExtensions.h
+ */
+
+#include "GLExtensions.h"
+#include "GLTrace.h"
+#include "GLCapture.h"
+#include "GLDebug.h"
+
+#include <cstring>
+
+#ifdef CG_GLEXT_VERSION_4_1
+int GLAD_GL_VERSION_4_1 = 0;
+PFNGLGETPROGRAMBINARYPROC glad_glGetProgramBinary = NULL;
+PFNGLPROGRAMBINARYPROC glad_glProgramBinary = NULL;
+PFNGLPROGRAMPARAMETERIPROC glad_glProgramParameteri = NULL;
+
+static void load_GL_VERSION_4_1(GLADloadproc load)
+{
+    glad_glGetProgramBinary = (PFNGLGETPROGRAMBINARYPROC)load("glGetProgramBinary");
+    glad_glProgramBinary = (PFNGLPROGRAMBINARYPROC)load("glProgramBinary");
+    glad_glProgramParameteri = (PFNGLPROGRAMPARAMETERIPROC)load("glProgramParameteri");
+}
+#endif
+
+#ifdef CG_GLEXT_VERSION_4_3
+int GLAD_GL_VERSION_4_3 = 0;
+PFNGLCOPYIMAGESUBDATAPROC glad_glCopyImageSubData = NULL;
+PFNGLMULTIDRAWELEMENTSINDIRECTPROC glad_glMultiDrawElementsIndirect = NULL;
+PFNGLDISPATCHCOMPUTEPROC glad_glDispatchCompute = NULL;
+PFNGLMEMORYBARRIERPROC glad_glMemoryBarrier = NULL;
+PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXBASEINSTANCEPROC glad_glDrawElementsInstancedBaseVertexBaseInstance = NULL;
+PFNGLBINDIMAGETEXTUREPROC glad_glBindImageTexture = NULL;
+
+static void load_GL_VERSION_4_3(GLADloadproc load)
+{
+    glad_glCopyImageSubData = (PFNGLCOPYIMAGESUBDATAPROC)load("glCopyImageSubData");
+    glad_glMultiDrawElementsIndirect = (PFNGLMULTIDRAWELEMENTSINDIRECTPROC)load("glMultiDrawElementsIndirect");
+    glad_glDispatchCompute = (PFNGLDISPATCHCOMPUTEPROC)load("glDispatchCompute");
+    glad_glMemoryBarrier = (PFNGLMEMORYBARRIERPROC)load("glMemoryBarrier");
+    glad_glDrawElementsInstancedBaseVertexBaseInstance =
+        (PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXBASEINSTANCEPROC)load("glDrawElementsInstancedBaseVertexBaseInstance");
+    glad_glBindImageTexture = (PFNGLBINDIMAGETEXTUREPROC)load("glBindImageTexture");
+}
+#endif
+
+#ifdef CG_GLEXT_VERSION_4_4
+int GLAD_GL_VERSION_4_4 = 0;
+PFNGLBINDTEXTURESPROC glad_glBindTextures = NULL;
+PFNGLBINDSAMPLERSPROC glad_glBindSamplers = NULL;
+PFNGLBINDBUFFERSRANGEPROC glad_glBindBuffersRange = NULL;
+PFNGLBUFFERSTORAGEPROC glad_glBufferStorage = NULL;
+
+static void load_GL_VERSION_4_4(GLADloadproc load)
+{
+    glad_glBindTextures = (PFNGLBINDTEXTURESPROC)load("glBindTextures");
+    glad_glBindSamplers = (PFNGLBINDSAMPLERSPROC)load("glBindSamplers");
+    glad_glBindBuffersRange = (PFNGLBINDBUFFERSRANGEPROC)load("glBindBuffersRange");
+    glad_glBufferStorage = (PFNGLBUFFERSTORAGEPROC)load("glBufferStorage");
+}
+#endif
+
+#ifdef CG_GLEXT_VERSION_4_5
+int GLAD_GL_VERSION_4_5 = 0;
+PFNGLCREATETEXTURESPROC glad_glCreateTextures = NULL;
+PFNGLTEXTURESTORAGE2DPROC glad_glTextureStorage2D = NULL;
+PFNGLTEXTURESUBIMAGE2DPROC glad_glTextureSubImage2D = NULL;
+PFNGLGENERATETEXTUREMIPMAPPROC glad_glGenerateTextureMipmap = NULL;
+PFNGLBINDTEXTUREUNITPROC glad_glBindTextureUnit = NULL;
+PFNGLTEXTUREPARAMETERIPROC glad_glTextureParameteri = NULL;
+PFNGLCREATESAMPLERSPROC glad_glCreateSamplers = NULL;
+
+static void load_GL_VERSION_4_5(GLADloadproc load)
+{
+    glad_glCreateTextures = (PFNGLCREATETEXTURESPROC)load("glCreateTextures");
+    glad_glTextureStorage2D = (PFNGLTEXTURESTORAGE2DPROC)load("glTextureStorage2D");
+    glad_glTextureSubImage2D = (PFNGLTEXTURESUBIMAGE2DPROC)load("glTextureSubImage2D");
+    glad_glGenerateTextureMipmap = (PFNGLGENERATETEXTUREMIPMAPPROC)load("glGenerateTextureMipmap");
+    glad_glBindTextureUnit = (PFNGLBINDTEXTUREUNITPROC)load("glBindTextureUnit");
+    glad_glTextureParameteri = (PFNGLTEXTUREPARAMETERIPROC)load("glTextureParameteri");
+    glad_glCreateSamplers = (PFNGLCREATESAMPLERSPROC)load("glCreateSamplers");
+}
+#endif
+
+#ifdef CG_GLEXT_KHR_parallel_shader_compile
+int GLAD_GL_KHR_parallel_shader_compile = 0;
+PFNGLMAXSHADERCOMPILERTHREADSKHRPROC glad_glMaxShaderCompilerThreadsKHR = NULL;
+#endif
+
+#ifdef CG_GLEXT_KHR_debug
+int GLAD_GL_KHR_debug = 0;
+PFNGLDEBUGMESSAGECONTROLPROC glad_glDebugMessageControl = NULL;
+PFNGLDEBUGMESSAGECALLBACKPROC glad_glDebugMessageCallback = NULL;
+PFNGLOBJECTLABELPROC glad_glObjectLabel = NULL;
+
+static void load_GL_KHR_debug(GLADloadproc load)
+{
+    glad_glDebugMessageControl = (PFNGLDEBUGMESSAGECONTROLPROC)load("glDebugMessageControl");
+    glad_glDebugMessageCallback = (PFNGLDEBUGMESSAGECALLBACKPROC)load("glDebugMessageCallback");
+    glad_glObjectLabel = (PFNGLOBJECTLABELPROC)load("glObjectLabel");
+}
+#endif
+
+static bool contextVersionAtLeast(int major, int minor)
+{
+    GLint ctxMajor = 0, ctxMinor = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &ctxMajor);
+    glGetIntegerv(GL_MINOR_VERSION, &ctxMinor);
+    return ctxMajor > major || (ctxMajor == major && ctxMinor >= minor);
+}
+
+bool hasGLExtension(const char* name)
+{
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (GLint i = 0; i < count; i++)
+    {
+        const char* ext = (const char*)glGetStringi(GL_EXTENSIONS, i);
+        if (ext && strcmp(ext, name) == 0)
+            return true;
+    }
+    return false;
+}
+
+int loadGLExtensions(GLADloadproc load)
+{
+    if (!glGetString || !glGetIntegerv) return 0;
+
+#ifdef CG_GLEXT_VERSION_4_1
+    GLAD_GL_VERSION_4_1 = contextVersionAtLeast(4, 1);
+    if (GLAD_GL_VERSION_4_1)
+    {
+        load_GL_VERSION_4_1(load);
+        GLAD_GL_VERSION_4_1 = glad_glGetProgramBinary != NULL && glad_glProgramBinary != NULL &&
+                              glad_glProgramParameteri != NULL;
+    }
+#endif
+
+#ifdef CG_GLEXT_VERSION_4_3
+    GLAD_GL_VERSION_4_3 = contextVersionAtLeast(4, 3);
+    if (GLAD_GL_VERSION_4_3)
+    {
+        load_GL_VERSION_4_3(load);
+        GLAD_GL_VERSION_4_3 = glad_glCopyImageSubData != NULL && glad_glMultiDrawElementsIndirect != NULL &&
+                              glad_glDispatchCompute != NULL && glad_glMemoryBarrier != NULL &&
+                              glad_glDrawElementsInstancedBaseVertexBaseInstance != NULL &&
+                              glad_glBindImageTexture != NULL;
+    }
+#endif
+
+#ifdef CG_GLEXT_VERSION_4_4
+    GLAD_GL_VERSION_4_4 = contextVersionAtLeast(4, 4);
+    if (GLAD_GL_VERSION_4_4)
+    {
+        load_GL_VERSION_4_4(load);
+        GLAD_GL_VERSION_4_4 = glad_glBindTextures != NULL && glad_glBindSamplers != NULL &&
+                              glad_glBindBuffersRange != NULL && glad_glBufferStorage != NULL;
+    }
+#endif
+
+#ifdef CG_GLEXT_VERSION_4_5
+    GLAD_GL_VERSION_4_5 = contextVersionAtLeast(4, 5);
+    if (GLAD_GL_VERSION_4_5)
+    {
+        load_GL_VERSION_4_5(load);
+        GLAD_GL_VERSION_4_5 = glad_glCreateTextures != NULL && glad_glTextureStorage2D != NULL;
+    }
+#endif
+
+#ifdef CG_GLEXT_KHR_parallel_shader_compile
+    // A versão ARB tem os mesmos enums e a mesma assinatura, só muda o sufixo
+    if (hasGLExtension("GL_KHR_parallel_shader_compile"))
+        glad_glMaxShaderCompilerThreadsKHR = (PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)load("glMaxShaderCompilerThreadsKHR");
+    else if (hasGLExtension("GL_ARB_parallel_shader_compile"))
+        glad_glMaxShaderCompilerThreadsKHR = (PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)load("glMaxShaderCompilerThreadsARB");
+    GLAD_GL_KHR_parallel_shader_compile = glad_glMaxShaderCompilerThreadsKHR != NULL;
+#endif
+
+#ifdef CG_GLEXT_KHR_debug
+    // No desktop a extensão usa os mesmos nomes, sem sufixo
+    if (contextVersionAtLeast(4, 3) || hasGLExtension("GL_KHR_debug"))
+        load_GL_KHR_debug(load);
+    GLAD_GL_KHR_debug = glad_glDebugMessageControl != NULL && glad_glDebugMessageCallback != NULL &&
+                        glad_glObjectLabel != NULL;
+#endif
+
+    // Com todos os ponteiros carregados: instrumentação opcional (CG_GL_TRACE=1)
+    // e gravação do fluxo de chamadas (CG_GL_CAPTURE=arquivo), que usa os
+    // mesmos invólucros
+    if (glTraceRequested() || glCaptureRequested())
+        installGLTrace();
+    startGLCaptureFromEnvironment();
+    if (glDebugRequested())
+        installGLDebug();
+
+    return 1;
+}
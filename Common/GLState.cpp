@@ -0,0 +1,322 @@
+/*
+ *  Cache do estado OpenGL - ver include/GLState.h
+ */
+
+#include "GLState.h"
+#include "GLExtensions.h"
+
+#include <iostream>
+#include <algorithm>
+
+using namespace std;
+
+// Nenhum nome OpenGL válido: força a próxima chamada a chegar ao driver
+static const GLuint UNKNOWN = ~0u;
+
+GLStateCache& glState()
+{
+    static GLStateCache cache;
+    return cache;
+}
+
+GLStateCache::GLStateCache()
+{
+    invalidate();
+}
+
+void GLStateCache::invalidate()
+{
+    program = UNKNOWN;
+    vertexArray = UNKNOWN;
+    fill(textures.begin(), textures.end(), UNKNOWN);
+    fill(samplers.begin(), samplers.end(), UNKNOWN);
+    buffers.clear();
+    ranges.clear();
+    depthKnown = blendKnown = rasterKnown = false;
+}
+
+void GLStateCache::invalidateTextureUnit(GLuint unit)
+{
+    if (unit < textures.size())
+        textures[unit] = UNKNOWN;
+}
+
+void GLStateCache::growUnits(size_t count)
+{
+    if (textures.size() < count)
+    {
+        textures.resize(count, UNKNOWN);
+        samplers.resize(count, UNKNOWN);
+    }
+}
+
+void GLStateCache::useProgram(GLuint name)
+{
+    current.requested++;
+    if (program == name) return;
+    glUseProgram(name);
+    program = name;
+    issue();
+}
+
+void GLStateCache::bindVertexArray(GLuint name)
+{
+    current.requested++;
+    if (vertexArray == name) return;
+    glBindVertexArray(name);
+    vertexArray = name;
+    issue();
+}
+
+void GLStateCache::setDepth(const DepthState& d)
+{
+    current.requested += 3;
+    if (!depthKnown || d.test != depth.test)
+    {
+        if (d.test) glEnable(GL_DEPTH_TEST);
+        else glDisable(GL_DEPTH_TEST);
+        issue();
+    }
+    if (!depthKnown || d.write != depth.write)
+    {
+        glDepthMask(d.write ? GL_TRUE : GL_FALSE);
+        issue();
+    }
+    if (!depthKnown || d.func != depth.func)
+    {
+        glDepthFunc(d.func);
+        issue();
+    }
+    depth = d;
+    depthKnown = true;
+}
+
+void GLStateCache::setBlend(const BlendState& b)
+{
+    current.requested += 2;
+    if (!blendKnown || b.enabled != blend.enabled)
+    {
+        if (b.enabled) glEnable(GL_BLEND);
+        else glDisable(GL_BLEND);
+        issue();
+    }
+    if (!blendKnown || b.srcFactor != blend.srcFactor || b.dstFactor != blend.dstFactor)
+    {
+        glBlendFunc(b.srcFactor, b.dstFactor);
+        issue();
+    }
+    blend = b;
+    blendKnown = true;
+}
+
+void GLStateCache::setRaster(const RasterState& r)
+{
+    current.requested += 4;
+    if (!rasterKnown || r.cullFace != raster.cullFace)
+    {
+        if (r.cullFace) glEnable(GL_CULL_FACE);
+        else glDisable(GL_CULL_FACE);
+        issue();
+    }
+    if (!rasterKnown || r.cullMode != raster.cullMode)
+    {
+        glCullFace(r.cullMode);
+        issue();
+    }
+    if (!rasterKnown || r.frontFace != raster.frontFace)
+    {
+        glFrontFace(r.frontFace);
+        issue();
+    }
+    if (!rasterKnown || r.polygonMode != raster.polygonMode)
+    {
+        glPolygonMode(GL_FRONT_AND_BACK, r.polygonMode);
+        issue();
+    }
+    raster = r;
+    rasterKnown = true;
+}
+
+void GLStateCache::bindPipeline(const PipelineState& pipeline)
+{
+    const PipelineDesc& desc = pipeline.description();
+    useProgram(desc.program);
+    bindVertexArray(desc.vertexArray);
+    setRaster(desc.raster);
+    setDepth(desc.depth);
+    setBlend(desc.blend);
+}
+
+void GLStateCache::bindTexture(GLuint unit, GLuint texture, GLenum target)
+{
+    current.requested++;
+    growUnits(unit + 1);
+    if (textures[unit] == texture) return;
+
+    if (GLAD_GL_VERSION_4_5)
+    {
+        glBindTextureUnit(unit, texture);
+        issue();
+    }
+    else
+    {
+        // A unidade ativa volta para a 0, a usada para editar texturas. Conta
+        // como um bind emitido, para issued não passar de requested
+        glActiveTexture(GL_TEXTURE0 + unit);
+        glBindTexture(target, texture);
+        glActiveTexture(GL_TEXTURE0);
+        issue();
+    }
+    textures[unit] = texture;
+}
+
+void GLStateCache::bindSampler(GLuint unit, GLuint sampler)
+{
+    current.requested++;
+    growUnits(unit + 1);
+    if (samplers[unit] == sampler) return;
+    glBindSampler(unit, sampler);
+    samplers[unit] = sampler;
+    issue();
+}
+
+void GLStateCache::bindTextures(GLuint first, GLsizei count, const GLuint* names, const GLuint* samplerNames)
+{
+    if (count <= 0) return;
+    if (!GLAD_GL_VERSION_4_4)
+    {
+        for (GLsizei i = 0; i < count; i++)
+        {
+            bindTexture(first + i, names[i]);
+            if (samplerNames) bindSampler(first + i, samplerNames[i]);
+        }
+        return;
+    }
+
+    growUnits(first + count);
+    current.requested += samplerNames ? 2 * count : count;
+
+    // Uma chamada para a faixa entre a primeira e a última unidade que mudou
+    GLsizei lo = count, hi = -1;
+    for (GLsizei i = 0; i < count; i++)
+        if (textures[first + i] != names[i]) { lo = min(lo, i); hi = i; }
+    if (hi >= lo)
+    {
+        glBindTextures(first + lo, hi - lo + 1, names + lo);
+        copy(names + lo, names + hi + 1, textures.begin() + first + lo);
+        issue();
+    }
+
+    if (!samplerNames) return;
+    lo = count, hi = -1;
+    for (GLsizei i = 0; i < count; i++)
+        if (samplers[first + i] != samplerNames[i]) { lo = min(lo, i); hi = i; }
+    if (hi >= lo)
+    {
+        glBindSamplers(first + lo, hi - lo + 1, samplerNames + lo);
+        copy(samplerNames + lo, samplerNames + hi + 1, samplers.begin() + first + lo);
+        issue();
+    }
+}
+
+void GLStateCache::bindBuffer(GLenum target, GLuint buffer)
+{
+    current.requested++;
+    if (target != GL_ELEMENT_ARRAY_BUFFER)
+    {
+        auto it = buffers.find(target);
+        if (it != buffers.end() && it->second == buffer) return;
+        buffers[target] = buffer;
+    }
+    glBindBuffer(target, buffer);
+    issue();
+}
+
+vector<GLStateCache::BufferRange>& GLStateCache::indexedBindings(GLenum target, size_t count)
+{
+    vector<BufferRange>& list = ranges[target];
+    if (list.size() < count)
+        list.resize(count, { UNKNOWN, -1, -1 });
+    return list;
+}
+
+void GLStateCache::bindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size)
+{
+    current.requested++;
+    vector<BufferRange>& list = indexedBindings(target, index + 1);
+    BufferRange range = { buffer, offset, size };
+    if (list[index] == range) return;
+
+    // glBindBufferRange também troca o vínculo genérico do alvo
+    glBindBufferRange(target, index, buffer, offset, size);
+    list[index] = range;
+    buffers[target] = buffer;
+    issue();
+}
+
+void GLStateCache::bindBuffersRange(GLenum target, GLuint first, GLsizei count, const GLuint* names,
+                                    const GLintptr* offsets, const GLsizeiptr* sizes)
+{
+    if (count <= 0) return;
+    if (!GLAD_GL_VERSION_4_4)
+    {
+        for (GLsizei i = 0; i < count; i++)
+            bindBufferRange(target, first + i, names[i], offsets[i], sizes[i]);
+        return;
+    }
+
+    current.requested += count;
+    vector<BufferRange>& list = indexedBindings(target, first + count);
+    GLsizei lo = count, hi = -1;
+    for (GLsizei i = 0; i < count; i++)
+    {
+        BufferRange range = { names[i], offsets[i], sizes[i] };
+        if (!(list[first + i] == range)) { lo = min(lo, i); hi = i; }
+    }
+    if (hi < lo) return;
+
+    // Ao contrário de glBindBufferRange, não mexe no vínculo genérico
+    glBindBuffersRange(target, first + lo, hi - lo + 1, names + lo, offsets + lo, sizes + lo);
+    for (GLsizei i = lo; i <= hi; i++)
+        list[first + i] = { names[i], offsets[i], sizes[i] };
+    issue();
+}
+
+void GLStateCache::forgetTexture(GLuint texture)
+{
+    // Apagar uma textura vinculada desvincula as unidades onde ela estava
+    replace(textures.begin(), textures.end(), texture, 0u);
+}
+
+void GLStateCache::forgetBuffer(GLuint buffer)
+{
+    for (auto& binding : buffers)
+        if (binding.second == buffer) binding.second = 0;
+    for (auto& list : ranges)
+        for (BufferRange& range : list.second)
+            if (range.buffer == buffer) range = { 0, 0, 0 };
+}
+
+void GLStateCache::forgetVertexArray(GLuint name)
+{
+    if (vertexArray == name) vertexArray = 0;
+}
+
+void GLStateCache::endFrame()
+{
+    total.requested += current.requested;
+    total.issued += current.issued;
+    frames++;
+    previous = current;
+    current = GLStateStats();
+}
+
+void GLStateCache::printStats() const
+{
+    unsigned long long percent = previous.requested ? previous.eliminated() * 100 / previous.requested : 0;
+    cout << "Estado GL: " << previous.eliminated() << " de " << previous.requested
+         << " chamadas eliminadas no último frame (" << percent << "%)";
+    if (frames)
+        cout << " | média " << total.eliminated() / frames << " por frame em " << frames << " frames";
+    cout << endl;
+}
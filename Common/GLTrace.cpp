@@ -0,0 +1,375 @@
+/*
+ *  Instrumentação das chamadas OpenGL - ver include/GLTrace.h
+ */
+
+#include "GLTrace.h"
+#include "GLExtensions.h"
+#include "GLCapture.h"
+#include "GLCaptureCodec.h"
+#include "GLDebug.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <type_traits>
+
+using namespace std;
+
+enum EntryCategory : unsigned char
+{
+    CATEGORY_OTHER,
+    CATEGORY_DRAW,
+    CATEGORY_STATE,
+};
+
+struct EntryCounters
+{
+    unsigned long long frameCalls;
+    unsigned long long totalCalls;
+    unsigned long long maxPerFrame;
+    long long frameNanos;
+    long long totalNanos;
+    EntryCategory category;
+};
+
+static const char* const entryNames[GL_ENTRY_COUNT] = {
+#define CG_GL_ENTRY(name) #name,
+#include "GLTraceEntryPoints.h"
+#undef CG_GL_ENTRY
+};
+
+static EntryCounters counters[GL_ENTRY_COUNT];
+static unsigned long long frameUploadBytes = 0;
+static GLTraceFrame lastFrame;
+static GLTraceFrame totals;
+static unsigned long long frames = 0;
+static bool installed = false;
+
+// --- Bytes enviados pela CPU ---------------------------------------------
+// Só conta quando há ponteiro de dados: com nullptr é alocação (ou leitura
+// de um PBO, que não sai da memória do processo)
+
+static size_t imageBytes(GLsizei w, GLsizei h, GLsizei d, GLenum format, GLenum type, const void* pixels)
+{
+    return pixels ? (size_t)w * h * d * glcapture::glPixelBytes(format, type) : 0;
+}
+
+template <int Id>
+struct Upload
+{
+    template <typename... Args>
+    static size_t bytes(Args...) { return 0; }
+};
+
+template <> struct Upload<GL_ENTRY_glBufferData>
+{
+    static size_t bytes(GLenum, GLsizeiptr size, const void* data, GLenum) { return data ? size : 0; }
+};
+
+template <> struct Upload<GL_ENTRY_glBufferSubData>
+{
+    static size_t bytes(GLenum, GLintptr, GLsizeiptr size, const void* data) { return data ? size : 0; }
+};
+
+template <> struct Upload<GL_ENTRY_glTexImage1D>
+{
+    static size_t bytes(GLenum, GLint, GLint, GLsizei w, GLint, GLenum format, GLenum type, const void* pixels)
+    {
+        return imageBytes(w, 1, 1, format, type, pixels);
+    }
+};
+
+template <> struct Upload<GL_ENTRY_glTexImage2D>
+{
+    static size_t bytes(GLenum, GLint, GLint, GLsizei w, GLsizei h, GLint, GLenum format, GLenum type,
+                        const void* pixels)
+    {
+        return imageBytes(w, h, 1, format, type, pixels);
+    }
+};
+
+template <> struct Upload<GL_ENTRY_glTexImage3D>
+{
+    static size_t bytes(GLenum, GLint, GLint, GLsizei w, GLsizei h, GLsizei d, GLint, GLenum format,
+                        GLenum type, const void* pixels)
+    {
+        return imageBytes(w, h, d, format, type, pixels);
+    }
+};
+
+template <> struct Upload<GL_ENTRY_glTexSubImage1D>
+{
+    static size_t bytes(GLenum, GLint, GLint, GLsizei w, GLenum format, GLenum type, const void* pixels)
+    {
+        return imageBytes(w, 1, 1, format, type, pixels);
+    }
+};
+
+template <> struct Upload<GL_ENTRY_glTexSubImage2D>
+{
+    static size_t bytes(GLenum, GLint, GLint, GLint, GLsizei w, GLsizei h, GLenum format, GLenum type,
+                        const void* pixels)
+    {
+        return imageBytes(w, h, 1, format, type, pixels);
+    }
+};
+
+template <> struct Upload<GL_ENTRY_glTexSubImage3D>
+{
+    static size_t bytes(GLenum, GLint, GLint, GLint, GLint, GLsizei w, GLsizei h, GLsizei d, GLenum format,
+                        GLenum type, const void* pixels)
+    {
+        return imageBytes(w, h, d, format, type, pixels);
+    }
+};
+
+template <> struct Upload<GL_ENTRY_glTextureSubImage2D>
+{
+    static size_t bytes(GLuint, GLint, GLint, GLint, GLsizei w, GLsizei h, GLenum format, GLenum type,
+                        const void* pixels)
+    {
+        return imageBytes(w, h, 1, format, type, pixels);
+    }
+};
+
+template <> struct Upload<GL_ENTRY_glCompressedTexImage2D>
+{
+    static size_t bytes(GLenum, GLint, GLenum, GLsizei, GLsizei, GLint, GLsizei size, const void* data)
+    {
+        return data ? size : 0;
+    }
+};
+
+template <> struct Upload<GL_ENTRY_glCompressedTexSubImage2D>
+{
+    static size_t bytes(GLenum, GLint, GLint, GLint, GLsizei, GLsizei, GLenum, GLsizei size, const void* data)
+    {
+        return data ? size : 0;
+    }
+};
+
+// --- Invólucros --------------------------------------------------------------
+
+struct CallTimer
+{
+    int id;
+    chrono::steady_clock::time_point start;
+
+    explicit CallTimer(int id) : id(id), start(chrono::steady_clock::now()) {}
+    ~CallTimer()
+    {
+        EntryCounters& c = counters[id];
+        c.frameCalls++;
+        c.frameNanos += chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+    }
+};
+
+// Um invólucro por ponto de entrada, com a mesma assinatura do ponteiro
+template <int Id, typename F>
+struct Hook;
+
+template <int Id, typename R, typename... Args>
+struct Hook<Id, R (APIENTRYP)(Args...)>
+{
+    typedef R (APIENTRYP Function)(Args...);
+    static inline Function original = nullptr;
+
+    static R APIENTRY call(Args... args)
+    {
+        frameUploadBytes += Upload<Id>::bytes(args...);
+        if (!glCaptureActive)
+        {
+            CallTimer timer(Id);
+            return original(args...);
+        }
+
+        // Gravando: argumentos antes (o driver pode mudar o que apontam),
+        // retorno e saídas depois; a gravação fica fora do tempo medido
+        typedef glcapture::Recorder<Id, Args...> Record;
+        Record::before(args...);
+        if constexpr (is_void<R>::value)
+        {
+            {
+                CallTimer timer(Id);
+                original(args...);
+            }
+            Record::after(args...);
+        }
+        else
+        {
+            R result;
+            {
+                CallTimer timer(Id);
+                result = original(args...);
+            }
+            Record::afterReturn(result, args...);
+            return result;
+        }
+    }
+};
+
+static EntryCategory categoryOf(const char* name)
+{
+    static const char* const drawPrefixes[] = { "glDraw", "glMultiDraw" };
+    static const char* const statePrefixes[] = {
+        "glBind", "glUseProgram", "glEnable", "glDisable", "glActiveTexture",
+        "glBlend", "glDepthFunc", "glDepthMask", "glDepthRange", "glCullFace", "glFrontFace",
+        "glPolygonMode", "glPolygonOffset", "glViewport", "glScissor", "glColorMask", "glStencil",
+        "glPixelStore", "glClearColor", "glClearDepth", "glLineWidth", "glPointSize",
+    };
+    for (const char* prefix : drawPrefixes)
+        if (strncmp(name, prefix, strlen(prefix)) == 0) return CATEGORY_DRAW;
+    for (const char* prefix : statePrefixes)
+        if (strncmp(name, prefix, strlen(prefix)) == 0) return CATEGORY_STATE;
+    return CATEGORY_OTHER;
+}
+
+static void reportAtExit()
+{
+    glTraceReport(cout);
+}
+
+bool glTraceRequested()
+{
+    const char* value = getenv("CG_GL_TRACE");
+    return value && *value && strcmp(value, "0") != 0;
+}
+
+bool installGLTrace()
+{
+    if (installed) return true;
+    if (!glad_glGetString) return false;
+
+    for (int i = 0; i < GL_ENTRY_COUNT; i++)
+        counters[i].category = categoryOf(entryNames[i]);
+
+#define CG_GL_ENTRY(name)                                                              \
+    if (glad_##name)                                                                   \
+    {                                                                                  \
+        Hook<GL_ENTRY_##name, decltype(glad_##name)>::original = glad_##name;          \
+        glad_##name = &Hook<GL_ENTRY_##name, decltype(glad_##name)>::call;             \
+    }
+#include "GLTraceEntryPoints.h"
+#undef CG_GL_ENTRY
+
+    installed = true;
+    atexit(reportAtExit);
+    cout << "GL trace: " << GL_ENTRY_COUNT << " pontos de entrada instrumentados" << endl;
+    return true;
+}
+
+bool glTraceInstalled()
+{
+    return installed;
+}
+
+// Soma o frame aberto; se closeFrame, ele conta como frame
+static void collect(bool closeFrame)
+{
+    GLTraceFrame frame;
+    long long nanos = 0;
+    for (EntryCounters& c : counters)
+    {
+        if (!c.frameCalls) continue;
+        frame.calls += c.frameCalls;
+        if (c.category == CATEGORY_DRAW) frame.drawCalls += c.frameCalls;
+        else if (c.category == CATEGORY_STATE) frame.stateChanges += c.frameCalls;
+        nanos += c.frameNanos;
+
+        c.totalCalls += c.frameCalls;
+        c.totalNanos += c.frameNanos;
+        if (closeFrame) c.maxPerFrame = max(c.maxPerFrame, c.frameCalls);
+        c.frameCalls = 0;
+        c.frameNanos = 0;
+    }
+    frame.uploadBytes = frameUploadBytes;
+    frame.driverSeconds = nanos * 1e-9;
+    frameUploadBytes = 0;
+
+    totals.calls += frame.calls;
+    totals.drawCalls += frame.drawCalls;
+    totals.stateChanges += frame.stateChanges;
+    totals.uploadBytes += frame.uploadBytes;
+    totals.driverSeconds += frame.driverSeconds;
+    if (closeFrame)
+    {
+        lastFrame = frame;
+        frames++;
+    }
+}
+
+void glTraceEndFrame()
+{
+    glDebugEndFrame();
+    if (!installed) return;
+    collect(true);
+    glCaptureEndFrame();
+}
+
+const GLTraceFrame& glTraceLastFrame()
+{
+    return lastFrame;
+}
+
+const GLTraceFrame& glTraceTotals()
+{
+    return totals;
+}
+
+unsigned long long glTraceFrameCount()
+{
+    return frames;
+}
+
+const char* glEntryPointName(GLEntryPoint entry)
+{
+    return entry >= 0 && entry < GL_ENTRY_COUNT ? entryNames[entry] : "?";
+}
+
+vector<GLEntryStats> glTraceEntryStats()
+{
+    vector<GLEntryStats> stats;
+    for (int i = 0; i < GL_ENTRY_COUNT; i++)
+    {
+        const EntryCounters& c = counters[i];
+        unsigned long long calls = c.totalCalls + c.frameCalls;
+        if (calls)
+            stats.push_back({ entryNames[i], calls, c.maxPerFrame, (c.totalNanos + c.frameNanos) * 1e-9 });
+    }
+    sort(stats.begin(), stats.end(), [](const GLEntryStats& a, const GLEntryStats& b) { return a.calls > b.calls; });
+    return stats;
+}
+
+void glTracePrintFrame()
+{
+    cout << "GL: " << lastFrame.calls << " chamadas, " << lastFrame.drawCalls << " draws, "
+         << lastFrame.stateChanges << " mudanças de estado, " << lastFrame.uploadBytes / 1024 << " KB enviados, "
+         << lastFrame.driverSeconds * 1000.0 << " ms no driver" << endl;
+}
+
+void glTraceReport(ostream& out)
+{
+    if (!installed) return;
+    collect(false);   // chamadas depois do último frame (limpeza) entram só nos totais
+
+    double perFrame = frames ? 1.0 / frames : 0.0;
+    out << "\n=== GL trace: " << frames << " frames ===" << endl;
+    out << "Chamadas: " << totals.calls << " (" << totals.calls * perFrame << " por frame)" << endl;
+    out << "Draws: " << totals.drawCalls << " (" << totals.drawCalls * perFrame << " por frame)" << endl;
+    out << "Mudanças de estado: " << totals.stateChanges << " (" << totals.stateChanges * perFrame << " por frame)" << endl;
+    out << "Enviado: " << totals.uploadBytes / 1024 << " KB (" << totals.uploadBytes * perFrame / 1024.0 << " KB por frame)" << endl;
+    out << "Tempo no driver: " << totals.driverSeconds * 1000.0 << " ms ("
+        << totals.driverSeconds * 1000.0 * perFrame << " ms por frame)" << endl;
+
+    vector<GLEntryStats> stats = glTraceEntryStats();
+    out << "Mais chamadas (total, média e máximo por frame, ms):" << endl;
+    for (size_t i = 0; i < stats.size() && i < 15; i++)
+        out << "  " << stats[i].name << ": " << stats[i].calls << ", " << stats[i].calls * perFrame << ", "
+            << stats[i].maxPerFrame << ", " << stats[i].seconds * 1000.0 << endl;
+
+    sort(stats.begin(), stats.end(), [](const GLEntryStats& a, const GLEntryStats& b) { return a.seconds > b.seconds; });
+    out << "Mais tempo no driver (ms, chamadas):" << endl;
+    for (size_t i = 0; i < stats.size() && i < 10; i++)
+        out << "  " << stats[i].name << ": " << stats[i].seconds * 1000.0 << ", " << stats[i].calls << endl;
+}
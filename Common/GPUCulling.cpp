@@ -0,0 +1,342 @@
+/*
+ *  Frustum culling na GPU - ver include/GPUCulling.h
+ */
+
+#include "GPUCulling.h"
+#include "GLState.h"
+#include "GLDebug.h"
+#include "Shader.h"
+#include "Frustum.h"
+
+#include <string>
+#include <iostream>
+#include <algorithm>
+
+using namespace std;
+
+const GLuint MESH_BOUNDS_BINDING = 3;
+const GLuint CULL_COMMANDS_BINDING = 4;
+const GLuint VISIBILITY_BINDING = 5;
+const GLuint HIZ_TEXTURE_UNIT = 0;
+const GLuint CULL_GROUP_SIZE = 64;
+
+const char* const visibleObjectsGLSL = R"(
+layout(std430, binding = 2) readonly buffer VisibleObjects
+{
+    uint visibleObjects[];
+};
+)";
+
+// Layout std430 de MeshBounds
+struct MeshBounds
+{
+    glm::vec4 sphere;   // xyz = centro, w = raio (espaço do modelo)
+    glm::vec4 boxMin;
+    glm::vec4 boxMax;
+};
+
+static const char* const cullComputeBody = R"(
+layout(local_size_x = 64) in;
+
+struct MeshBounds
+{
+    vec4 sphere;
+    vec4 boxMin;
+    vec4 boxMax;
+};
+
+layout(std430, binding = 3) readonly buffer MeshBoundsBuffer
+{
+    MeshBounds meshBounds[];
+};
+
+// DrawElementsIndirectCommand: 5 uint, 20 bytes também em std430
+struct Command
+{
+    uint count;
+    uint instanceCount;
+    uint firstIndex;
+    int baseVertex;
+    uint baseInstance;
+};
+
+layout(std430, binding = 4) buffer CommandBuffer
+{
+    Command commands[];
+};
+
+layout(std430, binding = 2) writeonly buffer VisibleObjects
+{
+    uint visibleObjects[];
+};
+
+layout(std430, binding = 5) buffer VisibilityBuffer
+{
+    uint visibility[];
+};
+
+layout(binding = 0) uniform sampler2D hiZ;
+
+const uint CULL_ALL = 0u;
+const uint CULL_EARLY = 1u;
+const uint CULL_LATE = 2u;
+
+uniform vec4 frustumPlanes[6];
+uniform uint objectCount;
+uniform uint phase;
+uniform bool occlusion;
+uniform mat4 viewProjection;
+uniform ivec2 screenSize;
+
+// A caixa projetada está atrás de tudo o que a pirâmide tem no seu retângulo?
+bool occluded(DrawData d)
+{
+    vec3 boxMin = meshBounds[d.mesh].boxMin.xyz;
+    vec3 boxMax = meshBounds[d.mesh].boxMax.xyz;
+    mat4 m = viewProjection * d.model;
+
+    vec2 ndcMin = vec2(1.0), ndcMax = vec2(-1.0);
+    float nearest = 1.0;
+    for (int i = 0; i < 8; i++)
+    {
+        vec3 corner = mix(boxMin, boxMax, vec3(i & 1, (i >> 1) & 1, (i >> 2) & 1));
+        vec4 clip = m * vec4(corner, 1.0);
+        if (clip.w <= 0.0) return false;   // atravessa o plano da câmera
+        vec3 ndc = clip.xyz / clip.w;
+        ndcMin = min(ndcMin, ndc.xy);
+        ndcMax = max(ndcMax, ndc.xy);
+        nearest = min(nearest, ndc.z);
+    }
+
+    // Pixels da tela cobertos e o nível em que cabem em 2x2 texels
+    ivec2 pixelMin = clamp(ivec2((ndcMin * 0.5 + 0.5) * vec2(screenSize)), ivec2(0), screenSize - 1);
+    ivec2 pixelMax = clamp(ivec2((ndcMax * 0.5 + 0.5) * vec2(screenSize)), ivec2(0), screenSize - 1);
+    int extent = max(pixelMax.x - pixelMin.x, pixelMax.y - pixelMin.y);
+    int level = clamp(findMSB(extent), 0, textureQueryLevels(hiZ) - 1);
+
+    ivec2 size = textureSize(hiZ, level);
+    ivec2 t0 = min(pixelMin >> (level + 1), size - 1);
+    ivec2 t1 = min(pixelMax >> (level + 1), size - 1);
+    float farthest = max(max(texelFetch(hiZ, t0, level).r, texelFetch(hiZ, ivec2(t1.x, t0.y), level).r),
+                         max(texelFetch(hiZ, ivec2(t0.x, t1.y), level).r, texelFetch(hiZ, t1, level).r));
+    return nearest * 0.5 + 0.5 > farthest;
+}
+
+void main()
+{
+    uint object = gl_GlobalInvocationID.x;
+    if (object >= objectCount) return;
+
+    DrawData d = draws[object];
+    vec4 sphere = meshBounds[d.mesh].sphere;
+    vec3 center = (d.model * vec4(sphere.xyz, 1.0)).xyz;
+    float scale = max(length(d.model[0].xyz), max(length(d.model[1].xyz), length(d.model[2].xyz)));
+    float radius = sphere.w * scale;
+
+    bool visible = true;
+    for (int i = 0; i < 6; i++)
+        if (dot(frustumPlanes[i].xyz, center) + frustumPlanes[i].w < -radius)
+            visible = false;
+
+    if (phase == CULL_EARLY)
+    {
+        if (!visible || visibility[d.object] == 0u) return;
+    }
+    else if (phase == CULL_LATE)
+    {
+        if (visible && occlusion) visible = !occluded(d);
+        // Visível no frame anterior e no frustum agora: já saiu no CULL_EARLY
+        bool drawnEarly = visibility[d.object] != 0u;
+        visibility[d.object] = visible ? 1u : 0u;
+        if (!visible || drawnEarly) return;
+    }
+    else if (!visible)
+        return;
+
+    uint slot = atomicAdd(commands[d.mesh].instanceCount, 1u);
+    visibleObjects[commands[d.mesh].baseInstance + slot] = object;
+}
+)";
+
+GPUCulling::GPUCulling(MeshPool& pool) : pool(&pool)
+{
+    if (!GLAD_GL_VERSION_4_3)
+    {
+        cout << "GPUCulling: compute shaders precisam de OpenGL 4.3" << endl;
+        return;
+    }
+
+    string source = string("#version 450 core\n") + drawDataGLSL + cullComputeBody;
+    program = createComputeProgram(source.c_str());
+    if (!program) return;
+    labelGLObject(GL_PROGRAM, program, "GPUCulling");
+    planesLocation = glGetUniformLocation(program, "frustumPlanes");
+    objectCountLocation = glGetUniformLocation(program, "objectCount");
+    phaseLocation = glGetUniformLocation(program, "phase");
+    occlusionLocation = glGetUniformLocation(program, "occlusion");
+    viewProjectionLocation = glGetUniformLocation(program, "viewProjection");
+    screenSizeLocation = glGetUniformLocation(program, "screenSize");
+
+    vector<MeshBounds> bounds(pool.meshCount());
+    for (int m = 0; m < pool.meshCount(); m++)
+    {
+        const MeshRange& range = pool.mesh(m);
+        bounds[m].sphere = glm::vec4(range.center, range.radius);
+        bounds[m].boxMin = glm::vec4(range.boundsMin, 1.0f);
+        bounds[m].boxMax = glm::vec4(range.boundsMax, 1.0f);
+    }
+
+    glGenBuffers(1, &meshBuffer);
+    glGenBuffers(1, &commandBuffer);
+    glGenBuffers(1, &visibleBuffer);
+    glState().bindBuffer(GL_SHADER_STORAGE_BUFFER, meshBuffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, bounds.size() * sizeof(MeshBounds), bounds.data(), GL_STATIC_DRAW);
+    glState().bindBuffer(GL_DRAW_INDIRECT_BUFFER, commandBuffer);
+    glState().bindBuffer(GL_SHADER_STORAGE_BUFFER, visibleBuffer);
+    labelGLObject(GL_BUFFER, meshBuffer, "GPUCulling esferas");
+    labelGLObject(GL_BUFFER, commandBuffer, "GPUCulling comandos");
+    labelGLObject(GL_BUFFER, visibleBuffer, "GPUCulling visíveis");
+}
+
+void GPUCulling::enableOcclusion(GLuint ids)
+{
+    if (!program || ids <= objectIds) return;
+
+    // Começa tudo invisível: o primeiro frame sai inteiro no CULL_LATE
+    objectIds = ids;
+    vector<GLuint> zeros(objectIds, 0);
+    if (!visibilityBuffer)
+    {
+        glGenBuffers(1, &visibilityBuffer);
+        glState().bindBuffer(GL_SHADER_STORAGE_BUFFER, visibilityBuffer);
+        labelGLObject(GL_BUFFER, visibilityBuffer, "GPUCulling visibilidade");
+    }
+    glState().bindBuffer(GL_SHADER_STORAGE_BUFFER, visibilityBuffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, zeros.size() * sizeof(GLuint), zeros.data(), GL_DYNAMIC_COPY);
+}
+
+void GPUCulling::cull(const IndirectBatch& batch, const glm::mat4& viewProjection, CullPhase phase,
+                      const HiZPyramid* hiz)
+{
+    if (!program) return;
+
+    if (phase != CULL_ALL && !visibilityBuffer)
+    {
+        if (phase == CULL_EARLY)
+        {
+            objects = 0;
+            return;
+        }
+        phase = CULL_ALL;
+    }
+
+    objects = batch.size();
+    drawDataBuffer = batch.drawDataBuffer();
+    int meshCount = pool->meshCount();
+
+    // Cada malha tem espaço para todos os objetos na lista de visíveis
+    if (objects > capacity)
+    {
+        capacity = max(objects, capacity * 2);
+        pool->reserveDrawIds((GLuint)(capacity * meshCount));
+        glState().bindBuffer(GL_SHADER_STORAGE_BUFFER, visibleBuffer);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, capacity * meshCount * sizeof(GLuint), nullptr, GL_DYNAMIC_COPY);
+
+        resetCommands.resize(meshCount);
+        for (int m = 0; m < meshCount; m++)
+        {
+            const MeshRange& range = pool->mesh(m);
+            resetCommands[m] = { range.indexCount, 0, range.firstIndex, range.baseVertex, (GLuint)(m * capacity) };
+        }
+    }
+    if (objects == 0) return;
+
+    // Comandos zerados (instanceCount = 0) antes do compute acrescentar os visíveis
+    glState().bindBuffer(GL_DRAW_INDIRECT_BUFFER, commandBuffer);
+    glBufferData(GL_DRAW_INDIRECT_BUFFER, resetCommands.size() * sizeof(DrawElementsIndirectCommand),
+                 resetCommands.data(), GL_DYNAMIC_COPY);
+
+    Frustum frustum = extractFrustum(viewProjection);
+    glState().useProgram(program);
+    glUniform4fv(planesLocation, FRUSTUM_PLANE_COUNT, &frustum.planes[0].x);
+    glUniform1ui(objectCountLocation, (GLuint)objects);
+    glUniform1ui(phaseLocation, (GLuint)phase);
+
+    bool occlusion = phase == CULL_LATE && hiz && hiz->levels() > 0;
+    glUniform1i(occlusionLocation, occlusion ? 1 : 0);
+    if (occlusion)
+    {
+        glUniformMatrix4fv(viewProjectionLocation, 1, GL_FALSE, &viewProjection[0][0]);
+        glUniform2i(screenSizeLocation, hiz->width(), hiz->height());
+        glState().bindTexture(HIZ_TEXTURE_UNIT, hiz->texture());
+    }
+    if (phase != CULL_ALL)
+        glState().bindBufferRange(GL_SHADER_STORAGE_BUFFER, VISIBILITY_BINDING, visibilityBuffer, 0,
+                                  objectIds * sizeof(GLuint));
+
+    glState().bindBufferRange(GL_SHADER_STORAGE_BUFFER, DRAW_DATA_BINDING, drawDataBuffer, 0,
+                              objects * sizeof(DrawData));
+    glState().bindBufferRange(GL_SHADER_STORAGE_BUFFER, MESH_BOUNDS_BINDING, meshBuffer, 0,
+                              meshCount * sizeof(MeshBounds));
+    glState().bindBufferRange(GL_SHADER_STORAGE_BUFFER, CULL_COMMANDS_BINDING, commandBuffer, 0,
+                              meshCount * sizeof(DrawElementsIndirectCommand));
+    glState().bindBufferRange(GL_SHADER_STORAGE_BUFFER, VISIBLE_OBJECTS_BINDING, visibleBuffer, 0,
+                              capacity * meshCount * sizeof(GLuint));
+
+    glDispatchCompute((GLuint)((objects + CULL_GROUP_SIZE - 1) / CULL_GROUP_SIZE), 1, 1);
+
+    // Os comandos são lidos como parâmetros de desenho e a lista pelo shader de vértice
+    glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+}
+
+int GPUCulling::draw()
+{
+    if (!program || objects == 0) return 0;
+
+    glState().bindBufferRange(GL_SHADER_STORAGE_BUFFER, DRAW_DATA_BINDING, drawDataBuffer, 0,
+                              objects * sizeof(DrawData));
+    glState().bindBufferRange(GL_SHADER_STORAGE_BUFFER, VISIBLE_OBJECTS_BINDING, visibleBuffer, 0,
+                              capacity * pool->meshCount() * sizeof(GLuint));
+    glState().bindBuffer(GL_DRAW_INDIRECT_BUFFER, commandBuffer);
+    glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, nullptr, (GLsizei)resetCommands.size(), 0);
+    return 1;
+}
+
+GLuint GPUCulling::readVisibleCount()
+{
+    if (!program || objects == 0) return 0;
+
+    glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+    vector<DrawElementsIndirectCommand> commands(resetCommands.size());
+    glState().bindBuffer(GL_DRAW_INDIRECT_BUFFER, commandBuffer);
+    glGetBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, commands.size() * sizeof(DrawElementsIndirectCommand),
+                       commands.data());
+
+    GLuint visible = 0;
+    for (const DrawElementsIndirectCommand& c : commands)
+        visible += c.instanceCount;
+    return visible;
+}
+
+void GPUCulling::clear()
+{
+    for (GLuint* buffer : { &meshBuffer, &commandBuffer, &visibleBuffer, &visibilityBuffer })
+    {
+        if (*buffer)
+        {
+            glState().forgetBuffer(*buffer);
+            forgetGLObjectLabel(GL_BUFFER, *buffer);
+            glDeleteBuffers(1, buffer);
+        }
+        *buffer = 0;
+    }
+    if (program)
+    {
+        forgetGLObjectLabel(GL_PROGRAM, program);
+        glDeleteProgram(program);
+    }
+    program = 0;
+    capacity = 0;
+    objects = 0;
+    objectIds = 0;
+}
@@ -0,0 +1,179 @@
+/*
+ *  Pirâmide Hi-Z - ver include/HiZPyramid.h
+ */
+
+#include "HiZPyramid.h"
+#include "GLState.h"
+#include "GLDebug.h"
+#include "Shader.h"
+
+#include <string>
+#include <iostream>
+#include <algorithm>
+
+using namespace std;
+
+const GLuint HIZ_GROUP_SIZE = 8;
+
+static const char* const reduceComputeSource = R"(
+#version 450 core
+layout(local_size_x = 8, local_size_y = 8) in;
+
+layout(binding = 0) uniform sampler2D source;
+layout(r32f, binding = 0) writeonly uniform image2D destination;
+uniform int sourceLevel;
+
+void main()
+{
+    ivec2 texel = ivec2(gl_GlobalInvocationID.xy);
+    ivec2 size = imageSize(destination);
+    if (texel.x >= size.x || texel.y >= size.y) return;
+
+    // 2x2 do nível anterior; a última linha/coluna leva junto a sobra ímpar
+    ivec2 sourceSize = textureSize(source, sourceLevel);
+    ivec2 first = texel * 2;
+    ivec2 last = min(first + 1, sourceSize - 1);
+    if (texel.x == size.x - 1) last.x = sourceSize.x - 1;
+    if (texel.y == size.y - 1) last.y = sourceSize.y - 1;
+
+    float farthest = 0.0;
+    for (int y = first.y; y <= last.y; y++)
+        for (int x = first.x; x <= last.x; x++)
+            farthest = max(farthest, texelFetch(source, ivec2(x, y), sourceLevel).r);
+    imageStore(destination, texel, vec4(farthest));
+}
+)";
+
+HiZPyramid::HiZPyramid()
+{
+    if (!GLAD_GL_VERSION_4_3)
+    {
+        cout << "HiZPyramid: compute shaders precisam de OpenGL 4.3" << endl;
+        return;
+    }
+
+    program = createComputeProgram(reduceComputeSource);
+    if (!program) return;
+    labelGLObject(GL_PROGRAM, program, "HiZPyramid");
+    sourceLevelLocation = glGetUniformLocation(program, "sourceLevel");
+}
+
+static void setSampling(GLenum minFilter)
+{
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+}
+
+void HiZPyramid::resize(int width, int height)
+{
+    width = max(width, 1);
+    height = max(height, 1);
+    if (width == sceneWidth && height == sceneHeight) return;
+    sceneWidth = width;
+    sceneHeight = height;
+
+    if (!fbo)
+    {
+        glGenFramebuffers(1, &fbo);
+        glGenTextures(1, &color);
+        glGenTextures(1, &depth);
+        glGenTextures(1, &pyramid);
+    }
+
+    // Nomes de glGenTextures só viram texturas no primeiro glBindTexture (o
+    // glBindTextureUnit do cache falharia com eles): edição sem DSA na unidade 0
+    glBindTexture(GL_TEXTURE_2D, color);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    setSampling(GL_NEAREST);
+    labelGLObject(GL_TEXTURE, color, "HiZPyramid cor");
+
+    glBindTexture(GL_TEXTURE_2D, depth);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT32F, width, height, 0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
+    setSampling(GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_MODE, GL_NONE);
+    labelGLObject(GL_TEXTURE, depth, "HiZPyramid profundidade");
+
+    // Nível 0 com metade da tela, até 1x1
+    int w = max(width / 2, 1), h = max(height / 2, 1);
+    glBindTexture(GL_TEXTURE_2D, pyramid);
+    for (levelCount = 0;; levelCount++)
+    {
+        glTexImage2D(GL_TEXTURE_2D, levelCount, GL_R32F, w, h, 0, GL_RED, GL_FLOAT, nullptr);
+        if (w == 1 && h == 1) break;
+        w = max(w / 2, 1);
+        h = max(h / 2, 1);
+    }
+    levelCount++;
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levelCount - 1);
+    setSampling(GL_NEAREST_MIPMAP_NEAREST);
+    labelGLObject(GL_TEXTURE, pyramid, "HiZPyramid");
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glState().invalidateTextureUnit(0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, color, 0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, depth, 0);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        cout << "ERROR::HIZPYRAMID::FBO_INCOMPLETE" << endl;
+    labelGLObject(GL_FRAMEBUFFER, fbo, "HiZPyramid cena");
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void HiZPyramid::build()
+{
+    if (!program || !fbo) return;
+
+    glState().useProgram(program);
+    int w = max(sceneWidth / 2, 1), h = max(sceneHeight / 2, 1);
+    for (int level = 0; level < levelCount; level++)
+    {
+        // Nível 0 lê a profundidade da cena; os outros, o nível anterior
+        glState().bindTexture(0, level == 0 ? depth : pyramid);
+        glUniform1i(sourceLevelLocation, level == 0 ? 0 : level - 1);
+        glBindImageTexture(0, pyramid, level, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+        glDispatchCompute((w + HIZ_GROUP_SIZE - 1) / HIZ_GROUP_SIZE, (h + HIZ_GROUP_SIZE - 1) / HIZ_GROUP_SIZE, 1);
+
+        // O próximo nível (e o culling) leem este com texelFetch
+        glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+        w = max(w / 2, 1);
+        h = max(h / 2, 1);
+    }
+}
+
+void HiZPyramid::present()
+{
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    glBlitFramebuffer(0, 0, sceneWidth, sceneHeight, 0, 0, sceneWidth, sceneHeight, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void HiZPyramid::clear()
+{
+    for (GLuint* texture : { &color, &depth, &pyramid })
+    {
+        if (*texture)
+        {
+            glState().forgetTexture(*texture);
+            forgetGLObjectLabel(GL_TEXTURE, *texture);
+            glDeleteTextures(1, texture);
+        }
+        *texture = 0;
+    }
+    if (fbo)
+    {
+        forgetGLObjectLabel(GL_FRAMEBUFFER, fbo);
+        glDeleteFramebuffers(1, &fbo);
+    }
+    fbo = 0;
+    if (program)
+    {
+        forgetGLObjectLabel(GL_PROGRAM, program);
+        glDeleteProgram(program);
+    }
+    program = 0;
+    sceneWidth = sceneHeight = levelCount = 0;
+}
@@ -0,0 +1,112 @@
+/*
+ *  Desenho indireto em lote - ver include/IndirectDraw.h
+ */
+
+#include "IndirectDraw.h"
+#include "GLState.h"
+#include "GLDebug.h"
+
+#include <algorithm>
+
+using namespace std;
+
+static_assert(sizeof(DrawElementsIndirectCommand) == 20, "layout do comando indireto");
+static_assert(sizeof(DrawData) == 80, "atualizar DrawData em drawDataGLSL");
+
+const char* const drawDataGLSL = R"(
+struct DrawData
+{
+    mat4 model;
+    uint material;
+    uint mesh;
+    uint object;
+    uint padding;
+};
+
+layout(std430, binding = 0) readonly buffer DrawDataBuffer
+{
+    DrawData draws[];
+};
+)";
+
+void IndirectBatch::reset()
+{
+    commands.clear();
+    data.clear();
+}
+
+void IndirectBatch::add(int mesh, const glm::mat4& model, GLuint material, GLuint object)
+{
+    const MeshRange& range = pool->mesh(mesh);
+    GLuint index = (GLuint)data.size();
+    commands.push_back({ range.indexCount, 1, range.firstIndex, range.baseVertex, index });
+
+    DrawData d;
+    d.model = model;
+    d.material = material;
+    d.mesh = (GLuint)mesh;
+    d.object = object;
+    d.padding = 0;
+    data.push_back(d);
+}
+
+void IndirectBatch::upload()
+{
+    if (!indirectBuffer)
+    {
+        glGenBuffers(1, &indirectBuffer);
+        glGenBuffers(1, &dataBuffer);
+        glState().bindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBuffer);
+        glState().bindBuffer(GL_SHADER_STORAGE_BUFFER, dataBuffer);
+        labelGLObject(GL_BUFFER, indirectBuffer, "IndirectBatch comandos");
+        labelGLObject(GL_BUFFER, dataBuffer, "IndirectBatch DrawData");
+    }
+    if (commands.empty()) return;
+
+    // Reespecifica o armazenamento antes de escrever: o driver entrega memória
+    // nova em vez de esperar a GPU terminar de ler o frame anterior
+    capacity = max(capacity, commands.size());
+    pool->reserveDrawIds((GLuint)capacity);
+
+    glState().bindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBuffer);
+    glBufferData(GL_DRAW_INDIRECT_BUFFER, capacity * sizeof(DrawElementsIndirectCommand), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, commands.size() * sizeof(DrawElementsIndirectCommand), commands.data());
+
+    glState().bindBuffer(GL_SHADER_STORAGE_BUFFER, dataBuffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, capacity * sizeof(DrawData), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, data.size() * sizeof(DrawData), data.data());
+}
+
+int IndirectBatch::draw(bool multiDraw)
+{
+    if (commands.empty() || !indirectBuffer) return 0;
+
+    glState().bindBufferRange(GL_SHADER_STORAGE_BUFFER, DRAW_DATA_BINDING, dataBuffer, 0,
+                              data.size() * sizeof(DrawData));
+    glState().bindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBuffer);
+
+    if (multiDraw)
+    {
+        glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, nullptr, (GLsizei)commands.size(), 0);
+        return 1;
+    }
+
+    for (size_t i = 0; i < commands.size(); i++)
+        glDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, (void*)(i * sizeof(DrawElementsIndirectCommand)));
+    return (int)commands.size();
+}
+
+void IndirectBatch::clear()
+{
+    for (GLuint* buffer : { &indirectBuffer, &dataBuffer })
+    {
+        if (*buffer)
+        {
+            glState().forgetBuffer(*buffer);
+            forgetGLObjectLabel(GL_BUFFER, *buffer);
+            glDeleteBuffers(1, buffer);
+        }
+        *buffer = 0;
+    }
+    capacity = 0;
+}
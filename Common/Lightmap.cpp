@@ -0,0 +1,154 @@
+/*
+ *  Baker de lightmaps - ver include/Lightmap.h
+ */
+
+#include "Lightmap.h"
+#include "TriangleBVH.h"
+#include "ThreadPool.h"
+#include "BakeUtils.h"
+
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+
+#include "stb_image_write.h"
+
+using namespace std;
+
+// Cena inteira em um único conjunto de triângulos, para uma BVH só
+struct LightmapScene
+{
+    vector<glm::vec3> positions;
+    vector<glm::vec3> normals;
+    vector<unsigned int> indices;
+    vector<int> triSurface;   // triângulo -> superfície de origem
+    TriangleBVH bvh;
+    float epsilon;
+};
+
+static glm::vec3 directLight(const LightmapScene& scene, const vector<LightmapLight>& lights,
+                             const glm::vec3& p, const glm::vec3& n)
+{
+    glm::vec3 result(0.0f);
+    glm::vec3 origin = p + n * scene.epsilon;
+    for (const LightmapLight& light : lights)
+    {
+        glm::vec3 toLight = light.position - origin;
+        float dist = glm::length(toLight);
+        glm::vec3 l = toLight / dist;
+        float diff = glm::dot(n, l);
+        if (diff <= 0.0f) continue;
+        if (scene.bvh.occluded(origin, l, 0.0f, dist)) continue;
+        result += light.color * diff;
+    }
+    return result;
+}
+
+void bakeLightmap(const vector<LightmapSurface>& surfaces, int target,
+                  const vector<LightmapLight>& lights, const LightmapSettings& settings,
+                  vector<glm::vec3>& texels)
+{
+    int size = settings.size;
+    const LightmapSurface& surface = surfaces[target];
+    auto start = chrono::steady_clock::now();
+
+    LightmapScene scene;
+    glm::vec3 bmin(1e30f), bmax(-1e30f);
+    for (size_t s = 0; s < surfaces.size(); s++)
+    {
+        unsigned int base = (unsigned int)scene.positions.size();
+        for (const MeshVertex& v : surfaces[s].mesh.vertices)
+        {
+            scene.positions.push_back(v.position);
+            scene.normals.push_back(v.normal);
+            bmin = glm::min(bmin, v.position);
+            bmax = glm::max(bmax, v.position);
+        }
+        for (unsigned int i : surfaces[s].mesh.indices)
+            scene.indices.push_back(base + i);
+        scene.triSurface.insert(scene.triSurface.end(), surfaces[s].mesh.triangleCount(), (int)s);
+    }
+    scene.epsilon = 1e-4f * glm::length(bmax - bmin);
+    scene.bvh.build(scene.positions, scene.indices);
+
+    vector<TexelSample> samples;
+    rasterizeUVs(surface.lightmapUVs, surface.mesh.indices, size, samples);
+
+    texels.assign((size_t)size * size, glm::vec3(0.0f));
+    vector<unsigned char> mask((size_t)size * size, 0);
+
+    ThreadPool pool;
+    pool.parallelFor(0, size, [&](int y) {
+        for (int x = 0; x < size; x++)
+        {
+            size_t idx = (size_t)y * size + x;
+            const TexelSample& s = samples[idx];
+            if (s.triangle < 0) continue;
+
+            const MeshData& mesh = surface.mesh;
+            const MeshVertex& a = mesh.vertices[mesh.indices[3 * s.triangle]];
+            const MeshVertex& b = mesh.vertices[mesh.indices[3 * s.triangle + 1]];
+            const MeshVertex& c = mesh.vertices[mesh.indices[3 * s.triangle + 2]];
+            glm::vec3 p = s.b0 * a.position + s.b1 * b.position + s.b2 * c.position;
+            glm::vec3 n = glm::normalize(s.b0 * a.normal + s.b1 * b.normal + s.b2 * c.normal);
+
+            glm::vec3 light = settings.ambient + directLight(scene, lights, p, n);
+
+            // Uma rebatida: média de albedo * luz direta nos pontos vistos pelo hemisfério
+            if (settings.bounceSamples > 0)
+            {
+                BakeRandom rng((uint32_t)idx);
+                glm::vec3 indirect(0.0f);
+                glm::vec3 origin = p + n * scene.epsilon;
+                for (int i = 0; i < settings.bounceSamples; i++)
+                {
+                    glm::vec3 dir = cosineSampleHemisphere(n, rng);
+                    RayHit hit;
+                    if (!scene.bvh.intersect(origin, dir, 0.0f, 1e30f, hit)) continue;
+
+                    unsigned int i0 = scene.indices[3 * hit.triangle];
+                    unsigned int i1 = scene.indices[3 * hit.triangle + 1];
+                    unsigned int i2 = scene.indices[3 * hit.triangle + 2];
+                    glm::vec3 hn = glm::normalize((1.0f - hit.u - hit.v) * scene.normals[i0] +
+                                                  hit.u * scene.normals[i1] + hit.v * scene.normals[i2]);
+                    if (glm::dot(hn, dir) >= 0.0f) continue;   // lado de trás da superfície
+
+                    glm::vec3 hp = origin + dir * hit.t;
+                    indirect += surfaces[scene.triSurface[hit.triangle]].albedo * directLight(scene, lights, hp, hn);
+                }
+                light += indirect / (float)settings.bounceSamples;
+            }
+
+            texels[idx] = light;
+            mask[idx] = 1;
+        }
+    }, 4);
+
+    // dilateTexels trabalha com canais intercalados
+    vector<float> flat((size_t)size * size * 3);
+    for (size_t i = 0; i < texels.size(); i++)
+        for (int c = 0; c < 3; c++)
+            flat[i * 3 + c] = texels[i][c];
+    dilateTexels(flat, 3, mask, size, settings.dilatePasses);
+    for (size_t i = 0; i < texels.size(); i++)
+        texels[i] = glm::vec3(flat[i * 3], flat[i * 3 + 1], flat[i * 3 + 2]);
+
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "Lightmap " << size << "x" << size << " (" << scene.bvh.triangleCount() << " triângulos, "
+         << settings.bounceSamples << " raios indiretos) em " << seconds << " s com " << pool.size() << " threads" << endl;
+}
+
+bool saveLightmap(const char* path, int size, const vector<glm::vec3>& texels)
+{
+    vector<unsigned char> rgb((size_t)size * size * 3);
+    for (size_t i = 0; i < texels.size(); i++)
+        for (int c = 0; c < 3; c++)
+            rgb[i * 3 + c] = (unsigned char)(min(max(texels[i][c], 0.0f), 1.0f) * 255.0f + 0.5f);
+
+    // Linha 0 é v = 0 (embaixo): inverte na gravação, como o loadTexture inverte na leitura
+    stbi_flip_vertically_on_write(1);
+    bool ok = stbi_write_png(path, size, size, 3, rgb.data(), size * 3) != 0;
+    if (!ok)
+        cout << "Falha ao gravar lightmap: " << path << endl;
+    return ok;
+}
@@ -0,0 +1,367 @@
+/*
+ *  Occlusion culling na CPU com profundidade mascarada - ver include/MaskedOcclusion.h
+ */
+
+#include "MaskedOcclusion.h"
+
+#include <cmath>
+#include <chrono>
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define CG_OCCLUSION_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#define CG_TARGET_AVX2
+#else
+#define CG_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+using namespace std;
+
+typedef MaskedOcclusion::Tile Tile;
+typedef MaskedOcclusion::Triangle Triangle;
+
+const int TILE_WIDTH = MaskedOcclusion::TILE_WIDTH;
+const int TILE_HEIGHT = MaskedOcclusion::TILE_HEIGHT;
+
+OccluderMesh OccluderMesh::fromMeshData(const MeshData& mesh)
+{
+    OccluderMesh occluder;
+    occluder.positions.reserve(mesh.vertices.size());
+    for (const MeshVertex& v : mesh.vertices)
+        occluder.positions.push_back(v.position);
+    occluder.indices.assign(mesh.indices.begin(), mesh.indices.end());
+    return occluder;
+}
+
+MaskedOcclusion::MaskedOcclusion(ThreadPool* threads, int width, int height)
+    : threads(threads), selected(bestCullingPath())
+{
+    tilesX = max((width + TILE_WIDTH - 1) / TILE_WIDTH, 1);
+    tilesY = max((height + TILE_HEIGHT - 1) / TILE_HEIGHT, 1);
+    tiles.resize((size_t)tilesX * tilesY);
+    clear();
+}
+
+void MaskedOcclusion::setPath(CullingPath path)
+{
+    if (cullingPathSupported(path))
+        selected = path;
+}
+
+void MaskedOcclusion::clear()
+{
+    for (Tile& tile : tiles)
+    {
+        fill(tile.mask, tile.mask + TILE_HEIGHT, 0u);
+        tile.zMax0 = 0.0f;
+        tile.zMax1 = 1.0f;
+    }
+    occluders.clear();
+    pendingTriangles = 0;
+}
+
+void MaskedOcclusion::addOccluder(const OccluderMesh& mesh, const glm::mat4& modelViewProjection)
+{
+    occluders.push_back({ &mesh, modelViewProjection, pendingTriangles });
+    pendingTriangles += mesh.indices.size() / 3;
+}
+
+// --- Preparação dos triângulos ----------------------------------------------
+
+void MaskedOcclusion::setupOccluder(const Occluder& occluder)
+{
+    const OccluderMesh& mesh = *occluder.mesh;
+    float w = (float)width(), h = (float)height();
+
+    // Vértices na tela; w <= 0 ou fora de [near, far] marcam o vértice como inútil
+    vector<glm::vec3> screen(mesh.positions.size());
+    vector<uint8_t> usable(mesh.positions.size());
+    for (size_t i = 0; i < mesh.positions.size(); i++)
+    {
+        glm::vec4 clip = occluder.mvp * glm::vec4(mesh.positions[i], 1.0f);
+        usable[i] = clip.w > 0.0f && clip.z >= -clip.w && clip.z <= clip.w;
+        if (!usable[i]) continue;
+        glm::vec3 ndc = glm::vec3(clip) / clip.w;
+        screen[i] = glm::vec3((ndc.x * 0.5f + 0.5f) * w, (ndc.y * 0.5f + 0.5f) * h, ndc.z * 0.5f + 0.5f);
+    }
+
+    size_t count = mesh.indices.size() / 3;
+    for (size_t t = 0; t < count; t++)
+    {
+        Triangle& tri = triangles[occluder.firstTriangle + t];
+        tri.tileX0 = 1;
+        tri.tileX1 = 0;
+
+        const uint32_t* index = &mesh.indices[t * 3];
+        if (!usable[index[0]] || !usable[index[1]] || !usable[index[2]]) continue;
+        glm::vec3 v[3] = { screen[index[0]], screen[index[1]], screen[index[2]] };
+
+        // Anti-horário na tela (y para cima) é a frente
+        float area = (v[1].x - v[0].x) * (v[2].y - v[0].y) - (v[2].x - v[0].x) * (v[1].y - v[0].y);
+        if (!(area > 0.0f)) continue;
+
+        float minX = min(v[0].x, min(v[1].x, v[2].x)), maxX = max(v[0].x, max(v[1].x, v[2].x));
+        float minY = min(v[0].y, min(v[1].y, v[2].y)), maxY = max(v[0].y, max(v[1].y, v[2].y));
+        if (maxX < 0.0f || maxY < 0.0f || minX >= w || minY >= h) continue;
+
+        // Dentro: (xj - xi)(y - yi) - (yj - yi)(x - xi) >= 0 para as três arestas.
+        // Numa linha y fixa cada aresta vira um limite para x.
+        tri.yMin = -INFINITY;
+        tri.yMax = INFINITY;
+        for (int e = 0; e < 3; e++)
+        {
+            const glm::vec3& a = v[e];
+            const glm::vec3& b = v[(e + 1) % 3];
+            float A = a.y - b.y, B = b.x - a.x, C = (b.y - a.y) * a.x - (b.x - a.x) * a.y;
+            if (A != 0.0f)
+            {
+                tri.edgeSide[e] = A > 0.0f ? 1 : -1;
+                tri.edgeSlope[e] = -B / A;
+                tri.edgeOffset[e] = -C / A;
+            }
+            else
+            {
+                tri.edgeSide[e] = 0;
+                tri.edgeSlope[e] = tri.edgeOffset[e] = 0.0f;
+                if (B > 0.0f) tri.yMin = max(tri.yMin, -C / B);
+                else tri.yMax = min(tri.yMax, -C / B);
+            }
+        }
+
+        float dz1 = v[1].z - v[0].z, dz2 = v[2].z - v[0].z;
+        tri.zx = (dz1 * (v[2].y - v[0].y) - dz2 * (v[1].y - v[0].y)) / area;
+        tri.zy = (dz2 * (v[1].x - v[0].x) - dz1 * (v[2].x - v[0].x)) / area;
+        tri.z0 = v[0].z - tri.zx * v[0].x - tri.zy * v[0].y;
+        tri.zMin = min(v[0].z, min(v[1].z, v[2].z));
+        tri.zMax = max(v[0].z, max(v[1].z, v[2].z));
+
+        tri.tileX0 = max((int)floor(minX) / TILE_WIDTH, 0);
+        tri.tileX1 = min((int)floor(maxX) / TILE_WIDTH, tilesX - 1);
+        tri.tileY0 = max((int)floor(minY) / TILE_HEIGHT, 0);
+        tri.tileY1 = min((int)floor(maxY) / TILE_HEIGHT, tilesY - 1);
+    }
+}
+
+// --- Cobertura e atualização dos tiles --------------------------------------
+
+// Bits [lo, hi) de cada linha; lo e hi já limitados a [0, 32]
+static inline uint32_t spanMask(int lo, int hi)
+{
+    return (uint32_t)(((uint64_t(1) << hi) - 1) & ~((uint64_t(1) << lo) - 1));
+}
+
+static bool coverageScalar(const Triangle& tri, int tileX, int tileY, uint32_t* coverage)
+{
+    uint32_t any = 0;
+    float x0 = (float)(tileX * TILE_WIDTH);
+    for (int r = 0; r < TILE_HEIGHT; r++)
+    {
+        float y = (float)(tileY * TILE_HEIGHT + r) + 0.5f;
+        float left = -INFINITY, right = INFINITY;
+        for (int e = 0; e < 3; e++)
+        {
+            float x = tri.edgeSlope[e] * y + tri.edgeOffset[e];
+            if (tri.edgeSide[e] > 0) left = max(left, x);
+            else if (tri.edgeSide[e] < 0) right = min(right, x);
+        }
+        // Pixel coberto quando o centro (x + 0.5) está em [left, right]
+        float lo = min(max(ceil(left - 0.5f) - x0, 0.0f), 32.0f);
+        float hi = min(max(floor(right - 0.5f) - x0 + 1.0f, 0.0f), 32.0f);
+        if (y < tri.yMin || y > tri.yMax) hi = 0.0f;
+        coverage[r] = spanMask((int)lo, (int)hi);
+        any |= coverage[r];
+    }
+    return any != 0;
+}
+
+#ifdef CG_OCCLUSION_X86
+
+// As 8 linhas do tile de uma vez
+CG_TARGET_AVX2 static bool coverageAVX2(const Triangle& tri, int tileX, int tileY, uint32_t* coverage)
+{
+    const __m256 rowOffsets = _mm256_setr_ps(0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f);
+    __m256 y = _mm256_add_ps(_mm256_set1_ps((float)(tileY * TILE_HEIGHT)), rowOffsets);
+    __m256 left = _mm256_set1_ps(-INFINITY), right = _mm256_set1_ps(INFINITY);
+    for (int e = 0; e < 3; e++)
+    {
+        if (tri.edgeSide[e] == 0) continue;
+        __m256 x = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(tri.edgeSlope[e]), y), _mm256_set1_ps(tri.edgeOffset[e]));
+        if (tri.edgeSide[e] > 0) left = _mm256_max_ps(left, x);
+        else right = _mm256_min_ps(right, x);
+    }
+
+    const __m256 half = _mm256_set1_ps(0.5f), zero = _mm256_setzero_ps(), full = _mm256_set1_ps(32.0f);
+    __m256 x0 = _mm256_set1_ps((float)(tileX * TILE_WIDTH));
+    __m256 lo = _mm256_sub_ps(_mm256_ceil_ps(_mm256_sub_ps(left, half)), x0);
+    __m256 hi = _mm256_add_ps(_mm256_sub_ps(_mm256_floor_ps(_mm256_sub_ps(right, half)), x0), _mm256_set1_ps(1.0f));
+    lo = _mm256_min_ps(_mm256_max_ps(lo, zero), full);
+    hi = _mm256_min_ps(_mm256_max_ps(hi, zero), full);
+
+    // Linhas fora das arestas horizontais ficam vazias
+    __m256 inside = _mm256_and_ps(_mm256_cmp_ps(y, _mm256_set1_ps(tri.yMin), _CMP_GE_OQ),
+                                  _mm256_cmp_ps(y, _mm256_set1_ps(tri.yMax), _CMP_LE_OQ));
+    hi = _mm256_and_ps(hi, inside);
+
+    // (1 << hi) - 1 com hi = 32 dá ~0: sllv zera shifts >= 32
+    const __m256i one = _mm256_set1_epi32(1);
+    __m256i upTo = _mm256_sub_epi32(_mm256_sllv_epi32(one, _mm256_cvtps_epi32(hi)), one);
+    __m256i below = _mm256_sub_epi32(_mm256_sllv_epi32(one, _mm256_cvtps_epi32(lo)), one);
+    __m256i mask = _mm256_andnot_si256(below, upTo);
+    _mm256_store_si256((__m256i*)coverage, mask);
+    return !_mm256_testz_si256(mask, mask);
+}
+
+#endif
+
+static void updateTile(Tile& tile, const uint32_t* coverage, float depth)
+{
+    // Os pixels cobertos ficam no máximo em depth (ou no que já estava lá)
+    depth = min(depth, tile.zMax1);
+
+    // Triângulo bem mais perto que a camada de trabalho: recomeça com ele
+    bool layer = false;
+    for (int r = 0; r < TILE_HEIGHT; r++)
+        layer |= tile.mask[r] != 0;
+    if (layer && tile.zMax0 - depth > tile.zMax1 - tile.zMax0)
+    {
+        fill(tile.mask, tile.mask + TILE_HEIGHT, 0u);
+        tile.zMax0 = 0.0f;
+    }
+
+    uint32_t full = ~0u;
+    for (int r = 0; r < TILE_HEIGHT; r++)
+    {
+        tile.mask[r] |= coverage[r];
+        full &= tile.mask[r];
+    }
+    tile.zMax0 = max(tile.zMax0, depth);
+
+    // Camada completa: vira a referência do tile inteiro
+    if (full == ~0u)
+    {
+        tile.zMax1 = tile.zMax0;
+        fill(tile.mask, tile.mask + TILE_HEIGHT, 0u);
+        tile.zMax0 = 0.0f;
+    }
+}
+
+void MaskedOcclusion::rasterizeTileRow(int tileY)
+{
+    bool avx2 = false;
+#ifdef CG_OCCLUSION_X86
+    avx2 = selected == CULLING_AVX2;
+#endif
+
+    alignas(32) uint32_t coverage[TILE_HEIGHT];
+    float y0 = (float)(tileY * TILE_HEIGHT), y1 = y0 + TILE_HEIGHT;
+    for (const Triangle& tri : triangles)
+    {
+        if (tri.tileX0 > tri.tileX1 || tileY < tri.tileY0 || tileY > tri.tileY1) continue;
+
+        // Faixa de profundidade do plano sobre o tile (canto mais longe e mais perto)
+        float yFar = tri.zy > 0.0f ? y1 : y0, yNear = tri.zy > 0.0f ? y0 : y1;
+        for (int tileX = tri.tileX0; tileX <= tri.tileX1; tileX++)
+        {
+            Tile& tile = tiles[(size_t)tileY * tilesX + tileX];
+            float x0 = (float)(tileX * TILE_WIDTH), x1 = x0 + TILE_WIDTH;
+            float zNear = tri.zx * (tri.zx > 0.0f ? x0 : x1) + tri.zy * yNear + tri.z0;
+            if (max(zNear, tri.zMin) > tile.zMax1) continue;   // atrás de tudo no tile
+
+            bool covered;
+#ifdef CG_OCCLUSION_X86
+            if (avx2)
+                covered = coverageAVX2(tri, tileX, tileY, coverage);
+            else
+#endif
+                covered = coverageScalar(tri, tileX, tileY, coverage);
+            if (!covered) continue;
+
+            float zFar = tri.zx * (tri.zx > 0.0f ? x1 : x0) + tri.zy * yFar + tri.z0;
+            updateTile(tile, coverage, min(zFar, tri.zMax));
+        }
+    }
+}
+
+void MaskedOcclusion::rasterize()
+{
+    auto start = chrono::steady_clock::now();
+
+    triangles.resize(pendingTriangles);
+    if (threads)
+        threads->parallelFor(0, (int)occluders.size(), [&](int i) { setupOccluder(occluders[i]); }, 4);
+    else
+        for (const Occluder& occluder : occluders)
+            setupOccluder(occluder);
+
+    rasterizedTriangles = 0;
+    for (const Triangle& tri : triangles)
+        rasterizedTriangles += tri.tileX0 <= tri.tileX1;
+
+    // Cada linha de tiles é de uma thread só: nenhuma trava
+    if (threads)
+        threads->parallelFor(0, tilesY, [&](int tileY) { rasterizeTileRow(tileY); });
+    else
+        for (int tileY = 0; tileY < tilesY; tileY++)
+            rasterizeTileRow(tileY);
+
+    rasterizeMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+// --- Consulta ---------------------------------------------------------------
+
+bool MaskedOcclusion::testBox(const glm::vec3& boxMin, const glm::vec3& boxMax,
+                              const glm::mat4& modelViewProjection) const
+{
+    glm::vec2 ndcMin(INFINITY), ndcMax(-INFINITY);
+    float nearest = INFINITY;
+    for (int i = 0; i < 8; i++)
+    {
+        glm::vec3 corner((i & 1) ? boxMax.x : boxMin.x, (i & 2) ? boxMax.y : boxMin.y, (i & 4) ? boxMax.z : boxMin.z);
+        glm::vec4 clip = modelViewProjection * glm::vec4(corner, 1.0f);
+        if (clip.w <= 0.0f) return true;   // atravessa o plano da câmera
+        ndcMin = glm::min(ndcMin, glm::vec2(clip.x, clip.y) / clip.w);
+        ndcMax = glm::max(ndcMax, glm::vec2(clip.x, clip.y) / clip.w);
+        nearest = min(nearest, clip.z / clip.w);
+    }
+    float depth = nearest * 0.5f + 0.5f;
+
+    // Pixels cujos centros podem estar na caixa projetada
+    int x0 = max((int)floor((ndcMin.x * 0.5f + 0.5f) * width()), 0);
+    int x1 = min((int)floor((ndcMax.x * 0.5f + 0.5f) * width()), width() - 1);
+    int y0 = max((int)floor((ndcMin.y * 0.5f + 0.5f) * height()), 0);
+    int y1 = min((int)floor((ndcMax.y * 0.5f + 0.5f) * height()), height() - 1);
+    if (x0 > x1 || y0 > y1) return true;   // fora da tela: fica com o frustum culling
+
+    for (int tileY = y0 / TILE_HEIGHT; tileY <= y1 / TILE_HEIGHT; tileY++)
+    {
+        int rowBegin = max(y0 - tileY * TILE_HEIGHT, 0), rowEnd = min(y1 - tileY * TILE_HEIGHT, TILE_HEIGHT - 1);
+        for (int tileX = x0 / TILE_WIDTH; tileX <= x1 / TILE_WIDTH; tileX++)
+        {
+            const Tile& tile = tiles[(size_t)tileY * tilesX + tileX];
+
+            // Todos os pixels do retângulo na camada de trabalho: vale zMax0
+            int lo = max(x0 - tileX * TILE_WIDTH, 0), hi = min(x1 - tileX * TILE_WIDTH, TILE_WIDTH - 1) + 1;
+            uint32_t span = spanMask(lo, hi);
+            bool inLayer = true;
+            for (int r = rowBegin; r <= rowEnd; r++)
+                inLayer &= (tile.mask[r] & span) == span;
+            if (depth <= (inLayer ? tile.zMax0 : tile.zMax1)) return true;
+        }
+    }
+    return false;
+}
+
+void MaskedOcclusion::depthImage(vector<float>& out) const
+{
+    out.resize((size_t)width() * height());
+    for (int y = 0; y < height(); y++)
+        for (int x = 0; x < width(); x++)
+        {
+            const Tile& tile = tiles[(size_t)(y / TILE_HEIGHT) * tilesX + x / TILE_WIDTH];
+            bool inLayer = (tile.mask[y % TILE_HEIGHT] >> (x % TILE_WIDTH)) & 1;
+            out[(size_t)y * width() + x] = inLayer ? tile.zMax0 : tile.zMax1;
+        }
+}
@@ -0,0 +1,134 @@
+/*
+ *  Várias malhas num único VAO - ver include/MeshPool.h
+ */
+
+#include "MeshPool.h"
+#include "GLState.h"
+#include "GLDebug.h"
+
+#include <iostream>
+#include <algorithm>
+#include <cstddef>
+
+using namespace std;
+
+int MeshPool::addOBJ(const string& path)
+{
+    MeshData data;
+    if (!loadOBJ(path, data))
+    {
+        cout << "MeshPool: não foi possível ler " << path << endl;
+        return -1;
+    }
+
+    size_t slash = path.find_last_of("/\\");
+    string name = slash == string::npos ? path : path.substr(slash + 1);
+    return add(data, name.substr(0, name.find_last_of('.')));
+}
+
+int MeshPool::add(const MeshData& mesh, const string& name)
+{
+    if (vao)
+    {
+        cout << "MeshPool: malha " << name << " adicionada depois do upload" << endl;
+        return -1;
+    }
+
+    MeshRange range;
+    range.name = name;
+    range.firstIndex = (GLuint)indices.size();
+    range.indexCount = (GLuint)mesh.indices.size();
+    range.baseVertex = (GLint)vertices.size();
+
+    if (!mesh.vertices.empty())
+    {
+        range.boundsMin = range.boundsMax = mesh.vertices[0].position;
+        for (const MeshVertex& v : mesh.vertices)
+        {
+            range.boundsMin = glm::min(range.boundsMin, v.position);
+            range.boundsMax = glm::max(range.boundsMax, v.position);
+        }
+        range.center = (range.boundsMin + range.boundsMax) * 0.5f;
+        for (const MeshVertex& v : mesh.vertices)
+            range.radius = max(range.radius, glm::length(v.position - range.center));
+    }
+
+    vertices.insert(vertices.end(), mesh.vertices.begin(), mesh.vertices.end());
+    indices.insert(indices.end(), mesh.indices.begin(), mesh.indices.end());
+    meshes.push_back(range);
+    return (int)meshes.size() - 1;
+}
+
+void MeshPool::upload()
+{
+    if (vao) return;
+
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &vbo);
+    glGenBuffers(1, &ebo);
+    glGenBuffers(1, &drawIdBuffer);
+
+    glState().bindVertexArray(vao);
+    labelGLObject(GL_VERTEX_ARRAY, vao, "MeshPool");
+
+    glState().bindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(MeshVertex), vertices.data(), GL_STATIC_DRAW);
+    glState().bindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.data(), GL_STATIC_DRAW);
+
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(MeshVertex), (void*)offsetof(MeshVertex, position));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(MeshVertex), (void*)offsetof(MeshVertex, normal));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(MeshVertex), (void*)offsetof(MeshVertex, texCoord));
+    glEnableVertexAttribArray(2);
+
+    // Índice do desenho: o atributo aponta sempre para o mesmo buffer,
+    // que só cresce (reserveDrawIds)
+    glState().bindBuffer(GL_ARRAY_BUFFER, drawIdBuffer);
+    glVertexAttribIPointer(DRAW_ID_LOCATION, 1, GL_UNSIGNED_INT, sizeof(GLuint), (void*)0);
+    glVertexAttribDivisor(DRAW_ID_LOCATION, 1);
+    glEnableVertexAttribArray(DRAW_ID_LOCATION);
+    reserveDrawIds(1024);
+
+    cout << "MeshPool: " << meshes.size() << " malhas, " << vertices.size() << " vértices, "
+         << indices.size() / 3 << " triângulos" << endl;
+
+    vertices = vector<MeshVertex>();
+    indices = vector<GLuint>();
+}
+
+void MeshPool::reserveDrawIds(GLuint count)
+{
+    if (count <= drawIds || !drawIdBuffer) return;
+
+    GLuint capacity = max(count, drawIds * 2);
+    vector<GLuint> ids(capacity);
+    for (GLuint i = 0; i < capacity; i++) ids[i] = i;
+
+    glState().bindBuffer(GL_ARRAY_BUFFER, drawIdBuffer);
+    glBufferData(GL_ARRAY_BUFFER, capacity * sizeof(GLuint), ids.data(), GL_STATIC_DRAW);
+    drawIds = capacity;
+}
+
+void MeshPool::clear()
+{
+    if (vao)
+    {
+        glState().forgetVertexArray(vao);
+        forgetGLObjectLabel(GL_VERTEX_ARRAY, vao);
+        glDeleteVertexArrays(1, &vao);
+    }
+    for (GLuint* buffer : { &vbo, &ebo, &drawIdBuffer })
+    {
+        if (*buffer)
+        {
+            glState().forgetBuffer(*buffer);
+            forgetGLObjectLabel(GL_BUFFER, *buffer);
+            glDeleteBuffers(1, buffer);
+        }
+        *buffer = 0;
+    }
+    vao = 0;
+    drawIds = 0;
+}
@@ -0,0 +1,165 @@
+/*
+ *  Leitura de arquivos Wavefront .OBJ - ver include/ObjLoader.h
+ */
+
+#include "ObjLoader.h"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <map>
+#include <tuple>
+#include <cmath>
+
+using namespace std;
+
+// Índice do OBJ (1-based, negativo = relativo ao fim) para 0-based; -1 se ausente
+static int objIndex(const string& token, size_t count)
+{
+    if (token.empty()) return -1;
+    int i = stoi(token);
+    return i > 0 ? i - 1 : (int)count + i;
+}
+
+bool loadOBJ(const string& filePath, MeshData& mesh)
+{
+    vector<glm::vec3> positions;
+    vector<glm::vec2> texCoords;
+    vector<glm::vec3> normals;
+    map<tuple<int, int, int>, unsigned int> vertexIndex;
+    bool missingNormals = false;
+
+    ifstream arqEntrada(filePath.c_str());
+    if (!arqEntrada.is_open())
+    {
+        cerr << "Erro ao tentar ler o arquivo " << filePath << endl;
+        return false;
+    }
+
+    mesh.vertices.clear();
+    mesh.indices.clear();
+    mesh.tangents.clear();
+
+    string line;
+    vector<unsigned int> face;
+    while (getline(arqEntrada, line))
+    {
+        istringstream ssline(line);
+        string word;
+        ssline >> word;
+
+        if (word == "v")
+        {
+            glm::vec3 v;
+            ssline >> v.x >> v.y >> v.z;
+            positions.push_back(v);
+        }
+        else if (word == "vt")
+        {
+            glm::vec2 vt;
+            ssline >> vt.s >> vt.t;
+            texCoords.push_back(vt);
+        }
+        else if (word == "vn")
+        {
+            glm::vec3 vn;
+            ssline >> vn.x >> vn.y >> vn.z;
+            normals.push_back(vn);
+        }
+        else if (word == "f")
+        {
+            face.clear();
+            while (ssline >> word)
+            {
+                istringstream ss(word);
+                string index;
+                int vi = -1, ti = -1, ni = -1;
+                if (getline(ss, index, '/')) vi = objIndex(index, positions.size());
+                if (getline(ss, index, '/')) ti = objIndex(index, texCoords.size());
+                if (getline(ss, index)) ni = objIndex(index, normals.size());
+                if (vi < 0 || vi >= (int)positions.size()) continue;
+
+                auto key = make_tuple(vi, ti, ni);
+                auto it = vertexIndex.find(key);
+                if (it == vertexIndex.end())
+                {
+                    MeshVertex vertex;
+                    vertex.position = positions[vi];
+                    vertex.texCoord = (ti >= 0 && ti < (int)texCoords.size()) ? texCoords[ti] : glm::vec2(0.0f);
+                    vertex.normal = (ni >= 0 && ni < (int)normals.size()) ? normals[ni] : glm::vec3(0.0f);
+                    if (ni < 0) missingNormals = true;
+                    it = vertexIndex.emplace(key, (unsigned int)mesh.vertices.size()).first;
+                    mesh.vertices.push_back(vertex);
+                }
+                face.push_back(it->second);
+            }
+
+            // Triangulação em leque
+            for (size_t i = 2; i < face.size(); i++)
+            {
+                mesh.indices.push_back(face[0]);
+                mesh.indices.push_back(face[i - 1]);
+                mesh.indices.push_back(face[i]);
+            }
+        }
+    }
+
+    if (missingNormals)
+    {
+        for (MeshVertex& v : mesh.vertices)
+            v.normal = glm::vec3(0.0f);
+        for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3)
+        {
+            MeshVertex& a = mesh.vertices[mesh.indices[i]];
+            MeshVertex& b = mesh.vertices[mesh.indices[i + 1]];
+            MeshVertex& c = mesh.vertices[mesh.indices[i + 2]];
+            glm::vec3 n = glm::cross(b.position - a.position, c.position - a.position);
+            a.normal += n; b.normal += n; c.normal += n;
+        }
+    }
+    for (MeshVertex& v : mesh.vertices)
+        if (glm::dot(v.normal, v.normal) > 0.0f)
+            v.normal = glm::normalize(v.normal);
+
+    return true;
+}
+
+void computeTangents(MeshData& mesh)
+{
+    vector<glm::vec3> tan(mesh.vertices.size(), glm::vec3(0.0f));
+    vector<glm::vec3> bitan(mesh.vertices.size(), glm::vec3(0.0f));
+
+    for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3)
+    {
+        unsigned int i0 = mesh.indices[i], i1 = mesh.indices[i + 1], i2 = mesh.indices[i + 2];
+        const MeshVertex& a = mesh.vertices[i0];
+        const MeshVertex& b = mesh.vertices[i1];
+        const MeshVertex& c = mesh.vertices[i2];
+
+        glm::vec3 e1 = b.position - a.position, e2 = c.position - a.position;
+        glm::vec2 d1 = b.texCoord - a.texCoord, d2 = c.texCoord - a.texCoord;
+        float det = d1.x * d2.y - d2.x * d1.y;
+        if (det == 0.0f) continue;   // UV degenerada: não contribui
+
+        float r = 1.0f / det;
+        glm::vec3 t = (e1 * d2.y - e2 * d1.y) * r;
+        glm::vec3 bt = (e2 * d1.x - e1 * d2.x) * r;
+        tan[i0] += t; tan[i1] += t; tan[i2] += t;
+        bitan[i0] += bt; bitan[i1] += bt; bitan[i2] += bt;
+    }
+
+    mesh.tangents.resize(mesh.vertices.size());
+    for (size_t i = 0; i < mesh.vertices.size(); i++)
+    {
+        const glm::vec3& n = mesh.vertices[i].normal;
+
+        // Gram-Schmidt; se sobrar tangente nula, usa qualquer vetor ortogonal à normal
+        glm::vec3 t = tan[i] - n * glm::dot(n, tan[i]);
+        if (glm::dot(t, t) < 1e-12f)
+            t = glm::cross(n, fabsf(n.x) < 0.9f ? glm::vec3(1, 0, 0) : glm::vec3(0, 1, 0));
+        t = glm::normalize(t);
+
+        float w = glm::dot(glm::cross(n, t), bitan[i]) < 0.0f ? -1.0f : 1.0f;
+        mesh.tangents[i] = glm::vec4(t, w);
+    }
+}
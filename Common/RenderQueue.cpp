@@ -0,0 +1,298 @@
+/*
+ *  Fila de desenho ordenada - ver include/RenderQueue.h
+ */
+
+#include "RenderQueue.h"
+
+#include <chrono>
+#include <algorithm>
+
+using namespace std;
+
+static const int TRANSLUCENT_SHIFT = 64 - RENDER_KEY_PASS_BITS - 1;
+static const int PASS_SHIFT = 64 - RENDER_KEY_PASS_BITS;
+
+static uint64_t field(unsigned value, int bits, int shift)
+{
+    return (uint64_t(value) & ((uint64_t(1) << bits) - 1)) << shift;
+}
+
+uint64_t makeRenderKey(unsigned pass, bool translucent, unsigned program, unsigned material, unsigned geometry,
+                       float depth)
+{
+    const uint32_t maxDepth = (1u << RENDER_KEY_DEPTH_BITS) - 1;
+    uint32_t quantized = (uint32_t)(min(max(depth, 0.0f), 1.0f) * maxDepth);
+
+    uint64_t key = field(pass, RENDER_KEY_PASS_BITS, PASS_SHIFT);
+    if (!translucent)
+    {
+        int shift = TRANSLUCENT_SHIFT - RENDER_KEY_PROGRAM_BITS;
+        key |= field(program, RENDER_KEY_PROGRAM_BITS, shift);
+        shift -= RENDER_KEY_MATERIAL_BITS;
+        key |= field(material, RENDER_KEY_MATERIAL_BITS, shift);
+        shift -= RENDER_KEY_GEOMETRY_BITS;
+        key |= field(geometry, RENDER_KEY_GEOMETRY_BITS, shift);
+        key |= quantized;
+    }
+    else
+    {
+        key |= uint64_t(1) << TRANSLUCENT_SHIFT;
+        int shift = TRANSLUCENT_SHIFT - RENDER_KEY_DEPTH_BITS;
+        key |= field(maxDepth - quantized, RENDER_KEY_DEPTH_BITS, shift);
+        shift -= RENDER_KEY_PROGRAM_BITS;
+        key |= field(program, RENDER_KEY_PROGRAM_BITS, shift);
+        shift -= RENDER_KEY_MATERIAL_BITS;
+        key |= field(material, RENDER_KEY_MATERIAL_BITS, shift);
+        key |= field(geometry, RENDER_KEY_GEOMETRY_BITS, 0);
+    }
+    return key;
+}
+
+uint32_t renderKeyChanges(uint64_t previous, uint64_t key)
+{
+    uint64_t diff = previous ^ key;
+    uint32_t changed = (diff >> PASS_SHIFT) ? RENDER_KEY_PASS : 0;
+
+    // Opaco <-> translúcido: os layouts não batem, todo o estado conta como mudado
+    if ((diff >> TRANSLUCENT_SHIFT) & 1)
+        return changed | (RENDER_KEY_ALL & ~RENDER_KEY_PASS);
+
+    bool translucent = (key >> TRANSLUCENT_SHIFT) & 1;
+    int geometryShift = translucent ? 0 : RENDER_KEY_DEPTH_BITS;
+    int materialShift = geometryShift + RENDER_KEY_GEOMETRY_BITS;
+    int programShift = materialShift + RENDER_KEY_MATERIAL_BITS;
+    if (field(~0u, RENDER_KEY_PROGRAM_BITS, programShift) & diff) changed |= RENDER_KEY_PROGRAM;
+    if (field(~0u, RENDER_KEY_MATERIAL_BITS, materialShift) & diff) changed |= RENDER_KEY_MATERIAL;
+    if (field(~0u, RENDER_KEY_GEOMETRY_BITS, geometryShift) & diff) changed |= RENDER_KEY_GEOMETRY;
+    return changed;
+}
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define CG_RADIX_BMI2 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define CG_TARGET_BMI2
+#define CG_FLATTEN
+#else
+#define CG_TARGET_BMI2 __attribute__((target("bmi2")))
+#define CG_FLATTEN __attribute__((flatten))   // pext/pdep dentro do laço, sem chamada
+#endif
+#endif
+
+// Dígitos dos pares compactados: até 16 bits, 2 passadas para 32 bits
+static const int PACKED_DIGIT_BITS = 16;
+
+// Dígitos dos itens inteiros (mais de 32 bits variando): 2048 baldes cabem no L1
+static const int WIDE_DIGIT_BITS = 11;
+static const int WIDE_DIGIT_SIZE = 1 << WIDE_DIGIT_BITS;
+
+// Compacta a chave para os bits de varying, na mesma ordem (o que pext faz):
+// a ordem das chaves compactadas é a das originais, porque os bits parados
+// são iguais em todas
+struct ScalarKeyCodec
+{
+    struct BitRun
+    {
+        int shift;
+        uint64_t mask;
+        int offset;
+    };
+
+    BitRun runs[32];   // até 32 bits variando, no máximo 32 faixas
+    int count = 0;
+    uint64_t fixed;
+
+    ScalarKeyCodec(uint64_t varying, uint64_t fixed) : fixed(fixed)
+    {
+        int offset = 0;
+        for (int bit = 0; bit < 64;)
+        {
+            if (((varying >> bit) & 1) == 0)
+            {
+                bit++;
+                continue;
+            }
+            int length = 1;
+            while (bit + length < 64 && ((varying >> (bit + length)) & 1)) length++;
+            runs[count++] = { bit, (uint64_t(1) << length) - 1, offset };
+            offset += length;
+            bit += length;
+        }
+    }
+
+    uint64_t pack(uint64_t key) const
+    {
+        uint64_t packed = 0;
+        for (int r = 0; r < count; r++)
+            packed |= ((key >> runs[r].shift) & runs[r].mask) << runs[r].offset;
+        return packed;
+    }
+
+    uint64_t unpack(uint64_t packed) const
+    {
+        uint64_t key = fixed;
+        for (int r = 0; r < count; r++)
+            key |= ((packed >> runs[r].offset) & runs[r].mask) << runs[r].shift;
+        return key;
+    }
+};
+
+// Pares (chave compactada << 32 | índice): a chave compactada ocupa a metade
+// alta, então os dígitos são lidos a partir do bit 32
+template <typename Codec>
+static inline void radixSortPacked(const Codec& codec, int bits, vector<RenderQueueItem>& items,
+                                   vector<RenderQueueItem>& output, vector<uint64_t>& pairs,
+                                   vector<uint64_t>& pairScratch, vector<uint32_t>& histograms, int& passes)
+{
+    size_t count = items.size();
+    int digits = (bits + PACKED_DIGIT_BITS - 1) / PACKED_DIGIT_BITS;
+    int digitBits = (bits + digits - 1) / digits;
+    uint32_t digitSize = 1u << digitBits, digitMask = digitSize - 1;
+
+    // Compacta e conta os histogramas de todas as passadas na mesma leitura
+    histograms.assign((size_t)digits * digitSize, 0);
+    pairs.resize(count);
+    pairScratch.resize(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        uint64_t packed = codec.pack(items[i].key);
+        pairs[i] = (packed << 32) | items[i].index;
+        for (int d = 0; d < digits; d++)
+            histograms[d * digitSize + ((packed >> (d * digitBits)) & digitMask)]++;
+    }
+
+    output.resize(count);
+    for (int d = 0; d < digits; d++)
+    {
+        uint32_t* histogram = &histograms[d * digitSize];
+        uint32_t offset = 0;
+        for (uint32_t b = 0; b < digitSize; b++)
+        {
+            uint32_t n = histogram[b];
+            histogram[b] = offset;
+            offset += n;
+        }
+
+        int shift = 32 + d * digitBits;
+        if (d < digits - 1)
+        {
+            for (uint64_t pair : pairs)
+                pairScratch[histogram[(pair >> shift) & digitMask]++] = pair;
+            pairs.swap(pairScratch);
+        }
+        else
+        {
+            // Última passada: já escreve os itens, com a chave original
+            for (uint64_t pair : pairs)
+                output[histogram[(pair >> shift) & digitMask]++] = { codec.unpack(pair >> 32), (uint32_t)pair };
+        }
+        passes++;
+    }
+    items.swap(output);
+}
+
+#ifdef CG_RADIX_BMI2
+
+struct Bmi2KeyCodec
+{
+    uint64_t varying;
+    uint64_t fixed;
+
+    CG_TARGET_BMI2 uint64_t pack(uint64_t key) const { return _pext_u64(key, varying); }
+    CG_TARGET_BMI2 uint64_t unpack(uint64_t packed) const { return fixed | _pdep_u64(packed, varying); }
+};
+
+CG_TARGET_BMI2 CG_FLATTEN static void radixSortPackedBmi2(uint64_t varying, uint64_t fixed, int bits,
+                                               vector<RenderQueueItem>& items, vector<RenderQueueItem>& output,
+                                               vector<uint64_t>& pairs, vector<uint64_t>& pairScratch,
+                                               vector<uint32_t>& histograms, int& passes)
+{
+    radixSortPacked(Bmi2KeyCodec{ varying, fixed }, bits, items, output, pairs, pairScratch, histograms, passes);
+}
+
+// pext/pdep são microcódigo lento nos Zen 1 e 2: lá o escalar ganha
+static bool bmi2Fast()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuidex(info, 7, 0);
+    if ((info[1] & (1 << 8)) == 0) return false;
+    __cpuid(info, 0);
+    bool amd = info[1] == 0x68747541;   // "Auth"enticAMD
+    __cpuid(info, 1);
+    int family = ((info[0] >> 8) & 0xF) + ((info[0] >> 20) & 0xFF);
+    return !amd || family >= 0x19;
+#else
+    return __builtin_cpu_supports("bmi2") && !__builtin_cpu_is("znver1") && !__builtin_cpu_is("znver2");
+#endif
+}
+
+#endif
+
+void RenderQueue::sortPacked(int bits)
+{
+    uint64_t fixed = first & ~varying;
+#ifdef CG_RADIX_BMI2
+    static const bool useBmi2 = bmi2Fast();
+    if (useBmi2)
+    {
+        radixSortPackedBmi2(varying, fixed, bits, items, scratch, packed, packedScratch, histogramScratch, sortPasses);
+        return;
+    }
+#endif
+    radixSortPacked(ScalarKeyCodec(varying, fixed), bits, items, scratch, packed, packedScratch, histogramScratch,
+                    sortPasses);
+}
+
+void RenderQueue::sortWide()
+{
+    // Só os dígitos com algum bit variando; histogramas de todos numa leitura
+    int shifts[64 / WIDE_DIGIT_BITS + 1];
+    int digits = 0;
+    for (int shift = 0; shift < 64; shift += WIDE_DIGIT_BITS)
+        if ((varying >> shift) & (WIDE_DIGIT_SIZE - 1))
+            shifts[digits++] = shift;
+
+    vector<uint32_t>& histograms = histogramScratch;
+    histograms.assign((size_t)digits * WIDE_DIGIT_SIZE, 0);
+    for (const RenderQueueItem& item : items)
+        for (int d = 0; d < digits; d++)
+            histograms[d * WIDE_DIGIT_SIZE + ((item.key >> shifts[d]) & (WIDE_DIGIT_SIZE - 1))]++;
+
+    scratch.resize(items.size());
+    for (int d = 0; d < digits; d++)
+    {
+        uint32_t* histogram = &histograms[d * WIDE_DIGIT_SIZE];
+        uint32_t offset = 0;
+        for (int b = 0; b < WIDE_DIGIT_SIZE; b++)
+        {
+            uint32_t n = histogram[b];
+            histogram[b] = offset;
+            offset += n;
+        }
+        for (const RenderQueueItem& item : items)
+            scratch[histogram[(item.key >> shifts[d]) & (WIDE_DIGIT_SIZE - 1)]++] = item;
+        items.swap(scratch);
+        sortPasses++;
+    }
+}
+
+void RenderQueue::sort()
+{
+    auto start = chrono::steady_clock::now();
+    sortPasses = 0;
+
+    // Chaves todas iguais (ou nenhuma): a ordem de submit já é a resposta
+    if (items.size() >= 2 && varying != 0)
+    {
+        int bits = 0;
+        for (uint64_t v = varying; v; v &= v - 1) bits++;
+        if (bits <= 32)
+            sortPacked(bits);
+        else
+            sortWide();
+    }
+
+    sortMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
@@ -0,0 +1,136 @@
+/*
+ *  Buffer em anel mapeado persistentemente - ver include/RingBuffer.h
+ */
+
+#include "RingBuffer.h"
+#include "GLState.h"
+#include "GLDebug.h"
+#include "GLCapture.h"
+
+#include <iostream>
+#include <chrono>
+#include <algorithm>
+
+using namespace std;
+
+// Vínculo usado só para criar/enviar: não mexe em GL_ARRAY_BUFFER nem no EBO do VAO atual
+static const GLenum RING_TARGET = GL_COPY_WRITE_BUFFER;
+
+RingBuffer::RingBuffer(GLsizeiptr frameSize, int framesInFlight, const char* label)
+    : regionSize(frameSize), frames(max(framesInFlight, 1), (GLsync)0)
+{
+    GLint alignment = 256;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    uniformAlignment = alignment;
+    if (GLAD_GL_VERSION_4_3)
+    {
+        glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+        storageAlignment = alignment;
+    }
+
+    GLsizeiptr total = regionSize * (GLsizeiptr)frames.size();
+    glGenBuffers(1, &id);
+    glState().bindBuffer(RING_TARGET, id);
+    labelGLObject(GL_BUFFER, id, label);
+
+    bool immutable = GLAD_GL_VERSION_4_4 && !glCaptureRequested();
+    if (immutable)
+    {
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(RING_TARGET, total, nullptr, flags);
+        mapped = (unsigned char*)glMapBufferRange(RING_TARGET, 0, total, flags);
+        if (!mapped)
+            cout << "RingBuffer: falha ao mapear '" << label << "', usando cópias" << endl;
+    }
+    if (!mapped)
+    {
+        // Armazenamento imutável não pode ser reespecificado: buffer novo
+        if (immutable)
+        {
+            glState().forgetBuffer(id);
+            forgetGLObjectLabel(GL_BUFFER, id);
+            glDeleteBuffers(1, &id);
+            glGenBuffers(1, &id);
+            glState().bindBuffer(RING_TARGET, id);
+            labelGLObject(GL_BUFFER, id, label);
+        }
+        glBufferData(RING_TARGET, total, nullptr, GL_STREAM_DRAW);
+        staging.resize((size_t)total);
+    }
+    cursor = flushed = regionStart();
+}
+
+void RingBuffer::beginFrame()
+{
+    GLsync& fence = frames[frame % frames.size()];
+    if (fence)
+    {
+        GLenum status = glClientWaitSync(fence, 0, 0);
+        if (status == GL_TIMEOUT_EXPIRED)
+        {
+            waitCount++;
+            auto start = chrono::steady_clock::now();
+            // GL_SYNC_FLUSH_COMMANDS_BIT garante que a fence chega à GPU
+            while (status == GL_TIMEOUT_EXPIRED)
+                status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);   // 1 ms
+            waitMs += chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        }
+        glDeleteSync(fence);
+        fence = 0;
+    }
+    cursor = flushed = regionStart();
+}
+
+RingAllocation RingBuffer::allocate(GLsizeiptr size, GLsizeiptr alignment)
+{
+    RingAllocation a;
+    GLintptr offset = (cursor + alignment - 1) / alignment * alignment;
+    if (offset + size > regionStart() + regionSize)
+        return a;
+
+    a.pointer = (mapped ? mapped : staging.data()) + offset;
+    a.offset = offset;
+    a.size = size;
+    cursor = offset + size;
+    return a;
+}
+
+void RingBuffer::flush()
+{
+    if (mapped || cursor == flushed) return;
+
+    glState().bindBuffer(RING_TARGET, id);
+    glBufferSubData(RING_TARGET, flushed, cursor - flushed, staging.data() + flushed);
+    flushed = cursor;
+}
+
+void RingBuffer::endFrame()
+{
+    flush();
+    if (mapped)
+        frames[frame % frames.size()] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    frame++;
+}
+
+void RingBuffer::clear()
+{
+    for (GLsync& fence : frames)
+    {
+        if (fence) glDeleteSync(fence);
+        fence = 0;
+    }
+    if (id)
+    {
+        if (mapped)
+        {
+            glState().bindBuffer(RING_TARGET, id);
+            glUnmapBuffer(RING_TARGET);
+        }
+        glState().forgetBuffer(id);
+        forgetGLObjectLabel(GL_BUFFER, id);
+        glDeleteBuffers(1, &id);
+    }
+    id = 0;
+    mapped = nullptr;
+    staging.clear();
+}
@@ -0,0 +1,268 @@
+/*
+ *  Programas de shader com cache de binários - ver include/Shader.h
+ */
+
+#include "Shader.h"
+#include "GLExtensions.h"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <filesystem>
+
+using namespace std;
+
+static string cacheDirectory = "shader_cache";
+
+static const char CACHE_MAGIC[4] = { 'C', 'G', 'P', 'B' };
+static const uint32_t CACHE_VERSION = 1;
+
+struct ProgramCacheHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint64_t key;          // repetido no arquivo para detectar colisões de nome
+    uint32_t binaryFormat;
+    uint32_t length;
+};
+
+void setShaderCacheDirectory(const string& path)
+{
+    cacheDirectory = path;
+}
+
+// Uma linha por programa (chave, origem, tempo) só com CG_SHADER_CACHE_LOG=1,
+// como CG_GL_TRACE/CG_GL_DEBUG
+static void logProgram(uint64_t key, const char* origin, chrono::steady_clock::time_point start)
+{
+    static const bool requested = [] {
+        const char* value = getenv("CG_SHADER_CACHE_LOG");
+        return value && *value && strcmp(value, "0") != 0;
+    }();
+    if (!requested) return;
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    cout << "Programa " << hex << key << dec << " " << origin << " (" << ms << " ms)" << endl;
+}
+
+static uint64_t fnv1a(uint64_t hash, const char* data, size_t size)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= (unsigned char)data[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+static uint64_t fnv1a(uint64_t hash, const char* str)
+{
+    // O terminador entra no hash: ("ab", "c") e ("a", "bc") têm chaves diferentes
+    return str ? fnv1a(hash, str, strlen(str) + 1) : fnv1a(hash, "", 1);
+}
+
+string injectDefines(const char* source, const vector<string>& defines)
+{
+    string src = source;
+    if (defines.empty()) return src;
+
+    string block;
+    for (const string& d : defines)
+        block += "#define " + d + "\n";
+
+    size_t version = src.find("#version");
+    if (version == string::npos)
+        return block + src;
+    size_t lineEnd = src.find('\n', version);
+    if (lineEnd == string::npos)
+        return src + "\n" + block;
+    return src.insert(lineEnd + 1, block);
+}
+
+static GLuint compileStage(GLenum type, const char* source)
+{
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, nullptr);
+    glCompileShader(shader);
+
+    GLint success;
+    char infoLog[512];
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (!success)
+    {
+        glGetShaderInfoLog(shader, 512, NULL, infoLog);
+        cout << "Erro compilando "
+             << (type == GL_VERTEX_SHADER ? "Vertex" : type == GL_FRAGMENT_SHADER ? "Fragment" : "Compute")
+             << " Shader: " << infoLog << endl;
+    }
+    return shader;
+}
+
+bool shaderCacheAvailable()
+{
+    if (cacheDirectory.empty() || !GLAD_GL_VERSION_4_1) return false;
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    return formats > 0;
+}
+
+static string cachePath(uint64_t key)
+{
+    ostringstream name;
+    name << cacheDirectory << "/" << hex << setw(16) << setfill('0') << key << ".bin";
+    return name.str();
+}
+
+GLuint loadCachedProgram(uint64_t key)
+{
+    ifstream file(cachePath(key), ios::binary);
+    if (!file.is_open()) return 0;
+
+    ProgramCacheHeader header;
+    if (!file.read((char*)&header, sizeof(header)) || memcmp(header.magic, CACHE_MAGIC, 4) != 0 ||
+        header.version != CACHE_VERSION || header.key != key)
+        return 0;
+
+    vector<char> binary(header.length);
+    if (!file.read(binary.data(), header.length)) return 0;
+
+    GLuint program = glCreateProgram();
+    glProgramBinary(program, header.binaryFormat, binary.data(), (GLsizei)header.length);
+
+    // O driver pode recusar binários de outra versão mesmo com a mesma chave
+    GLint success;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success)
+    {
+        glDeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+void saveCachedProgram(uint64_t key, GLuint program)
+{
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return;
+
+    ProgramCacheHeader header;
+    memcpy(header.magic, CACHE_MAGIC, 4);
+    header.version = CACHE_VERSION;
+    header.key = key;
+    vector<char> binary(length);
+    GLenum format = 0;
+    glGetProgramBinary(program, length, nullptr, &format, binary.data());
+    header.binaryFormat = format;
+    header.length = (uint32_t)length;
+
+    error_code ec;
+    filesystem::create_directories(cacheDirectory, ec);
+
+    // Grava em arquivo temporário e renomeia: outra instância nunca lê um binário pela metade
+    string path = cachePath(key);
+    string tmpPath = path + ".tmp";
+    {
+        ofstream file(tmpPath, ios::binary);
+        if (!file.is_open()) return;
+        file.write((const char*)&header, sizeof(header));
+        file.write(binary.data(), length);
+        if (!file) return;
+    }
+    filesystem::rename(tmpPath, path, ec);
+}
+
+uint64_t shaderCacheKey(const string& vs, const string& fs)
+{
+    uint64_t key = 14695981039346656037ull;
+    key = fnv1a(key, (const char*)glGetString(GL_VENDOR));
+    key = fnv1a(key, (const char*)glGetString(GL_RENDERER));
+    key = fnv1a(key, (const char*)glGetString(GL_VERSION));
+    key = fnv1a(key, vs.c_str());
+    key = fnv1a(key, fs.c_str());
+    return key;
+}
+
+// Linka os estágios já compilados (que são apagados) e salva o binário
+static GLuint linkStages(initializer_list<GLuint> stages, bool useCache, uint64_t key,
+                         chrono::steady_clock::time_point start)
+{
+    GLuint shaderProgram = glCreateProgram();
+    if (useCache)
+        glProgramParameteri(shaderProgram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    for (GLuint stage : stages)
+        glAttachShader(shaderProgram, stage);
+    glLinkProgram(shaderProgram);
+    for (GLuint stage : stages)
+        glDeleteShader(stage);
+
+    GLint success;
+    char infoLog[512];
+    glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
+    if (!success)
+    {
+        glGetProgramInfoLog(shaderProgram, 512, NULL, infoLog);
+        cout << "Erro linkando shader program: " << infoLog << endl;
+        glDeleteProgram(shaderProgram);
+        return 0;
+    }
+
+    if (useCache)
+    {
+        saveCachedProgram(key, shaderProgram);
+        logProgram(key, "compilado", start);
+    }
+    return shaderProgram;
+}
+
+GLuint createProgram(const char* vertexSource, const char* fragmentSource, const vector<string>& defines)
+{
+    auto start = chrono::steady_clock::now();
+
+    string vs = injectDefines(vertexSource, defines);
+    string fs = injectDefines(fragmentSource, defines);
+
+    bool useCache = shaderCacheAvailable();
+    uint64_t key = 0;
+    if (useCache)
+    {
+        key = shaderCacheKey(vs, fs);
+        GLuint program = loadCachedProgram(key);
+        if (program)
+        {
+            logProgram(key, "carregado do cache", start);
+            return program;
+        }
+    }
+
+    GLuint vertexShader = compileStage(GL_VERTEX_SHADER, vs.c_str());
+    GLuint fragmentShader = compileStage(GL_FRAGMENT_SHADER, fs.c_str());
+    return linkStages({ vertexShader, fragmentShader }, useCache, key, start);
+}
+
+GLuint createComputeProgram(const char* computeSource, const vector<string>& defines)
+{
+    auto start = chrono::steady_clock::now();
+
+    string cs = injectDefines(computeSource, defines);
+
+    // Mesma chave dos programas vertex/fragment, com um fragment vazio
+    bool useCache = shaderCacheAvailable();
+    uint64_t key = 0;
+    if (useCache)
+    {
+        key = shaderCacheKey(cs, "");
+        GLuint program = loadCachedProgram(key);
+        if (program)
+        {
+            logProgram(key, "carregado do cache", start);
+            return program;
+        }
+    }
+
+    return linkStages({ compileStage(GL_COMPUTE_SHADER, cs.c_str()) }, useCache, key, start);
+}
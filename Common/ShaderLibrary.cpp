@@ -0,0 +1,226 @@
+/*
+ *  Shaders em arquivos com recarga automática - ver include/ShaderLibrary.h
+ */
+
+#include "ShaderLibrary.h"
+#include "UniformBuffers.h"
+#include "GLDebug.h"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+
+using namespace std;
+namespace fs = std::filesystem;
+
+ShaderLibrary::ShaderLibrary(ShaderManager& manager)
+    : manager(manager)
+{
+    // Blocos uniform compartilhados: uma única definição, a mesma dos shaders embutidos
+    addInclude("UniformBuffers.glsl", uniformBlocksGLSL);
+}
+
+void ShaderLibrary::addInclude(const string& name, const string& source)
+{
+    includes[name] = source;
+}
+
+static string trimLeft(const string& line)
+{
+    size_t start = line.find_first_not_of(" \t");
+    return start == string::npos ? string() : line.substr(start);
+}
+
+bool ShaderLibrary::preprocessFile(const string& path, string& out, vector<string>& sources,
+                                   set<string>& included, bool topLevel)
+{
+    string text;
+    int index = (int)sources.size();
+    auto builtin = includes.find(path);
+    if (builtin != includes.end() && !topLevel)
+    {
+        text = builtin->second;
+        sources.push_back(path);
+    }
+    else
+    {
+        ifstream file(path);
+        if (!file.is_open())
+        {
+            cout << "Shader não encontrado: " << path << endl;
+            return false;
+        }
+        stringstream buffer;
+        buffer << file.rdbuf();
+        text = buffer.str();
+        sources.push_back(FileWatcher::normalize(path));
+    }
+
+    if (!topLevel)
+        out += "#line 1 " + to_string(index) + "\n";
+
+    istringstream lines(text);
+    string line;
+    int lineNumber = 0;
+    while (getline(lines, line))
+    {
+        lineNumber++;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        string directive = trimLeft(line);
+
+        if (directive.compare(0, 8, "#include") == 0)
+        {
+            size_t open = directive.find_first_of("\"<");
+            size_t close = open == string::npos ? string::npos : directive.find_first_of("\">", open + 1);
+            if (close == string::npos)
+            {
+                cout << sources[index] << "(" << lineNumber << "): #include mal formado" << endl;
+                return false;
+            }
+            string name = directive.substr(open + 1, close - open - 1);
+
+            // Relativo ao arquivo atual; includes registrados têm prioridade
+            string target = name;
+            if (includes.find(name) == includes.end())
+                target = (fs::path(path).parent_path() / name).string();
+            string key = includes.count(name) ? name : FileWatcher::normalize(target);
+
+            if (included.insert(key).second)
+            {
+                if (!preprocessFile(target, out, sources, included, false))
+                    return false;
+            }
+            out += "#line " + to_string(lineNumber + 1) + " " + to_string(index) + "\n";
+            continue;
+        }
+
+        out += line;
+        out += '\n';
+
+        // #line não pode vir antes do #version; logo depois dele, fixa a numeração
+        // (injectDefines insere os #define nesse ponto)
+        if (topLevel && directive.compare(0, 8, "#version") == 0)
+            out += "#line " + to_string(lineNumber + 1) + " " + to_string(index) + "\n";
+    }
+    return true;
+}
+
+bool ShaderLibrary::preprocess(const string& path, string& source, vector<string>& sources)
+{
+    source.clear();
+    sources.clear();
+    set<string> included = { FileWatcher::normalize(path) };
+    return preprocessFile(path, source, sources, included, true);
+}
+
+int ShaderLibrary::load(const string& vertexPath, const string& fragmentPath, const vector<string>& defines)
+{
+    Program program;
+    program.vertexPath = vertexPath;
+    program.fragmentPath = fragmentPath;
+    program.defines = defines;
+    programs.push_back(program);
+    submit(programs.back());
+    return (int)programs.size() - 1;
+}
+
+void ShaderLibrary::submit(Program& program)
+{
+    string vs, fs;
+    bool ok = preprocess(program.vertexPath, vs, program.vertexSources);
+    ok = preprocess(program.fragmentPath, fs, program.fragmentSources) && ok;
+
+    // Observa também os arquivos de uma versão com erro, para recompilar quando forem corrigidos
+    for (const vector<string>* list : { &program.vertexSources, &program.fragmentSources })
+        for (const string& source : *list)
+            if (!includes.count(source) && program.files.insert(source).second)
+                watcher.watch(source);
+    if (!ok) return;
+
+    program.pending = manager.submit(vs.c_str(), fs.c_str(), program.defines);
+}
+
+void ShaderLibrary::finish(Program& program)
+{
+    if (manager.failed(program.pending))
+    {
+        cout << "Mantendo a versão anterior de " << program.fragmentPath << ". Números de fonte:" << endl;
+        for (size_t i = 0; i < program.vertexSources.size(); i++)
+            cout << "  vertex " << i << " = " << program.vertexSources[i] << endl;
+        for (size_t i = 0; i < program.fragmentSources.size(); i++)
+            cout << "  fragment " << i << " = " << program.fragmentSources[i] << endl;
+    }
+    else
+    {
+        // Troca só com o novo programa linkado: nenhum frame usa um programa quebrado
+        program.reflection = manager.reflection(program.pending);
+        GLuint linked = manager.release(program.pending);
+        if (program.active)
+        {
+            forgetGLObjectLabel(GL_PROGRAM, program.active);
+            glDeleteProgram(program.active);
+            cout << "Recarregado " << program.vertexPath << " + " << program.fragmentPath << endl;
+        }
+        program.active = linked;
+        program.version++;
+
+        string label = program.fragmentPath;
+        for (const string& define : program.defines)
+            label += " " + define;
+        labelGLObject(GL_PROGRAM, linked, label);
+    }
+    // O programa já é nosso (ou falhou): a entrada do manager fica para o próximo reload
+    manager.remove(program.pending);
+    program.pending = -1;
+
+    if (program.dirty)
+    {
+        program.dirty = false;
+        submit(program);
+    }
+}
+
+GLuint ShaderLibrary::program(int id)
+{
+    Program& program = programs[id];
+    if (program.pending >= 0 && (manager.isReady(program.pending) || manager.failed(program.pending)))
+        finish(program);
+    return program.active;
+}
+
+void ShaderLibrary::update()
+{
+    manager.poll();
+
+    for (const string& file : watcher.poll())
+    {
+        for (Program& program : programs)
+        {
+            if (!program.files.count(file)) continue;
+            if (program.pending >= 0)
+                program.dirty = true;
+            else
+                submit(program);
+        }
+    }
+
+    for (Program& program : programs)
+        if (program.pending >= 0 && (manager.isReady(program.pending) || manager.failed(program.pending)))
+            finish(program);
+}
+
+void ShaderLibrary::clear()
+{
+    for (Program& program : programs)
+    {
+        if (program.pending >= 0)
+            manager.remove(program.pending);
+        if (program.active)
+        {
+            forgetGLObjectLabel(GL_PROGRAM, program.active);
+            glDeleteProgram(program.active);
+        }
+    }
+    programs.clear();
+}
@@ -0,0 +1,229 @@
+/*
+ *  Compilação de shaders em paralelo - ver include/ShaderManager.h
+ */
+
+#include "ShaderManager.h"
+#include "GLExtensions.h"
+#include "Shader.h"
+#include "GLDebug.h"
+
+#include <iostream>
+
+using namespace std;
+
+ShaderManager::ShaderManager()
+{
+    parallelCompile = GLAD_GL_KHR_parallel_shader_compile != 0;
+    if (parallelCompile)
+        glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);   // o driver escolhe quantas threads usar
+    useCache = shaderCacheAvailable();
+}
+
+int ShaderManager::submit(const char* vertexSource, const char* fragmentSource, const vector<string>& defines)
+{
+    if (reported)
+    {
+        firstSubmit = chrono::steady_clock::now();
+        reported = false;
+    }
+
+    string vs = injectDefines(vertexSource, defines);
+    string fs = injectDefines(fragmentSource, defines);
+
+    Entry entry;
+    if (useCache)
+    {
+        entry.cacheKey = shaderCacheKey(vs, fs);
+        entry.program = loadCachedProgram(entry.cacheKey);
+        if (entry.program)
+        {
+            entry.state = Ready;
+            entry.cached = true;
+            entry.reflection = reflectProgram(entry.program);
+            return store(entry);
+        }
+    }
+
+    const char* vsSource = vs.c_str();
+    const char* fsSource = fs.c_str();
+    entry.vertexShader = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(entry.vertexShader, 1, &vsSource, nullptr);
+    glCompileShader(entry.vertexShader);
+    entry.fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(entry.fragmentShader, 1, &fsSource, nullptr);
+    glCompileShader(entry.fragmentShader);
+
+    // Link sem consultar GL_COMPILE_STATUS: o driver encadeia as etapas e um
+    // erro de compilação aparece como falha de link, tratada em finish()
+    entry.program = glCreateProgram();
+    if (useCache)
+        glProgramParameteri(entry.program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    glAttachShader(entry.program, entry.vertexShader);
+    glAttachShader(entry.program, entry.fragmentShader);
+    glLinkProgram(entry.program);
+
+    return store(entry);
+}
+
+int ShaderManager::store(const Entry& entry)
+{
+    if (freeIds.empty())
+    {
+        entries.push_back(entry);
+        return (int)entries.size() - 1;
+    }
+    int id = freeIds.back();
+    freeIds.pop_back();
+    entries[id] = entry;
+    return id;
+}
+
+void ShaderManager::remove(int id)
+{
+    Entry& entry = entries[id];
+    if (entry.state == Free) return;
+    if (entry.vertexShader) glDeleteShader(entry.vertexShader);
+    if (entry.fragmentShader) glDeleteShader(entry.fragmentShader);
+    if (entry.program)
+    {
+        forgetGLObjectLabel(GL_PROGRAM, entry.program);
+        glDeleteProgram(entry.program);
+    }
+    entry = Entry();
+    entry.state = Free;
+    freeIds.push_back(id);
+}
+
+static void printShaderLog(GLuint shader, const char* stage)
+{
+    GLint success;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (success) return;
+
+    char infoLog[512];
+    glGetShaderInfoLog(shader, 512, NULL, infoLog);
+    cout << "Erro compilando " << stage << " Shader: " << infoLog << endl;
+}
+
+void ShaderManager::finish(Entry& entry)
+{
+    GLint success;
+    glGetProgramiv(entry.program, GL_LINK_STATUS, &success);
+    if (success)
+    {
+        entry.state = Ready;
+        entry.reflection = reflectProgram(entry.program);
+        if (useCache)
+            saveCachedProgram(entry.cacheKey, entry.program);
+    }
+    else
+    {
+        printShaderLog(entry.vertexShader, "Vertex");
+        printShaderLog(entry.fragmentShader, "Fragment");
+
+        char infoLog[512];
+        glGetProgramInfoLog(entry.program, 512, NULL, infoLog);
+        cout << "Erro linkando shader program: " << infoLog << endl;
+        glDeleteProgram(entry.program);
+        entry.program = 0;
+        entry.state = Failed;
+    }
+
+    glDeleteShader(entry.vertexShader);
+    glDeleteShader(entry.fragmentShader);
+    entry.vertexShader = entry.fragmentShader = 0;
+}
+
+void ShaderManager::update(Entry& entry, bool block)
+{
+    if (entry.state != Linking) return;
+
+    // Sem a extensão não há consulta que não bloqueie: GL_LINK_STATUS espera o driver
+    if (parallelCompile && !block)
+    {
+        GLint done = GL_FALSE;
+        glGetProgramiv(entry.program, GL_COMPLETION_STATUS_KHR, &done);
+        if (!done) return;
+    }
+    finish(entry);
+}
+
+bool ShaderManager::poll()
+{
+    for (Entry& entry : entries)
+        update(entry, false);
+
+    if (pendingCount() > 0) return false;
+
+    if (!reported)
+    {
+        int cached = 0, failures = 0;
+        for (const Entry& entry : entries)
+        {
+            cached += entry.cached;
+            failures += entry.state == Failed;
+        }
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - firstSubmit).count();
+        cout << entries.size() - freeIds.size() << " programas prontos em " << ms << " ms ("
+             << (parallelCompile ? "compilação paralela" : "compilação serial") << ", "
+             << cached << " do cache, " << failures << " com erro)" << endl;
+        reported = true;
+    }
+    return true;
+}
+
+bool ShaderManager::isReady(int id)
+{
+    update(entries[id], false);
+    return entries[id].state == Ready;
+}
+
+GLuint ShaderManager::program(int id)
+{
+    return isReady(id) ? entries[id].program : 0;
+}
+
+GLuint ShaderManager::release(int id)
+{
+    GLuint program = wait(id);
+    entries[id].program = 0;
+    return program;
+}
+
+GLuint ShaderManager::wait(int id)
+{
+    update(entries[id], true);
+    return entries[id].program;
+}
+
+void ShaderManager::waitAll()
+{
+    for (Entry& entry : entries)
+        update(entry, true);
+    poll();
+}
+
+int ShaderManager::pendingCount() const
+{
+    int count = 0;
+    for (const Entry& entry : entries)
+        count += entry.state == Linking;
+    return count;
+}
+
+void ShaderManager::clear()
+{
+    for (Entry& entry : entries)
+    {
+        if (entry.vertexShader) glDeleteShader(entry.vertexShader);
+        if (entry.fragmentShader) glDeleteShader(entry.fragmentShader);
+        if (entry.program)
+        {
+            forgetGLObjectLabel(GL_PROGRAM, entry.program);
+            glDeleteProgram(entry.program);
+        }
+    }
+    entries.clear();
+    freeIds.clear();
+    reported = true;
+}
@@ -0,0 +1,69 @@
+/*
+ *  Variantes de shader por bits de recurso - ver include/ShaderVariants.h
+ */
+
+#include "ShaderVariants.h"
+#include "UniformBuffers.h"
+
+#include <algorithm>
+
+using namespace std;
+
+static const struct { uint32_t bit; const char* define; const char* name; } featureNames[] = {
+    { FEATURE_TEXTURE,      "USE_TEXTURE",      "TEXTURE" },
+    { FEATURE_VERTEX_COLOR, "USE_VERTEX_COLOR", "VERTEX_COLOR" },
+    { FEATURE_NORMAL_MAP,   "USE_NORMAL_MAP",   "NORMAL_MAP" },
+};
+
+VariantKey variantKey(uint32_t features, int lightCount)
+{
+    lightCount = min(max(lightCount, 1), MAX_LIGHTS);
+    return (features & 0xFFu) | ((uint32_t)lightCount << 8);
+}
+
+vector<string> ShaderVariants::defines(VariantKey key)
+{
+    vector<string> result;
+    for (const auto& feature : featureNames)
+        if (key & feature.bit)
+            result.push_back(feature.define);
+    result.push_back("LIGHT_COUNT " + to_string((key >> 8) & 0xFu));
+    return result;
+}
+
+string ShaderVariants::describe(VariantKey key)
+{
+    string result;
+    for (const auto& feature : featureNames)
+        if (key & feature.bit)
+            result += (result.empty() ? "" : "+") + string(feature.name);
+    if (result.empty()) result = "sem recursos";
+    unsigned lights = (key >> 8) & 0xFu;
+    return result + ", " + to_string(lights) + (lights == 1 ? " luz" : " luzes");
+}
+
+ShaderVariants::ShaderVariants(ShaderLibrary& library, const string& vertexPath, const string& fragmentPath)
+    : library(library), vertexPath(vertexPath), fragmentPath(fragmentPath)
+{
+}
+
+int ShaderVariants::variant(VariantKey key)
+{
+    auto it = variants.find(key);
+    if (it != variants.end()) return it->second;
+
+    int id = library.load(vertexPath, fragmentPath, defines(key));
+    variants[key] = id;
+    return id;
+}
+
+void ShaderVariants::prewarm(const vector<VariantKey>& keys)
+{
+    for (VariantKey key : keys)
+        variant(key);
+}
+
+GLuint ShaderVariants::program(VariantKey key)
+{
+    return library.program(variant(key));
+}
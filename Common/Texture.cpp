@@ -0,0 +1,147 @@
+/*
+ *  Carregamento de texturas e cache de samplers - ver include/Texture.h
+ */
+
+#include "Texture.h"
+#include "GLExtensions.h"
+#include "GLState.h"
+#include "GLDebug.h"
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+
+#include "stb_image.h"
+
+using namespace std;
+
+struct SamplerEntry
+{
+    SamplerDesc desc;
+    GLuint sampler;
+};
+
+// Poucas combinações por programa: busca linear é suficiente
+static vector<SamplerEntry> samplerCache;
+
+GLsizei mipLevelCount(int width, int height)
+{
+    GLsizei levels = 1;
+    while ((max(width, height) >> levels) > 0) levels++;
+    return levels;
+}
+
+void textureFormat(int channels, GLenum& internalFormat, GLenum& format)
+{
+    internalFormat = GL_RGBA8; format = GL_RGBA;
+    if (channels == 1) { internalFormat = GL_R8; format = GL_RED; }
+    else if (channels == 2) { internalFormat = GL_RG8; format = GL_RG; }
+    else if (channels == 3) { internalFormat = GL_RGB8; format = GL_RGB; }
+}
+
+GLuint allocateTexture(int width, int height, GLsizei levels, GLenum internalFormat)
+{
+    GLuint textureID = 0;
+    if (GLAD_GL_VERSION_4_5)
+    {
+        glCreateTextures(GL_TEXTURE_2D, 1, &textureID);
+        glTextureStorage2D(textureID, levels, internalFormat, width, height);
+    }
+    else
+    {
+        // Sem 4.5: aloca nível a nível e trava a cadeia com MAX_LEVEL
+        glGenTextures(1, &textureID);
+        glBindTexture(GL_TEXTURE_2D, textureID);
+        for (GLsizei level = 0; level < levels; level++)
+            glTexImage2D(GL_TEXTURE_2D, level, internalFormat, max(1, width >> level), max(1, height >> level), 0,
+                         GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels - 1);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glState().invalidateTextureUnit(0);
+    }
+    return textureID;
+}
+
+GLuint createTexture(int width, int height, int channels, const unsigned char* pixels, bool mipmaps)
+{
+    GLenum internalFormat, format;
+    textureFormat(channels, internalFormat, format);
+    GLsizei levels = mipmaps ? mipLevelCount(width, height) : 1;
+
+    GLuint textureID = allocateTexture(width, height, levels, internalFormat);
+
+    // Linhas RGB/R/RG nem sempre são múltiplas de 4 bytes
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    if (GLAD_GL_VERSION_4_5)
+    {
+        glTextureSubImage2D(textureID, 0, 0, 0, width, height, format, GL_UNSIGNED_BYTE, pixels);
+        if (levels > 1)
+            glGenerateTextureMipmap(textureID);
+    }
+    else
+    {
+        glBindTexture(GL_TEXTURE_2D, textureID);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, format, GL_UNSIGNED_BYTE, pixels);
+        if (levels > 1)
+            glGenerateMipmap(GL_TEXTURE_2D);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glState().invalidateTextureUnit(0);
+    }
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    return textureID;
+}
+
+GLuint loadTexture(const char* path, bool flipVertically)
+{
+    int width, height, nrChannels;
+    stbi_set_flip_vertically_on_load(flipVertically);
+    unsigned char* data = stbi_load(path, &width, &height, &nrChannels, 0);
+    if (!data)
+    {
+        cout << "Falha ao carregar textura: " << path << endl;
+        return 0;
+    }
+
+    GLuint textureID = createTexture(width, height, nrChannels, data);
+    stbi_image_free(data);
+    labelGLObject(GL_TEXTURE, textureID, path);
+    return textureID;
+}
+
+GLuint getSampler(const SamplerDesc& desc)
+{
+    for (const SamplerEntry& entry : samplerCache)
+        if (entry.desc == desc)
+            return entry.sampler;
+
+    GLuint sampler = 0;
+    if (GLAD_GL_VERSION_4_5)
+        glCreateSamplers(1, &sampler);
+    else
+        glGenSamplers(1, &sampler);
+
+    glSamplerParameteri(sampler, GL_TEXTURE_MIN_FILTER, desc.minFilter);
+    glSamplerParameteri(sampler, GL_TEXTURE_MAG_FILTER, desc.magFilter);
+    glSamplerParameteri(sampler, GL_TEXTURE_WRAP_S, desc.wrapS);
+    glSamplerParameteri(sampler, GL_TEXTURE_WRAP_T, desc.wrapT);
+    if (desc.maxAnisotropy > 1.0f)
+        glSamplerParameterf(sampler, GL_TEXTURE_MAX_ANISOTROPY, desc.maxAnisotropy);
+
+    samplerCache.push_back({ desc, sampler });
+    return sampler;
+}
+
+void deleteSamplers()
+{
+    for (const SamplerEntry& entry : samplerCache)
+        glDeleteSamplers(1, &entry.sampler);
+    samplerCache.clear();
+}
+
+void bindTexture(GLuint unit, GLuint texture, GLuint sampler)
+{
+    glState().bindTexture(unit, texture);
+    glState().bindSampler(unit, sampler);
+}
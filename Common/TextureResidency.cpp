@@ -0,0 +1,325 @@
+/*
+ *  Gerência de residência de texturas - ver include/TextureResidency.h
+ */
+
+#include "TextureResidency.h"
+#include "Texture.h"
+#include "GLExtensions.h"
+#include "GLState.h"
+#include "GLDebug.h"
+
+#include <iostream>
+#include <algorithm>
+
+#include "stb_image.h"
+
+using namespace std;
+
+TextureResidency::TextureResidency(size_t budgetBytes)
+    : budget(budgetBytes)
+{
+}
+
+TextureResidency::~TextureResidency()
+{
+    // Só encerra a thread: as texturas precisam de contexto ativo (ver clear)
+    {
+        lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    cond.notify_all();
+    if (worker.joinable())
+        worker.join();
+    for (Decoded& d : decoded)
+        stbi_image_free(d.pixels);
+}
+
+size_t TextureResidency::computeBytes(int width, int height, int channels, int droppedLevels)
+{
+    // Drivers normalmente guardam RGB8 com 4 bytes por texel
+    size_t bpp = channels == 3 ? 4 : channels;
+    GLsizei levels = mipLevelCount(width, height);
+    size_t bytes = 0;
+    for (GLsizei level = droppedLevels; level < levels; level++)
+        bytes += (size_t)max(1, width >> level) * max(1, height >> level) * bpp;
+    return bytes;
+}
+
+TextureHandle TextureResidency::load(const char* path, bool flipVertically)
+{
+    if (!placeholder)
+    {
+        const unsigned char gray[4] = { 128, 128, 128, 255 };
+        placeholder = createTexture(1, 1, 4, gray, false);
+    }
+
+    int width, height, nrChannels;
+    stbi_set_flip_vertically_on_load(flipVertically);
+    unsigned char* data = stbi_load(path, &width, &height, &nrChannels, 0);
+    if (!data)
+    {
+        cout << "Falha ao carregar textura: " << path << endl;
+        return INVALID_TEXTURE;
+    }
+
+    Entry e;
+    e.path = path;
+    e.flip = flipVertically;
+    e.alive = true;
+    e.texture = createTexture(width, height, nrChannels, data);
+    e.width = width;
+    e.height = height;
+    e.channels = nrChannels;
+    e.fullBytes = e.bytes = computeBytes(width, height, nrChannels, 0);
+    e.lastUsed = frame;
+    stbi_image_free(data);
+
+    totalBytes += e.bytes;
+    entries.push_back(e);
+    return (TextureHandle)entries.size() - 1;
+}
+
+void TextureResidency::release(TextureHandle handle)
+{
+    if (handle < 0 || handle >= (TextureHandle)entries.size() || !entries[handle].alive) return;
+    Entry& e = entries[handle];
+    evict(e);
+    e.alive = false;
+}
+
+GLuint TextureResidency::use(TextureHandle handle)
+{
+    if (handle < 0 || handle >= (TextureHandle)entries.size() || !entries[handle].alive)
+        return placeholder;
+    Entry& e = entries[handle];
+    e.lastUsed = frame;
+    return e.texture ? e.texture : placeholder;
+}
+
+void TextureResidency::bind(GLuint unit, TextureHandle handle, GLuint sampler)
+{
+    bindTexture(unit, use(handle), sampler);
+}
+
+void TextureResidency::dropTopLevel(Entry& e)
+{
+    int srcW = max(1, e.width >> e.droppedLevels);
+    int srcH = max(1, e.height >> e.droppedLevels);
+    int dstW = max(1, srcW >> 1), dstH = max(1, srcH >> 1);
+    GLsizei levels = mipLevelCount(dstW, dstH);
+
+    GLenum internalFormat, format;
+    textureFormat(e.channels, internalFormat, format);
+    GLuint texture = allocateTexture(dstW, dstH, levels, internalFormat);
+
+    // O nível l da nova textura é o nível l+1 da atual: cópia direto na GPU
+    if (GLAD_GL_VERSION_4_3)
+    {
+        for (GLsizei level = 0; level < levels; level++)
+            glCopyImageSubData(e.texture, GL_TEXTURE_2D, level + 1, 0, 0, 0,
+                               texture, GL_TEXTURE_2D, level, 0, 0, 0,
+                               max(1, dstW >> level), max(1, dstH >> level), 1);
+    }
+    else
+    {
+        // Sem glCopyImageSubData: ida e volta pela CPU (só no caminho de fallback)
+        vector<unsigned char> pixels((size_t)dstW * dstH * 4);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        for (GLsizei level = 0; level < levels; level++)
+        {
+            glBindTexture(GL_TEXTURE_2D, e.texture);
+            glGetTexImage(GL_TEXTURE_2D, level + 1, format, GL_UNSIGNED_BYTE, pixels.data());
+            glBindTexture(GL_TEXTURE_2D, texture);
+            glTexSubImage2D(GL_TEXTURE_2D, level, 0, 0, max(1, dstW >> level), max(1, dstH >> level),
+                            format, GL_UNSIGNED_BYTE, pixels.data());
+        }
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glState().invalidateTextureUnit(0);
+        glPixelStorei(GL_PACK_ALIGNMENT, 4);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    }
+
+    glState().forgetTexture(e.texture);
+    forgetGLObjectLabel(GL_TEXTURE, e.texture);
+    glDeleteTextures(1, &e.texture);
+
+    e.texture = texture;
+    e.droppedLevels++;
+    totalBytes -= e.bytes;
+    e.bytes = computeBytes(e.width, e.height, e.channels, e.droppedLevels);
+    totalBytes += e.bytes;
+}
+
+void TextureResidency::evict(Entry& e)
+{
+    if (!e.texture) return;
+    glState().forgetTexture(e.texture);
+    forgetGLObjectLabel(GL_TEXTURE, e.texture);
+    glDeleteTextures(1, &e.texture);
+    e.texture = 0;
+    e.droppedLevels = mipLevelCount(e.width, e.height);
+    totalBytes -= e.bytes;
+    e.bytes = 0;
+}
+
+void TextureResidency::requestRestore(TextureHandle handle)
+{
+    Entry& e = entries[handle];
+    e.restoring = true;
+    {
+        lock_guard<std::mutex> lock(mutex);
+        restoreQueue.push_back({ handle, e.path, e.flip });
+    }
+    if (!worker.joinable())
+        worker = thread(&TextureResidency::workerLoop, this);
+    cond.notify_one();
+}
+
+void TextureResidency::workerLoop()
+{
+    while (true)
+    {
+        RestoreRequest request;
+        {
+            unique_lock<std::mutex> lock(mutex);
+            cond.wait(lock, [this] { return stopping || !restoreQueue.empty(); });
+            if (stopping) return;
+            request = move(restoreQueue.front());
+            restoreQueue.pop_front();
+        }
+
+        Decoded d;
+        d.handle = request.handle;
+        stbi_set_flip_vertically_on_load_thread(request.flip);
+        d.pixels = stbi_load(request.path.c_str(), &d.width, &d.height, &d.channels, 0);
+
+        lock_guard<std::mutex> lock(mutex);
+        decoded.push_back(d);
+    }
+}
+
+void TextureResidency::endFrame()
+{
+    // 1) Texturas restauradas pela thread: sobem se ainda couberem no orçamento
+    vector<Decoded> ready;
+    {
+        lock_guard<std::mutex> lock(mutex);
+        ready.swap(decoded);
+    }
+    for (Decoded& d : ready)
+    {
+        Entry& e = entries[d.handle];
+        e.restoring = false;
+        if (d.pixels && e.alive && totalBytes - e.bytes + e.fullBytes <= budget)
+        {
+            GLuint texture = createTexture(d.width, d.height, d.channels, d.pixels);
+            if (e.texture)
+            {
+                glState().forgetTexture(e.texture);
+                forgetGLObjectLabel(GL_TEXTURE, e.texture);
+                glDeleteTextures(1, &e.texture);
+            }
+            e.texture = texture;
+            e.droppedLevels = 0;
+            totalBytes = totalBytes - e.bytes + e.fullBytes;
+            e.bytes = e.fullBytes;
+        }
+        stbi_image_free(d.pixels);
+    }
+
+    // 2) Pede de volta as texturas rebaixadas usadas neste frame, se houver folga
+    //    (90% do orçamento, para não ficar rebaixando e restaurando a mesma textura)
+    size_t reserved = 0;
+    for (const Entry& e : entries)
+        if (e.restoring) reserved += e.fullBytes - e.bytes;
+    for (TextureHandle h = 0; h < (TextureHandle)entries.size(); h++)
+    {
+        Entry& e = entries[h];
+        if (!e.alive || e.restoring || e.droppedLevels == 0 || e.lastUsed != frame) continue;
+        size_t extra = e.fullBytes - e.bytes;
+        if (totalBytes + reserved + extra > budget / 10 * 9) continue;
+        reserved += extra;
+        requestRestore(h);
+    }
+
+    // 3) Acima do orçamento: rebaixa/remove as menos usadas recentemente
+    while (totalBytes > budget)
+    {
+        Entry* victim = nullptr;
+        for (Entry& e : entries)
+        {
+            if (!e.alive || !e.texture || e.lastUsed >= frame) continue;
+            if (!victim || e.lastUsed < victim->lastUsed)
+                victim = &e;
+        }
+
+        if (victim)
+        {
+            int dim = max(victim->width, victim->height) >> victim->droppedLevels;
+            if (dim > minDimension) dropTopLevel(*victim);
+            else evict(*victim);
+            continue;
+        }
+
+        // Todas estão em uso: reduz a resolução da maior, mas não remove nenhuma
+        for (Entry& e : entries)
+        {
+            if (!e.alive || !e.texture) continue;
+            if ((max(e.width, e.height) >> e.droppedLevels) <= minDimension) continue;
+            if (!victim || e.bytes > victim->bytes)
+                victim = &e;
+        }
+        if (!victim) break;
+        dropTopLevel(*victim);
+    }
+
+    frame++;
+}
+
+void TextureResidency::clear()
+{
+    {
+        lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    cond.notify_all();
+    if (worker.joinable())
+        worker.join();
+    stopping = false;
+    restoreQueue.clear();
+    for (Decoded& d : decoded)
+        stbi_image_free(d.pixels);
+    decoded.clear();
+
+    for (Entry& e : entries)
+    {
+        if (!e.texture) continue;
+        glState().forgetTexture(e.texture);
+        forgetGLObjectLabel(GL_TEXTURE, e.texture);
+        glDeleteTextures(1, &e.texture);
+    }
+    entries.clear();
+    if (placeholder)
+    {
+        glState().forgetTexture(placeholder);
+        forgetGLObjectLabel(GL_TEXTURE, placeholder);
+        glDeleteTextures(1, &placeholder);
+    }
+    placeholder = 0;
+    totalBytes = 0;
+}
+
+void TextureResidency::printStats() const
+{
+    int full = 0, reduced = 0, evicted = 0;
+    for (const Entry& e : entries)
+    {
+        if (!e.alive) continue;
+        if (!e.texture) evicted++;
+        else if (e.droppedLevels > 0) reduced++;
+        else full++;
+    }
+    cout << "Texturas: " << totalBytes / (1024 * 1024) << " MB de " << budget / (1024 * 1024) << " MB"
+         << " | completas: " << full << " rebaixadas: " << reduced << " removidas: " << evicted << endl;
+}
@@ -0,0 +1,90 @@
+/*
+ *  Pool de threads - ver include/ThreadPool.h
+ */
+
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+using namespace std;
+
+ThreadPool::ThreadPool(unsigned int threadCount)
+{
+    if (threadCount == 0)
+        threadCount = max(1u, thread::hardware_concurrency());
+    for (unsigned int i = 1; i < threadCount; i++)
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (thread& t : workers)
+        t.join();
+}
+
+void ThreadPool::runChunks()
+{
+    while (true)
+    {
+        int first = next.fetch_add(jobGrain);
+        if (first >= jobEnd) return;
+        int last = min(jobEnd, first + jobGrain);
+        for (int i = first; i < last; i++)
+            (*job)(i);
+    }
+}
+
+void ThreadPool::workerLoop()
+{
+    unsigned long long seen = 0;
+    while (true)
+    {
+        {
+            unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+        }
+
+        runChunks();
+
+        lock_guard<std::mutex> lock(mutex);
+        if (--pending == 0)
+            done.notify_one();
+    }
+}
+
+void ThreadPool::parallelFor(int begin, int end, const function<void(int)>& body, int grainSize)
+{
+    if (begin >= end) return;
+    if (workers.empty() || end - begin <= grainSize)
+    {
+        for (int i = begin; i < end; i++)
+            body(i);
+        return;
+    }
+
+    {
+        lock_guard<std::mutex> lock(mutex);
+        job = &body;
+        jobEnd = end;
+        jobGrain = max(1, grainSize);
+        next = begin;
+        pending = (unsigned int)workers.size();
+        generation++;
+    }
+    wake.notify_all();
+
+    runChunks();
+
+    // Toda thread passa por cada geração: ao chegar a zero, nenhuma está mais
+    // lendo o trabalho atual e ele pode ser trocado com segurança
+    unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [&] { return pending == 0; });
+    job = nullptr;
+}
@@ -0,0 +1,257 @@
+/*
+ *  BVH de triângulos - ver include/TriangleBVH.h
+ */
+
+#include "TriangleBVH.h"
+#include "ObjLoader.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+using namespace std;
+
+static const int BVH_BINS = 12;
+static const int BVH_MAX_LEAF = 4;
+
+struct BuildBox
+{
+    glm::vec3 bmin = glm::vec3(FLT_MAX);
+    glm::vec3 bmax = glm::vec3(-FLT_MAX);
+
+    void grow(const glm::vec3& p) { bmin = glm::min(bmin, p); bmax = glm::max(bmax, p); }
+    void grow(const BuildBox& b) { bmin = glm::min(bmin, b.bmin); bmax = glm::max(bmax, b.bmax); }
+    float area() const
+    {
+        glm::vec3 e = bmax - bmin;
+        return e.x < 0.0f ? 0.0f : 2.0f * (e.x * e.y + e.y * e.z + e.z * e.x);
+    }
+};
+
+void TriangleBVH::build(const MeshData& mesh)
+{
+    vector<glm::vec3> positions(mesh.vertices.size());
+    for (size_t i = 0; i < mesh.vertices.size(); i++)
+        positions[i] = mesh.vertices[i].position;
+    build(positions, mesh.indices);
+}
+
+void TriangleBVH::build(const vector<glm::vec3>& positions, const vector<unsigned int>& indices)
+{
+    int triCount = (int)(indices.size() / 3);
+    nodes.clear();
+    maxDepth = 0;
+    triIndex.resize(triCount);
+    if (triCount == 0) return;
+
+    vector<BuildBox> triBox(triCount);
+    vector<glm::vec3> centroid(triCount);
+    for (int i = 0; i < triCount; i++)
+    {
+        for (int k = 0; k < 3; k++)
+            triBox[i].grow(positions[indices[3 * i + k]]);
+        centroid[i] = (triBox[i].bmin + triBox[i].bmax) * 0.5f;
+        triIndex[i] = i;
+    }
+
+    nodes.reserve(2 * triCount);
+    nodes.push_back({ glm::vec3(0.0f), 0, glm::vec3(0.0f), triCount });
+
+    // (nó, profundidade)
+    vector<pair<int, int>> stack;
+    stack.push_back({ 0, 0 });
+    while (!stack.empty())
+    {
+        int nodeIdx = stack.back().first, depth = stack.back().second;
+        stack.pop_back();
+        maxDepth = max(maxDepth, depth);
+        int first = nodes[nodeIdx].leftOrFirst, count = nodes[nodeIdx].count;
+
+        BuildBox bounds, centroidBounds;
+        for (int i = first; i < first + count; i++)
+        {
+            bounds.grow(triBox[triIndex[i]]);
+            centroidBounds.grow(centroid[triIndex[i]]);
+        }
+        nodes[nodeIdx].bmin = bounds.bmin;
+        nodes[nodeIdx].bmax = bounds.bmax;
+        if (count <= BVH_MAX_LEAF) continue;
+
+        // SAH em bins ao longo de cada eixo
+        int bestAxis = -1, bestSplit = 0;
+        float bestCost = FLT_MAX;
+        for (int axis = 0; axis < 3; axis++)
+        {
+            float lo = centroidBounds.bmin[axis], hi = centroidBounds.bmax[axis];
+            if (hi - lo <= 0.0f) continue;
+            float scale = BVH_BINS / (hi - lo);
+
+            BuildBox binBox[BVH_BINS];
+            int binCount[BVH_BINS] = {};
+            for (int i = first; i < first + count; i++)
+            {
+                int b = min(BVH_BINS - 1, (int)((centroid[triIndex[i]][axis] - lo) * scale));
+                binBox[b].grow(triBox[triIndex[i]]);
+                binCount[b]++;
+            }
+
+            // Custos acumulados da esquerda para a direita e vice-versa
+            float leftArea[BVH_BINS - 1], rightArea[BVH_BINS - 1];
+            int leftCount[BVH_BINS - 1], rightCount[BVH_BINS - 1];
+            BuildBox leftBox, rightBox;
+            int leftSum = 0, rightSum = 0;
+            for (int i = 0; i < BVH_BINS - 1; i++)
+            {
+                leftSum += binCount[i];
+                leftBox.grow(binBox[i]);
+                leftCount[i] = leftSum;
+                leftArea[i] = leftBox.area();
+
+                rightSum += binCount[BVH_BINS - 1 - i];
+                rightBox.grow(binBox[BVH_BINS - 1 - i]);
+                rightCount[BVH_BINS - 2 - i] = rightSum;
+                rightArea[BVH_BINS - 2 - i] = rightBox.area();
+            }
+            for (int i = 0; i < BVH_BINS - 1; i++)
+            {
+                float cost = leftCount[i] * leftArea[i] + rightCount[i] * rightArea[i];
+                if (leftCount[i] > 0 && rightCount[i] > 0 && cost < bestCost)
+                {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestSplit = i;
+                }
+            }
+        }
+
+        // Dividir não compensa: fica como folha (só se não for grande demais)
+        float leafCost = count * bounds.area();
+        int mid;
+        if (bestAxis >= 0 && (bestCost < leafCost || count > 4 * BVH_MAX_LEAF))
+        {
+            float lo = centroidBounds.bmin[bestAxis];
+            float scale = BVH_BINS / (centroidBounds.bmax[bestAxis] - lo);
+            int* midPtr = partition(&triIndex[first], &triIndex[first] + count, [&](int t) {
+                return min(BVH_BINS - 1, (int)((centroid[t][bestAxis] - lo) * scale)) <= bestSplit;
+            });
+            mid = (int)(midPtr - &triIndex[0]);
+        }
+        else if (count > 4 * BVH_MAX_LEAF)
+        {
+            // Centróides todos no mesmo ponto: divide ao meio
+            mid = first + count / 2;
+        }
+        else
+        {
+            continue;
+        }
+
+        int left = (int)nodes.size();
+        nodes.push_back({ glm::vec3(0.0f), first, glm::vec3(0.0f), mid - first });
+        nodes.push_back({ glm::vec3(0.0f), mid, glm::vec3(0.0f), first + count - mid });
+        nodes[nodeIdx].leftOrFirst = left;
+        nodes[nodeIdx].count = 0;
+        stack.push_back({ left, depth + 1 });
+        stack.push_back({ left + 1, depth + 1 });
+    }
+
+    v0.resize(triCount);
+    e1.resize(triCount);
+    e2.resize(triCount);
+    for (int i = 0; i < triCount; i++)
+    {
+        int t = triIndex[i];
+        glm::vec3 p0 = positions[indices[3 * t]];
+        v0[i] = p0;
+        e1[i] = positions[indices[3 * t + 1]] - p0;
+        e2[i] = positions[indices[3 * t + 2]] - p0;
+    }
+}
+
+// Teste de slab; retorna a distância de entrada ou FLT_MAX se não houver interseção
+static inline float rayBox(const glm::vec3& bmin, const glm::vec3& bmax,
+                           const glm::vec3& origin, const glm::vec3& invDir, float tMin, float tMax)
+{
+    glm::vec3 t0 = (bmin - origin) * invDir;
+    glm::vec3 t1 = (bmax - origin) * invDir;
+    glm::vec3 tNear = glm::min(t0, t1), tFar = glm::max(t0, t1);
+    float enter = max(max(tNear.x, tNear.y), max(tNear.z, tMin));
+    float exit = min(min(tFar.x, tFar.y), min(tFar.z, tMax));
+    return enter <= exit ? enter : FLT_MAX;
+}
+
+template <bool AnyHit>
+bool TriangleBVH::traverse(const glm::vec3& origin, const glm::vec3& dir, float tMin, float tMax, RayHit& hit) const
+{
+    if (nodes.empty()) return false;
+
+    glm::vec3 invDir(1.0f / dir.x, 1.0f / dir.y, 1.0f / dir.z);
+    bool found = false;
+
+    // Guarda no máximo um irmão por nível mais os dois filhos do nó atual:
+    // maxDepth + 1 entradas. Só malhas patológicas passam da pilha fixa
+    int fixedStack[64];
+    vector<int> deepStack;
+    int* stack = fixedStack;
+    if (maxDepth + 1 > 64)
+    {
+        deepStack.resize(maxDepth + 1);
+        stack = deepStack.data();
+    }
+    int sp = 0;
+    if (rayBox(nodes[0].bmin, nodes[0].bmax, origin, invDir, tMin, tMax) == FLT_MAX) return false;
+    stack[sp++] = 0;
+
+    while (sp > 0)
+    {
+        const Node& node = nodes[stack[--sp]];
+        if (node.count > 0)
+        {
+            for (int i = node.leftOrFirst; i < node.leftOrFirst + node.count; i++)
+            {
+                // Möller-Trumbore
+                glm::vec3 p = glm::cross(dir, e2[i]);
+                float det = glm::dot(e1[i], p);
+                if (fabsf(det) < 1e-12f) continue;
+                float invDet = 1.0f / det;
+                glm::vec3 s = origin - v0[i];
+                float u = glm::dot(s, p) * invDet;
+                if (u < 0.0f || u > 1.0f) continue;
+                glm::vec3 q = glm::cross(s, e1[i]);
+                float v = glm::dot(dir, q) * invDet;
+                if (v < 0.0f || u + v > 1.0f) continue;
+                float t = glm::dot(e2[i], q) * invDet;
+                if (t < tMin || t > tMax) continue;
+
+                if (AnyHit) return true;
+                tMax = t;
+                hit.t = t;
+                hit.triangle = triIndex[i];
+                hit.u = u;
+                hit.v = v;
+                found = true;
+            }
+            continue;
+        }
+
+        // Visita primeiro o filho mais próximo
+        int left = node.leftOrFirst, right = left + 1;
+        float dl = rayBox(nodes[left].bmin, nodes[left].bmax, origin, invDir, tMin, tMax);
+        float dr = rayBox(nodes[right].bmin, nodes[right].bmax, origin, invDir, tMin, tMax);
+        if (dl > dr) { swap(dl, dr); swap(left, right); }
+        if (dr != FLT_MAX) stack[sp++] = right;
+        if (dl != FLT_MAX) stack[sp++] = left;
+    }
+    return found;
+}
+
+bool TriangleBVH::intersect(const glm::vec3& origin, const glm::vec3& dir, float tMin, float tMax, RayHit& hit) const
+{
+    return traverse<false>(origin, dir, tMin, tMax, hit);
+}
+
+bool TriangleBVH::occluded(const glm::vec3& origin, const glm::vec3& dir, float tMin, float tMax) const
+{
+    RayHit hit;
+    return traverse<true>(origin, dir, tMin, tMax, hit);
+}
@@ -0,0 +1,127 @@
+/*
+ *  Uniform buffers por frame e por objeto - ver include/UniformBuffers.h
+ */
+
+#include "UniformBuffers.h"
+#include "GLState.h"
+
+#include <vector>
+
+using namespace std;
+
+static_assert(MAX_LIGHTS == 4, "atualizar o tamanho de lightPositions em uniformBlocksGLSL");
+
+const char* const uniformBlocksGLSL = R"(
+layout(std140, binding = 0) uniform FrameUniforms
+{
+    mat4 view;
+    mat4 projection;
+    vec4 cameraPosition;
+    vec4 lightPositions[4];     // MAX_LIGHTS
+    vec4 ambientColor;
+    vec4 diffuseColor;
+    vec4 specularColor;     // w = shininess
+};
+
+layout(std140, binding = 1) uniform ObjectUniforms
+{
+    mat4 model;
+    mat4 normalMatrix;
+};
+)";
+
+ObjectUniforms objectUniforms(const glm::mat4& model)
+{
+    ObjectUniforms data;
+    data.model = model;
+    data.normalMatrix = glm::mat4(glm::transpose(glm::inverse(glm::mat3(model))));
+    return data;
+}
+
+UniformBuffer::UniformBuffer(GLsizeiptr size, int count, GLuint binding)
+    : binding(binding), size(size), count(count)
+{
+    GLint alignment = 256;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    stride = (size + alignment - 1) / alignment * alignment;
+
+    glGenBuffers(1, &buffer);
+    glState().bindBuffer(GL_UNIFORM_BUFFER, buffer);
+    glBufferData(GL_UNIFORM_BUFFER, stride * count, nullptr, GL_DYNAMIC_DRAW);
+    bind(0);
+}
+
+void UniformBuffer::clear()
+{
+    if (buffer)
+    {
+        glState().forgetBuffer(buffer);
+        glDeleteBuffers(1, &buffer);
+    }
+    buffer = 0;
+}
+
+void UniformBuffer::update(int index, const void* data)
+{
+    // O vínculo genérico fica no buffer: atualizar de novo não revincula
+    glState().bindBuffer(GL_UNIFORM_BUFFER, buffer);
+    glBufferSubData(GL_UNIFORM_BUFFER, stride * index, size, data);
+}
+
+void UniformBuffer::bind(int index)
+{
+    glState().bindBufferRange(GL_UNIFORM_BUFFER, binding, buffer, stride * index, size);
+}
+
+GLint ProgramReflection::location(const string& name) const
+{
+    auto it = uniforms.find(name);
+    return it == uniforms.end() ? -1 : it->second;
+}
+
+ProgramReflection reflectProgram(GLuint program)
+{
+    ProgramReflection reflection;
+    if (!program) return reflection;
+
+    GLint maxLength = 0, count = 0;
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &count);
+    vector<char> name(maxLength + 1);
+    for (GLint i = 0; i < count; i++)
+    {
+        GLsizei length = 0;
+        GLint arraySize = 0;
+        GLenum type = 0;
+        glGetActiveUniform(program, i, (GLsizei)name.size(), &length, &arraySize, &type, name.data());
+        GLint location = glGetUniformLocation(program, name.data());
+        if (location < 0) continue;   // membro de bloco: sem location
+
+        // Arrays aparecem como "nome[0]"; guarda também pelo nome sem índice
+        string uniformName(name.data(), length);
+        if (uniformName.size() > 3 && uniformName.compare(uniformName.size() - 3, 3, "[0]") == 0)
+            reflection.uniforms[uniformName.substr(0, uniformName.size() - 3)] = location;
+        reflection.uniforms[uniformName] = location;
+    }
+
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &maxLength);
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_BLOCKS, &count);
+    name.assign(maxLength + 1, 0);
+    for (GLint i = 0; i < count; i++)
+    {
+        GLsizei length = 0;
+        glGetActiveUniformBlockName(program, i, (GLsizei)name.size(), &length, name.data());
+        string blockName(name.data(), length);
+
+        // Blocos conhecidos sempre no binding padrão, mesmo sem layout(binding) no GLSL
+        if (blockName == "FrameUniforms")
+            glUniformBlockBinding(program, i, FRAME_UNIFORMS_BINDING);
+        else if (blockName == "ObjectUniforms")
+            glUniformBlockBinding(program, i, OBJECT_UNIFORMS_BINDING);
+
+        GLint binding = 0;
+        glGetActiveUniformBlockiv(program, i, GL_UNIFORM_BLOCK_BINDING, &binding);
+        reflection.blockBindings[blockName] = (GLuint)binding;
+    }
+    return reflection;
+}
@@ -0,0 +1,686 @@
+/*
+ *  Texturização virtual com streaming de tiles - ver include/VirtualTexture.h
+ */
+
+#include "VirtualTexture.h"
+#include "GLState.h"
+#include "GLDebug.h"
+
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+
+#include "stb_image.h"
+
+using namespace std;
+
+static const char VT_MAGIC[4] = { 'C', 'G', 'V', 'T' };
+static const uint32_t VT_VERSION = 2;
+
+// Entradas da page table: (slot x, slot y, mip residente, válido) em RGBA8UI
+static inline uint32_t packEntry(uint32_t slotX, uint32_t slotY, uint32_t mip)
+{
+    return slotX | (slotY << 8) | (mip << 16) | (255u << 24);
+}
+
+static uint32_t nextPow2(uint32_t v)
+{
+    uint32_t p = 1;
+    while (p < v) p <<= 1;
+    return p;
+}
+
+// ---------------------------------------------------------------------------
+// Conversão offline: imagem -> arquivo .vt
+// ---------------------------------------------------------------------------
+
+bool buildVirtualTexture(const char* imagePath, const char* outPath, int tileSize, int border)
+{
+    // Mesmo caminho de importação do loadTexture: stb_image com flip vertical,
+    // para que uv (0,0) seja o canto inferior esquerdo como na OpenGL.
+    // Obs: a imagem de origem inteira precisa caber na RAM; somente o runtime
+    // trabalha por tiles.
+    int width, height, nrChannels;
+    stbi_set_flip_vertically_on_load(true);
+    unsigned char* data = stbi_load(imagePath, &width, &height, &nrChannels, 4);
+    if (!data)
+    {
+        cout << "Falha ao carregar textura: " << imagePath << endl;
+        return false;
+    }
+
+    VTFileHeader header = {};
+    memcpy(header.magic, VT_MAGIC, 4);
+    header.version = VT_VERSION;
+    header.width = width;
+    header.height = height;
+    header.pagesX = nextPow2((width + tileSize - 1) / tileSize);
+    header.pagesY = nextPow2((height + tileSize - 1) / tileSize);
+    header.tileSize = tileSize;
+    header.border = border;
+    // A cadeia para quando o eixo menor chega a uma página: assim todo nível
+    // tem metade das páginas do anterior nos dois eixos, como vtSample assume
+    header.mipCount = 1;
+    while ((header.pagesX >> header.mipCount) > 0 && (header.pagesY >> header.mipCount) > 0)
+        header.mipCount++;
+
+    // Mip 0 estendido até pagesX*tileSize x pagesY*tileSize replicando a borda
+    int levelW = header.pagesX * tileSize;
+    int levelH = header.pagesY * tileSize;
+    vector<unsigned char> level((size_t)levelW * levelH * 4);
+    for (int y = 0; y < levelH; y++)
+    {
+        int sy = min(y, height - 1);
+        for (int x = 0; x < levelW; x++)
+        {
+            int sx = min(x, width - 1);
+            memcpy(&level[((size_t)y * levelW + x) * 4], &data[((size_t)sy * width + sx) * 4], 4);
+        }
+    }
+    stbi_image_free(data);
+
+    ofstream out(outPath, ios::binary);
+    if (!out.is_open())
+    {
+        cout << "Erro ao criar o arquivo " << outPath << endl;
+        return false;
+    }
+    out.write((const char*)&header, sizeof(header));
+
+    int padded = tileSize + 2 * border;
+    vector<unsigned char> tile((size_t)padded * padded * 4);
+
+    for (uint32_t mip = 0; mip < header.mipCount; mip++)
+    {
+        int pagesX = max(1u, header.pagesX >> mip);
+        int pagesY = max(1u, header.pagesY >> mip);
+
+        for (int py = 0; py < pagesY; py++)
+        {
+            for (int px = 0; px < pagesX; px++)
+            {
+                for (int ty = 0; ty < padded; ty++)
+                {
+                    int sy = clamp(py * tileSize + ty - border, 0, levelH - 1);
+                    for (int tx = 0; tx < padded; tx++)
+                    {
+                        int sx = clamp(px * tileSize + tx - border, 0, levelW - 1);
+                        memcpy(&tile[((size_t)ty * padded + tx) * 4], &level[((size_t)sy * levelW + sx) * 4], 4);
+                    }
+                }
+                out.write((const char*)tile.data(), tile.size());
+            }
+        }
+
+        // Próximo nível: filtro box 2x2
+        if (mip + 1 < header.mipCount)
+        {
+            int nextW = levelW / 2;
+            int nextH = levelH / 2;
+            const int fx = 2, fy = 2;
+            vector<unsigned char> next((size_t)nextW * nextH * 4);
+            for (int y = 0; y < nextH; y++)
+            {
+                for (int x = 0; x < nextW; x++)
+                {
+                    for (int c = 0; c < 4; c++)
+                    {
+                        int sum = 0;
+                        for (int j = 0; j < fy; j++)
+                            for (int i = 0; i < fx; i++)
+                                sum += level[((size_t)(y * fy + j) * levelW + (x * fx + i)) * 4 + c];
+                        next[((size_t)y * nextW + x) * 4 + c] = (unsigned char)(sum / (fx * fy));
+                    }
+                }
+            }
+            level.swap(next);
+            levelW = nextW;
+            levelH = nextH;
+        }
+    }
+
+    cout << "Textura virtual gerada: " << outPath << " (" << header.pagesX << "x" << header.pagesY
+         << " paginas, " << header.mipCount << " mips)" << endl;
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Shaders
+// ---------------------------------------------------------------------------
+
+const char* vtFeedbackFragmentSource = R"(
+#version 450 core
+in vec2 TexCoord;
+
+uniform vec2 vtVirtualSize;
+uniform vec2 vtUVScale;
+uniform float vtMaxMip;
+uniform float vtTileSize;
+uniform float vtFeedbackBias;
+
+out uvec4 feedback;
+
+void main()
+{
+    vec2 vuv = clamp(TexCoord, 0.0, 1.0) * vtUVScale;
+    vec2 texel = vuv * vtVirtualSize;
+    vec2 dx = dFdx(texel), dy = dFdy(texel);
+    // O FBO de feedback é menor que a tela: as derivadas são maiores na mesma proporção
+    float lod = clamp(0.5 * log2(max(dot(dx, dx), dot(dy, dy))) - vtFeedbackBias, 0.0, vtMaxMip);
+    int mip = int(lod);
+    ivec2 pages = max(ivec2(vtVirtualSize / vtTileSize) >> mip, ivec2(1));
+    ivec2 page = clamp(ivec2(vuv * vec2(pages)), ivec2(0), pages - 1);
+    feedback = uvec4(uvec2(page), uint(mip), 1u);
+}
+)";
+
+const char* vtSampleGLSL = R"(
+uniform usampler2D vtPageTable;
+uniform sampler2D vtCache;
+uniform vec2 vtVirtualSize;
+uniform vec2 vtUVScale;
+uniform float vtMaxMip;
+uniform float vtTileSize;
+uniform float vtBorder;
+uniform float vtCacheSize;
+
+vec4 vtSample(vec2 uv)
+{
+    vec2 vuv = clamp(uv, 0.0, 1.0) * vtUVScale;
+    vec2 texel = vuv * vtVirtualSize;
+    vec2 dx = dFdx(texel), dy = dFdy(texel);
+    float lod = clamp(0.5 * log2(max(dot(dx, dx), dot(dy, dy))), 0.0, vtMaxMip);
+    int mip = int(lod);
+    ivec2 pages = max(ivec2(vtVirtualSize / vtTileSize) >> mip, ivec2(1));
+    ivec2 page = clamp(ivec2(vuv * vec2(pages)), ivec2(0), pages - 1);
+
+    // A entrada pode apontar para um ancestral (mip mais grosso) enquanto o tile pedido carrega
+    uvec4 entry = texelFetch(vtPageTable, page, mip);
+    vec2 pageCoord = texel / (vtTileSize * exp2(float(entry.z)));
+    vec2 inPage = fract(pageCoord) * vtTileSize;
+    vec2 phys = (vec2(entry.xy) * (vtTileSize + 2.0 * vtBorder) + vtBorder + inPage) / vtCacheSize;
+    return textureLod(vtCache, phys, 0.0);
+}
+)";
+
+// ---------------------------------------------------------------------------
+// VirtualTexture
+// ---------------------------------------------------------------------------
+
+VirtualTexture::~VirtualTexture()
+{
+    close();
+}
+
+uint32_t VirtualTexture::pagesAt(uint32_t mip, bool axisY) const
+{
+    return max(1u, (axisY ? header.pagesY : header.pagesX) >> mip);
+}
+
+uint32_t VirtualTexture::pageId(uint32_t mip, uint32_t x, uint32_t y) const
+{
+    return mipFirstPage[mip] + y * pagesAt(mip, false) + x;
+}
+
+void VirtualTexture::pageCoords(uint32_t id, uint32_t& mip, uint32_t& x, uint32_t& y) const
+{
+    mip = header.mipCount - 1;
+    while (mip > 0 && id < mipFirstPage[mip]) mip--;
+    uint32_t local = id - mipFirstPage[mip];
+    x = local % pagesAt(mip, false);
+    y = local / pagesAt(mip, false);
+}
+
+size_t VirtualTexture::tileBytes() const
+{
+    size_t padded = header.tileSize + 2 * header.border;
+    return padded * padded * 4;
+}
+
+uint64_t VirtualTexture::tileOffset(uint32_t page) const
+{
+    return sizeof(VTFileHeader) + (uint64_t)page * tileBytes();
+}
+
+bool VirtualTexture::open(const char* path, int cacheTilesPerSide, int workerCount)
+{
+    close();
+
+    ifstream in(path, ios::binary);
+    if (!in.is_open())
+    {
+        cout << "Erro ao tentar ler o arquivo " << path << endl;
+        return false;
+    }
+    in.read((char*)&header, sizeof(header));
+    if (!in || memcmp(header.magic, VT_MAGIC, 4) != 0 || header.version != VT_VERSION)
+    {
+        cout << "Arquivo de textura virtual invalido: " << path << endl;
+        return false;
+    }
+    filePath = path;
+
+    mipFirstPage.resize(header.mipCount);
+    uint32_t totalPages = 0;
+    for (uint32_t mip = 0; mip < header.mipCount; mip++)
+    {
+        mipFirstPage[mip] = totalPages;
+        totalPages += pagesAt(mip, false) * pagesAt(mip, true);
+    }
+    pageTableData.assign(totalPages, 0);
+
+    // O cache precisa caber no limite de textura do driver (e em 8 bits por slot)
+    GLint maxTexSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTexSize);
+    int padded = header.tileSize + 2 * header.border;
+    cacheTiles = min(min(cacheTilesPerSide, maxTexSize / padded), 256);
+
+    // Page table: uma mip por nível da textura virtual
+    glGenTextures(1, &pageTableTex);
+    glBindTexture(GL_TEXTURE_2D, pageTableTex);
+    for (uint32_t mip = 0; mip < header.mipCount; mip++)
+        glTexImage2D(GL_TEXTURE_2D, mip, GL_RGBA8UI, pagesAt(mip, false), pagesAt(mip, true), 0,
+                     GL_RGBA_INTEGER, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, header.mipCount - 1);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    labelGLObject(GL_TEXTURE, pageTableTex, "vt page table");
+
+    // Cache físico
+    glGenTextures(1, &cacheTex);
+    glBindTexture(GL_TEXTURE_2D, cacheTex);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, cacheTiles * padded, cacheTiles * padded, 0,
+                 GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+    labelGLObject(GL_TEXTURE, cacheTex, "vt cache");
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glState().invalidateTextureUnit(0);
+
+    slots.assign(cacheTiles * cacheTiles, Slot());
+    freeSlots.clear();
+    for (int i = (int)slots.size() - 1; i >= 0; i--)
+        freeSlots.push_back(i);
+
+    // O mip mais grosso (uma página no eixo menor, algumas no maior) é carregado
+    // já e nunca sai do cache, assim toda entrada da page table sempre tem um
+    // ancestral residente
+    uint32_t topMip = header.mipCount - 1;
+    uint32_t topPages = pagesAt(topMip, false) * pagesAt(topMip, true);
+    if (topPages >= slots.size())
+    {
+        cout << "Cache de textura virtual pequeno demais para o mip mais grosso (" << topPages << " paginas)" << endl;
+        close();
+        return false;
+    }
+    LoadedTile top;
+    top.pixels.resize(tileBytes());
+    for (uint32_t page = mipFirstPage[topMip]; page < mipFirstPage[topMip] + topPages; page++)
+    {
+        top.page = page;
+        in.seekg(tileOffset(page));
+        in.read((char*)top.pixels.data(), top.pixels.size());
+        int slot = acquireSlot();
+        uploadTile(top, slot);
+        slots[slot].pinned = true;
+        resident[page] = slot;
+    }
+    rebuildPageTable();
+
+    stopping = false;
+    for (int i = 0; i < max(1, workerCount); i++)
+        workers.emplace_back(&VirtualTexture::workerLoop, this);
+
+    return true;
+}
+
+void VirtualTexture::close()
+{
+    stopping = true;
+    queueCond.notify_all();
+    for (thread& t : workers)
+        t.join();
+    workers.clear();
+    loadQueue.clear();
+    loaded.clear();
+    pending.clear();
+    readFailed = false;
+    resident.clear();
+
+    for (GLuint texture : { pageTableTex, cacheTex, feedbackColor })
+    {
+        glState().forgetTexture(texture);
+        forgetGLObjectLabel(GL_TEXTURE, texture);
+    }
+    if (pageTableTex) glDeleteTextures(1, &pageTableTex);
+    if (cacheTex) glDeleteTextures(1, &cacheTex);
+    if (feedbackColor) glDeleteTextures(1, &feedbackColor);
+    if (feedbackDepth) glDeleteRenderbuffers(1, &feedbackDepth);
+    if (feedbackFBO) glDeleteFramebuffers(1, &feedbackFBO);
+    if (feedbackPBO[0]) glDeleteBuffers(2, feedbackPBO);
+    pageTableTex = cacheTex = feedbackColor = feedbackDepth = feedbackFBO = 0;
+    feedbackPBO[0] = feedbackPBO[1] = 0;
+    pboHasData[0] = pboHasData[1] = false;
+    feedbackW = feedbackH = 0;
+}
+
+void VirtualTexture::workerLoop()
+{
+    // Cada thread tem seu próprio stream para não disputar a posição de leitura
+    ifstream in(filePath, ios::binary);
+
+    while (true)
+    {
+        uint32_t page;
+        {
+            unique_lock<mutex> lock(queueMutex);
+            queueCond.wait(lock, [this] { return stopping || !loadQueue.empty(); });
+            if (stopping) return;
+            page = loadQueue.front();
+            loadQueue.pop_front();
+        }
+
+        LoadedTile tile;
+        tile.page = page;
+        tile.pixels.resize(tileBytes());
+        in.seekg(tileOffset(page));
+        in.read((char*)tile.pixels.data(), tile.pixels.size());
+        if (!in)
+        {
+            // Sai de pending para ser pedida de novo (até lá fica na mip mais grossa)
+            in.clear();
+            lock_guard<mutex> lock(queueMutex);
+            pending.erase(page);
+            if (!readFailed)
+                cout << "Erro ao ler a pagina " << page << " de " << filePath << endl;
+            readFailed = true;
+            continue;
+        }
+
+        lock_guard<mutex> lock(loadedMutex);
+        loaded.push_back(std::move(tile));
+    }
+}
+
+void VirtualTexture::beginFeedback(int screenWidth, int screenHeight, int divisor)
+{
+    glGetIntegerv(GL_VIEWPORT, savedViewport);
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &savedFBO);
+
+    feedbackDivisor = max(1, divisor);
+    int w = max(1, screenWidth / feedbackDivisor);
+    int h = max(1, screenHeight / feedbackDivisor);
+
+    if (w != feedbackW || h != feedbackH)
+    {
+        feedbackW = w;
+        feedbackH = h;
+
+        if (!feedbackFBO)
+        {
+            glGenFramebuffers(1, &feedbackFBO);
+            glGenTextures(1, &feedbackColor);
+            glGenRenderbuffers(1, &feedbackDepth);
+            glGenBuffers(2, feedbackPBO);
+        }
+
+        glBindTexture(GL_TEXTURE_2D, feedbackColor);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16UI, w, h, 0, GL_RGBA_INTEGER, GL_UNSIGNED_SHORT, nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glState().invalidateTextureUnit(0);
+
+        glBindRenderbuffer(GL_RENDERBUFFER, feedbackDepth);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, w, h);
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, feedbackFBO);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, feedbackColor, 0);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, feedbackDepth);
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+            cout << "ERROR::VIRTUALTEXTURE::FEEDBACK_FBO_INCOMPLETE" << endl;
+
+        for (int i = 0; i < 2; i++)
+        {
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, feedbackPBO[i]);
+            glBufferData(GL_PIXEL_PACK_BUFFER, (GLsizeiptr)w * h * 4 * sizeof(GLushort), nullptr, GL_STREAM_READ);
+            pboHasData[i] = false;
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, feedbackFBO);
+    glViewport(0, 0, feedbackW, feedbackH);
+    const GLuint clearColor[4] = { 0, 0, 0, 0 };
+    const GLfloat clearDepth = 1.0f;
+    glClearBufferuiv(GL_COLOR, 0, clearColor);
+    glClearBufferfv(GL_DEPTH, 0, &clearDepth);
+}
+
+void VirtualTexture::endFeedback()
+{
+    // Leitura assíncrona: o glReadPixels deste frame vai para um PBO e o
+    // resultado do frame anterior é mapeado do outro, evitando o stall
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, feedbackPBO[pboIndex]);
+    glReadPixels(0, 0, feedbackW, feedbackH, GL_RGBA_INTEGER, GL_UNSIGNED_SHORT, nullptr);
+    pboHasData[pboIndex] = true;
+
+    int previous = 1 - pboIndex;
+    pboIndex = previous;
+
+    vector<uint32_t> requests;
+    if (pboHasData[previous])
+    {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, feedbackPBO[previous]);
+        const GLushort* pixels = (const GLushort*)glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+        if (pixels)
+        {
+            unordered_set<uint32_t> unique;
+            size_t count = (size_t)feedbackW * feedbackH;
+            for (size_t i = 0; i < count; i++)
+            {
+                const GLushort* p = pixels + i * 4;
+                if (p[3] == 0 || p[2] >= header.mipCount) continue;
+
+                // Pede também os ancestrais: o refinamento fica gradual
+                uint32_t mip = p[2], x = p[0], y = p[1];
+                for (; mip < header.mipCount; mip++, x >>= 1, y >>= 1)
+                {
+                    uint32_t id = pageId(mip, min(x, pagesAt(mip, false) - 1), min(y, pagesAt(mip, true) - 1));
+                    if (!unique.insert(id).second) break;
+                }
+            }
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+            requests.assign(unique.begin(), unique.end());
+        }
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, savedFBO);
+    glViewport(savedViewport[0], savedViewport[1], savedViewport[2], savedViewport[3]);
+
+    if (!pboHasData[previous]) return;
+
+    // Mips mais grossos primeiro: cobrem mais área da tela por tile carregado
+    sort(requests.begin(), requests.end(), [this](uint32_t a, uint32_t b)
+    {
+        uint32_t ma, mb, x, y;
+        pageCoords(a, ma, x, y);
+        pageCoords(b, mb, x, y);
+        return ma != mb ? ma > mb : a < b;
+    });
+
+    unordered_set<uint32_t> wanted(requests.begin(), requests.end());
+    lock_guard<mutex> lock(queueMutex);
+
+    // Descarta da fila o que deixou de ser visível
+    deque<uint32_t> kept;
+    for (uint32_t page : loadQueue)
+    {
+        if (wanted.count(page)) kept.push_back(page);
+        else pending.erase(page);
+    }
+    loadQueue.swap(kept);
+
+    for (uint32_t page : requests)
+        requestPage(page);
+    queueCond.notify_all();
+}
+
+// Chamado com queueMutex travado
+void VirtualTexture::requestPage(uint32_t page)
+{
+    auto it = resident.find(page);
+    if (it != resident.end())
+    {
+        slots[it->second].lastUsed = frame;
+        return;
+    }
+    if (pending.count(page)) return;
+    pending.insert(page);
+    loadQueue.push_back(page);
+}
+
+int VirtualTexture::acquireSlot()
+{
+    if (!freeSlots.empty())
+    {
+        int slot = freeSlots.back();
+        freeSlots.pop_back();
+        return slot;
+    }
+
+    // LRU: o slot menos usado recentemente, que não tenha sido pedido neste frame
+    int victim = -1;
+    for (int i = 0; i < (int)slots.size(); i++)
+    {
+        const Slot& s = slots[i];
+        if (s.pinned || s.lastUsed >= frame) continue;
+        if (victim < 0 || s.lastUsed < slots[victim].lastUsed)
+            victim = i;
+    }
+    if (victim >= 0)
+    {
+        resident.erase(slots[victim].page);
+        slots[victim].page = UINT32_MAX;
+        pageTableDirty = true;
+    }
+    return victim;
+}
+
+void VirtualTexture::uploadTile(const LoadedTile& tile, int slot)
+{
+    int padded = header.tileSize + 2 * header.border;
+    int sx = slot % cacheTiles, sy = slot / cacheTiles;
+
+    glBindTexture(GL_TEXTURE_2D, cacheTex);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, sx * padded, sy * padded, padded, padded,
+                    GL_RGBA, GL_UNSIGNED_BYTE, tile.pixels.data());
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glState().invalidateTextureUnit(0);
+
+    slots[slot].page = tile.page;
+    slots[slot].lastUsed = frame;
+    pageTableDirty = true;
+}
+
+void VirtualTexture::update(int maxUploads)
+{
+    vector<LoadedTile> ready;
+    {
+        lock_guard<mutex> lock(loadedMutex);
+        int n = min((int)loaded.size(), maxUploads);
+        for (int i = 0; i < n; i++)
+            ready.push_back(std::move(loaded[i]));
+        loaded.erase(loaded.begin(), loaded.begin() + n);
+    }
+
+    for (LoadedTile& tile : ready)
+    {
+        {
+            lock_guard<mutex> lock(queueMutex);
+            pending.erase(tile.page);
+        }
+        if (resident.count(tile.page)) continue;
+
+        int slot = acquireSlot();
+        if (slot < 0) continue;   // cache cheio com tiles deste frame: será pedido de novo
+        uploadTile(tile, slot);
+        resident[tile.page] = slot;
+    }
+
+    if (pageTableDirty)
+        rebuildPageTable();
+    frame++;
+}
+
+void VirtualTexture::rebuildPageTable()
+{
+    // Do mip mais grosso para o mais fino: página não residente herda a entrada do pai
+    for (int mip = (int)header.mipCount - 1; mip >= 0; mip--)
+    {
+        uint32_t pagesX = pagesAt(mip, false), pagesY = pagesAt(mip, true);
+        for (uint32_t y = 0; y < pagesY; y++)
+        {
+            for (uint32_t x = 0; x < pagesX; x++)
+            {
+                uint32_t id = pageId(mip, x, y);
+                auto it = resident.find(id);
+                if (it != resident.end())
+                    pageTableData[id] = packEntry(it->second % cacheTiles, it->second / cacheTiles, mip);
+                else if (mip + 1 < (int)header.mipCount)
+                    pageTableData[id] = pageTableData[pageId(mip + 1, min(x >> 1, pagesAt(mip + 1, false) - 1),
+                                                                       min(y >> 1, pagesAt(mip + 1, true) - 1))];
+            }
+        }
+    }
+
+    glBindTexture(GL_TEXTURE_2D, pageTableTex);
+    for (uint32_t mip = 0; mip < header.mipCount; mip++)
+        glTexSubImage2D(GL_TEXTURE_2D, mip, 0, 0, pagesAt(mip, false), pagesAt(mip, true),
+                        GL_RGBA_INTEGER, GL_UNSIGNED_BYTE, &pageTableData[mipFirstPage[mip]]);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glState().invalidateTextureUnit(0);
+    pageTableDirty = false;
+}
+
+void VirtualTexture::bind(GLuint pageTableUnit, GLuint cacheUnit) const
+{
+    glState().bindTexture(pageTableUnit, pageTableTex);
+    glState().bindTexture(cacheUnit, cacheTex);
+}
+
+void VirtualTexture::setFeedbackUniforms(GLuint program) const
+{
+    glUniform2f(glGetUniformLocation(program, "vtVirtualSize"),
+                (float)(header.pagesX * header.tileSize), (float)(header.pagesY * header.tileSize));
+    glUniform2f(glGetUniformLocation(program, "vtUVScale"),
+                (float)header.width / (header.pagesX * header.tileSize),
+                (float)header.height / (header.pagesY * header.tileSize));
+    glUniform1f(glGetUniformLocation(program, "vtMaxMip"), (float)(header.mipCount - 1));
+    glUniform1f(glGetUniformLocation(program, "vtTileSize"), (float)header.tileSize);
+    glUniform1f(glGetUniformLocation(program, "vtFeedbackBias"), log2f((float)feedbackDivisor));
+}
+
+void VirtualTexture::setUniforms(GLuint program, GLuint pageTableUnit, GLuint cacheUnit) const
+{
+    int padded = header.tileSize + 2 * header.border;
+    glUniform1i(glGetUniformLocation(program, "vtPageTable"), pageTableUnit);
+    glUniform1i(glGetUniformLocation(program, "vtCache"), cacheUnit);
+    glUniform2f(glGetUniformLocation(program, "vtVirtualSize"),
+                (float)(header.pagesX * header.tileSize), (float)(header.pagesY * header.tileSize));
+    glUniform2f(glGetUniformLocation(program, "vtUVScale"),
+                (float)header.width / (header.pagesX * header.tileSize),
+                (float)header.height / (header.pagesY * header.tileSize));
+    glUniform1f(glGetUniformLocation(program, "vtMaxMip"), (float)(header.mipCount - 1));
+    glUniform1f(glGetUniformLocation(program, "vtTileSize"), (float)header.tileSize);
+    glUniform1f(glGetUniformLocation(program, "vtBorder"), (float)header.border);
+    glUniform1f(glGetUniformLocation(program, "vtCacheSize"), (float)(cacheTiles * padded));
+}
@@ -0,0 +1,6 @@
+// Implementação única da stb_image/stb_image_write para todo o código compartilhado (common/)
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include "stb_image_write.h"
@@ -0,0 +1,15 @@
+#version 450 core
+// M4 - ambiente + difusa (com sombras e uma rebatida) já estão no lightmap
+
+in vec2 TexCoord;
+in vec2 LightmapCoord;
+
+layout(binding = 0) uniform sampler2D texture1;
+layout(binding = 1) uniform sampler2D lightmap;
+
+out vec4 color;
+
+void main()
+{
+    color = vec4(texture(texture1, TexCoord).rgb * texture(lightmap, LightmapCoord).rgb, 1.0);
+}
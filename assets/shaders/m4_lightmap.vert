@@ -0,0 +1,17 @@
+#version 450 core
+// M4 - luz pré-calculada no lightmap (vertex)
+#include "UniformBuffers.glsl"
+
+layout(location = 0) in vec3 position;
+layout(location = 2) in vec2 texCoord;
+layout(location = 4) in vec2 lightmapCoord;
+
+out vec2 TexCoord;
+out vec2 LightmapCoord;
+
+void main()
+{
+    gl_Position = projection * view * model * vec4(position, 1.0);
+    TexCoord = texCoord;
+    LightmapCoord = lightmapCoord;
+}
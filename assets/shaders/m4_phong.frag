@@ -0,0 +1,71 @@
+#version 450 core
+// M4 - Phong por fragmento (fragment)
+// Recursos opcionais definidos por ShaderVariants: USE_TEXTURE, USE_VERTEX_COLOR,
+// USE_NORMAL_MAP e LIGHT_COUNT (constante: o laço das luzes é desenrolado)
+#include "UniformBuffers.glsl"
+
+#ifndef LIGHT_COUNT
+#define LIGHT_COUNT 1
+#endif
+
+in vec2 TexCoord;
+in vec3 Normal;
+in vec3 FragPos;
+
+#ifdef USE_VERTEX_COLOR
+in vec3 VertexColor;
+#endif
+
+#ifdef USE_TEXTURE
+layout(binding = 0) uniform sampler2D texture1;
+#endif
+
+#ifdef USE_NORMAL_MAP
+layout(binding = 2) uniform sampler2D normalMap;
+
+// Base tangente pelas derivadas de tela: dispensa o atributo de tangente
+vec3 perturbNormal(vec3 n, vec3 p, vec2 uv)
+{
+    vec3 dp1 = dFdx(p), dp2 = dFdy(p);
+    vec2 duv1 = dFdx(uv), duv2 = dFdy(uv);
+    vec3 dp2perp = cross(dp2, n);
+    vec3 dp1perp = cross(n, dp1);
+    vec3 t = dp2perp * duv1.x + dp1perp * duv2.x;
+    vec3 b = dp2perp * duv1.y + dp1perp * duv2.y;
+    float invmax = inversesqrt(max(dot(t, t), dot(b, b)));
+    vec3 m = texture(normalMap, uv).xyz * 2.0 - 1.0;
+    return normalize(mat3(t * invmax, b * invmax, n) * m);
+}
+#endif
+
+out vec4 color;
+
+void main()
+{
+    vec3 albedo = vec3(1.0);
+#ifdef USE_TEXTURE
+    albedo *= texture(texture1, TexCoord).rgb;
+#endif
+#ifdef USE_VERTEX_COLOR
+    albedo *= VertexColor;
+#endif
+
+    vec3 norm = normalize(Normal);
+#ifdef USE_NORMAL_MAP
+    norm = perturbNormal(norm, FragPos, TexCoord);
+#endif
+    vec3 viewDir = normalize(cameraPosition.xyz - FragPos);
+
+    vec3 result = ambientColor.rgb * albedo;
+    for (int i = 0; i < LIGHT_COUNT; i++)
+    {
+        vec3 lightDir = normalize(lightPositions[i].xyz - FragPos);
+        vec3 reflectDir = reflect(-lightDir, norm);
+
+        float diff = max(dot(norm, lightDir), 0.0);
+        float spec = pow(max(dot(viewDir, reflectDir), 0.0), specularColor.w);
+
+        result += diffuseColor.rgb * diff * albedo + specularColor.rgb * spec;
+    }
+    color = vec4(result, 1.0);
+}
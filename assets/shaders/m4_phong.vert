@@ -0,0 +1,29 @@
+#version 450 core
+// M4 - Phong por fragmento (vertex). model/normalMatrix e luz/câmera vêm dos blocos uniform.
+// Recursos opcionais definidos por ShaderVariants (USE_VERTEX_COLOR etc.)
+#include "UniformBuffers.glsl"
+
+layout(location = 0) in vec3 position;
+layout(location = 2) in vec2 texCoord;
+layout(location = 3) in vec3 normal;
+
+out vec2 TexCoord;
+out vec3 Normal;
+out vec3 FragPos;
+
+#ifdef USE_VERTEX_COLOR
+layout(location = 1) in vec3 color;
+out vec3 VertexColor;
+#endif
+
+void main()
+{
+    vec4 worldPos = model * vec4(position, 1.0);
+    gl_Position = projection * view * worldPos;
+    FragPos = vec3(worldPos);
+    Normal = mat3(normalMatrix) * normal;
+    TexCoord = texCoord;
+#ifdef USE_VERTEX_COLOR
+    VertexColor = color;
+#endif
+}
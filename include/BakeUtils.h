@@ -0,0 +1,81 @@
+/*
+ *  Utilitários compartilhados pelos bakers de texturas na CPU
+ *
+ *  - rasterizeUVs: para cada texel, qual triângulo o cobre no espaço UV e
+ *    as baricêntricas do centro do texel (linha 0 = v próximo de 0)
+ *  - BakeRandom / cosineSampleHemisphere: amostragem do hemisfério com
+ *    semente por texel, para o resultado não depender da ordem das threads
+ *  - dilateTexels: estende as bordas das ilhas de UV para os texels vazios,
+ *    evitando que filtragem/mipmaps puxem a cor do fundo
+ */
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include <glm/glm.hpp>
+
+struct TexelSample
+{
+    int triangle = -1;   // -1 = texel fora de todas as ilhas
+    float b0 = 0.0f, b1 = 0.0f, b2 = 0.0f;
+};
+
+void rasterizeUVs(const std::vector<glm::vec2>& uvs, const std::vector<unsigned int>& indices,
+                  int size, std::vector<TexelSample>& texels);
+
+struct BakeRandom
+{
+    uint32_t state;
+
+    explicit BakeRandom(uint32_t seed) : state(seed * 747796405u + 2891336453u) { if (!state) state = 1; }
+
+    // xorshift32, uniforme em [0, 1)
+    float next()
+    {
+        state ^= state << 13; state ^= state >> 17; state ^= state << 5;
+        return (state >> 8) * (1.0f / 16777216.0f);
+    }
+};
+
+// Direção com densidade proporcional a cos(theta) em torno de n
+glm::vec3 cosineSampleHemisphere(const glm::vec3& n, BakeRandom& rng);
+
+// Preenche texels com mask == 0 pela média dos vizinhos já preenchidos,
+// avançando um texel por passada. mask é atualizada.
+template <typename T>
+void dilateTexels(std::vector<T>& pixels, int channels, std::vector<unsigned char>& mask, int size, int passes)
+{
+    std::vector<float> sum(channels);
+    for (int pass = 0; pass < passes; pass++)
+    {
+        std::vector<unsigned char> nextMask = mask;
+        for (int y = 0; y < size; y++)
+            for (int x = 0; x < size; x++)
+            {
+                size_t idx = (size_t)y * size + x;
+                if (mask[idx]) continue;
+
+                int count = 0;
+                for (int c = 0; c < channels; c++) sum[c] = 0.0f;
+                for (int dy = -1; dy <= 1; dy++)
+                    for (int dx = -1; dx <= 1; dx++)
+                    {
+                        int nx = x + dx, ny = y + dy;
+                        if (nx < 0 || ny < 0 || nx >= size || ny >= size) continue;
+                        size_t n = (size_t)ny * size + nx;
+                        if (!mask[n]) continue;
+                        for (int c = 0; c < channels; c++) sum[c] += (float)pixels[n * channels + c];
+                        count++;
+                    }
+                if (count == 0) continue;
+
+                for (int c = 0; c < channels; c++)
+                    pixels[idx * channels + c] = (T)(sum[c] / count);
+                nextMask[idx] = 1;
+            }
+        mask.swap(nextMask);
+    }
+}
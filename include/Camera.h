@@ -0,0 +1,76 @@
+/*
+ *  Câmera em primeira pessoa (yaw/pitch), compartilhada pelos exercícios
+ *
+ *  Mesma câmera que M5 e M6 tinham cada um a sua cópia: WASD move ao longo
+ *  de Front/Right e o mouse gira em graus (MouseSensitivity por pixel).
+ *
+ *  Forma de uso
+ *  ------------
+ *  Camera camera(glm::vec3(0, 0, 5), glm::vec3(0, 1, 0), -90.0f, 0.0f);
+ *  camera.ProcessKeyboard('W', deltaTime);
+ *  camera.ProcessMouseMovement(xoffset, yoffset);
+ *  frame.view = camera.GetViewMatrix();
+ */
+
+#pragma once
+
+#include <cmath>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+class Camera {
+public:
+    glm::vec3 Position, Front, Up, Right, WorldUp;
+    float Yaw, Pitch;
+    float MovementSpeed = 3.0f;
+    float MouseSensitivity = 0.1f;
+
+    Camera(glm::vec3 position, glm::vec3 up, float yaw, float pitch)
+        : Front(glm::vec3(0, 0, -1))
+    {
+        Position = position; WorldUp = up;
+        Yaw = yaw; Pitch = pitch;
+        updateCameraVectors();
+    }
+
+    glm::mat4 GetViewMatrix() const { return glm::lookAt(Position, Position + Front, Up); }
+
+    void ProcessKeyboard(char dir, float deltaTime)
+    {
+        float velocity = MovementSpeed * deltaTime;
+        if (dir == 'W') Position += Front * velocity;
+        if (dir == 'S') Position -= Front * velocity;
+        if (dir == 'A') Position -= Right * velocity;
+        if (dir == 'D') Position += Right * velocity;
+    }
+
+    void ProcessMouseMovement(float xoffset, float yoffset, bool constrainPitch = true)
+    {
+        xoffset *= MouseSensitivity;
+        yoffset *= MouseSensitivity;
+
+        Yaw += xoffset;
+        Pitch += yoffset;
+
+        if (constrainPitch)
+        {
+            if (Pitch > 89.0f) Pitch = 89.0f;
+            if (Pitch < -89.0f) Pitch = -89.0f;
+        }
+
+        updateCameraVectors();
+    }
+
+private:
+    void updateCameraVectors()
+    {
+        glm::vec3 front;
+        front.x = cos(glm::radians(Yaw)) * cos(glm::radians(Pitch));
+        front.y = sin(glm::radians(Pitch));
+        front.z = sin(glm::radians(Yaw)) * cos(glm::radians(Pitch));
+        Front = glm::normalize(front);
+        Right = glm::normalize(glm::cross(Front, WorldUp));
+        Up = glm::normalize(glm::cross(Right, Front));
+    }
+};
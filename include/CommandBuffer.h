@@ -0,0 +1,203 @@
+/*
+ *  Listas de comandos de desenho gravadas em várias threads
+ *
+ *  A GL só aceita chamadas da thread do contexto, mas montar os desenhos
+ *  (culling, matrizes, escolha de estado) não precisa da GL. Aqui essa parte
+ *  grava comandos pequenos e sem ponteiros para a GL (POD: tipo, tamanho e
+ *  campos numéricos) num CommandBuffer, e só a thread do contexto os
+ *  executa, com replayCommands. Cada thread grava no seu próprio buffer, sem
+ *  trava nenhuma; os buffers são executados em sequência, na ordem em que o
+ *  chamador os passa, então o resultado não depende de qual thread gravou o
+ *  quê.
+ *
+ *  A memória é de um LinearAllocator: blocos grandes que só crescem, com
+ *  alocação por incremento de ponteiro e reset() no início do frame (os
+ *  blocos ficam para o próximo). Um comando nunca atravessa blocos.
+ *
+ *  O formato não depende da GL: pipelines são índices numa tabela que o
+ *  executor recebe, buffers e texturas são números (os nomes GL, no
+ *  executor daqui) e a topologia é PrimitiveTopology. Os índices são
+ *  sempre uint32 (formato do MeshPool).
+ *
+ *  Forma de uso
+ *  ------------
+ *  std::vector<CommandBuffer> buffers(blocos);
+ *  threads.parallelFor(0, blocos, [&](int b) {
+ *      CommandBuffer& cmd = buffers[b];
+ *      cmd.reset();
+ *      cmd.bindPipeline(PIPELINE_SOLID);
+ *      cmd.drawIndexed(range.indexCount, range.firstIndex, range.baseVertex, 1, slot);
+ *  });
+ *  // thread da GL:
+ *  std::vector<const PipelineState*> pipelines = { &solid, &wireframe };
+ *  for (const CommandBuffer& cmd : buffers)
+ *      replayCommands(cmd, pipelines);
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <memory>
+
+#include "GLState.h"
+
+class LinearAllocator
+{
+public:
+    explicit LinearAllocator(size_t blockSize = 64 * 1024) : blockSize(blockSize) {}
+
+    // alignment potência de 2; size até blockSize
+    void* allocate(size_t size, size_t alignment = 8);
+
+    // Esquece tudo, mantendo os blocos
+    void reset();
+
+    size_t used() const;
+    size_t reserved() const { return blocks.size() * blockSize; }
+
+    // f(início, bytes usados) para cada bloco com dados, na ordem
+    template <typename F>
+    void forEachBlock(F&& f) const
+    {
+        for (size_t b = 0; b < blocks.size(); b++)
+            if (blocks[b].used) f(blocks[b].data.get(), blocks[b].used);
+    }
+
+private:
+    struct Block
+    {
+        std::unique_ptr<unsigned char[]> data;
+        size_t used = 0;
+    };
+
+    size_t blockSize;
+    std::vector<Block> blocks;
+    size_t current = 0;
+};
+
+enum RenderCommandType : uint16_t
+{
+    RENDER_COMMAND_BIND_PIPELINE,
+    RENDER_COMMAND_BIND_BUFFER_RANGE,
+    RENDER_COMMAND_BIND_TEXTURE,
+    RENDER_COMMAND_DRAW_INDEXED
+};
+
+enum PrimitiveTopology : uint32_t
+{
+    TOPOLOGY_TRIANGLES,
+    TOPOLOGY_LINES,
+    TOPOLOGY_LINE_STRIP,
+    TOPOLOGY_POINTS
+};
+
+enum BufferBindingTarget : uint32_t
+{
+    BUFFER_BINDING_UNIFORM,
+    BUFFER_BINDING_STORAGE
+};
+
+struct RenderCommandHeader
+{
+    RenderCommandType type;
+    uint16_t size;   // do comando inteiro, para pular ao próximo
+};
+
+struct BindPipelineCommand
+{
+    static const RenderCommandType TYPE = RENDER_COMMAND_BIND_PIPELINE;
+    RenderCommandHeader header;
+    uint32_t pipeline;   // índice na tabela do executor
+};
+
+struct BindBufferRangeCommand
+{
+    static const RenderCommandType TYPE = RENDER_COMMAND_BIND_BUFFER_RANGE;
+    RenderCommandHeader header;
+    BufferBindingTarget target;
+    uint32_t index;
+    uint32_t buffer;
+    uint64_t offset;
+    uint64_t size;
+};
+
+struct BindTextureCommand
+{
+    static const RenderCommandType TYPE = RENDER_COMMAND_BIND_TEXTURE;
+    RenderCommandHeader header;
+    uint32_t unit;
+    uint32_t texture;   // 2D
+};
+
+struct DrawIndexedCommand
+{
+    static const RenderCommandType TYPE = RENDER_COMMAND_DRAW_INDEXED;
+    RenderCommandHeader header;
+    PrimitiveTopology topology;
+    uint32_t indexCount;
+    uint32_t firstIndex;
+    int32_t baseVertex;
+    uint32_t instanceCount;
+    uint32_t baseInstance;   // chega ao shader pelo atributo de instância (DRAW_ID_LOCATION)
+};
+
+class CommandBuffer
+{
+public:
+    // Todo comando começa num múltiplo disto (o leitor acha o próximo pelo tamanho)
+    static const size_t COMMAND_ALIGNMENT = 8;
+
+    explicit CommandBuffer(size_t blockSize = 64 * 1024) : memory(blockSize) {}
+
+    void reset() { memory.reset(); commands = 0; }
+
+    // Comando do tipo C com o cabeçalho preenchido; o resto fica para o chamador
+    template <typename C>
+    C& add()
+    {
+        static_assert(alignof(C) <= COMMAND_ALIGNMENT && sizeof(C) <= 0xFFFF, "comando grande demais");
+        C* command = (C*)memory.allocate(sizeof(C), COMMAND_ALIGNMENT);
+        command->header = { C::TYPE, (uint16_t)sizeof(C) };
+        commands++;
+        return *command;
+    }
+
+    void bindPipeline(uint32_t pipeline) { add<BindPipelineCommand>().pipeline = pipeline; }
+    void bindBufferRange(BufferBindingTarget target, uint32_t index, uint32_t buffer, uint64_t offset, uint64_t size);
+    void bindTexture(uint32_t unit, uint32_t texture);
+    void drawIndexed(uint32_t indexCount, uint32_t firstIndex, int32_t baseVertex, uint32_t instanceCount = 1,
+                     uint32_t baseInstance = 0, PrimitiveTopology topology = TOPOLOGY_TRIANGLES);
+
+    // f(const RenderCommandHeader&) na ordem de gravação
+    template <typename F>
+    void forEach(F&& f) const
+    {
+        memory.forEachBlock([&](const unsigned char* data, size_t used) {
+            for (size_t offset = 0; offset < used;)
+            {
+                const RenderCommandHeader& header = *(const RenderCommandHeader*)(data + offset);
+                f(header);
+                offset = (offset + header.size + COMMAND_ALIGNMENT - 1) & ~(COMMAND_ALIGNMENT - 1);
+            }
+        });
+    }
+
+    size_t size() const { return commands; }
+    size_t bytes() const { return memory.used(); }
+
+private:
+    LinearAllocator memory;
+    size_t commands = 0;
+};
+
+struct ReplayStats
+{
+    size_t commands = 0;
+    size_t draws = 0;
+};
+
+// Executor GL: roda na thread do contexto. Vínculos passam pelo cache de
+// GLState.h, então pipelines repetidos entre buffers não chegam à GL.
+ReplayStats replayCommands(const CommandBuffer& buffer, const std::vector<const PipelineState*>& pipelines);
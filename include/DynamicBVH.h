@@ -0,0 +1,137 @@
+/*
+ *  Árvore dinâmica de AABBs para índice da cena (culling e consultas)
+ *
+ *  Diferente de TriangleBVH (construída uma vez, somente leitura), aqui os
+ *  objetos entram, saem e se movem a qualquer momento, como no broadphase
+ *  de uma engine de física. Cada objeto é uma folha com uma caixa "gorda"
+ *  (a caixa real aumentada de uma margem); os nós internos guardam a união
+ *  dos filhos.
+ *
+ *  - Inserção guiada por SAH: o irmão da folha nova é o nó que menos
+ *    aumenta a soma das áreas de superfície da árvore, achado por
+ *    branch-and-bound (descarta subárvores cujo custo mínimo já é pior que
+ *    o melhor encontrado).
+ *  - Rotações: na subida depois de inserir ou remover, cada nó troca um
+ *    filho com um neto do outro lado quando isso diminui a área do filho.
+ *  - move(): só reinsere se a caixa nova sai da caixa gorda; movimentos
+ *    pequenos não mexem na árvore.
+ *  - refit(): atualiza a folha e recalcula as caixas dos ancestrais sem
+ *    mudar a topologia. É o mais barato para objetos que andam um pouco a
+ *    cada frame (trajetórias), mas a qualidade cai se eles se afastam muito
+ *    de onde foram inseridos; aí move() é o indicado.
+ *
+ *  Consultas devolvem o userData das folhas: frustum (Frustum.h), caixa e
+ *  raio (todas as folhas cruzadas, ou a mais próxima com um teste exato
+ *  fornecido pelo chamador).
+ *
+ *  Forma de uso
+ *  ------------
+ *  DynamicBVH tree;
+ *  int proxy = tree.insert(caixaDoObjeto, indiceDoObjeto);
+ *  ...
+ *  tree.refit(proxy, caixaNova);   // ou tree.move(proxy, caixaNova)
+ *  std::vector<int> visible;
+ *  tree.queryFrustum(extractFrustum(projection * view), visible);
+ *  ...
+ *  tree.remove(proxy);
+ */
+
+#pragma once
+
+#include <vector>
+#include <functional>
+
+#include <glm/glm.hpp>
+
+#include "Frustum.h"
+
+struct AABB
+{
+    glm::vec3 min = glm::vec3(0.0f);
+    glm::vec3 max = glm::vec3(0.0f);
+
+    AABB() = default;
+    AABB(const glm::vec3& min, const glm::vec3& max) : min(min), max(max) {}
+
+    float area() const
+    {
+        glm::vec3 d = max - min;
+        return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+    }
+    bool contains(const AABB& b) const
+    {
+        return min.x <= b.min.x && min.y <= b.min.y && min.z <= b.min.z &&
+               max.x >= b.max.x && max.y >= b.max.y && max.z >= b.max.z;
+    }
+    bool overlaps(const AABB& b) const
+    {
+        return min.x <= b.max.x && min.y <= b.max.y && min.z <= b.max.z &&
+               max.x >= b.min.x && max.y >= b.min.y && max.z >= b.min.z;
+    }
+};
+
+inline AABB merge(const AABB& a, const AABB& b)
+{
+    return AABB(glm::min(a.min, b.min), glm::max(a.max, b.max));
+}
+
+class DynamicBVH
+{
+public:
+    explicit DynamicBVH(float margin = 0.1f) : margin(margin) {}
+
+    // Retorna o proxy (estável até remove) da folha criada
+    int insert(const AABB& box, int userData);
+    void remove(int proxy);
+
+    // Reinsere só se box saiu da caixa gorda; retorna true se reinseriu
+    bool move(int proxy, const AABB& box);
+
+    // Atualiza a folha e os ancestrais, sem mudar a topologia
+    void refit(int proxy, const AABB& box);
+
+    int userData(int proxy) const { return nodes[proxy].userData; }
+    const AABB& fatBox(int proxy) const { return nodes[proxy].box; }
+
+    // userData das folhas cuja caixa gorda cruza o frustum / a caixa
+    void queryFrustum(const Frustum& frustum, std::vector<int>& out) const;
+    void queryBox(const AABB& box, std::vector<int>& out) const;
+
+    // Folhas cruzadas pelo raio em [0, tMax] (dir não precisa ser unitário; t em unidades de dir)
+    void queryRay(const glm::vec3& origin, const glm::vec3& dir, float tMax, std::vector<int>& out) const;
+
+    // Folha mais próxima: hit(userData) faz o teste exato e retorna t, ou < 0
+    // se não acerta. Subárvores mais distantes que o melhor t são puladas.
+    // Retorna o userData acertado ou -1.
+    int raycast(const glm::vec3& origin, const glm::vec3& dir, float tMax,
+                const std::function<float(int)>& hit, float* tHit = nullptr) const;
+
+    int leafCount() const { return leaves; }
+    int height() const;
+    // Soma das áreas dos nós internos / área da raiz: menor = árvore melhor
+    float areaRatio() const;
+
+private:
+    struct Node
+    {
+        AABB box;
+        int parent = -1;       // na lista livre: próximo livre
+        int child1 = -1;       // -1 = folha
+        int child2 = -1;
+        int userData = -1;
+        bool isLeaf() const { return child1 < 0; }
+    };
+
+    int allocateNode();
+    void freeNode(int node);
+    void insertLeaf(int leaf);
+    void removeLeaf(int leaf);
+    int findBestSibling(const AABB& box) const;
+    void rotate(int node);
+
+    std::vector<Node> nodes;
+    int root = -1;
+    int freeList = -1;
+    int leaves = 0;
+    float margin;
+};
@@ -0,0 +1,57 @@
+/*
+ *  Observa arquivos e informa quais mudaram
+ *
+ *  No Linux usa inotify sobre as pastas dos arquivos (não sobre os arquivos:
+ *  editores que salvam gravando um temporário e renomeando trocariam o inode
+ *  observado). O descritor é não bloqueante e lido em poll(), então não há
+ *  thread: basta chamar poll() uma vez por frame.
+ *
+ *  Nas outras plataformas compara a data de modificação de cada arquivo, no
+ *  máximo a cada pollInterval segundos.
+ *
+ *  Forma de uso
+ *  ------------
+ *  FileWatcher watcher;
+ *  watcher.watch("../assets/shaders/m4_phong.frag");
+ *  ...
+ *  for (const string& path : watcher.poll()) { ... recarrega path ... }
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <chrono>
+
+class FileWatcher
+{
+public:
+    FileWatcher();
+    ~FileWatcher();
+
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    // Caminhos são normalizados; observar o mesmo arquivo duas vezes não tem efeito
+    void watch(const std::string& path);
+
+    // Arquivos observados que mudaram desde a última chamada (caminhos normalizados)
+    std::vector<std::string> poll();
+
+    static std::string normalize(const std::string& path);
+
+    float pollInterval = 0.25f;   // só no modo sem inotify
+
+private:
+    std::set<std::string> files;
+
+#ifdef __linux__
+    int inotifyFd = -1;
+    std::map<int, std::string> directories;   // watch descriptor -> pasta
+#else
+    std::map<std::string, long long> modified;
+    std::chrono::steady_clock::time_point lastPoll;
+#endif
+};
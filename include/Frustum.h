@@ -0,0 +1,76 @@
+/*
+ *  Planos do frustum da câmera
+ *
+ *  Os seis planos saem direto das linhas da matriz view-projection (método
+ *  de Gribb/Hartmann, profundidade de -1 a 1 como na OpenGL): um ponto p
+ *  está dentro quando dot(plano.xyz, p) + plano.w >= 0 para os seis. Os
+ *  planos são normalizados, então esse valor é a distância ao plano e uma
+ *  esfera de raio r só está fora quando a distância é menor que -r.
+ *
+ *  O teste é conservador: esferas perto de um canto do frustum podem passar
+ *  sem estar visíveis, mas nenhuma visível é descartada.
+ *
+ *  Forma de uso
+ *  ------------
+ *  Frustum frustum = extractFrustum(projection * camera.GetViewMatrix());
+ *  if (sphereInFrustum(frustum, centro, raio)) ...
+ */
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+enum FrustumPlane
+{
+    FRUSTUM_LEFT,
+    FRUSTUM_RIGHT,
+    FRUSTUM_BOTTOM,
+    FRUSTUM_TOP,
+    FRUSTUM_NEAR,
+    FRUSTUM_FAR,
+    FRUSTUM_PLANE_COUNT
+};
+
+struct Frustum
+{
+    glm::vec4 planes[FRUSTUM_PLANE_COUNT];   // xyz = normal para dentro, w = distância
+};
+
+inline Frustum extractFrustum(const glm::mat4& viewProjection)
+{
+    // glm guarda colunas: a linha i é (m[0][i], m[1][i], m[2][i], m[3][i])
+    glm::mat4 rows = glm::transpose(viewProjection);
+
+    Frustum f;
+    f.planes[FRUSTUM_LEFT] = rows[3] + rows[0];
+    f.planes[FRUSTUM_RIGHT] = rows[3] - rows[0];
+    f.planes[FRUSTUM_BOTTOM] = rows[3] + rows[1];
+    f.planes[FRUSTUM_TOP] = rows[3] - rows[1];
+    f.planes[FRUSTUM_NEAR] = rows[3] + rows[2];
+    f.planes[FRUSTUM_FAR] = rows[3] - rows[2];
+    for (glm::vec4& p : f.planes)
+        p /= glm::length(glm::vec3(p));
+    return f;
+}
+
+inline bool sphereInFrustum(const Frustum& f, const glm::vec3& center, float radius)
+{
+    for (const glm::vec4& p : f.planes)
+        if (glm::dot(glm::vec3(p), center) + p.w < -radius)
+            return false;
+    return true;
+}
+
+// Canto da caixa mais avançado na direção da normal de cada plano
+inline bool boxInFrustum(const Frustum& f, const glm::vec3& boundsMin, const glm::vec3& boundsMax)
+{
+    for (const glm::vec4& p : f.planes)
+    {
+        glm::vec3 corner(p.x >= 0.0f ? boundsMax.x : boundsMin.x,
+                         p.y >= 0.0f ? boundsMax.y : boundsMin.y,
+                         p.z >= 0.0f ? boundsMax.z : boundsMin.z);
+        if (glm::dot(glm::vec3(p), corner) + p.w < 0.0f)
+            return false;
+    }
+    return true;
+}
@@ -0,0 +1,113 @@
+/*
+ *  Frustum culling na CPU com SIMD, sobre volumes em estrutura de arrays
+ *
+ *  Os volumes ficam em arrays separados por componente (SoA: todos os x,
+ *  depois todos os y...), então 8 objetos seguidos são 8 floats contíguos
+ *  e cabem num registrador AVX de uma vez. Cada plano do frustum (Frustum.h)
+ *  é testado contra 8 esferas ou caixas por instrução com AVX2, ou 4 com
+ *  SSE; os que passam pelos seis planos têm o índice escrito, em ordem, na
+ *  lista de visíveis.
+ *
+ *  O caminho é escolhido em tempo de execução (bestCullingPath): AVX2 se a
+ *  CPU e o sistema suportam, senão SSE (sempre presente em x86-64), e o
+ *  escalar fora de x86. O AVX2 é compilado só nas funções que o usam, então
+ *  o executável continua rodando em CPUs sem AVX2.
+ *
+ *  Com um ThreadPool o intervalo é dividido em blocos testados em paralelo;
+ *  cada bloco escreve numa região própria e as listas são juntadas na ordem
+ *  dos blocos, então o resultado é o mesmo do teste numa thread só.
+ *
+ *  Forma de uso
+ *  ------------
+ *  SphereBoundsSoA spheres;
+ *  spheres.resize(n);
+ *  spheres.set(i, centroNoMundo, raio);
+ *  ...
+ *  ThreadPool threads;
+ *  FrustumCuller culler(&threads);
+ *  const std::vector<uint32_t>& visible = culler.cull(extractFrustum(projection * view), spheres);
+ *  for (uint32_t i : visible) ...desenha o objeto i...
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "Frustum.h"
+#include "ThreadPool.h"
+
+struct SphereBoundsSoA
+{
+    std::vector<float> x, y, z, radius;
+
+    size_t size() const { return x.size(); }
+    void resize(size_t n) { x.resize(n); y.resize(n); z.resize(n); radius.resize(n); }
+    void set(size_t i, const glm::vec3& center, float r) { x[i] = center.x; y[i] = center.y; z[i] = center.z; radius[i] = r; }
+};
+
+struct BoxBoundsSoA
+{
+    std::vector<float> minX, minY, minZ, maxX, maxY, maxZ;
+
+    size_t size() const { return minX.size(); }
+    void resize(size_t n)
+    {
+        minX.resize(n); minY.resize(n); minZ.resize(n);
+        maxX.resize(n); maxY.resize(n); maxZ.resize(n);
+    }
+    void set(size_t i, const glm::vec3& boundsMin, const glm::vec3& boundsMax)
+    {
+        minX[i] = boundsMin.x; minY[i] = boundsMin.y; minZ[i] = boundsMin.z;
+        maxX[i] = boundsMax.x; maxY[i] = boundsMax.y; maxZ[i] = boundsMax.z;
+    }
+};
+
+enum CullingPath
+{
+    CULLING_SCALAR,
+    CULLING_SSE,
+    CULLING_AVX2
+};
+
+bool cullingPathSupported(CullingPath path);
+CullingPath bestCullingPath();
+const char* cullingPathName(CullingPath path);
+
+// Testa os objetos [begin, end) e escreve os índices visíveis em out, que
+// precisa de espaço para end - begin índices. Retorna quantos.
+size_t cullRange(CullingPath path, const Frustum& frustum, const SphereBoundsSoA& spheres, size_t begin, size_t end,
+                 uint32_t* out);
+size_t cullRange(CullingPath path, const Frustum& frustum, const BoxBoundsSoA& boxes, size_t begin, size_t end,
+                 uint32_t* out);
+
+class FrustumCuller
+{
+public:
+    // Sem pool, tudo na thread que chama. chunkSize é arredondado para múltiplo de 8.
+    explicit FrustumCuller(ThreadPool* threads = nullptr, size_t chunkSize = 16384);
+
+    // Caminhos sem suporte nesta CPU são ignorados
+    void setPath(CullingPath path);
+    CullingPath path() const { return selected; }
+
+    const std::vector<uint32_t>& cull(const Frustum& frustum, const SphereBoundsSoA& spheres);
+    const std::vector<uint32_t>& cull(const Frustum& frustum, const BoxBoundsSoA& boxes);
+
+    const std::vector<uint32_t>& visible() const { return result; }
+
+private:
+    template <typename Bounds>
+    const std::vector<uint32_t>& run(const Frustum& frustum, const Bounds& bounds);
+
+    ThreadPool* threads;
+    size_t chunkSize;
+    CullingPath selected;
+
+    std::vector<uint32_t> scratch;      // cada bloco escreve a partir do seu início
+    std::vector<size_t> chunkCounts;
+    std::vector<uint32_t> result;
+};
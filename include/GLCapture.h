@@ -0,0 +1,205 @@
+/*
+ *  Gravação e reprodução do fluxo de chamadas OpenGL
+ *
+ *  Usa os invólucros de GLTrace.h: com a gravação ativa, cada chamada é
+ *  serializada (ponto de entrada + argumentos + dados apontados) em um
+ *  arquivo binário, e o executável GLReplay re-executa o arquivo numa janela
+ *  oculta, o mais rápido possível, medindo cada frame. Assim mudanças no
+ *  renderizador ou no driver são comparadas sobre exatamente a mesma carga,
+ *  sem entrada de teclado nem simulação no caminho.
+ *
+ *  Gravação (variáveis de ambiente, lidas por loadGLExtensions):
+ *    CG_GL_CAPTURE=m4.glcap        arquivo de saída
+ *    CG_GL_CAPTURE_FRAMES=100-200  frames medidos no replay (padrão 0-299)
+ *  Tudo desde a criação do contexto é gravado (texturas, programas e buffers
+ *  criados na inicialização são necessários no replay); os frames antes do
+ *  intervalo são reproduzidos sem medir. A gravação termina no fim do
+ *  último frame do intervalo. Frames são delimitados por glTraceEndFrame().
+ *
+ *  Como os dados são gravados (ver GLCaptureCodec.h):
+ *  - escalares por valor;
+ *  - ponteiros de entrada com tamanho conhecido (glBufferData,
+ *    glTexImage*, glUniform*v, glShaderSource...) levam os bytes junto;
+ *  - deslocamentos em buffers (glVertexAttribPointer, glDrawElements...)
+ *    como número;
+ *  - ponteiros de saída (glGet*) não são gravados: o replay usa memória
+ *    própria;
+ *  - escritas em buffers mapeados são gravadas no glUnmapBuffer; as feitas
+ *    em mapeamentos persistentes (GL_MAP_PERSISTENT_BIT), que nunca são
+ *    desmapeados, não são vistas - RingBuffer.h usa cópias explícitas
+ *    quando a gravação foi pedida;
+ *  - ponteiros de entrada sem tamanho conhecido marcam a chamada como não
+ *    suportada, e o replay a pula (e conta).
+ *  Os nomes de objetos não são traduzidos: um contexto novo, criando os
+ *  objetos na mesma ordem, devolve os mesmos nomes. O replay confere os
+ *  nomes devolvidos por glGen*, glCreate* e as locations de uniforms e
+ *  avisa se divergirem. GL_UNPACK_ROW_LENGTH/SKIP_* não são considerados.
+ *
+ *  Formato: cabeçalho (GLCaptureHeader, com a tabela de nomes dos pontos
+ *  de entrada para o replay funcionar mesmo se a lista mudar) seguido dos
+ *  registros: uint16 ponto de entrada, argumentos, bloco pós-chamada
+ *  (uint32 tamanho + retorno + saídas conferidas). GLCAPTURE_FRAME_MARKER +
+ *  uint32 número do frame fecha cada frame. Dados apontados são alinhados
+ *  em 8 bytes a partir do início do arquivo.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+
+#include <glad/glad.h>
+
+#include "GLTrace.h"
+
+const uint32_t GLCAPTURE_MAGIC = 0x4C474743;   // "CGGL"
+const uint32_t GLCAPTURE_VERSION = 2;
+const uint16_t GLCAPTURE_FRAME_MARKER = 0xFFFF;
+
+struct GLCaptureHeader
+{
+    uint32_t firstFrame = 0;   // primeiro frame medido
+    uint32_t lastFrame = 0;    // último frame gravado
+    int32_t width = 0, height = 0;
+    int32_t glMajor = 0, glMinor = 0;
+    int32_t coreProfile = 0;   // 1 = contexto core (GL_CONTEXT_CORE_PROFILE_BIT)
+    std::vector<std::string> entryNames;   // índice no arquivo -> nome
+};
+
+// --- Gravação ---------------------------------------------------------------
+
+class GLCaptureWriter
+{
+public:
+    template <typename T>
+    void put(const T& value) { put(&value, sizeof(T)); }
+    void put(const void* data, size_t size)
+    {
+        const unsigned char* bytes = (const unsigned char*)data;
+        buffer.insert(buffer.end(), bytes, bytes + size);
+    }
+
+    // Completa com zeros até o próximo múltiplo de 8 (posição no arquivo)
+    void align() { buffer.resize(buffer.size() + (8 - (offset() & 7)) % 8, 0); }
+
+    // Reserva um uint32 para ser preenchido depois com patch()
+    size_t reserve() { size_t at = buffer.size(); put<uint32_t>(0); return at; }
+    void patch(size_t at, uint32_t value) { memcpy(&buffer[at], &value, sizeof(value)); }
+    size_t sizeSince(size_t at) const { return buffer.size() - at - sizeof(uint32_t); }
+
+    uint64_t offset() const { return written + buffer.size(); }
+    bool flush(FILE* file);
+
+private:
+    std::vector<unsigned char> buffer;
+    uint64_t written = 0;
+};
+
+// Ativo entre o início da gravação e o fim do último frame; lido em toda chamada
+extern bool glCaptureActive;
+
+GLCaptureWriter& glCaptureWriter();
+
+// CG_GL_CAPTURE definida
+bool glCaptureRequested();
+
+// Começa a gravar (com installGLTrace já chamado); frames contados a partir
+// do próximo glTraceEndFrame
+bool startGLCapture(const std::string& path, uint32_t firstFrame, uint32_t lastFrame);
+bool startGLCaptureFromEnvironment();
+void stopGLCapture();
+
+// Chamado por glTraceEndFrame
+void glCaptureEndFrame();
+
+// --- Reprodução -----------------------------------------------------------
+
+class GLCaptureReader
+{
+public:
+    bool open(const std::string& path, GLCaptureHeader& header);
+
+    bool atEnd() const { return position >= size; }
+    bool overrun() const { return position > size; }
+
+    template <typename T>
+    T get()
+    {
+        T value{};
+        if (position + sizeof(T) <= size) memcpy(&value, bytes() + position, sizeof(T));
+        position += sizeof(T);
+        return value;
+    }
+
+    // Dados alinhados, apontando direto para o arquivo em memória
+    const void* payload(uint64_t length)
+    {
+        position += (8 - (position & 7)) % 8;
+        const void* data = bytes() + position;
+        position += length;
+        return position <= size ? data : nullptr;
+    }
+
+    void skip(uint64_t length) { position += length; }
+
+private:
+    const unsigned char* bytes() const { return (const unsigned char*)storage.data(); }
+
+    std::vector<uint64_t> storage;   // uint64 para o início ficar alinhado em 8
+    uint64_t size = 0;
+    uint64_t position = 0;
+};
+
+struct GLReplayState
+{
+    std::unordered_map<uint64_t, GLsync> syncs;   // gravado -> criado no replay
+    std::map<GLenum, void*> mapped;               // alvo -> ponteiro do mapeamento atual
+    GLuint packBuffer = 0;                        // GL_PIXEL_PACK_BUFFER vinculado
+    std::vector<unsigned char> scratch;           // destino dos ponteiros de saída
+    std::vector<uint64_t> outputRaw;              // valores gravados dos ponteiros de saída
+    std::vector<const GLchar*> strings;           // glShaderSource
+    std::vector<GLint> lengths;
+    unsigned long long nameMismatches = 0;
+
+    void* scratchFor(size_t bytes)
+    {
+        if (scratch.size() < bytes) scratch.resize(bytes);
+        return scratch.data();
+    }
+};
+
+enum GLReplayStep
+{
+    GL_REPLAY_CALL,       // chamada executada
+    GL_REPLAY_SKIPPED,    // chamada não suportada ou sem ponteiro no contexto atual
+    GL_REPLAY_FRAME,      // fim de frame (frame recebe o número)
+    GL_REPLAY_END,
+    GL_REPLAY_ERROR,      // arquivo corrompido ou ponto de entrada desconhecido
+};
+
+class GLReplayer
+{
+public:
+    // O contexto precisa estar corrente e os ponteiros carregados
+    explicit GLReplayer(GLCaptureReader& reader, const GLCaptureHeader& header);
+
+    GLReplayStep step(uint32_t& frame);
+
+    // Último ponto de entrada lido (para mensagens e contagem de pulos)
+    const char* lastEntryName() const;
+
+    const GLReplayState& state() const { return replayState; }
+
+private:
+    GLCaptureReader& reader;
+    std::vector<int> translation;   // índice no arquivo -> GLEntryPoint local (-1 = ausente)
+    std::vector<std::string> names;
+    int lastEntry = -1;
+    GLReplayState replayState;
+};
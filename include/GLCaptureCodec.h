@@ -0,0 +1,656 @@
+/*
+ *  Serialização dos argumentos das chamadas OpenGL - uso interno de
+ *  GLTrace.cpp (gravação) e GLCapture.cpp (reprodução)
+ *
+ *  A codificação sai do tipo de cada argumento, lido da assinatura do
+ *  ponteiro glad_glXxx. O que o tipo não diz (quantos bytes um ponteiro
+ *  aponta, saídas a conferir, buffers mapeados) fica nas especializações de
+ *  Special<ponto de entrada> no fim deste arquivo:
+ *
+ *    sizes(s, args...)      tamanho dos dados de cada ponteiro de entrada
+ *                           (PAYLOAD_OFFSET = deslocamento, gravado como número)
+ *    before(w, args...)     dados extras gravados depois dos argumentos
+ *    after(w, [ret,] args...)            dados pós-chamada (saídas a conferir)
+ *    replayBefore(r, s, args&...)        lê os extras; pode trocar argumentos
+ *    replayAfter(r, s, [gravado, ret,] args...)  lê o pós-chamada
+ */
+
+#pragma once
+
+#include <tuple>
+#include <utility>
+#include <type_traits>
+#include <algorithm>
+
+#include "GLCapture.h"
+
+namespace glcapture
+{
+
+const long long PAYLOAD_UNKNOWN = -1;   // ponteiro sem tamanho conhecido: replay pula a chamada
+const long long PAYLOAD_OFFSET = -2;    // deslocamento em buffer vinculado
+
+enum PointerTag : uint8_t
+{
+    TAG_VALUE = 0,         // nullptr, deslocamento ou ponteiro de saída (uint64)
+    TAG_DATA = 1,          // uint64 tamanho + dados alinhados
+    TAG_UNSUPPORTED = 2,   // uint64 valor; o replay não executa a chamada
+};
+
+// Estado acompanhado durante a gravação
+struct CaptureState
+{
+    struct Mapping
+    {
+        void* pointer = nullptr;
+        GLsizeiptr length = 0;
+        bool write = false;
+    };
+
+    GLuint unpackBuffer = 0;
+    GLint unpackAlignment = 4;
+    std::map<GLenum, Mapping> mapped;
+};
+
+CaptureState& captureState();
+
+// Tamanho de um pixel no formato/tipo de uma transferência
+inline size_t glPixelBytes(GLenum format, GLenum type)
+{
+    switch (type)
+    {
+    case GL_UNSIGNED_BYTE_3_3_2: case GL_UNSIGNED_BYTE_2_3_3_REV:
+        return 1;
+    case GL_UNSIGNED_SHORT_5_6_5: case GL_UNSIGNED_SHORT_5_6_5_REV:
+    case GL_UNSIGNED_SHORT_4_4_4_4: case GL_UNSIGNED_SHORT_4_4_4_4_REV:
+    case GL_UNSIGNED_SHORT_5_5_5_1: case GL_UNSIGNED_SHORT_1_5_5_5_REV:
+        return 2;
+    case GL_UNSIGNED_INT_8_8_8_8: case GL_UNSIGNED_INT_8_8_8_8_REV:
+    case GL_UNSIGNED_INT_10_10_10_2: case GL_UNSIGNED_INT_2_10_10_10_REV:
+    case GL_UNSIGNED_INT_24_8: case GL_UNSIGNED_INT_10F_11F_11F_REV: case GL_UNSIGNED_INT_5_9_9_9_REV:
+        return 4;
+    case GL_FLOAT_32_UNSIGNED_INT_24_8_REV:
+        return 8;
+    }
+
+    size_t components = 4;
+    switch (format)
+    {
+    case GL_RED: case GL_GREEN: case GL_BLUE: case GL_ALPHA: case GL_RED_INTEGER:
+    case GL_DEPTH_COMPONENT: case GL_STENCIL_INDEX:
+        components = 1; break;
+    case GL_RG: case GL_RG_INTEGER: case GL_DEPTH_STENCIL:
+        components = 2; break;
+    case GL_RGB: case GL_BGR: case GL_RGB_INTEGER: case GL_BGR_INTEGER:
+        components = 3; break;
+    }
+
+    size_t size = 1;
+    switch (type)
+    {
+    case GL_UNSIGNED_SHORT: case GL_SHORT: case GL_HALF_FLOAT: size = 2; break;
+    case GL_UNSIGNED_INT: case GL_INT: case GL_FLOAT: size = 4; break;
+    }
+    return components * size;
+}
+
+// Bytes lidos de um ponteiro de upload, com o alinhamento de linha atual
+inline long long uploadBytes(GLsizei w, GLsizei h, GLsizei d, GLenum format, GLenum type)
+{
+    const CaptureState& state = captureState();
+    if (state.unpackBuffer) return PAYLOAD_OFFSET;
+    size_t row = (size_t)w * glPixelBytes(format, type);
+    size_t alignment = std::max(1, state.unpackAlignment);
+    size_t stride = (row + alignment - 1) / alignment * alignment;
+    size_t rows = (size_t)h * d;
+    return rows ? (long long)(stride * (rows - 1) + row) : 0;
+}
+
+inline long long compressedBytes(GLsizei size)
+{
+    return captureState().unpackBuffer ? PAYLOAD_OFFSET : size;
+}
+
+template <int Id>
+struct Special
+{
+    template <typename... A> static void sizes(long long*, const A&...) {}
+    template <typename... A> static void before(GLCaptureWriter&, const A&...) {}
+    template <typename... A> static void after(GLCaptureWriter&, const A&...) {}
+    template <typename... A> static void replayBefore(GLCaptureReader&, GLReplayState&, A&...) {}
+    template <typename... A> static void replayAfter(GLCaptureReader&, GLReplayState&, const A&...) {}
+};
+
+// --- Argumentos -------------------------------------------------------------
+
+template <typename T>
+void encodeArg(GLCaptureWriter& w, const T& value, long long payload)
+{
+    if constexpr (std::is_same<T, GLsync>::value)
+    {
+        w.put<uint64_t>((uint64_t)(uintptr_t)value);
+    }
+    else if constexpr (std::is_same<T, const GLchar*>::value)
+    {
+        // Nomes de uniforms/atributos: cadeia terminada em zero
+        if (!value)
+        {
+            w.put<uint8_t>(TAG_VALUE);
+            w.put<uint64_t>(0);
+            return;
+        }
+        uint64_t length = strlen(value) + 1;
+        w.put<uint8_t>(TAG_DATA);
+        w.put<uint64_t>(length);
+        w.align();
+        w.put(value, length);
+    }
+    else if constexpr (std::is_pointer<T>::value)
+    {
+        typedef typename std::remove_pointer<T>::type Pointee;
+        constexpr bool input = std::is_const<Pointee>::value;
+        if (std::is_function<Pointee>::value)
+        {
+            // Callbacks (glDebugMessageCallback) não fazem sentido em outro processo
+            w.put<uint8_t>(TAG_UNSUPPORTED);
+            w.put<uint64_t>(0);
+            return;
+        }
+        if (input && value && payload >= 0)
+        {
+            w.put<uint8_t>(TAG_DATA);
+            w.put<uint64_t>((uint64_t)payload);
+            w.align();
+            w.put((const void*)value, (size_t)payload);
+            return;
+        }
+        w.put<uint8_t>(input && value && payload == PAYLOAD_UNKNOWN ? TAG_UNSUPPORTED : TAG_VALUE);
+        w.put<uint64_t>((uint64_t)(uintptr_t)value);
+    }
+    else
+    {
+        w.put(value);
+    }
+}
+
+template <typename T>
+T decodeArg(GLCaptureReader& r, GLReplayState& s, bool& unsupported)
+{
+    if constexpr (std::is_same<T, GLsync>::value)
+    {
+        auto it = s.syncs.find(r.get<uint64_t>());
+        return it == s.syncs.end() ? nullptr : it->second;
+    }
+    else if constexpr (std::is_pointer<T>::value)
+    {
+        uint8_t tag = r.get<uint8_t>();
+        uint64_t value = r.get<uint64_t>();
+        if (tag == TAG_DATA)
+            return (T)r.payload(value);
+        if (tag == TAG_UNSUPPORTED)
+        {
+            unsupported = true;
+            return nullptr;
+        }
+        if constexpr (std::is_const<typename std::remove_pointer<T>::type>::value)
+        {
+            return (T)(uintptr_t)value;
+        }
+        else
+        {
+            // Até 4 ponteiros de saída por chamada (glGetActiveUniform), 1 MB cada
+            size_t slot = s.outputRaw.size() % 4;
+            s.outputRaw.push_back(value);
+            return (T)((unsigned char*)s.scratchFor(4 << 20) + (slot << 20));
+        }
+    }
+    else
+    {
+        return r.get<T>();
+    }
+}
+
+// Retornos: ponteiros (GLsync, glMapBuffer) como uint64
+template <typename R>
+using Recorded = typename std::conditional<std::is_pointer<R>::value, uint64_t, R>::type;
+
+template <typename R>
+Recorded<R> recordedValue(R value)
+{
+    if constexpr (std::is_pointer<R>::value) return (uint64_t)(uintptr_t)value;
+    else return value;
+}
+
+// --- Gravação -----------------------------------------------------------------
+
+template <int Id, typename... Args>
+struct Recorder
+{
+    static void before(Args... args)
+    {
+        GLCaptureWriter& w = glCaptureWriter();
+        w.put<uint16_t>((uint16_t)Id);
+        long long sizes[sizeof...(Args) + 1];
+        std::fill(sizes, sizes + sizeof...(Args) + 1, PAYLOAD_UNKNOWN);
+        Special<Id>::sizes(sizes, args...);
+        size_t i = 0;
+        (void)i;
+        (encodeArg(w, args, sizes[i++]), ...);
+        Special<Id>::before(w, args...);
+    }
+
+    static void after(Args... args)
+    {
+        GLCaptureWriter& w = glCaptureWriter();
+        size_t at = w.reserve();
+        Special<Id>::after(w, args...);
+        w.patch(at, (uint32_t)w.sizeSince(at));
+    }
+
+    template <typename R>
+    static void afterReturn(R result, Args... args)
+    {
+        GLCaptureWriter& w = glCaptureWriter();
+        size_t at = w.reserve();
+        w.put(recordedValue(result));
+        Special<Id>::after(w, result, args...);
+        w.patch(at, (uint32_t)w.sizeSince(at));
+    }
+};
+
+// --- Reprodução -------------------------------------------------------------
+
+template <int Id, typename F>
+struct Replay;
+
+template <int Id, typename R, typename... Args>
+struct Replay<Id, R (APIENTRYP)(Args...)>
+{
+    typedef R (APIENTRYP Function)(Args...);
+
+    static GLReplayStep run(GLCaptureReader& r, GLReplayState& s, Function fn)
+    {
+        bool unsupported = false;
+        s.outputRaw.clear();
+        std::tuple<Args...> args{ decodeArg<Args>(r, s, unsupported)... };
+        std::apply([&](Args&... a) { Special<Id>::replayBefore(r, s, a...); }, args);
+
+        uint32_t afterSize = r.get<uint32_t>();
+        if (unsupported || !fn)
+        {
+            r.skip(afterSize);
+            return GL_REPLAY_SKIPPED;
+        }
+
+        if constexpr (std::is_void<R>::value)
+        {
+            std::apply(fn, args);
+            std::apply([&](Args&... a) { Special<Id>::replayAfter(r, s, a...); }, args);
+        }
+        else
+        {
+            R result = std::apply(fn, args);
+            Recorded<R> recorded = r.get<Recorded<R>>();
+            std::apply([&](Args&... a) { Special<Id>::replayAfter(r, s, recorded, result, a...); }, args);
+        }
+        return GL_REPLAY_CALL;
+    }
+};
+
+// --- Especializações ----------------------------------------------------------
+
+// Recebe o identificador já montado: glXxx é macro da GLAD e seria expandido
+// ao passar por uma segunda macro
+#define CG_CAPTURE_SPECIAL(entry, ...)                                                    \
+    template <> struct Special<entry> : Special<-1>                                       \
+    {                                                                                     \
+        template <typename... A> static void sizes(long long* s, const A&... a)           \
+        {                                                                                 \
+            auto args = std::forward_as_tuple(a...);                                      \
+            (void)args;                                                                   \
+            __VA_ARGS__;                                                                  \
+        }                                                                                 \
+    };
+
+#define CG_CAPTURE_SIZES(name, ...) CG_CAPTURE_SPECIAL(GL_ENTRY_##name, __VA_ARGS__)
+#define ARG(i) std::get<i>(args)
+
+// Dados por tamanho explícito
+CG_CAPTURE_SIZES(glBufferData, s[2] = ARG(1))
+CG_CAPTURE_SIZES(glBufferSubData, s[3] = ARG(2))
+
+// Imagens (deslocamento se houver GL_PIXEL_UNPACK_BUFFER vinculado)
+CG_CAPTURE_SIZES(glTexImage1D, s[7] = uploadBytes(ARG(3), 1, 1, ARG(5), ARG(6)))
+CG_CAPTURE_SIZES(glTexImage2D, s[8] = uploadBytes(ARG(3), ARG(4), 1, ARG(6), ARG(7)))
+CG_CAPTURE_SIZES(glTexImage3D, s[9] = uploadBytes(ARG(3), ARG(4), ARG(5), ARG(7), ARG(8)))
+CG_CAPTURE_SIZES(glTexSubImage1D, s[6] = uploadBytes(ARG(3), 1, 1, ARG(4), ARG(5)))
+CG_CAPTURE_SIZES(glTexSubImage2D, s[8] = uploadBytes(ARG(4), ARG(5), 1, ARG(6), ARG(7)))
+CG_CAPTURE_SIZES(glTexSubImage3D, s[10] = uploadBytes(ARG(5), ARG(6), ARG(7), ARG(8), ARG(9)))
+CG_CAPTURE_SIZES(glCompressedTexImage1D, s[6] = compressedBytes(ARG(5)))
+CG_CAPTURE_SIZES(glCompressedTexImage2D, s[7] = compressedBytes(ARG(6)))
+CG_CAPTURE_SIZES(glCompressedTexImage3D, s[8] = compressedBytes(ARG(7)))
+CG_CAPTURE_SIZES(glCompressedTexSubImage1D, s[6] = compressedBytes(ARG(5)))
+CG_CAPTURE_SIZES(glCompressedTexSubImage2D, s[8] = compressedBytes(ARG(7)))
+CG_CAPTURE_SIZES(glCompressedTexSubImage3D, s[10] = compressedBytes(ARG(9)))
+
+// Uniforms: count elementos de N componentes
+#define CG_CAPTURE_UNIFORM(name, components, type) \
+    CG_CAPTURE_SPECIAL(GL_ENTRY_##name, s[2] = (long long)ARG(1) * (components) * sizeof(type))
+#define CG_CAPTURE_UNIFORM_MATRIX(name, components, type) \
+    CG_CAPTURE_SPECIAL(GL_ENTRY_##name, s[3] = (long long)ARG(1) * (components) * sizeof(type))
+
+CG_CAPTURE_UNIFORM(glUniform1fv, 1, GLfloat)
+CG_CAPTURE_UNIFORM(glUniform2fv, 2, GLfloat)
+CG_CAPTURE_UNIFORM(glUniform3fv, 3, GLfloat)
+CG_CAPTURE_UNIFORM(glUniform4fv, 4, GLfloat)
+CG_CAPTURE_UNIFORM(glUniform1iv, 1, GLint)
+CG_CAPTURE_UNIFORM(glUniform2iv, 2, GLint)
+CG_CAPTURE_UNIFORM(glUniform3iv, 3, GLint)
+CG_CAPTURE_UNIFORM(glUniform4iv, 4, GLint)
+CG_CAPTURE_UNIFORM(glUniform1uiv, 1, GLuint)
+CG_CAPTURE_UNIFORM(glUniform2uiv, 2, GLuint)
+CG_CAPTURE_UNIFORM(glUniform3uiv, 3, GLuint)
+CG_CAPTURE_UNIFORM(glUniform4uiv, 4, GLuint)
+CG_CAPTURE_UNIFORM(glUniform1dv, 1, GLdouble)
+CG_CAPTURE_UNIFORM(glUniform2dv, 2, GLdouble)
+CG_CAPTURE_UNIFORM(glUniform3dv, 3, GLdouble)
+CG_CAPTURE_UNIFORM(glUniform4dv, 4, GLdouble)
+CG_CAPTURE_UNIFORM_MATRIX(glUniformMatrix2fv, 4, GLfloat)
+CG_CAPTURE_UNIFORM_MATRIX(glUniformMatrix3fv, 9, GLfloat)
+CG_CAPTURE_UNIFORM_MATRIX(glUniformMatrix4fv, 16, GLfloat)
+CG_CAPTURE_UNIFORM_MATRIX(glUniformMatrix2x3fv, 6, GLfloat)
+CG_CAPTURE_UNIFORM_MATRIX(glUniformMatrix3x2fv, 6, GLfloat)
+CG_CAPTURE_UNIFORM_MATRIX(glUniformMatrix2x4fv, 8, GLfloat)
+CG_CAPTURE_UNIFORM_MATRIX(glUniformMatrix4x2fv, 8, GLfloat)
+CG_CAPTURE_UNIFORM_MATRIX(glUniformMatrix3x4fv, 12, GLfloat)
+CG_CAPTURE_UNIFORM_MATRIX(glUniformMatrix4x3fv, 12, GLfloat)
+CG_CAPTURE_UNIFORM_MATRIX(glUniformMatrix2dv, 4, GLdouble)
+CG_CAPTURE_UNIFORM_MATRIX(glUniformMatrix3dv, 9, GLdouble)
+CG_CAPTURE_UNIFORM_MATRIX(glUniformMatrix4dv, 16, GLdouble)
+
+// Listas de nomes/enums
+CG_CAPTURE_SIZES(glDeleteBuffers, s[1] = (long long)ARG(0) * sizeof(GLuint))
+CG_CAPTURE_SIZES(glDeleteTextures, s[1] = (long long)ARG(0) * sizeof(GLuint))
+CG_CAPTURE_SIZES(glDeleteVertexArrays, s[1] = (long long)ARG(0) * sizeof(GLuint))
+CG_CAPTURE_SIZES(glDeleteFramebuffers, s[1] = (long long)ARG(0) * sizeof(GLuint))
+CG_CAPTURE_SIZES(glDeleteRenderbuffers, s[1] = (long long)ARG(0) * sizeof(GLuint))
+CG_CAPTURE_SIZES(glDeleteSamplers, s[1] = (long long)ARG(0) * sizeof(GLuint))
+CG_CAPTURE_SIZES(glDeleteQueries, s[1] = (long long)ARG(0) * sizeof(GLuint))
+CG_CAPTURE_SIZES(glDeleteTransformFeedbacks, s[1] = (long long)ARG(0) * sizeof(GLuint))
+CG_CAPTURE_SIZES(glDrawBuffers, s[1] = (long long)ARG(0) * sizeof(GLenum))
+
+// Parâmetros vetoriais: cor de borda e swizzle têm 4 valores, o resto 1
+#define CG_CAPTURE_PARAMETER(name, type)                                                  \
+    CG_CAPTURE_SPECIAL(GL_ENTRY_##name, s[2] = (ARG(1) == GL_TEXTURE_BORDER_COLOR ||       \
+                                                ARG(1) == GL_TEXTURE_SWIZZLE_RGBA ? 4 : 1) * sizeof(type))
+CG_CAPTURE_PARAMETER(glTexParameterfv, GLfloat)
+CG_CAPTURE_PARAMETER(glTexParameteriv, GLint)
+CG_CAPTURE_PARAMETER(glTexParameterIiv, GLint)
+CG_CAPTURE_PARAMETER(glTexParameterIuiv, GLuint)
+CG_CAPTURE_PARAMETER(glSamplerParameterfv, GLfloat)
+CG_CAPTURE_PARAMETER(glSamplerParameteriv, GLint)
+CG_CAPTURE_PARAMETER(glSamplerParameterIiv, GLint)
+CG_CAPTURE_PARAMETER(glSamplerParameterIuiv, GLuint)
+
+#define CG_CAPTURE_CLEAR(name, type) \
+    CG_CAPTURE_SPECIAL(GL_ENTRY_##name, s[2] = (ARG(0) == GL_COLOR ? 4 : 1) * sizeof(type))
+CG_CAPTURE_CLEAR(glClearBufferfv, GLfloat)
+CG_CAPTURE_CLEAR(glClearBufferiv, GLint)
+CG_CAPTURE_CLEAR(glClearBufferuiv, GLuint)
+
+// Deslocamentos em buffers vinculados
+CG_CAPTURE_SIZES(glVertexAttribPointer, s[5] = PAYLOAD_OFFSET)
+CG_CAPTURE_SIZES(glVertexAttribIPointer, s[4] = PAYLOAD_OFFSET)
+CG_CAPTURE_SIZES(glDrawElements, s[3] = PAYLOAD_OFFSET)
+CG_CAPTURE_SIZES(glDrawElementsInstanced, s[3] = PAYLOAD_OFFSET)
+CG_CAPTURE_SIZES(glDrawElementsBaseVertex, s[3] = PAYLOAD_OFFSET)
+CG_CAPTURE_SIZES(glDrawElementsInstancedBaseVertex, s[3] = PAYLOAD_OFFSET)
+CG_CAPTURE_SIZES(glDrawRangeElements, s[5] = PAYLOAD_OFFSET)
+CG_CAPTURE_SIZES(glDrawRangeElementsBaseVertex, s[5] = PAYLOAD_OFFSET)
+CG_CAPTURE_SIZES(glDrawArraysIndirect, s[1] = PAYLOAD_OFFSET)
+CG_CAPTURE_SIZES(glDrawElementsIndirect, s[2] = PAYLOAD_OFFSET)
+CG_CAPTURE_SIZES(glMultiDrawArrays, s[1] = s[2] = (long long)ARG(3) * sizeof(GLint))
+CG_CAPTURE_SIZES(glMultiDrawElements, s[1] = (long long)ARG(4) * sizeof(GLsizei);
+                 s[3] = (long long)ARG(4) * sizeof(void*))
+CG_CAPTURE_SIZES(glMultiDrawElementsBaseVertex, s[1] = s[5] = (long long)ARG(4) * sizeof(GLsizei);
+                 s[3] = (long long)ARG(4) * sizeof(void*))
+
+// Fontes: as cadeias vão nos extras; o replay passa as suas
+template <> struct Special<GL_ENTRY_glShaderSource> : Special<-1>
+{
+    static void sizes(long long* s, GLuint, GLsizei, const GLchar* const*, const GLint*)
+    {
+        s[2] = s[3] = PAYLOAD_OFFSET;
+    }
+    static void before(GLCaptureWriter& w, GLuint, GLsizei count, const GLchar* const* strings, const GLint* lengths)
+    {
+        for (GLsizei i = 0; i < count; i++)
+        {
+            uint64_t length = lengths && lengths[i] >= 0 ? (uint64_t)lengths[i] : strlen(strings[i]);
+            w.put(length);
+            w.align();
+            w.put(strings[i], length);
+        }
+    }
+    static void replayBefore(GLCaptureReader& r, GLReplayState& s, GLuint&, GLsizei& count,
+                             const GLchar* const*& strings, const GLint*& lengths)
+    {
+        s.strings.clear();
+        s.lengths.clear();
+        for (GLsizei i = 0; i < count; i++)
+        {
+            uint64_t length = r.get<uint64_t>();
+            s.strings.push_back((const GLchar*)r.payload(length));
+            s.lengths.push_back((GLint)length);
+        }
+        strings = s.strings.data();
+        lengths = s.lengths.data();
+    }
+};
+
+// glGen*/glCreate*: os nomes devolvidos são conferidos no replay
+template <int NamesArg, int CountArg>
+struct GeneratedNames : Special<-1>
+{
+    template <typename... A>
+    static void after(GLCaptureWriter& w, const A&... a)
+    {
+        auto args = std::forward_as_tuple(a...);
+        w.put(std::get<NamesArg>(args), std::get<CountArg>(args) * sizeof(GLuint));
+    }
+    template <typename... A>
+    static void replayAfter(GLCaptureReader& r, GLReplayState& s, const A&... a)
+    {
+        auto args = std::forward_as_tuple(a...);
+        const GLuint* names = std::get<NamesArg>(args);
+        for (GLsizei i = 0; i < std::get<CountArg>(args); i++)
+            if (r.get<GLuint>() != names[i]) s.nameMismatches++;
+    }
+};
+
+template <> struct Special<GL_ENTRY_glGenBuffers> : GeneratedNames<1, 0> {};
+template <> struct Special<GL_ENTRY_glGenTextures> : GeneratedNames<1, 0> {};
+template <> struct Special<GL_ENTRY_glGenVertexArrays> : GeneratedNames<1, 0> {};
+template <> struct Special<GL_ENTRY_glGenFramebuffers> : GeneratedNames<1, 0> {};
+template <> struct Special<GL_ENTRY_glGenRenderbuffers> : GeneratedNames<1, 0> {};
+template <> struct Special<GL_ENTRY_glGenSamplers> : GeneratedNames<1, 0> {};
+template <> struct Special<GL_ENTRY_glGenQueries> : GeneratedNames<1, 0> {};
+template <> struct Special<GL_ENTRY_glGenTransformFeedbacks> : GeneratedNames<1, 0> {};
+
+// Retornos que o código usa depois como nome/location
+struct ComparedReturn : Special<-1>
+{
+    template <typename R, typename... A>
+    static void replayAfter(GLCaptureReader&, GLReplayState& s, const R& recorded, const R& result, const A&...)
+    {
+        if (recorded != result) s.nameMismatches++;
+    }
+};
+
+template <> struct Special<GL_ENTRY_glCreateProgram> : ComparedReturn {};
+template <> struct Special<GL_ENTRY_glCreateShader> : ComparedReturn {};
+template <> struct Special<GL_ENTRY_glGetUniformLocation> : ComparedReturn {};
+template <> struct Special<GL_ENTRY_glGetAttribLocation> : ComparedReturn {};
+template <> struct Special<GL_ENTRY_glGetUniformBlockIndex> : ComparedReturn {};
+
+template <> struct Special<GL_ENTRY_glFenceSync> : Special<-1>
+{
+    static void replayAfter(GLCaptureReader&, GLReplayState& s, uint64_t recorded, GLsync result, GLenum, GLbitfield)
+    {
+        s.syncs[recorded] = result;
+    }
+};
+
+// Vínculos que mudam o significado dos ponteiros de imagem
+template <> struct Special<GL_ENTRY_glBindBuffer> : Special<-1>
+{
+    static void before(GLCaptureWriter&, GLenum target, GLuint buffer)
+    {
+        if (target == GL_PIXEL_UNPACK_BUFFER) captureState().unpackBuffer = buffer;
+    }
+    static void replayBefore(GLCaptureReader&, GLReplayState& s, GLenum& target, GLuint& buffer)
+    {
+        if (target == GL_PIXEL_PACK_BUFFER) s.packBuffer = buffer;
+    }
+};
+
+template <> struct Special<GL_ENTRY_glPixelStorei> : Special<-1>
+{
+    static void before(GLCaptureWriter&, GLenum pname, GLint param)
+    {
+        if (pname == GL_UNPACK_ALIGNMENT) captureState().unpackAlignment = param;
+    }
+};
+
+// Leituras: com GL_PIXEL_PACK_BUFFER o ponteiro é um deslocamento; sem ele,
+// memória própria do tamanho da imagem
+template <> struct Special<GL_ENTRY_glReadPixels> : Special<-1>
+{
+    static void replayBefore(GLCaptureReader&, GLReplayState& s, GLint&, GLint&, GLsizei& w, GLsizei& h,
+                             GLenum& format, GLenum& type, void*& pixels)
+    {
+        if (s.packBuffer) pixels = (void*)(uintptr_t)s.outputRaw[0];
+        else pixels = s.scratchFor((size_t)w * h * glPixelBytes(format, type) + 4 * (size_t)h);
+    }
+};
+
+template <> struct Special<GL_ENTRY_glGetTexImage> : Special<-1>
+{
+    static void replayBefore(GLCaptureReader&, GLReplayState& s, GLenum& target, GLint& level,
+                             GLenum& format, GLenum& type, void*& pixels)
+    {
+        if (s.packBuffer)
+        {
+            pixels = (void*)(uintptr_t)s.outputRaw[0];
+            return;
+        }
+        GLint w = 1, h = 1, d = 1;
+        glGetTexLevelParameteriv(target, level, GL_TEXTURE_WIDTH, &w);
+        glGetTexLevelParameteriv(target, level, GL_TEXTURE_HEIGHT, &h);
+        glGetTexLevelParameteriv(target, level, GL_TEXTURE_DEPTH, &d);
+        pixels = s.scratchFor((size_t)w * h * d * glPixelBytes(format, type) + 4 * (size_t)h * d);
+    }
+};
+
+template <> struct Special<GL_ENTRY_glGetBufferSubData> : Special<-1>
+{
+    static void replayBefore(GLCaptureReader&, GLReplayState& s, GLenum&, GLintptr&, GLsizeiptr& size, void*& data)
+    {
+        data = s.scratchFor((size_t)size);
+    }
+};
+
+// Buffers mapeados: o conteúdo escrito vai no glUnmapBuffer
+template <> struct Special<GL_ENTRY_glMapBuffer> : Special<-1>
+{
+    static void after(GLCaptureWriter&, void* pointer, GLenum target, GLenum access)
+    {
+        GLint size = 0;
+        glCaptureActive = false;   // consulta do próprio gravador, fora do arquivo
+        glGetBufferParameteriv(target, GL_BUFFER_SIZE, &size);
+        glCaptureActive = true;
+        captureState().mapped[target] = { pointer, size, access != GL_READ_ONLY };
+    }
+    static void replayAfter(GLCaptureReader&, GLReplayState& s, uint64_t, void* result, GLenum target, GLenum)
+    {
+        s.mapped[target] = result;
+    }
+};
+
+template <> struct Special<GL_ENTRY_glMapBufferRange> : Special<-1>
+{
+    static void after(GLCaptureWriter&, void* pointer, GLenum target, GLintptr, GLsizeiptr length, GLbitfield access)
+    {
+        captureState().mapped[target] = { pointer, length, (access & GL_MAP_WRITE_BIT) != 0 };
+    }
+    static void replayAfter(GLCaptureReader&, GLReplayState& s, uint64_t, void* result, GLenum target,
+                            GLintptr, GLsizeiptr, GLbitfield)
+    {
+        s.mapped[target] = result;
+    }
+};
+
+template <> struct Special<GL_ENTRY_glUnmapBuffer> : Special<-1>
+{
+    static void before(GLCaptureWriter& w, GLenum target)
+    {
+        auto it = captureState().mapped.find(target);
+        bool data = it != captureState().mapped.end() && it->second.write && it->second.pointer;
+        w.put<uint8_t>(data ? 1 : 0);
+        if (data)
+        {
+            w.put<uint64_t>((uint64_t)it->second.length);
+            w.align();
+            w.put(it->second.pointer, (size_t)it->second.length);
+        }
+        if (it != captureState().mapped.end())
+            captureState().mapped.erase(it);
+    }
+    static void replayBefore(GLCaptureReader& r, GLReplayState& s, GLenum& target)
+    {
+        if (r.get<uint8_t>())
+        {
+            uint64_t length = r.get<uint64_t>();
+            const void* data = r.payload(length);
+            auto it = s.mapped.find(target);
+            if (it != s.mapped.end() && it->second && data)
+                memcpy(it->second, data, (size_t)length);
+        }
+        s.mapped.erase(target);
+    }
+};
+
+// Pontos de entrada carregados por GLExtensions.h
+#ifdef CG_GLEXT_VERSION_4_1
+CG_CAPTURE_SIZES(glProgramBinary, s[2] = ARG(3))
+#endif
+#ifdef CG_GLEXT_VERSION_4_3
+CG_CAPTURE_SIZES(glMultiDrawElementsIndirect, s[2] = PAYLOAD_OFFSET)
+CG_CAPTURE_SIZES(glDrawElementsInstancedBaseVertexBaseInstance, s[3] = PAYLOAD_OFFSET)
+#endif
+#ifdef CG_GLEXT_VERSION_4_4
+CG_CAPTURE_SIZES(glBindTextures, s[2] = (long long)ARG(1) * sizeof(GLuint))
+CG_CAPTURE_SIZES(glBindSamplers, s[2] = (long long)ARG(1) * sizeof(GLuint))
+CG_CAPTURE_SIZES(glBindBuffersRange, s[3] = (long long)ARG(2) * sizeof(GLuint);
+                 s[4] = (long long)ARG(2) * sizeof(GLintptr);
+                 s[5] = (long long)ARG(2) * sizeof(GLsizeiptr))
+CG_CAPTURE_SIZES(glBufferStorage, s[2] = ARG(1))
+#endif
+#ifdef CG_GLEXT_VERSION_4_5
+CG_CAPTURE_SIZES(glTextureSubImage2D, s[8] = uploadBytes(ARG(4), ARG(5), 1, ARG(6), ARG(7)))
+template <> struct Special<GL_ENTRY_glCreateTextures> : GeneratedNames<2, 1> {};
+template <> struct Special<GL_ENTRY_glCreateSamplers> : GeneratedNames<1, 0> {};
+#endif
+#ifdef CG_GLEXT_KHR_debug
+CG_CAPTURE_SIZES(glDebugMessageControl, s[4] = (long long)ARG(3) * sizeof(GLuint))
+#endif
+
+#undef ARG
+#undef CG_CAPTURE_CLEAR
+#undef CG_CAPTURE_PARAMETER
+#undef CG_CAPTURE_UNIFORM_MATRIX
+#undef CG_CAPTURE_UNIFORM
+#undef CG_CAPTURE_SIZES
+#undef CG_CAPTURE_SPECIAL
+
+} // namespace glcapture
@@ -0,0 +1,67 @@
+/*
+ *  Mensagens do driver (KHR_debug): erros e avisos de desempenho por frame
+ *
+ *  Os logs de compilação só mostram erros de shader; os avisos do próprio
+ *  driver (buffer em uso causando espera, shader recompilado por mudança de
+ *  estado, leitura síncrona da GPU...) só chegam pelo callback do KHR_debug.
+ *  installGLDebug() liga GL_DEBUG_OUTPUT em modo síncrono (a mensagem chega
+ *  dentro da chamada que a causou) e agrupa as mensagens por frame.
+ *
+ *  Cada mensagem é associada aos objetos ativos no momento - programa, VAO
+ *  e texturas vinculados segundo o cache de GLState.h - pelos rótulos dados
+ *  com labelGLObject() (que também chama glObjectLabel, para os rótulos
+ *  aparecerem no RenderDoc/Nsight). Objetos sem rótulo ficam de fora.
+ *
+ *  Saída:
+ *  - gl_debug.jsonl (ou CG_GL_DEBUG_LOG): uma linha JSON por mensagem
+ *    distinta por frame, com contagem, ordenada para dar para comparar
+ *    (diff) os logs de duas versões do programa;
+ *  - erros e a primeira ocorrência de cada aviso de desempenho no console;
+ *  - um resumo por mensagem ao sair do programa.
+ *  Notificações (GL_DEBUG_SEVERITY_NOTIFICATION) são desligadas.
+ *
+ *  É opcional, como GLTrace.h: loadGLExtensions chama installGLDebug() só
+ *  com CG_GL_DEBUG definida (e diferente de "0"). Alguns drivers só mandam
+ *  mensagens num contexto de depuração, pedido antes de criar a janela:
+ *
+ *  if (glDebugRequested()) glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GLFW_TRUE);
+ *  GLFWwindow* window = glfwCreateWindow(...);
+ *  ...
+ *  labelGLObject(GL_VERTEX_ARRAY, VAO, "cubo");
+ *  ...
+ *  glTraceEndFrame();   // fecha também o frame das mensagens
+ */
+
+#pragma once
+
+#include <string>
+#include <iostream>
+
+#include <glad/glad.h>
+
+#include "GLExtensions.h"
+
+// CG_GL_DEBUG definida e diferente de "0"
+bool glDebugRequested();
+
+// Liga o callback; false sem KHR_debug. Chamada por loadGLExtensions.
+bool installGLDebug();
+bool glDebugInstalled();
+
+// Rótulo de um objeto (GL_TEXTURE, GL_PROGRAM, GL_VERTEX_ARRAY, GL_BUFFER...).
+// O objeto já deve existir: nomes de glGen* só viram objeto no primeiro bind.
+void labelGLObject(GLenum identifier, GLuint name, const std::string& label);
+
+// Rótulo guardado, ou nullptr
+const char* glObjectLabelOf(GLenum identifier, GLuint name);
+
+// Chamar antes de glDelete*: a GL reusa os nomes (programas recarregados,
+// texturas despejadas) e o objeto novo herdaria o rótulo do antigo
+void forgetGLObjectLabel(GLenum identifier, GLuint name);
+
+// Fecha o frame das mensagens (chamado por glTraceEndFrame)
+void glDebugEndFrame();
+
+// Mensagens do último frame fechado, por tipo
+void glDebugPrintFrame();
+void glDebugReport(std::ostream& out);
@@ -0,0 +1,214 @@
+/*
+ *  Cache do estado OpenGL e objetos de pipeline
+ *
+ *  O driver não sabe que um glUseProgram, glBindVertexArray ou glBindTexture
+ *  repete o que já está vinculado: cada chamada passa pela validação mesmo
+ *  sem mudar nada. glState() guarda uma cópia do que foi vinculado por meio
+ *  dele (programa, VAO, texturas e samplers por unidade, buffers genéricos e
+ *  indexados, depth, blend e rasterização) e só repassa ao driver o que
+ *  muda. Estado desconhecido (início ou depois de invalidate) sempre é
+ *  enviado.
+ *
+ *  Um PipelineState é imutável: junta programa, formato de vértice (o VAO) e
+ *  os estados de rasterização, depth e blend, e é aplicado de uma vez com
+ *  bindPipeline. Recursos em unidades/bindings consecutivos vão em lote:
+ *  bindTextures usa glBindTextures + glBindSamplers e bindBuffersRange usa
+ *  glBindBuffersRange (OpenGL 4.4), só para a faixa que mudou.
+ *
+ *  Regras para o cache não ficar desatualizado:
+ *  - Todo código que roda entre os desenhos vincula por aqui. Vínculos
+ *    feitos direto na GL (inicialização, por exemplo) devem ser seguidos de
+ *    glState().invalidate().
+ *  - Código sem DSA que vincula uma textura para editá-la usa a unidade
+ *    ativa, que fica sempre na 0: depois chama invalidateTextureUnit(0).
+ *  - Antes de apagar uma textura, buffer ou VAO, chame forgetTexture /
+ *    forgetBuffer / forgetVertexArray (o nome pode ser reaproveitado pela
+ *    GL e o cache acharia que o objeto novo já está vinculado).
+ *  - Um contexto só: o cache é do processo, não de cada contexto.
+ *
+ *  Cada pedido conta em stats(); endFrame() fecha o frame e printStats()
+ *  mostra quantas chamadas foram eliminadas.
+ *
+ *  Forma de uso
+ *  ------------
+ *  PipelineDesc desc;
+ *  desc.program = program;
+ *  desc.vertexArray = VAO;
+ *  desc.depth.test = true;
+ *  PipelineState pipeline(desc);
+ *  ...
+ *  // no loop:
+ *  glState().bindPipeline(pipeline);
+ *  glState().bindTextures(0, 2, textures, samplers);
+ *  glDrawArrays(...);
+ *  glState().endFrame();
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <map>
+
+#include <glad/glad.h>
+
+struct DepthState
+{
+    bool test = true;
+    bool write = true;
+    GLenum func = GL_LESS;
+
+    bool operator==(const DepthState& o) const { return test == o.test && write == o.write && func == o.func; }
+};
+
+struct BlendState
+{
+    bool enabled = false;
+    GLenum srcFactor = GL_SRC_ALPHA;
+    GLenum dstFactor = GL_ONE_MINUS_SRC_ALPHA;
+
+    bool operator==(const BlendState& o) const
+    {
+        return enabled == o.enabled && srcFactor == o.srcFactor && dstFactor == o.dstFactor;
+    }
+};
+
+struct RasterState
+{
+    bool cullFace = false;
+    GLenum cullMode = GL_BACK;
+    GLenum frontFace = GL_CCW;
+    GLenum polygonMode = GL_FILL;
+
+    bool operator==(const RasterState& o) const
+    {
+        return cullFace == o.cullFace && cullMode == o.cullMode &&
+               frontFace == o.frontFace && polygonMode == o.polygonMode;
+    }
+};
+
+struct PipelineDesc
+{
+    GLuint program = 0;
+    GLuint vertexArray = 0;   // formato de vértice e buffers
+    RasterState raster;
+    DepthState depth;
+    BlendState blend;
+};
+
+class PipelineState
+{
+public:
+    explicit PipelineState(const PipelineDesc& desc) : desc(desc) {}
+
+    // Mesmo pipeline com outro programa (variantes, shader recarregado)
+    PipelineState withProgram(GLuint program) const
+    {
+        PipelineDesc d = desc;
+        d.program = program;
+        return PipelineState(d);
+    }
+
+    const PipelineDesc& description() const { return desc; }
+    GLuint program() const { return desc.program; }
+
+private:
+    PipelineDesc desc;
+};
+
+struct GLStateStats
+{
+    unsigned long long requested = 0;   // pedidos feitos ao cache
+    unsigned long long issued = 0;      // chamadas que chegaram à GL
+
+    unsigned long long eliminated() const { return requested - issued; }
+};
+
+class GLStateCache
+{
+public:
+    GLStateCache();
+
+    GLStateCache(const GLStateCache&) = delete;
+    GLStateCache& operator=(const GLStateCache&) = delete;
+
+    void useProgram(GLuint program);
+    void bindVertexArray(GLuint vertexArray);
+    void setDepth(const DepthState& depth);
+    void setBlend(const BlendState& blend);
+    void setRaster(const RasterState& raster);
+    void bindPipeline(const PipelineState& pipeline);
+
+    // target só é usado sem OpenGL 4.5 (glBindTextureUnit serve para qualquer tipo)
+    void bindTexture(GLuint unit, GLuint texture, GLenum target = GL_TEXTURE_2D);
+    void bindSampler(GLuint unit, GLuint sampler);
+
+    // Unidades first .. first+count-1; samplers pode ser nullptr
+    void bindTextures(GLuint first, GLsizei count, const GLuint* textures, const GLuint* samplers);
+
+    // GL_ELEMENT_ARRAY_BUFFER é estado do VAO: sempre repassado
+    void bindBuffer(GLenum target, GLuint buffer);
+    void bindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size);
+    void bindBuffersRange(GLenum target, GLuint first, GLsizei count, const GLuint* buffers,
+                          const GLintptr* offsets, const GLsizeiptr* sizes);
+
+    // Chamar antes do glDelete* correspondente
+    void forgetTexture(GLuint texture);
+    void forgetBuffer(GLuint buffer);
+    void forgetVertexArray(GLuint vertexArray);
+
+    // Esquece o estado (vínculos feitos sem passar pelo cache)
+    void invalidate();
+    void invalidateTextureUnit(GLuint unit);
+
+    // Vínculos conhecidos pelo cache (~0u = desconhecido), sem consultar o driver
+    GLuint boundProgram() const { return program; }
+    GLuint boundVertexArray() const { return vertexArray; }
+    size_t textureUnits() const { return textures.size(); }
+    GLuint boundTexture(GLuint unit) const { return unit < textures.size() ? textures[unit] : ~0u; }
+
+    // Contagem do frame atual; endFrame guarda em lastFrame() e zera
+    const GLStateStats& stats() const { return current; }
+    const GLStateStats& lastFrame() const { return previous; }
+    void endFrame();
+    void printStats() const;
+
+private:
+    struct BufferRange
+    {
+        GLuint buffer;
+        GLintptr offset;
+        GLsizeiptr size;
+
+        bool operator==(const BufferRange& o) const
+        {
+            return buffer == o.buffer && offset == o.offset && size == o.size;
+        }
+    };
+
+    void growUnits(size_t count);
+    std::vector<BufferRange>& indexedBindings(GLenum target, size_t count);
+    void issue() { current.issued++; }
+
+    GLuint program;
+    GLuint vertexArray;
+    std::vector<GLuint> textures;   // por unidade
+    std::vector<GLuint> samplers;
+    std::map<GLenum, GLuint> buffers;
+    std::map<GLenum, std::vector<BufferRange>> ranges;
+
+    DepthState depth;
+    BlendState blend;
+    RasterState raster;
+    bool depthKnown = false;
+    bool blendKnown = false;
+    bool rasterKnown = false;
+
+    GLStateStats current;
+    GLStateStats previous;
+    GLStateStats total;
+    unsigned long long frames = 0;
+};
+
+// Cache único do processo (um contexto OpenGL)
+GLStateCache& glState();
@@ -0,0 +1,86 @@
+/*
+ *  Instrumentação das chamadas OpenGL sobre os ponteiros da GLAD
+ *
+ *  Toda chamada glXxx passa pelo ponteiro glad_glXxx. installGLTrace() troca
+ *  cada ponteiro carregado por um invólucro que conta a chamada, mede o
+ *  tempo gasto dentro do driver (CPU) e chama o original. A lista de pontos
+ *  de entrada está em GLTraceEntryPoints.h.
+ *
+ *  Por frame são somados: chamadas por ponto de entrada, draw calls,
+ *  mudanças de estado (bind, enable, use, blend, depth...) e bytes enviados
+ *  por glBufferData/glBufferSubData e glTex(ture)[Sub]Image*. Um relatório
+ *  com os totais e os pontos de entrada mais chamados e mais caros é
+ *  impresso ao sair do programa.
+ *
+ *  É opcional: loadGLExtensions chama installGLTrace() só quando a variável
+ *  de ambiente CG_GL_TRACE está definida (e diferente de "0"). Sem ela os
+ *  ponteiros não são tocados e não há custo algum.
+ *
+ *  Forma de uso
+ *  ------------
+ *  $ CG_GL_TRACE=1 ./M4
+ *  ...
+ *  // no loop, logo antes de glfwSwapBuffers:
+ *  glTraceEndFrame();
+ *  ...
+ *  if (glTraceInstalled()) glTracePrintFrame();   // último frame fechado
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <iostream>
+
+#include <glad/glad.h>
+
+#include "GLExtensions.h"
+
+// Um identificador por ponto de entrada interceptável
+enum GLEntryPoint
+{
+#define CG_GL_ENTRY(name) GL_ENTRY_##name,
+#include "GLTraceEntryPoints.h"
+#undef CG_GL_ENTRY
+    GL_ENTRY_COUNT
+};
+
+struct GLTraceFrame
+{
+    unsigned long long calls = 0;
+    unsigned long long drawCalls = 0;
+    unsigned long long stateChanges = 0;
+    unsigned long long uploadBytes = 0;
+    double driverSeconds = 0.0;   // tempo de CPU dentro das chamadas
+};
+
+struct GLEntryStats
+{
+    const char* name;
+    unsigned long long calls;         // total
+    unsigned long long maxPerFrame;
+    double seconds;                   // total
+};
+
+// Troca os ponteiros já carregados (GLAD e GLExtensions) pelos invólucros.
+// Chamar uma vez, depois de loadGLExtensions; false se não havia contexto.
+bool installGLTrace();
+bool glTraceInstalled();
+
+// Variável CG_GL_TRACE definida e diferente de "0"
+bool glTraceRequested();
+
+// Fecha o frame atual; não faz nada se a instrumentação não foi instalada
+void glTraceEndFrame();
+
+const GLTraceFrame& glTraceLastFrame();
+const GLTraceFrame& glTraceTotals();
+unsigned long long glTraceFrameCount();
+
+// Pontos de entrada chamados ao menos uma vez, do mais chamado ao menos chamado
+std::vector<GLEntryStats> glTraceEntryStats();
+
+const char* glEntryPointName(GLEntryPoint entry);
+
+void glTracePrintFrame();
+void glTraceReport(std::ostream& out);
@@ -0,0 +1,823 @@
+/*
+ *  Lista de pontos de entrada OpenGL interceptados por GLTrace.h (X-macro)
+ *
+ *  Um CG_GL_ENTRY(nome) por ponteiro glad_nome. A primeira parte é gerada de
+ *  include/glad/glad.h e deve ser refeita se a GLAD for regenerada:
+ *
+ *    grep -o "^GLAPI PFN[A-Z0-9_]* glad_gl[A-Za-z0-9_]*" include/glad/glad.h \
+ *        | sed 's/.*glad_\(.*\)/CG_GL_ENTRY(\1)/'
+ *
+ *  A segunda acompanha os blocos de GLExtensions.h (só existem quando a
+ *  GLAD não traz a versão). Sem #pragma once: incluído várias vezes, com
+ *  CG_GL_ENTRY definido de formas diferentes, sempre depois de GLExtensions.h.
+ */
+
+// --- glad.h (gl=4.0) --------------------------------------------------------
+CG_GL_ENTRY(glCullFace)
+CG_GL_ENTRY(glFrontFace)
+CG_GL_ENTRY(glHint)
+CG_GL_ENTRY(glLineWidth)
+CG_GL_ENTRY(glPointSize)
+CG_GL_ENTRY(glPolygonMode)
+CG_GL_ENTRY(glScissor)
+CG_GL_ENTRY(glTexParameterf)
+CG_GL_ENTRY(glTexParameterfv)
+CG_GL_ENTRY(glTexParameteri)
+CG_GL_ENTRY(glTexParameteriv)
+CG_GL_ENTRY(glTexImage1D)
+CG_GL_ENTRY(glTexImage2D)
+CG_GL_ENTRY(glDrawBuffer)
+CG_GL_ENTRY(glClear)
+CG_GL_ENTRY(glClearColor)
+CG_GL_ENTRY(glClearStencil)
+CG_GL_ENTRY(glClearDepth)
+CG_GL_ENTRY(glStencilMask)
+CG_GL_ENTRY(glColorMask)
+CG_GL_ENTRY(glDepthMask)
+CG_GL_ENTRY(glDisable)
+CG_GL_ENTRY(glEnable)
+CG_GL_ENTRY(glFinish)
+CG_GL_ENTRY(glFlush)
+CG_GL_ENTRY(glBlendFunc)
+CG_GL_ENTRY(glLogicOp)
+CG_GL_ENTRY(glStencilFunc)
+CG_GL_ENTRY(glStencilOp)
+CG_GL_ENTRY(glDepthFunc)
+CG_GL_ENTRY(glPixelStoref)
+CG_GL_ENTRY(glPixelStorei)
+CG_GL_ENTRY(glReadBuffer)
+CG_GL_ENTRY(glReadPixels)
+CG_GL_ENTRY(glGetBooleanv)
+CG_GL_ENTRY(glGetDoublev)
+CG_GL_ENTRY(glGetError)
+CG_GL_ENTRY(glGetFloatv)
+CG_GL_ENTRY(glGetIntegerv)
+CG_GL_ENTRY(glGetString)
+CG_GL_ENTRY(glGetTexImage)
+CG_GL_ENTRY(glGetTexParameterfv)
+CG_GL_ENTRY(glGetTexParameteriv)
+CG_GL_ENTRY(glGetTexLevelParameterfv)
+CG_GL_ENTRY(glGetTexLevelParameteriv)
+CG_GL_ENTRY(glIsEnabled)
+CG_GL_ENTRY(glDepthRange)
+CG_GL_ENTRY(glViewport)
+CG_GL_ENTRY(glNewList)
+CG_GL_ENTRY(glEndList)
+CG_GL_ENTRY(glCallList)
+CG_GL_ENTRY(glCallLists)
+CG_GL_ENTRY(glDeleteLists)
+CG_GL_ENTRY(glGenLists)
+CG_GL_ENTRY(glListBase)
+CG_GL_ENTRY(glBegin)
+CG_GL_ENTRY(glBitmap)
+CG_GL_ENTRY(glColor3b)
+CG_GL_ENTRY(glColor3bv)
+CG_GL_ENTRY(glColor3d)
+CG_GL_ENTRY(glColor3dv)
+CG_GL_ENTRY(glColor3f)
+CG_GL_ENTRY(glColor3fv)
+CG_GL_ENTRY(glColor3i)
+CG_GL_ENTRY(glColor3iv)
+CG_GL_ENTRY(glColor3s)
+CG_GL_ENTRY(glColor3sv)
+CG_GL_ENTRY(glColor3ub)
+CG_GL_ENTRY(glColor3ubv)
+CG_GL_ENTRY(glColor3ui)
+CG_GL_ENTRY(glColor3uiv)
+CG_GL_ENTRY(glColor3us)
+CG_GL_ENTRY(glColor3usv)
+CG_GL_ENTRY(glColor4b)
+CG_GL_ENTRY(glColor4bv)
+CG_GL_ENTRY(glColor4d)
+CG_GL_ENTRY(glColor4dv)
+CG_GL_ENTRY(glColor4f)
+CG_GL_ENTRY(glColor4fv)
+CG_GL_ENTRY(glColor4i)
+CG_GL_ENTRY(glColor4iv)
+CG_GL_ENTRY(glColor4s)
+CG_GL_ENTRY(glColor4sv)
+CG_GL_ENTRY(glColor4ub)
+CG_GL_ENTRY(glColor4ubv)
+CG_GL_ENTRY(glColor4ui)
+CG_GL_ENTRY(glColor4uiv)
+CG_GL_ENTRY(glColor4us)
+CG_GL_ENTRY(glColor4usv)
+CG_GL_ENTRY(glEdgeFlag)
+CG_GL_ENTRY(glEdgeFlagv)
+CG_GL_ENTRY(glEnd)
+CG_GL_ENTRY(glIndexd)
+CG_GL_ENTRY(glIndexdv)
+CG_GL_ENTRY(glIndexf)
+CG_GL_ENTRY(glIndexfv)
+CG_GL_ENTRY(glIndexi)
+CG_GL_ENTRY(glIndexiv)
+CG_GL_ENTRY(glIndexs)
+CG_GL_ENTRY(glIndexsv)
+CG_GL_ENTRY(glNormal3b)
+CG_GL_ENTRY(glNormal3bv)
+CG_GL_ENTRY(glNormal3d)
+CG_GL_ENTRY(glNormal3dv)
+CG_GL_ENTRY(glNormal3f)
+CG_GL_ENTRY(glNormal3fv)
+CG_GL_ENTRY(glNormal3i)
+CG_GL_ENTRY(glNormal3iv)
+CG_GL_ENTRY(glNormal3s)
+CG_GL_ENTRY(glNormal3sv)
+CG_GL_ENTRY(glRasterPos2d)
+CG_GL_ENTRY(glRasterPos2dv)
+CG_GL_ENTRY(glRasterPos2f)
+CG_GL_ENTRY(glRasterPos2fv)
+CG_GL_ENTRY(glRasterPos2i)
+CG_GL_ENTRY(glRasterPos2iv)
+CG_GL_ENTRY(glRasterPos2s)
+CG_GL_ENTRY(glRasterPos2sv)
+CG_GL_ENTRY(glRasterPos3d)
+CG_GL_ENTRY(glRasterPos3dv)
+CG_GL_ENTRY(glRasterPos3f)
+CG_GL_ENTRY(glRasterPos3fv)
+CG_GL_ENTRY(glRasterPos3i)
+CG_GL_ENTRY(glRasterPos3iv)
+CG_GL_ENTRY(glRasterPos3s)
+CG_GL_ENTRY(glRasterPos3sv)
+CG_GL_ENTRY(glRasterPos4d)
+CG_GL_ENTRY(glRasterPos4dv)
+CG_GL_ENTRY(glRasterPos4f)
+CG_GL_ENTRY(glRasterPos4fv)
+CG_GL_ENTRY(glRasterPos4i)
+CG_GL_ENTRY(glRasterPos4iv)
+CG_GL_ENTRY(glRasterPos4s)
+CG_GL_ENTRY(glRasterPos4sv)
+CG_GL_ENTRY(glRectd)
+CG_GL_ENTRY(glRectdv)
+CG_GL_ENTRY(glRectf)
+CG_GL_ENTRY(glRectfv)
+CG_GL_ENTRY(glRecti)
+CG_GL_ENTRY(glRectiv)
+CG_GL_ENTRY(glRects)
+CG_GL_ENTRY(glRectsv)
+CG_GL_ENTRY(glTexCoord1d)
+CG_GL_ENTRY(glTexCoord1dv)
+CG_GL_ENTRY(glTexCoord1f)
+CG_GL_ENTRY(glTexCoord1fv)
+CG_GL_ENTRY(glTexCoord1i)
+CG_GL_ENTRY(glTexCoord1iv)
+CG_GL_ENTRY(glTexCoord1s)
+CG_GL_ENTRY(glTexCoord1sv)
+CG_GL_ENTRY(glTexCoord2d)
+CG_GL_ENTRY(glTexCoord2dv)
+CG_GL_ENTRY(glTexCoord2f)
+CG_GL_ENTRY(glTexCoord2fv)
+CG_GL_ENTRY(glTexCoord2i)
+CG_GL_ENTRY(glTexCoord2iv)
+CG_GL_ENTRY(glTexCoord2s)
+CG_GL_ENTRY(glTexCoord2sv)
+CG_GL_ENTRY(glTexCoord3d)
+CG_GL_ENTRY(glTexCoord3dv)
+CG_GL_ENTRY(glTexCoord3f)
+CG_GL_ENTRY(glTexCoord3fv)
+CG_GL_ENTRY(glTexCoord3i)
+CG_GL_ENTRY(glTexCoord3iv)
+CG_GL_ENTRY(glTexCoord3s)
+CG_GL_ENTRY(glTexCoord3sv)
+CG_GL_ENTRY(glTexCoord4d)
+CG_GL_ENTRY(glTexCoord4dv)
+CG_GL_ENTRY(glTexCoord4f)
+CG_GL_ENTRY(glTexCoord4fv)
+CG_GL_ENTRY(glTexCoord4i)
+CG_GL_ENTRY(glTexCoord4iv)
+CG_GL_ENTRY(glTexCoord4s)
+CG_GL_ENTRY(glTexCoord4sv)
+CG_GL_ENTRY(glVertex2d)
+CG_GL_ENTRY(glVertex2dv)
+CG_GL_ENTRY(glVertex2f)
+CG_GL_ENTRY(glVertex2fv)
+CG_GL_ENTRY(glVertex2i)
+CG_GL_ENTRY(glVertex2iv)
+CG_GL_ENTRY(glVertex2s)
+CG_GL_ENTRY(glVertex2sv)
+CG_GL_ENTRY(glVertex3d)
+CG_GL_ENTRY(glVertex3dv)
+CG_GL_ENTRY(glVertex3f)
+CG_GL_ENTRY(glVertex3fv)
+CG_GL_ENTRY(glVertex3i)
+CG_GL_ENTRY(glVertex3iv)
+CG_GL_ENTRY(glVertex3s)
+CG_GL_ENTRY(glVertex3sv)
+CG_GL_ENTRY(glVertex4d)
+CG_GL_ENTRY(glVertex4dv)
+CG_GL_ENTRY(glVertex4f)
+CG_GL_ENTRY(glVertex4fv)
+CG_GL_ENTRY(glVertex4i)
+CG_GL_ENTRY(glVertex4iv)
+CG_GL_ENTRY(glVertex4s)
+CG_GL_ENTRY(glVertex4sv)
+CG_GL_ENTRY(glClipPlane)
+CG_GL_ENTRY(glColorMaterial)
+CG_GL_ENTRY(glFogf)
+CG_GL_ENTRY(glFogfv)
+CG_GL_ENTRY(glFogi)
+CG_GL_ENTRY(glFogiv)
+CG_GL_ENTRY(glLightf)
+CG_GL_ENTRY(glLightfv)
+CG_GL_ENTRY(glLighti)
+CG_GL_ENTRY(glLightiv)
+CG_GL_ENTRY(glLightModelf)
+CG_GL_ENTRY(glLightModelfv)
+CG_GL_ENTRY(glLightModeli)
+CG_GL_ENTRY(glLightModeliv)
+CG_GL_ENTRY(glLineStipple)
+CG_GL_ENTRY(glMaterialf)
+CG_GL_ENTRY(glMaterialfv)
+CG_GL_ENTRY(glMateriali)
+CG_GL_ENTRY(glMaterialiv)
+CG_GL_ENTRY(glPolygonStipple)
+CG_GL_ENTRY(glShadeModel)
+CG_GL_ENTRY(glTexEnvf)
+CG_GL_ENTRY(glTexEnvfv)
+CG_GL_ENTRY(glTexEnvi)
+CG_GL_ENTRY(glTexEnviv)
+CG_GL_ENTRY(glTexGend)
+CG_GL_ENTRY(glTexGendv)
+CG_GL_ENTRY(glTexGenf)
+CG_GL_ENTRY(glTexGenfv)
+CG_GL_ENTRY(glTexGeni)
+CG_GL_ENTRY(glTexGeniv)
+CG_GL_ENTRY(glFeedbackBuffer)
+CG_GL_ENTRY(glSelectBuffer)
+CG_GL_ENTRY(glRenderMode)
+CG_GL_ENTRY(glInitNames)
+CG_GL_ENTRY(glLoadName)
+CG_GL_ENTRY(glPassThrough)
+CG_GL_ENTRY(glPopName)
+CG_GL_ENTRY(glPushName)
+CG_GL_ENTRY(glClearAccum)
+CG_GL_ENTRY(glClearIndex)
+CG_GL_ENTRY(glIndexMask)
+CG_GL_ENTRY(glAccum)
+CG_GL_ENTRY(glPopAttrib)
+CG_GL_ENTRY(glPushAttrib)
+CG_GL_ENTRY(glMap1d)
+CG_GL_ENTRY(glMap1f)
+CG_GL_ENTRY(glMap2d)
+CG_GL_ENTRY(glMap2f)
+CG_GL_ENTRY(glMapGrid1d)
+CG_GL_ENTRY(glMapGrid1f)
+CG_GL_ENTRY(glMapGrid2d)
+CG_GL_ENTRY(glMapGrid2f)
+CG_GL_ENTRY(glEvalCoord1d)
+CG_GL_ENTRY(glEvalCoord1dv)
+CG_GL_ENTRY(glEvalCoord1f)
+CG_GL_ENTRY(glEvalCoord1fv)
+CG_GL_ENTRY(glEvalCoord2d)
+CG_GL_ENTRY(glEvalCoord2dv)
+CG_GL_ENTRY(glEvalCoord2f)
+CG_GL_ENTRY(glEvalCoord2fv)
+CG_GL_ENTRY(glEvalMesh1)
+CG_GL_ENTRY(glEvalPoint1)
+CG_GL_ENTRY(glEvalMesh2)
+CG_GL_ENTRY(glEvalPoint2)
+CG_GL_ENTRY(glAlphaFunc)
+CG_GL_ENTRY(glPixelZoom)
+CG_GL_ENTRY(glPixelTransferf)
+CG_GL_ENTRY(glPixelTransferi)
+CG_GL_ENTRY(glPixelMapfv)
+CG_GL_ENTRY(glPixelMapuiv)
+CG_GL_ENTRY(glPixelMapusv)
+CG_GL_ENTRY(glCopyPixels)
+CG_GL_ENTRY(glDrawPixels)
+CG_GL_ENTRY(glGetClipPlane)
+CG_GL_ENTRY(glGetLightfv)
+CG_GL_ENTRY(glGetLightiv)
+CG_GL_ENTRY(glGetMapdv)
+CG_GL_ENTRY(glGetMapfv)
+CG_GL_ENTRY(glGetMapiv)
+CG_GL_ENTRY(glGetMaterialfv)
+CG_GL_ENTRY(glGetMaterialiv)
+CG_GL_ENTRY(glGetPixelMapfv)
+CG_GL_ENTRY(glGetPixelMapuiv)
+CG_GL_ENTRY(glGetPixelMapusv)
+CG_GL_ENTRY(glGetPolygonStipple)
+CG_GL_ENTRY(glGetTexEnvfv)
+CG_GL_ENTRY(glGetTexEnviv)
+CG_GL_ENTRY(glGetTexGendv)
+CG_GL_ENTRY(glGetTexGenfv)
+CG_GL_ENTRY(glGetTexGeniv)
+CG_GL_ENTRY(glIsList)
+CG_GL_ENTRY(glFrustum)
+CG_GL_ENTRY(glLoadIdentity)
+CG_GL_ENTRY(glLoadMatrixf)
+CG_GL_ENTRY(glLoadMatrixd)
+CG_GL_ENTRY(glMatrixMode)
+CG_GL_ENTRY(glMultMatrixf)
+CG_GL_ENTRY(glMultMatrixd)
+CG_GL_ENTRY(glOrtho)
+CG_GL_ENTRY(glPopMatrix)
+CG_GL_ENTRY(glPushMatrix)
+CG_GL_ENTRY(glRotated)
+CG_GL_ENTRY(glRotatef)
+CG_GL_ENTRY(glScaled)
+CG_GL_ENTRY(glScalef)
+CG_GL_ENTRY(glTranslated)
+CG_GL_ENTRY(glTranslatef)
+CG_GL_ENTRY(glDrawArrays)
+CG_GL_ENTRY(glDrawElements)
+CG_GL_ENTRY(glGetPointerv)
+CG_GL_ENTRY(glPolygonOffset)
+CG_GL_ENTRY(glCopyTexImage1D)
+CG_GL_ENTRY(glCopyTexImage2D)
+CG_GL_ENTRY(glCopyTexSubImage1D)
+CG_GL_ENTRY(glCopyTexSubImage2D)
+CG_GL_ENTRY(glTexSubImage1D)
+CG_GL_ENTRY(glTexSubImage2D)
+CG_GL_ENTRY(glBindTexture)
+CG_GL_ENTRY(glDeleteTextures)
+CG_GL_ENTRY(glGenTextures)
+CG_GL_ENTRY(glIsTexture)
+CG_GL_ENTRY(glArrayElement)
+CG_GL_ENTRY(glColorPointer)
+CG_GL_ENTRY(glDisableClientState)
+CG_GL_ENTRY(glEdgeFlagPointer)
+CG_GL_ENTRY(glEnableClientState)
+CG_GL_ENTRY(glIndexPointer)
+CG_GL_ENTRY(glInterleavedArrays)
+CG_GL_ENTRY(glNormalPointer)
+CG_GL_ENTRY(glTexCoordPointer)
+CG_GL_ENTRY(glVertexPointer)
+CG_GL_ENTRY(glAreTexturesResident)
+CG_GL_ENTRY(glPrioritizeTextures)
+CG_GL_ENTRY(glIndexub)
+CG_GL_ENTRY(glIndexubv)
+CG_GL_ENTRY(glPopClientAttrib)
+CG_GL_ENTRY(glPushClientAttrib)
+CG_GL_ENTRY(glDrawRangeElements)
+CG_GL_ENTRY(glTexImage3D)
+CG_GL_ENTRY(glTexSubImage3D)
+CG_GL_ENTRY(glCopyTexSubImage3D)
+CG_GL_ENTRY(glActiveTexture)
+CG_GL_ENTRY(glSampleCoverage)
+CG_GL_ENTRY(glCompressedTexImage3D)
+CG_GL_ENTRY(glCompressedTexImage2D)
+CG_GL_ENTRY(glCompressedTexImage1D)
+CG_GL_ENTRY(glCompressedTexSubImage3D)
+CG_GL_ENTRY(glCompressedTexSubImage2D)
+CG_GL_ENTRY(glCompressedTexSubImage1D)
+CG_GL_ENTRY(glGetCompressedTexImage)
+CG_GL_ENTRY(glClientActiveTexture)
+CG_GL_ENTRY(glMultiTexCoord1d)
+CG_GL_ENTRY(glMultiTexCoord1dv)
+CG_GL_ENTRY(glMultiTexCoord1f)
+CG_GL_ENTRY(glMultiTexCoord1fv)
+CG_GL_ENTRY(glMultiTexCoord1i)
+CG_GL_ENTRY(glMultiTexCoord1iv)
+CG_GL_ENTRY(glMultiTexCoord1s)
+CG_GL_ENTRY(glMultiTexCoord1sv)
+CG_GL_ENTRY(glMultiTexCoord2d)
+CG_GL_ENTRY(glMultiTexCoord2dv)
+CG_GL_ENTRY(glMultiTexCoord2f)
+CG_GL_ENTRY(glMultiTexCoord2fv)
+CG_GL_ENTRY(glMultiTexCoord2i)
+CG_GL_ENTRY(glMultiTexCoord2iv)
+CG_GL_ENTRY(glMultiTexCoord2s)
+CG_GL_ENTRY(glMultiTexCoord2sv)
+CG_GL_ENTRY(glMultiTexCoord3d)
+CG_GL_ENTRY(glMultiTexCoord3dv)
+CG_GL_ENTRY(glMultiTexCoord3f)
+CG_GL_ENTRY(glMultiTexCoord3fv)
+CG_GL_ENTRY(glMultiTexCoord3i)
+CG_GL_ENTRY(glMultiTexCoord3iv)
+CG_GL_ENTRY(glMultiTexCoord3s)
+CG_GL_ENTRY(glMultiTexCoord3sv)
+CG_GL_ENTRY(glMultiTexCoord4d)
+CG_GL_ENTRY(glMultiTexCoord4dv)
+CG_GL_ENTRY(glMultiTexCoord4f)
+CG_GL_ENTRY(glMultiTexCoord4fv)
+CG_GL_ENTRY(glMultiTexCoord4i)
+CG_GL_ENTRY(glMultiTexCoord4iv)
+CG_GL_ENTRY(glMultiTexCoord4s)
+CG_GL_ENTRY(glMultiTexCoord4sv)
+CG_GL_ENTRY(glLoadTransposeMatrixf)
+CG_GL_ENTRY(glLoadTransposeMatrixd)
+CG_GL_ENTRY(glMultTransposeMatrixf)
+CG_GL_ENTRY(glMultTransposeMatrixd)
+CG_GL_ENTRY(glBlendFuncSeparate)
+CG_GL_ENTRY(glMultiDrawArrays)
+CG_GL_ENTRY(glMultiDrawElements)
+CG_GL_ENTRY(glPointParameterf)
+CG_GL_ENTRY(glPointParameterfv)
+CG_GL_ENTRY(glPointParameteri)
+CG_GL_ENTRY(glPointParameteriv)
+CG_GL_ENTRY(glFogCoordf)
+CG_GL_ENTRY(glFogCoordfv)
+CG_GL_ENTRY(glFogCoordd)
+CG_GL_ENTRY(glFogCoorddv)
+CG_GL_ENTRY(glFogCoordPointer)
+CG_GL_ENTRY(glSecondaryColor3b)
+CG_GL_ENTRY(glSecondaryColor3bv)
+CG_GL_ENTRY(glSecondaryColor3d)
+CG_GL_ENTRY(glSecondaryColor3dv)
+CG_GL_ENTRY(glSecondaryColor3f)
+CG_GL_ENTRY(glSecondaryColor3fv)
+CG_GL_ENTRY(glSecondaryColor3i)
+CG_GL_ENTRY(glSecondaryColor3iv)
+CG_GL_ENTRY(glSecondaryColor3s)
+CG_GL_ENTRY(glSecondaryColor3sv)
+CG_GL_ENTRY(glSecondaryColor3ub)
+CG_GL_ENTRY(glSecondaryColor3ubv)
+CG_GL_ENTRY(glSecondaryColor3ui)
+CG_GL_ENTRY(glSecondaryColor3uiv)
+CG_GL_ENTRY(glSecondaryColor3us)
+CG_GL_ENTRY(glSecondaryColor3usv)
+CG_GL_ENTRY(glSecondaryColorPointer)
+CG_GL_ENTRY(glWindowPos2d)
+CG_GL_ENTRY(glWindowPos2dv)
+CG_GL_ENTRY(glWindowPos2f)
+CG_GL_ENTRY(glWindowPos2fv)
+CG_GL_ENTRY(glWindowPos2i)
+CG_GL_ENTRY(glWindowPos2iv)
+CG_GL_ENTRY(glWindowPos2s)
+CG_GL_ENTRY(glWindowPos2sv)
+CG_GL_ENTRY(glWindowPos3d)
+CG_GL_ENTRY(glWindowPos3dv)
+CG_GL_ENTRY(glWindowPos3f)
+CG_GL_ENTRY(glWindowPos3fv)
+CG_GL_ENTRY(glWindowPos3i)
+CG_GL_ENTRY(glWindowPos3iv)
+CG_GL_ENTRY(glWindowPos3s)
+CG_GL_ENTRY(glWindowPos3sv)
+CG_GL_ENTRY(glBlendColor)
+CG_GL_ENTRY(glBlendEquation)
+CG_GL_ENTRY(glGenQueries)
+CG_GL_ENTRY(glDeleteQueries)
+CG_GL_ENTRY(glIsQuery)
+CG_GL_ENTRY(glBeginQuery)
+CG_GL_ENTRY(glEndQuery)
+CG_GL_ENTRY(glGetQueryiv)
+CG_GL_ENTRY(glGetQueryObjectiv)
+CG_GL_ENTRY(glGetQueryObjectuiv)
+CG_GL_ENTRY(glBindBuffer)
+CG_GL_ENTRY(glDeleteBuffers)
+CG_GL_ENTRY(glGenBuffers)
+CG_GL_ENTRY(glIsBuffer)
+CG_GL_ENTRY(glBufferData)
+CG_GL_ENTRY(glBufferSubData)
+CG_GL_ENTRY(glGetBufferSubData)
+CG_GL_ENTRY(glMapBuffer)
+CG_GL_ENTRY(glUnmapBuffer)
+CG_GL_ENTRY(glGetBufferParameteriv)
+CG_GL_ENTRY(glGetBufferPointerv)
+CG_GL_ENTRY(glBlendEquationSeparate)
+CG_GL_ENTRY(glDrawBuffers)
+CG_GL_ENTRY(glStencilOpSeparate)
+CG_GL_ENTRY(glStencilFuncSeparate)
+CG_GL_ENTRY(glStencilMaskSeparate)
+CG_GL_ENTRY(glAttachShader)
+CG_GL_ENTRY(glBindAttribLocation)
+CG_GL_ENTRY(glCompileShader)
+CG_GL_ENTRY(glCreateProgram)
+CG_GL_ENTRY(glCreateShader)
+CG_GL_ENTRY(glDeleteProgram)
+CG_GL_ENTRY(glDeleteShader)
+CG_GL_ENTRY(glDetachShader)
+CG_GL_ENTRY(glDisableVertexAttribArray)
+CG_GL_ENTRY(glEnableVertexAttribArray)
+CG_GL_ENTRY(glGetActiveAttrib)
+CG_GL_ENTRY(glGetActiveUniform)
+CG_GL_ENTRY(glGetAttachedShaders)
+CG_GL_ENTRY(glGetAttribLocation)
+CG_GL_ENTRY(glGetProgramiv)
+CG_GL_ENTRY(glGetProgramInfoLog)
+CG_GL_ENTRY(glGetShaderiv)
+CG_GL_ENTRY(glGetShaderInfoLog)
+CG_GL_ENTRY(glGetShaderSource)
+CG_GL_ENTRY(glGetUniformLocation)
+CG_GL_ENTRY(glGetUniformfv)
+CG_GL_ENTRY(glGetUniformiv)
+CG_GL_ENTRY(glGetVertexAttribdv)
+CG_GL_ENTRY(glGetVertexAttribfv)
+CG_GL_ENTRY(glGetVertexAttribiv)
+CG_GL_ENTRY(glGetVertexAttribPointerv)
+CG_GL_ENTRY(glIsProgram)
+CG_GL_ENTRY(glIsShader)
+CG_GL_ENTRY(glLinkProgram)
+CG_GL_ENTRY(glShaderSource)
+CG_GL_ENTRY(glUseProgram)
+CG_GL_ENTRY(glUniform1f)
+CG_GL_ENTRY(glUniform2f)
+CG_GL_ENTRY(glUniform3f)
+CG_GL_ENTRY(glUniform4f)
+CG_GL_ENTRY(glUniform1i)
+CG_GL_ENTRY(glUniform2i)
+CG_GL_ENTRY(glUniform3i)
+CG_GL_ENTRY(glUniform4i)
+CG_GL_ENTRY(glUniform1fv)
+CG_GL_ENTRY(glUniform2fv)
+CG_GL_ENTRY(glUniform3fv)
+CG_GL_ENTRY(glUniform4fv)
+CG_GL_ENTRY(glUniform1iv)
+CG_GL_ENTRY(glUniform2iv)
+CG_GL_ENTRY(glUniform3iv)
+CG_GL_ENTRY(glUniform4iv)
+CG_GL_ENTRY(glUniformMatrix2fv)
+CG_GL_ENTRY(glUniformMatrix3fv)
+CG_GL_ENTRY(glUniformMatrix4fv)
+CG_GL_ENTRY(glValidateProgram)
+CG_GL_ENTRY(glVertexAttrib1d)
+CG_GL_ENTRY(glVertexAttrib1dv)
+CG_GL_ENTRY(glVertexAttrib1f)
+CG_GL_ENTRY(glVertexAttrib1fv)
+CG_GL_ENTRY(glVertexAttrib1s)
+CG_GL_ENTRY(glVertexAttrib1sv)
+CG_GL_ENTRY(glVertexAttrib2d)
+CG_GL_ENTRY(glVertexAttrib2dv)
+CG_GL_ENTRY(glVertexAttrib2f)
+CG_GL_ENTRY(glVertexAttrib2fv)
+CG_GL_ENTRY(glVertexAttrib2s)
+CG_GL_ENTRY(glVertexAttrib2sv)
+CG_GL_ENTRY(glVertexAttrib3d)
+CG_GL_ENTRY(glVertexAttrib3dv)
+CG_GL_ENTRY(glVertexAttrib3f)
+CG_GL_ENTRY(glVertexAttrib3fv)
+CG_GL_ENTRY(glVertexAttrib3s)
+CG_GL_ENTRY(glVertexAttrib3sv)
+CG_GL_ENTRY(glVertexAttrib4Nbv)
+CG_GL_ENTRY(glVertexAttrib4Niv)
+CG_GL_ENTRY(glVertexAttrib4Nsv)
+CG_GL_ENTRY(glVertexAttrib4Nub)
+CG_GL_ENTRY(glVertexAttrib4Nubv)
+CG_GL_ENTRY(glVertexAttrib4Nuiv)
+CG_GL_ENTRY(glVertexAttrib4Nusv)
+CG_GL_ENTRY(glVertexAttrib4bv)
+CG_GL_ENTRY(glVertexAttrib4d)
+CG_GL_ENTRY(glVertexAttrib4dv)
+CG_GL_ENTRY(glVertexAttrib4f)
+CG_GL_ENTRY(glVertexAttrib4fv)
+CG_GL_ENTRY(glVertexAttrib4iv)
+CG_GL_ENTRY(glVertexAttrib4s)
+CG_GL_ENTRY(glVertexAttrib4sv)
+CG_GL_ENTRY(glVertexAttrib4ubv)
+CG_GL_ENTRY(glVertexAttrib4uiv)
+CG_GL_ENTRY(glVertexAttrib4usv)
+CG_GL_ENTRY(glVertexAttribPointer)
+CG_GL_ENTRY(glUniformMatrix2x3fv)
+CG_GL_ENTRY(glUniformMatrix3x2fv)
+CG_GL_ENTRY(glUniformMatrix2x4fv)
+CG_GL_ENTRY(glUniformMatrix4x2fv)
+CG_GL_ENTRY(glUniformMatrix3x4fv)
+CG_GL_ENTRY(glUniformMatrix4x3fv)
+CG_GL_ENTRY(glColorMaski)
+CG_GL_ENTRY(glGetBooleani_v)
+CG_GL_ENTRY(glGetIntegeri_v)
+CG_GL_ENTRY(glEnablei)
+CG_GL_ENTRY(glDisablei)
+CG_GL_ENTRY(glIsEnabledi)
+CG_GL_ENTRY(glBeginTransformFeedback)
+CG_GL_ENTRY(glEndTransformFeedback)
+CG_GL_ENTRY(glBindBufferRange)
+CG_GL_ENTRY(glBindBufferBase)
+CG_GL_ENTRY(glTransformFeedbackVaryings)
+CG_GL_ENTRY(glGetTransformFeedbackVarying)
+CG_GL_ENTRY(glClampColor)
+CG_GL_ENTRY(glBeginConditionalRender)
+CG_GL_ENTRY(glEndConditionalRender)
+CG_GL_ENTRY(glVertexAttribIPointer)
+CG_GL_ENTRY(glGetVertexAttribIiv)
+CG_GL_ENTRY(glGetVertexAttribIuiv)
+CG_GL_ENTRY(glVertexAttribI1i)
+CG_GL_ENTRY(glVertexAttribI2i)
+CG_GL_ENTRY(glVertexAttribI3i)
+CG_GL_ENTRY(glVertexAttribI4i)
+CG_GL_ENTRY(glVertexAttribI1ui)
+CG_GL_ENTRY(glVertexAttribI2ui)
+CG_GL_ENTRY(glVertexAttribI3ui)
+CG_GL_ENTRY(glVertexAttribI4ui)
+CG_GL_ENTRY(glVertexAttribI1iv)
+CG_GL_ENTRY(glVertexAttribI2iv)
+CG_GL_ENTRY(glVertexAttribI3iv)
+CG_GL_ENTRY(glVertexAttribI4iv)
+CG_GL_ENTRY(glVertexAttribI1uiv)
+CG_GL_ENTRY(glVertexAttribI2uiv)
+CG_GL_ENTRY(glVertexAttribI3uiv)
+CG_GL_ENTRY(glVertexAttribI4uiv)
+CG_GL_ENTRY(glVertexAttribI4bv)
+CG_GL_ENTRY(glVertexAttribI4sv)
+CG_GL_ENTRY(glVertexAttribI4ubv)
+CG_GL_ENTRY(glVertexAttribI4usv)
+CG_GL_ENTRY(glGetUniformuiv)
+CG_GL_ENTRY(glBindFragDataLocation)
+CG_GL_ENTRY(glGetFragDataLocation)
+CG_GL_ENTRY(glUniform1ui)
+CG_GL_ENTRY(glUniform2ui)
+CG_GL_ENTRY(glUniform3ui)
+CG_GL_ENTRY(glUniform4ui)
+CG_GL_ENTRY(glUniform1uiv)
+CG_GL_ENTRY(glUniform2uiv)
+CG_GL_ENTRY(glUniform3uiv)
+CG_GL_ENTRY(glUniform4uiv)
+CG_GL_ENTRY(glTexParameterIiv)
+CG_GL_ENTRY(glTexParameterIuiv)
+CG_GL_ENTRY(glGetTexParameterIiv)
+CG_GL_ENTRY(glGetTexParameterIuiv)
+CG_GL_ENTRY(glClearBufferiv)
+CG_GL_ENTRY(glClearBufferuiv)
+CG_GL_ENTRY(glClearBufferfv)
+CG_GL_ENTRY(glClearBufferfi)
+CG_GL_ENTRY(glGetStringi)
+CG_GL_ENTRY(glIsRenderbuffer)
+CG_GL_ENTRY(glBindRenderbuffer)
+CG_GL_ENTRY(glDeleteRenderbuffers)
+CG_GL_ENTRY(glGenRenderbuffers)
+CG_GL_ENTRY(glRenderbufferStorage)
+CG_GL_ENTRY(glGetRenderbufferParameteriv)
+CG_GL_ENTRY(glIsFramebuffer)
+CG_GL_ENTRY(glBindFramebuffer)
+CG_GL_ENTRY(glDeleteFramebuffers)
+CG_GL_ENTRY(glGenFramebuffers)
+CG_GL_ENTRY(glCheckFramebufferStatus)
+CG_GL_ENTRY(glFramebufferTexture1D)
+CG_GL_ENTRY(glFramebufferTexture2D)
+CG_GL_ENTRY(glFramebufferTexture3D)
+CG_GL_ENTRY(glFramebufferRenderbuffer)
+CG_GL_ENTRY(glGetFramebufferAttachmentParameteriv)
+CG_GL_ENTRY(glGenerateMipmap)
+CG_GL_ENTRY(glBlitFramebuffer)
+CG_GL_ENTRY(glRenderbufferStorageMultisample)
+CG_GL_ENTRY(glFramebufferTextureLayer)
+CG_GL_ENTRY(glMapBufferRange)
+CG_GL_ENTRY(glFlushMappedBufferRange)
+CG_GL_ENTRY(glBindVertexArray)
+CG_GL_ENTRY(glDeleteVertexArrays)
+CG_GL_ENTRY(glGenVertexArrays)
+CG_GL_ENTRY(glIsVertexArray)
+CG_GL_ENTRY(glDrawArraysInstanced)
+CG_GL_ENTRY(glDrawElementsInstanced)
+CG_GL_ENTRY(glTexBuffer)
+CG_GL_ENTRY(glPrimitiveRestartIndex)
+CG_GL_ENTRY(glCopyBufferSubData)
+CG_GL_ENTRY(glGetUniformIndices)
+CG_GL_ENTRY(glGetActiveUniformsiv)
+CG_GL_ENTRY(glGetActiveUniformName)
+CG_GL_ENTRY(glGetUniformBlockIndex)
+CG_GL_ENTRY(glGetActiveUniformBlockiv)
+CG_GL_ENTRY(glGetActiveUniformBlockName)
+CG_GL_ENTRY(glUniformBlockBinding)
+CG_GL_ENTRY(glDrawElementsBaseVertex)
+CG_GL_ENTRY(glDrawRangeElementsBaseVertex)
+CG_GL_ENTRY(glDrawElementsInstancedBaseVertex)
+CG_GL_ENTRY(glMultiDrawElementsBaseVertex)
+CG_GL_ENTRY(glProvokingVertex)
+CG_GL_ENTRY(glFenceSync)
+CG_GL_ENTRY(glIsSync)
+CG_GL_ENTRY(glDeleteSync)
+CG_GL_ENTRY(glClientWaitSync)
+CG_GL_ENTRY(glWaitSync)
+CG_GL_ENTRY(glGetInteger64v)
+CG_GL_ENTRY(glGetSynciv)
+CG_GL_ENTRY(glGetInteger64i_v)
+CG_GL_ENTRY(glGetBufferParameteri64v)
+CG_GL_ENTRY(glFramebufferTexture)
+CG_GL_ENTRY(glTexImage2DMultisample)
+CG_GL_ENTRY(glTexImage3DMultisample)
+CG_GL_ENTRY(glGetMultisamplefv)
+CG_GL_ENTRY(glSampleMaski)
+CG_GL_ENTRY(glBindFragDataLocationIndexed)
+CG_GL_ENTRY(glGetFragDataIndex)
+CG_GL_ENTRY(glGenSamplers)
+CG_GL_ENTRY(glDeleteSamplers)
+CG_GL_ENTRY(glIsSampler)
+CG_GL_ENTRY(glBindSampler)
+CG_GL_ENTRY(glSamplerParameteri)
+CG_GL_ENTRY(glSamplerParameteriv)
+CG_GL_ENTRY(glSamplerParameterf)
+CG_GL_ENTRY(glSamplerParameterfv)
+CG_GL_ENTRY(glSamplerParameterIiv)
+CG_GL_ENTRY(glSamplerParameterIuiv)
+CG_GL_ENTRY(glGetSamplerParameteriv)
+CG_GL_ENTRY(glGetSamplerParameterIiv)
+CG_GL_ENTRY(glGetSamplerParameterfv)
+CG_GL_ENTRY(glGetSamplerParameterIuiv)
+CG_GL_ENTRY(glQueryCounter)
+CG_GL_ENTRY(glGetQueryObjecti64v)
+CG_GL_ENTRY(glGetQueryObjectui64v)
+CG_GL_ENTRY(glVertexAttribDivisor)
+CG_GL_ENTRY(glVertexAttribP1ui)
+CG_GL_ENTRY(glVertexAttribP1uiv)
+CG_GL_ENTRY(glVertexAttribP2ui)
+CG_GL_ENTRY(glVertexAttribP2uiv)
+CG_GL_ENTRY(glVertexAttribP3ui)
+CG_GL_ENTRY(glVertexAttribP3uiv)
+CG_GL_ENTRY(glVertexAttribP4ui)
+CG_GL_ENTRY(glVertexAttribP4uiv)
+CG_GL_ENTRY(glVertexP2ui)
+CG_GL_ENTRY(glVertexP2uiv)
+CG_GL_ENTRY(glVertexP3ui)
+CG_GL_ENTRY(glVertexP3uiv)
+CG_GL_ENTRY(glVertexP4ui)
+CG_GL_ENTRY(glVertexP4uiv)
+CG_GL_ENTRY(glTexCoordP1ui)
+CG_GL_ENTRY(glTexCoordP1uiv)
+CG_GL_ENTRY(glTexCoordP2ui)
+CG_GL_ENTRY(glTexCoordP2uiv)
+CG_GL_ENTRY(glTexCoordP3ui)
+CG_GL_ENTRY(glTexCoordP3uiv)
+CG_GL_ENTRY(glTexCoordP4ui)
+CG_GL_ENTRY(glTexCoordP4uiv)
+CG_GL_ENTRY(glMultiTexCoordP1ui)
+CG_GL_ENTRY(glMultiTexCoordP1uiv)
+CG_GL_ENTRY(glMultiTexCoordP2ui)
+CG_GL_ENTRY(glMultiTexCoordP2uiv)
+CG_GL_ENTRY(glMultiTexCoordP3ui)
+CG_GL_ENTRY(glMultiTexCoordP3uiv)
+CG_GL_ENTRY(glMultiTexCoordP4ui)
+CG_GL_ENTRY(glMultiTexCoordP4uiv)
+CG_GL_ENTRY(glNormalP3ui)
+CG_GL_ENTRY(glNormalP3uiv)
+CG_GL_ENTRY(glColorP3ui)
+CG_GL_ENTRY(glColorP3uiv)
+CG_GL_ENTRY(glColorP4ui)
+CG_GL_ENTRY(glColorP4uiv)
+CG_GL_ENTRY(glSecondaryColorP3ui)
+CG_GL_ENTRY(glSecondaryColorP3uiv)
+CG_GL_ENTRY(glMinSampleShading)
+CG_GL_ENTRY(glBlendEquationi)
+CG_GL_ENTRY(glBlendEquationSeparatei)
+CG_GL_ENTRY(glBlendFunci)
+CG_GL_ENTRY(glBlendFuncSeparatei)
+CG_GL_ENTRY(glDrawArraysIndirect)
+CG_GL_ENTRY(glDrawElementsIndirect)
+CG_GL_ENTRY(glUniform1d)
+CG_GL_ENTRY(glUniform2d)
+CG_GL_ENTRY(glUniform3d)
+CG_GL_ENTRY(glUniform4d)
+CG_GL_ENTRY(glUniform1dv)
+CG_GL_ENTRY(glUniform2dv)
+CG_GL_ENTRY(glUniform3dv)
+CG_GL_ENTRY(glUniform4dv)
+CG_GL_ENTRY(glUniformMatrix2dv)
+CG_GL_ENTRY(glUniformMatrix3dv)
+CG_GL_ENTRY(glUniformMatrix4dv)
+CG_GL_ENTRY(glUniformMatrix2x3dv)
+CG_GL_ENTRY(glUniformMatrix2x4dv)
+CG_GL_ENTRY(glUniformMatrix3x2dv)
+CG_GL_ENTRY(glUniformMatrix3x4dv)
+CG_GL_ENTRY(glUniformMatrix4x2dv)
+CG_GL_ENTRY(glUniformMatrix4x3dv)
+CG_GL_ENTRY(glGetUniformdv)
+CG_GL_ENTRY(glGetSubroutineUniformLocation)
+CG_GL_ENTRY(glGetSubroutineIndex)
+CG_GL_ENTRY(glGetActiveSubroutineUniformiv)
+CG_GL_ENTRY(glGetActiveSubroutineUniformName)
+CG_GL_ENTRY(glGetActiveSubroutineName)
+CG_GL_ENTRY(glUniformSubroutinesuiv)
+CG_GL_ENTRY(glGetUniformSubroutineuiv)
+CG_GL_ENTRY(glGetProgramStageiv)
+CG_GL_ENTRY(glPatchParameteri)
+CG_GL_ENTRY(glPatchParameterfv)
+CG_GL_ENTRY(glBindTransformFeedback)
+CG_GL_ENTRY(glDeleteTransformFeedbacks)
+CG_GL_ENTRY(glGenTransformFeedbacks)
+CG_GL_ENTRY(glIsTransformFeedback)
+CG_GL_ENTRY(glPauseTransformFeedback)
+CG_GL_ENTRY(glResumeTransformFeedback)
+CG_GL_ENTRY(glDrawTransformFeedback)
+CG_GL_ENTRY(glDrawTransformFeedbackStream)
+CG_GL_ENTRY(glBeginQueryIndexed)
+CG_GL_ENTRY(glEndQueryIndexed)
+CG_GL_ENTRY(glGetQueryIndexediv)
+
+// --- GLExtensions.h ---------------------------------------------------------
+#ifdef CG_GLEXT_VERSION_4_1
+CG_GL_ENTRY(glGetProgramBinary)
+CG_GL_ENTRY(glProgramBinary)
+CG_GL_ENTRY(glProgramParameteri)
+#endif
+#ifdef CG_GLEXT_VERSION_4_3
+CG_GL_ENTRY(glCopyImageSubData)
+CG_GL_ENTRY(glMultiDrawElementsIndirect)
+CG_GL_ENTRY(glDispatchCompute)
+CG_GL_ENTRY(glMemoryBarrier)
+CG_GL_ENTRY(glDrawElementsInstancedBaseVertexBaseInstance)
+CG_GL_ENTRY(glBindImageTexture)
+#endif
+#ifdef CG_GLEXT_VERSION_4_4
+CG_GL_ENTRY(glBindTextures)
+CG_GL_ENTRY(glBindSamplers)
+CG_GL_ENTRY(glBindBuffersRange)
+CG_GL_ENTRY(glBufferStorage)
+#endif
+#ifdef CG_GLEXT_VERSION_4_5
+CG_GL_ENTRY(glCreateTextures)
+CG_GL_ENTRY(glTextureStorage2D)
+CG_GL_ENTRY(glTextureSubImage2D)
+CG_GL_ENTRY(glGenerateTextureMipmap)
+CG_GL_ENTRY(glBindTextureUnit)
+CG_GL_ENTRY(glTextureParameteri)
+CG_GL_ENTRY(glCreateSamplers)
+#endif
+#ifdef CG_GLEXT_KHR_debug
+CG_GL_ENTRY(glDebugMessageControl)
+CG_GL_ENTRY(glDebugMessageCallback)
+CG_GL_ENTRY(glObjectLabel)
+#endif
+#ifdef CG_GLEXT_KHR_parallel_shader_compile
+CG_GL_ENTRY(glMaxShaderCompilerThreadsKHR)
+#endif
@@ -0,0 +1,136 @@
+/*
+ *  Frustum culling na GPU com compute shader
+ *
+ *  Com IndirectBatch a CPU ainda monta um comando por objeto e a GPU
+ *  processa todos, visíveis ou não. GPUCulling recebe o DrawData do lote
+ *  (model e malha de cada objeto, já na GPU) e, num compute shader com uma
+ *  invocação por objeto, testa a esfera envolvente da malha - transformada
+ *  pela model - contra os planos do frustum (Frustum.h). Os sobreviventes
+ *  são acrescentados com atomicAdd ao comando da sua malha: a CPU não toca
+ *  em nenhum objeto.
+ *
+ *  Há um comando indireto por malha do MeshPool. O da malha m tem
+ *  baseInstance = m * capacidade e instanceCount = visíveis; o compute
+ *  grava o índice de cada objeto visível em visibleObjects[baseInstance +
+ *  slot]. O shader de vértice lê o índice do desenho (DRAW_ID_LOCATION, que
+ *  vale baseInstance + gl_InstanceID) e busca o objeto por essa lista:
+ *
+ *  #ifdef GPU_CULLING
+ *      DrawData d = draws[visibleObjects[drawId]];
+ *  #else
+ *      DrawData d = draws[drawId];
+ *  #endif
+ *
+ *  Assim o número de comandos é fixo e o desenho não precisa ler da GPU
+ *  quantos sobraram (glMultiDrawElementsIndirectCount é da OpenGL 4.6).
+ *
+ *  Occlusion culling em duas fases (com enableOcclusion e HiZPyramid.h)
+ *  --------------------------------------------------------------------
+ *  Um buffer guarda, por DrawData::object, se o objeto estava visível no
+ *  frame anterior. CULL_EARLY desenha só esses (com o teste de frustum):
+ *  são os oclusores, e a profundidade deles vira a pirâmide Hi-Z. CULL_LATE
+ *  testa todos os objetos contra o frustum e contra a pirâmide (a caixa da
+ *  malha, projetada, comparada com 2x2 texels do nível em que ela cabe),
+ *  atualiza a visibilidade e desenha só os que estão visíveis e não foram
+ *  desenhados na primeira fase. Um objeto que reaparece (desoclusão) entra
+ *  assim no mesmo frame, sem buraco na imagem; um oclusor que ficou
+ *  escondido custa um desenho a mais e sai no frame seguinte.
+ *
+ *  Forma de uso (um GPUCulling por IndirectBatch)
+ *  ----------------------------------------------
+ *  GPUCulling culling(pool);
+ *  GLuint program = createProgram(vs, fs, { "GPU_CULLING" });   // vs com visibleObjectsGLSL
+ *  // a cada frame:
+ *  batch.upload();
+ *  culling.cull(batch, projection * camera.GetViewMatrix());
+ *  glState().bindPipeline(pipeline);
+ *  culling.draw();
+ *  ...
+ *  culling.clear();   // antes de glfwTerminate
+ *
+ *  // duas fases:
+ *  culling.enableOcclusion(objectCount);
+ *  // a cada frame, com o framebuffer de hiz vinculado:
+ *  culling.cull(batch, viewProjection, CULL_EARLY);
+ *  culling.draw();
+ *  hiz.build();
+ *  culling.cull(batch, viewProjection, CULL_LATE, &hiz);
+ *  culling.draw();
+ */
+
+#pragma once
+
+#include <vector>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "GLExtensions.h"
+#include "IndirectDraw.h"
+#include "MeshPool.h"
+#include "HiZPyramid.h"
+
+// Binding do storage buffer VisibleObjects
+const GLuint VISIBLE_OBJECTS_BINDING = 2;
+
+// Declaração GLSL da lista de visíveis, para o shader de vértice
+extern const char* const visibleObjectsGLSL;
+
+enum CullPhase
+{
+    CULL_ALL,     // só frustum, um passo
+    CULL_EARLY,   // frustum, só os visíveis no frame anterior
+    CULL_LATE     // frustum + Hi-Z em todos; desenha os que não saíram no CULL_EARLY
+};
+
+class GPUCulling
+{
+public:
+    // Compila o compute shader e envia as esferas das malhas (OpenGL 4.3)
+    explicit GPUCulling(MeshPool& pool);
+
+    GPUCulling(const GPUCulling&) = delete;
+    GPUCulling& operator=(const GPUCulling&) = delete;
+
+    bool valid() const { return program != 0; }
+
+    // Visibilidade entre frames para ids DrawData::object em [0, objectIds).
+    // Sem isto CULL_EARLY não desenha nada e CULL_LATE vale CULL_ALL.
+    void enableOcclusion(GLuint objectIds);
+
+    // Monta os comandos de desenho dos visíveis; batch.upload() já foi chamado.
+    // CULL_LATE sem pirâmide (hiz nulo ou vazio) só testa o frustum.
+    void cull(const IndirectBatch& batch, const glm::mat4& viewProjection, CullPhase phase = CULL_ALL,
+              const HiZPyramid* hiz = nullptr);
+
+    // Um comando por malha; retorna o número de chamadas de desenho (0 ou 1)
+    int draw();
+
+    // Visíveis no último cull. Lê da GPU e espera por ela: só para estatísticas.
+    GLuint readVisibleCount();
+
+    size_t objectCount() const { return objects; }
+
+    void clear();
+
+private:
+    MeshPool* pool;
+    GLuint program = 0;
+    GLint planesLocation = -1;
+    GLint objectCountLocation = -1;
+    GLint phaseLocation = -1;
+    GLint occlusionLocation = -1;
+    GLint viewProjectionLocation = -1;
+    GLint screenSizeLocation = -1;
+
+    GLuint meshBuffer = 0;      // esfera e faixa de índices de cada malha
+    GLuint commandBuffer = 0;   // um DrawElementsIndirectCommand por malha
+    GLuint visibleBuffer = 0;   // índices dos objetos visíveis, por malha
+    GLuint visibilityBuffer = 0;   // visível no frame anterior, por DrawData::object
+    GLuint objectIds = 0;
+
+    std::vector<DrawElementsIndirectCommand> resetCommands;
+    GLuint drawDataBuffer = 0;  // do lote do último cull
+    size_t objects = 0;
+    size_t capacity = 0;        // objetos por malha na lista de visíveis
+};
@@ -0,0 +1,83 @@
+/*
+ *  Pirâmide de profundidade máxima (Hi-Z) para occlusion culling na GPU
+ *
+ *  O frustum culling não descarta objetos escondidos atrás de outros. Com a
+ *  profundidade da cena já desenhada dá para testar um objeto inteiro de uma
+ *  vez: se o ponto mais próximo da sua caixa está mais longe que o ponto
+ *  mais distante de tudo o que foi desenhado no retângulo que ele ocupa na
+ *  tela, ele está escondido. Para esse "mais distante" custar poucas
+ *  leituras, build() monta num compute shader uma cadeia de mips em que cada
+ *  texel guarda o máximo dos 2x2 texels do nível anterior (em tamanhos
+ *  ímpares a última linha/coluna leva junto a sobra, para nenhum pixel
+ *  ficar de fora). O nível 0 tem metade da resolução da tela e o último é
+ *  1x1: qualquer retângulo cabe em 2x2 texels de algum nível.
+ *
+ *  A profundidade precisa estar numa textura, então a cena é desenhada no
+ *  framebuffer daqui (cor + profundidade GL_DEPTH_COMPONENT32F) e present()
+ *  copia a cor para a janela.
+ *
+ *  O texel de um pixel p da tela no nível L é min(p >> (L + 1), tamanho - 1),
+ *  que é como o teste de oclusão do GPUCulling (CULL_LATE) lê a pirâmide.
+ *
+ *  Forma de uso
+ *  ------------
+ *  HiZPyramid hiz;
+ *  // a cada frame:
+ *  hiz.resize(width, height);
+ *  glBindFramebuffer(GL_FRAMEBUFFER, hiz.framebuffer());
+ *  ...desenha os oclusores...
+ *  hiz.build();
+ *  ...culling com a pirâmide (textura hiz.texture(), níveis hiz.levels())...
+ *  hiz.present();
+ *  ...
+ *  hiz.clear();   // antes de glfwTerminate
+ */
+
+#pragma once
+
+#include <glad/glad.h>
+
+#include "GLExtensions.h"
+
+class HiZPyramid
+{
+public:
+    // Compila o compute shader da redução (OpenGL 4.3)
+    HiZPyramid();
+
+    HiZPyramid(const HiZPyramid&) = delete;
+    HiZPyramid& operator=(const HiZPyramid&) = delete;
+
+    bool valid() const { return program != 0; }
+
+    // Recria o framebuffer da cena e a pirâmide se o tamanho mudou
+    void resize(int width, int height);
+
+    // Framebuffer da cena: cor RGBA8 + profundidade em textura
+    GLuint framebuffer() const { return fbo; }
+
+    // Reduz a profundidade atual do framebuffer para a pirâmide
+    void build();
+
+    // Copia a cor da cena para o framebuffer 0 (e deixa o 0 vinculado)
+    void present();
+
+    GLuint texture() const { return pyramid; }
+    GLuint depthTexture() const { return depth; }
+    int levels() const { return levelCount; }
+    int width() const { return sceneWidth; }
+    int height() const { return sceneHeight; }
+
+    void clear();
+
+private:
+    GLuint program = 0;
+    GLint sourceLevelLocation = -1;
+
+    GLuint fbo = 0;
+    GLuint color = 0;
+    GLuint depth = 0;
+    GLuint pyramid = 0;
+    int sceneWidth = 0, sceneHeight = 0;
+    int levelCount = 0;
+};
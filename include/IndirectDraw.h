@@ -0,0 +1,117 @@
+/*
+ *  Desenho indireto em lote (glMultiDrawElementsIndirect)
+ *
+ *  Com um glDrawElements por objeto o custo de CPU cresce com o número de
+ *  objetos: cada chamada atualiza uniforms e passa pela validação do driver.
+ *  Aqui cada objeto vira um DrawElementsIndirectCommand num buffer da GPU
+ *  (GL_DRAW_INDIRECT_BUFFER) e os dados dele (model, material) um elemento
+ *  de um shader storage buffer. Um IndirectBatch por estado de pipeline
+ *  (programa + rasterização/depth/blend) desenha todos os seus objetos com
+ *  uma única chamada, sobre as malhas de um MeshPool.
+ *
+ *  O índice do desenho chega ao shader pelo atributo DRAW_ID_LOCATION do
+ *  MeshPool e não por gl_DrawID, que exige GLSL 4.60 ou
+ *  ARB_shader_draw_parameters: cada comando tem baseInstance = índice dos
+ *  seus dados, e o atributo por instância devolve esse mesmo número.
+ *
+ *  Os dados por desenho seguem o layout std430 de drawDataGLSL (80 bytes).
+ *  Os buffers são reespecificados (orphaning) e reenviados a cada upload.
+ *
+ *  Exige OpenGL 4.3 nos dois caminhos: os dados ficam num shader storage
+ *  buffer, e baseInstance nos comandos já é da 4.2. draw(false) emite um
+ *  glDrawElementsIndirect por comando, com os mesmos buffers: é o caminho
+ *  de depuração/comparação do custo das chamadas.
+ *
+ *  Forma de uso
+ *  ------------
+ *  string vs = string("#version 450 core\n") + uniformBlocksGLSL + drawDataGLSL + R"(
+ *  layout(location = 0) in vec3 aPos;
+ *  layout(location = 3) in uint drawId;   // DRAW_ID_LOCATION
+ *  void main() { gl_Position = projection * view * draws[drawId].model * vec4(aPos, 1.0); }
+ *  )";
+ *  ...
+ *  IndirectBatch batch(pool);
+ *  // a cada frame:
+ *  batch.reset();
+ *  batch.add(suzanne, model, material);
+ *  batch.upload();
+ *  glState().bindPipeline(pipeline);   // VAO = pool.vertexArray()
+ *  batch.draw();
+ *  ...
+ *  batch.clear();   // antes de glfwTerminate
+ */
+
+#pragma once
+
+#include <vector>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "GLExtensions.h"
+#include "MeshPool.h"
+
+// Binding do storage buffer DrawDataBuffer
+const GLuint DRAW_DATA_BINDING = 0;
+
+// Layout fixado pela GL (ver glDrawElementsIndirect)
+struct DrawElementsIndirectCommand
+{
+    GLuint count;
+    GLuint instanceCount;
+    GLuint firstIndex;
+    GLint baseVertex;
+    GLuint baseInstance;
+};
+
+// std430: mat4 + 4 uint, 80 bytes por elemento
+struct DrawData
+{
+    glm::mat4 model;
+    GLuint material;
+    GLuint mesh;
+    GLuint object;   // id estável entre frames (visibilidade do GPUCulling com oclusão)
+    GLuint padding;
+};
+
+// Declaração GLSL do buffer de DrawData, para concatenar após o #version
+extern const char* const drawDataGLSL;
+
+class IndirectBatch
+{
+public:
+    explicit IndirectBatch(MeshPool& pool) : pool(&pool) {}
+
+    IndirectBatch(const IndirectBatch&) = delete;
+    IndirectBatch& operator=(const IndirectBatch&) = delete;
+
+    // Esvazia as listas (começo do frame); os buffers continuam alocados
+    void reset();
+
+    void add(int mesh, const glm::mat4& model, GLuint material, GLuint object = 0);
+
+    // Envia comandos e dados para a GPU
+    void upload();
+
+    // Vincula os buffers e desenha; retorna o número de chamadas de desenho.
+    // Programa e VAO (pool.vertexArray()) já devem estar vinculados.
+    int draw(bool multiDraw = true);
+
+    size_t size() const { return commands.size(); }
+    const std::vector<DrawElementsIndirectCommand>& commandList() const { return commands; }
+    const std::vector<DrawData>& drawData() const { return data; }
+    GLuint commandBuffer() const { return indirectBuffer; }
+    GLuint drawDataBuffer() const { return dataBuffer; }
+
+    // Apaga os buffers (contexto ainda corrente)
+    void clear();
+
+private:
+    MeshPool* pool;
+    std::vector<DrawElementsIndirectCommand> commands;
+    std::vector<DrawData> data;
+
+    GLuint indirectBuffer = 0;
+    GLuint dataBuffer = 0;
+    size_t capacity = 0;   // em desenhos, nos dois buffers
+};
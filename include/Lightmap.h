@@ -0,0 +1,67 @@
+/*
+ *  Baker de lightmaps na CPU para cenas estáticas
+ *
+ *  Para cada texel do atlas de lightmap da superfície alvo, calcula a luz que
+ *  chega no ponto correspondente:
+ *    - ambiente constante (o mesmo termo ambientColor da Phong dos exercícios)
+ *    - luz direta das luzes pontuais, com raio de sombra até cada luz
+ *    - uma rebatida de luz indireta: raios com distribuição cosseno no
+ *      hemisfério; onde acertam outra superfície, soma a luz direta daquele
+ *      ponto multiplicada pelo albedo dela
+ *  Os raios usam uma TriangleBVH com todas as superfícies da cena e as
+ *  linhas do atlas são divididas entre as threads do ThreadPool.
+ *
+ *  O resultado é um fator de luz por texel (RGB linear): no runtime o shader
+ *  faz só cor = textura * lightmap, sem avaliar as luzes. Termos que dependem
+ *  da câmera (especular) não entram no lightmap.
+ *
+ *  Forma de uso
+ *  ------------
+ *  vector<LightmapSurface> scene(1);
+ *  scene[0].mesh = malha;  scene[0].lightmapUVs = uvs;   // UVs sem sobreposição
+ *  vector<glm::vec3> texels;
+ *  bakeLightmap(scene, 0, { { lightPos, glm::vec3(0.5f) } }, LightmapSettings(), texels);
+ *  saveLightmap("lightmap.png", 256, texels);
+ *  ...
+ *  // runtime: TextureHandle lm = textures.load("lightmap.png");
+ */
+
+#pragma once
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "ObjLoader.h"
+
+// Luz pontual sem atenuação, como nos exercícios (color = intensidade difusa)
+struct LightmapLight
+{
+    glm::vec3 position;
+    glm::vec3 color;
+};
+
+// Malha estática da cena, já em coordenadas de mundo
+struct LightmapSurface
+{
+    MeshData mesh;
+    std::vector<glm::vec2> lightmapUVs;   // uma por vértice; vazio = só bloqueia/rebate luz
+    glm::vec3 albedo = glm::vec3(0.7f);   // refletância usada na rebatida
+};
+
+struct LightmapSettings
+{
+    int size = 256;                        // atlas size x size
+    int bounceSamples = 128;               // raios de luz indireta por texel (0 = só direta)
+    int dilatePasses = 4;                  // margem ao redor das ilhas de UV
+    glm::vec3 ambient = glm::vec3(0.0f);
+};
+
+// Assa o lightmap da superfície scene[target]. texels recebe size * size
+// valores RGB lineares, linha 0 = v próximo de 0.
+void bakeLightmap(const std::vector<LightmapSurface>& scene, int target,
+                  const std::vector<LightmapLight>& lights, const LightmapSettings& settings,
+                  std::vector<glm::vec3>& texels);
+
+// Grava como PNG RGB8 (valores limitados a [0, 1]), já invertido para o loadTexture
+bool saveLightmap(const char* path, int size, const std::vector<glm::vec3>& texels);
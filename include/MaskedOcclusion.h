@@ -0,0 +1,146 @@
+/*
+ *  Occlusion culling na CPU com um rasterizador de profundidade mascarada
+ *
+ *  Alternativa ao Hi-Z (HiZPyramid.h) que não depende de ler nada da GPU e
+ *  roda igual com driver de software (llvmpipe): uns poucos oclusores são
+ *  rasterizados em baixa resolução (320x192 por padrão) num buffer de
+ *  profundidade próprio, e a caixa de cada objeto é testada contra ele antes
+ *  de o desenho ser gravado. Objetos escondidos não custam nem a gravação na
+ *  CPU nem o desenho na GPU.
+ *
+ *  O buffer não guarda uma profundidade por pixel. A tela é dividida em
+ *  tiles de 32x8 pixels, e cada tile tem:
+ *
+ *    mask   - um bit por pixel (uint32 por linha): pixels da camada de trabalho
+ *    zMax0  - profundidade máxima dos pixels marcados em mask
+ *    zMax1  - profundidade máxima de todos os pixels do tile (referência)
+ *
+ *  Cada triângulo soma sua cobertura a mask e sua profundidade máxima no tile
+ *  (do plano de profundidade nos cantos do tile) a zMax0. Quando mask fica
+ *  cheia, zMax0 vira a nova referência e a camada recomeça. Se um triângulo
+ *  chega bem mais perto que a camada de trabalho, ela é descartada e recomeça
+ *  com ele (descartar só perde informação, nunca a correção). São 40 bytes
+ *  por 256 pixels, e o teste de uma caixa lê um tile por vez.
+ *
+ *  A cobertura de um tile é calculada por linha: cada aresta do triângulo
+ *  limita x à esquerda ou à direita, e os limites das 8 linhas saem juntos
+ *  num registrador AVX2 (8 floats), viram inteiros e máscaras com shift
+ *  variável por lane (_mm256_sllv_epi32). Sem AVX2 o mesmo cálculo é feito
+ *  linha a linha (o SSE não tem shift variável por lane, então CULLING_SSE
+ *  usa o escalar aqui). O caminho segue bestCullingPath (FrustumCulling.h).
+ *
+ *  Com um ThreadPool, a transformação dos oclusores é dividida entre as
+ *  threads, e a rasterização também: cada thread fica com faixas de linhas
+ *  de tiles e percorre os triângulos na ordem em que foram adicionados, então
+ *  o resultado não depende do número de threads.
+ *
+ *  É conservador: testBox só diz "escondido" quando toda a caixa está atrás
+ *  do que foi rasterizado. Oclusores que atravessam o plano próximo ou o
+ *  distante são ignorados, e faces de trás (ordem horária na tela) também.
+ *
+ *  Forma de uso
+ *  ------------
+ *  MeshData cube; loadOBJ("../assets/Modelos3D/Cube.obj", cube);
+ *  OccluderMesh occluder = OccluderMesh::fromMeshData(cube);
+ *  MaskedOcclusion occlusion(&threads);
+ *  // a cada frame:
+ *  occlusion.clear();
+ *  occlusion.addOccluder(occluder, viewProjection * model);   // os maiores e mais próximos
+ *  occlusion.rasterize();
+ *  // (pode ser chamado de várias threads)
+ *  if (occlusion.testBox(boundsMin, boundsMax, viewProjection * model)) ...grava o desenho...
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "ObjLoader.h"
+#include "FrustumCulling.h"
+#include "ThreadPool.h"
+
+// Só posições e índices: é tudo o que o rasterizador lê
+struct OccluderMesh
+{
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> indices;   // 3 por triângulo, anti-horário na frente
+
+    static OccluderMesh fromMeshData(const MeshData& mesh);
+};
+
+class MaskedOcclusion
+{
+public:
+    static const int TILE_WIDTH = 32;
+    static const int TILE_HEIGHT = 8;
+
+    // Tamanho arredondado para múltiplos do tile
+    explicit MaskedOcclusion(ThreadPool* threads = nullptr, int width = 320, int height = 192);
+
+    // Caminhos sem suporte nesta CPU são ignorados
+    void setPath(CullingPath path);
+    CullingPath path() const { return selected; }
+
+    // Tudo no plano distante e nenhum oclusor
+    void clear();
+
+    // A malha precisa existir até rasterize()
+    void addOccluder(const OccluderMesh& mesh, const glm::mat4& modelViewProjection);
+
+    void rasterize();
+
+    // false se a caixa (espaço do modelo) está escondida com certeza
+    bool testBox(const glm::vec3& boxMin, const glm::vec3& boxMax, const glm::mat4& modelViewProjection) const;
+
+    // Profundidade conservadora por pixel (linha 0 embaixo), para depuração
+    void depthImage(std::vector<float>& out) const;
+
+    int width() const { return tilesX * TILE_WIDTH; }
+    int height() const { return tilesY * TILE_HEIGHT; }
+    size_t occluderCount() const { return occluders.size(); }
+    size_t triangleCount() const { return rasterizedTriangles; }
+    double lastRasterizeMs() const { return rasterizeMs; }
+
+    struct Tile
+    {
+        alignas(32) uint32_t mask[TILE_HEIGHT];
+        float zMax0;
+        float zMax1;
+    };
+
+    // Triângulo na tela (pixels, y para cima) pronto para rasterizar
+    struct Triangle
+    {
+        float edgeSlope[3], edgeOffset[3];   // x = slope * y + offset na aresta
+        int edgeSide[3];                     // 1 limita à esquerda, -1 à direita, 0 nenhum
+        float yMin, yMax;                    // limites das arestas horizontais
+        float zx, zy, z0;                    // plano de profundidade
+        float zMin, zMax;
+        int tileX0, tileY0, tileX1, tileY1;  // inclusivos; tileX0 > tileX1 = descartado
+    };
+
+private:
+    struct Occluder
+    {
+        const OccluderMesh* mesh;
+        glm::mat4 mvp;
+        size_t firstTriangle;
+    };
+
+    void setupOccluder(const Occluder& occluder);
+    void rasterizeTileRow(int tileY);
+
+    ThreadPool* threads;
+    CullingPath selected;
+    int tilesX, tilesY;
+    std::vector<Tile> tiles;
+    std::vector<Occluder> occluders;
+    std::vector<Triangle> triangles;
+    size_t pendingTriangles = 0;
+    size_t rasterizedTriangles = 0;
+    double rasterizeMs = 0.0;
+};
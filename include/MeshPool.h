@@ -0,0 +1,94 @@
+/*
+ *  Várias malhas num único VAO (VBO e EBO compartilhados)
+ *
+ *  Para desenhar objetos de malhas diferentes numa só chamada
+ *  (glMultiDrawElementsIndirect, ver IndirectDraw.h) todos precisam do mesmo
+ *  formato de vértice e dos mesmos buffers. O MeshPool concatena as malhas
+ *  lidas com loadOBJ: cada uma fica com uma faixa do EBO (firstIndex,
+ *  indexCount) e um baseVertex, que a GL soma a cada índice - os índices de
+ *  cada malha continuam começando em 0.
+ *
+ *  Atributos do VAO (formato MeshVertex):
+ *    0 posição, 1 normal, 2 coordenada de textura
+ *    DRAW_ID_LOCATION (3) índice do desenho: uint por instância (divisor 1)
+ *        lido de um buffer 0, 1, 2... Um comando indireto com baseInstance = i
+ *        entrega i ao shader, que o usa para indexar os dados por desenho.
+ *
+ *  As cópias na CPU são descartadas no upload; ficam só as faixas e os
+ *  volumes envolventes de cada malha (para culling).
+ *
+ *  Forma de uso
+ *  ------------
+ *  MeshPool pool;
+ *  int cubo = pool.addOBJ("../assets/Modelos3D/Cube.obj");
+ *  int suzanne = pool.addOBJ("../assets/Modelos3D/Suzanne.obj");
+ *  pool.upload();
+ *  ...
+ *  const MeshRange& r = pool.mesh(suzanne);
+ *  glState().bindVertexArray(pool.vertexArray());
+ *  glDrawElementsBaseVertex(GL_TRIANGLES, r.indexCount, GL_UNSIGNED_INT,
+ *                           (void*)(r.firstIndex * sizeof(GLuint)), r.baseVertex);
+ *  ...
+ *  pool.clear();   // antes de glfwTerminate
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "ObjLoader.h"
+
+const GLuint DRAW_ID_LOCATION = 3;
+
+struct MeshRange
+{
+    std::string name;
+    GLuint firstIndex = 0;    // em índices, não bytes
+    GLuint indexCount = 0;
+    GLint baseVertex = 0;
+
+    // Volumes no espaço do modelo
+    glm::vec3 boundsMin = glm::vec3(0.0f);
+    glm::vec3 boundsMax = glm::vec3(0.0f);
+    glm::vec3 center = glm::vec3(0.0f);   // esfera envolvente
+    float radius = 0.0f;
+};
+
+class MeshPool
+{
+public:
+    MeshPool() = default;
+    MeshPool(const MeshPool&) = delete;
+    MeshPool& operator=(const MeshPool&) = delete;
+
+    // Índice da malha, ou -1 se o arquivo não puder ser lido
+    int addOBJ(const std::string& path);
+    int add(const MeshData& mesh, const std::string& name);
+
+    // Cria VBO, EBO e VAO com tudo o que foi adicionado (uma vez)
+    void upload();
+
+    // Garante ao menos 'count' índices de desenho no atributo DRAW_ID_LOCATION
+    void reserveDrawIds(GLuint count);
+
+    const MeshRange& mesh(int id) const { return meshes[id]; }
+    int meshCount() const { return (int)meshes.size(); }
+    GLuint vertexArray() const { return vao; }
+    GLuint drawIdCapacity() const { return drawIds; }
+
+    // Apaga os buffers e o VAO (contexto ainda corrente)
+    void clear();
+
+private:
+    std::vector<MeshRange> meshes;
+    std::vector<MeshVertex> vertices;
+    std::vector<GLuint> indices;
+
+    GLuint vao = 0, vbo = 0, ebo = 0;
+    GLuint drawIdBuffer = 0;
+    GLuint drawIds = 0;
+};
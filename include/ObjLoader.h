@@ -0,0 +1,46 @@
+/*
+ *  Leitura de arquivos Wavefront .OBJ para a CPU
+ *
+ *  Versão do loadSimpleOBJ (Code snippets) que guarda a malha em memória em
+ *  vez de criar o VAO direto: vértices sem repetição (cada combinação
+ *  posição/uv/normal vira um vértice) e índices de triângulos. Polígonos com
+ *  mais de 3 lados são triangulados em leque. Serve para ferramentas que
+ *  processam a geometria na CPU (baker de mapas, BVH) e para montar VBOs.
+ *
+ *  Forma de uso
+ *  ------------
+ *  MeshData mesh;
+ *  if (!loadOBJ("../assets/Modelos3D/Suzanne.obj", mesh)) ...
+ *  computeTangents(mesh);   // opcional: base tangente por vértice
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+struct MeshVertex
+{
+    glm::vec3 position;
+    glm::vec3 normal;
+    glm::vec2 texCoord;
+};
+
+struct MeshData
+{
+    std::vector<MeshVertex> vertices;
+    std::vector<unsigned int> indices;   // 3 por triângulo
+    std::vector<glm::vec4> tangents;     // xyz = tangente, w = sinal da bitangente
+
+    size_t triangleCount() const { return indices.size() / 3; }
+};
+
+// Retorna false se o arquivo não puder ser lido. Normais ausentes no arquivo
+// são calculadas pela média das normais das faces.
+bool loadOBJ(const std::string& filePath, MeshData& mesh);
+
+// Tangentes por vértice a partir das coordenadas de textura (acumuladas por
+// face e ortogonalizadas com a normal); bitangente = cross(N, T) * w
+void computeTangents(MeshData& mesh);
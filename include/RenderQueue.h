@@ -0,0 +1,140 @@
+/*
+ *  Fila de desenho ordenada por chave de 64 bits (radix sort)
+ *
+ *  Sem ordem explícita os desenhos saem na ordem do laço que os gera, e cada
+ *  troca de programa, material ou VAO entre dois objetos vizinhos custa uma
+ *  mudança de estado. Aqui cada desenho entra na fila com uma chave de 64
+ *  bits e o índice dos seus dados (no vetor do chamador); a fila é ordenada
+ *  pela chave e executada nessa ordem.
+ *
+ *  Campos da chave, do mais significativo ao menos:
+ *
+ *    opacos:       passo(4) | 0 | programa(10) | material(16) | geometria(10) | profundidade(23)
+ *    translúcidos: passo(4) | 1 | ~profundidade(23) | programa(10) | material(16) | geometria(10)
+ *
+ *  - Opacos agrupam por estado e, dentro do mesmo estado, vão da frente para
+ *    trás (early-Z descarta os fragmentos escondidos).
+ *  - Translúcidos vêm depois dos opacos do mesmo passo e vão de trás para a
+ *    frente (a profundidade invertida vem antes do estado: a composição
+ *    correta vale mais que as trocas de estado).
+ *
+ *  Programa, material e geometria são ids compactos escolhidos pelo chamador
+ *  (índice do pipeline, do material, da malha ou do VAO; nomes GL também
+ *  servem, são números pequenos) e são truncados à largura do campo: uma
+ *  colisão só custa trocas de estado a mais, nunca um desenho errado, porque
+ *  o estado de verdade vem dos dados do desenho. A profundidade é a
+ *  distância na direção da câmera normalizada para [0, 1] (por exemplo
+ *  dividida pelo far plane).
+ *
+ *  A ordenação é um radix sort LSD estável só sobre os bits que variam entre
+ *  as chaves (submit() já os acumula). Numa cena com poucos programas,
+ *  materiais e malhas são 25-30 bits: cabem em 32, e a fila ordena pares de
+ *  8 bytes (chave compactada, índice) em vez dos itens de 16, com dígitos de
+ *  até 16 bits, ou seja 2 passadas. Uma leitura compacta as chaves e conta
+ *  os histogramas das duas; a última passada já escreve os itens com a chave
+ *  original de volta. Com BMI2 compactar e restaurar é uma instrução cada
+ *  (pext/pdep). Com mais de 32 bits variando, as passadas são de 11 bits
+ *  sobre os itens inteiros, pulando os dígitos que não variam.
+ *  lastSortMs() dá o tempo da última.
+ *
+ *  Forma de uso
+ *  ------------
+ *  RenderQueue queue;
+ *  // a cada frame:
+ *  queue.clear();
+ *  for (i...)
+ *      queue.submit(makeRenderKey(0, false, pipelineId, material, mesh, depth / farPlane), i);
+ *  queue.sort();
+ *  queue.execute([&](uint32_t i, uint32_t changed) {
+ *      if (changed & RENDER_KEY_PROGRAM) ...vincula o pipeline do objeto i...
+ *      ...desenha o objeto i...
+ *  });
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+const int RENDER_KEY_PASS_BITS = 4;
+const int RENDER_KEY_PROGRAM_BITS = 10;
+const int RENDER_KEY_MATERIAL_BITS = 16;
+const int RENDER_KEY_GEOMETRY_BITS = 10;
+const int RENDER_KEY_DEPTH_BITS = 23;
+
+// Campos que mudaram entre dois desenhos seguidos (ver renderKeyChanges)
+enum RenderKeyField
+{
+    RENDER_KEY_PASS = 1 << 0,
+    RENDER_KEY_TRANSLUCENT = 1 << 1,
+    RENDER_KEY_PROGRAM = 1 << 2,
+    RENDER_KEY_MATERIAL = 1 << 3,
+    RENDER_KEY_GEOMETRY = 1 << 4,
+    RENDER_KEY_ALL = (1 << 5) - 1
+};
+
+// depth em [0, 1] (valores fora são limitados)
+uint64_t makeRenderKey(unsigned pass, bool translucent, unsigned program, unsigned material, unsigned geometry,
+                       float depth);
+
+// RenderKeyField dos campos de estado diferentes entre as duas chaves
+uint32_t renderKeyChanges(uint64_t previous, uint64_t key);
+
+struct RenderQueueItem
+{
+    uint64_t key;
+    uint32_t index;
+};
+
+class RenderQueue
+{
+public:
+    void clear() { items.clear(); varying = 0; }
+    void reserve(size_t count) { items.reserve(count); }
+    void submit(uint64_t key, uint32_t index)
+    {
+        if (items.empty()) first = key;
+        varying |= key ^ first;
+        items.push_back({ key, index });
+    }
+
+    // Ordena por chave, estável (chaves iguais mantêm a ordem de submit)
+    void sort();
+
+    // draw(index, changed): changed tem os RenderKeyField que mudaram desde
+    // o desenho anterior (RENDER_KEY_ALL no primeiro). Retorna quantos
+    // desenhos tiveram alguma mudança de estado.
+    template <typename Draw>
+    size_t execute(Draw&& draw) const
+    {
+        size_t stateChanges = 0;
+        for (size_t i = 0; i < items.size(); i++)
+        {
+            uint32_t changed = i == 0 ? (uint32_t)RENDER_KEY_ALL : renderKeyChanges(items[i - 1].key, items[i].key);
+            if (changed) stateChanges++;
+            draw(items[i].index, changed);
+        }
+        return stateChanges;
+    }
+
+    size_t size() const { return items.size(); }
+    const std::vector<RenderQueueItem>& sorted() const { return items; }
+
+    // Duração da última ordenação
+    double lastSortMs() const { return sortMs; }
+    int lastSortPasses() const { return sortPasses; }
+
+private:
+    void sortPacked(int bits);
+    void sortWide();
+
+    std::vector<RenderQueueItem> items;
+    uint64_t first = 0;
+    uint64_t varying = 0;   // bits diferentes entre as chaves da fila
+    std::vector<RenderQueueItem> scratch;
+    std::vector<uint64_t> packed, packedScratch;
+    std::vector<uint32_t> histogramScratch;
+    double sortMs = 0.0;
+    int sortPasses = 0;
+};
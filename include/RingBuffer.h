@@ -0,0 +1,119 @@
+/*
+ *  Buffer em anel mapeado persistentemente para dados dinâmicos por frame
+ *
+ *  Com glBufferSubData (UniformBuffer) cada atualização passa por uma cópia
+ *  do driver, e se a GPU ainda lê a região anterior o driver precisa
+ *  sincronizar ou guardar outra cópia por conta própria. Aqui um único
+ *  buffer com armazenamento imutável (glBufferStorage, OpenGL 4.4) fica
+ *  mapeado o tempo todo (GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT): o
+ *  envio vira um memcpy direto para a memória que a GPU lê.
+ *
+ *  O buffer é dividido em N regiões, uma por frame em voo. Cada frame
+ *  escreve só na sua região; endFrame põe uma fence (glFenceSync) depois
+ *  dos comandos do frame, e beginFrame, antes de reaproveitar a região N
+ *  frames depois, espera essa fence (glClientWaitSync). Com N = 3 a CPU
+ *  quase nunca espera: a GPU já terminou o frame de dois atrás.
+ *
+ *  allocate devolve o ponteiro para escrever e o deslocamento no buffer,
+ *  que serve para glBindBufferRange (uniform/storage, alinhado ao que a GL
+ *  exige em allocateUniform/allocateStorage) ou como primeiro vértice
+ *  (alinhado ao tamanho do vértice: first = offset / stride).
+ *
+ *  Sem OpenGL 4.4, ou com a gravação de GLCapture.h pedida (as escritas num
+ *  mapeamento persistente não passam por nenhuma chamada GL, então não
+ *  entrariam no arquivo), o anel usa uma cópia na CPU: allocate devolve
+ *  memória comum e flush() envia o que foi escrito com glBufferSubData.
+ *  O código que usa o anel chama flush() antes dos desenhos nos dois casos
+ *  (no modo persistente não faz nada).
+ *
+ *  Forma de uso
+ *  ------------
+ *  RingBuffer ring(64 * 1024, 3, "dados por frame");
+ *  // a cada frame:
+ *  ring.beginFrame();
+ *  RingAllocation a = ring.allocateUniform(sizeof(FrameUniforms));
+ *  memcpy(a.pointer, &frame, sizeof(FrameUniforms));
+ *  ring.flush();
+ *  glState().bindBufferRange(GL_UNIFORM_BUFFER, FRAME_UNIFORMS_BINDING, ring.buffer(), a.offset, a.size);
+ *  ...desenhos...
+ *  ring.endFrame();
+ *  ...
+ *  ring.clear();   // antes de glfwTerminate
+ */
+
+#pragma once
+
+#include <cstring>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "GLExtensions.h"
+
+struct RingAllocation
+{
+    void* pointer = nullptr;   // nullptr: não coube na região do frame
+    GLintptr offset = 0;       // no buffer inteiro
+    GLsizeiptr size = 0;
+
+    explicit operator bool() const { return pointer != nullptr; }
+};
+
+class RingBuffer
+{
+public:
+    // frameSize bytes por frame em voo
+    RingBuffer(GLsizeiptr frameSize, int framesInFlight = 3, const char* label = "RingBuffer");
+
+    RingBuffer(const RingBuffer&) = delete;
+    RingBuffer& operator=(const RingBuffer&) = delete;
+
+    // Espera a GPU liberar a região deste frame e recomeça nela
+    void beginFrame();
+
+    // offset múltiplo de alignment (qualquer valor > 0, não só potências de 2)
+    RingAllocation allocate(GLsizeiptr size, GLsizeiptr alignment = 16);
+    RingAllocation allocateUniform(GLsizeiptr size) { return allocate(size, uniformAlignment); }
+    RingAllocation allocateStorage(GLsizeiptr size) { return allocate(size, storageAlignment); }
+
+    template <typename T>
+    RingAllocation pushUniform(const T& value)
+    {
+        RingAllocation a = allocateUniform(sizeof(T));
+        if (a) memcpy(a.pointer, &value, sizeof(T));
+        return a;
+    }
+
+    // Envia o que foi escrito desde o último flush (só no modo com cópia)
+    void flush();
+
+    // Fence depois dos comandos que leem a região deste frame
+    void endFrame();
+
+    GLuint buffer() const { return id; }
+    bool persistent() const { return mapped != nullptr; }
+    GLsizeiptr frameSize() const { return regionSize; }
+    GLsizeiptr frameUsed() const { return cursor - regionStart(); }
+
+    // Vezes que beginFrame precisou esperar a GPU, e quanto tempo no total
+    unsigned long long waits() const { return waitCount; }
+    double waitedMs() const { return waitMs; }
+
+    void clear();
+
+private:
+    GLintptr regionStart() const { return (GLintptr)(frame % frames.size()) * regionSize; }
+
+    GLuint id = 0;
+    GLsizeiptr regionSize;
+    GLsizeiptr uniformAlignment = 256;
+    GLsizeiptr storageAlignment = 256;
+    unsigned char* mapped = nullptr;        // modo persistente
+    std::vector<unsigned char> staging;     // modo com cópia
+    std::vector<GLsync> frames;             // fence de cada região (0 = livre)
+    unsigned long long frame = 0;
+    GLintptr cursor = 0;
+    GLintptr flushed = 0;
+    unsigned long long waitCount = 0;
+    double waitMs = 0.0;
+};
@@ -0,0 +1,59 @@
+/*
+ *  Criação de programas de shader com cache de binários em disco
+ *
+ *  createProgram compila e linka o par vertex/fragment como os exercícios já
+ *  faziam, mas antes procura o programa no cache: a chave é um hash FNV-1a
+ *  dos fontes, dos #defines e do driver (GL_VENDOR, GL_RENDERER, GL_VERSION).
+ *  Se houver binário salvo, ele é carregado com glProgramBinary e nenhuma
+ *  compilação acontece. Se não houver (primeira execução, shader editado,
+ *  driver atualizado) ou se o driver recusar o binário, o programa é
+ *  compilado do fonte e o resultado de glGetProgramBinary é salvo para a
+ *  próxima execução.
+ *
+ *  Sem OpenGL 4.1 ou sem formatos de binário no driver, só compila.
+ *  Com CG_SHADER_CACHE_LOG=1 cada programa imprime se veio do cache ou foi
+ *  compilado, e quanto tempo levou.
+ *
+ *  Forma de uso (depois de loadGLExtensions)
+ *  -----------------------------------------
+ *  GLuint program = createProgram(vertexShaderSource, fragmentShaderSource);
+ *  GLuint variante = createProgram(vs, fs, { "USE_TEXTURE", "LIGHT_COUNT 2" });
+ *  GLuint culling = createComputeProgram(computeSource);   // OpenGL 4.3
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include <glad/glad.h>
+
+// Retorna o programa linkado, ou 0 se a compilação/link falhar (erro no console).
+// Cada define ("NOME" ou "NOME VALOR") vira uma linha #define logo após o #version.
+GLuint createProgram(const char* vertexSource, const char* fragmentSource,
+                     const std::vector<std::string>& defines = {});
+
+// Programa só com um compute shader (OpenGL 4.3), com o mesmo cache
+GLuint createComputeProgram(const char* computeSource, const std::vector<std::string>& defines = {});
+
+// Pasta dos binários (padrão "shader_cache", relativa à pasta de execução).
+// String vazia desativa o cache.
+void setShaderCacheDirectory(const std::string& path);
+
+// Insere as linhas #define depois da diretiva #version do fonte
+std::string injectDefines(const char* source, const std::vector<std::string>& defines);
+
+// --- Acesso ao cache, usado também pelo ShaderManager ---
+
+// true se há pasta de cache configurada e o driver exporta binários (GL 4.1)
+bool shaderCacheAvailable();
+
+// Chave do programa: fontes (já com os #defines) + strings do driver
+uint64_t shaderCacheKey(const std::string& vertexSource, const std::string& fragmentSource);
+
+// Programa linkado a partir do binário salvo, ou 0 se não houver / o driver recusar
+GLuint loadCachedProgram(uint64_t key);
+
+// Grava o binário de um programa já linkado com sucesso
+void saveCachedProgram(uint64_t key, GLuint program);
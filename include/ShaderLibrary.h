@@ -0,0 +1,100 @@
+/*
+ *  Shaders em arquivos, com #include e recarga automática
+ *
+ *  Os fontes ficam em assets/shaders. O pré-processador resolve
+ *  #include "arquivo" (relativo ao arquivo que inclui) antes de entregar o
+ *  fonte ao driver; cada arquivo entra uma vez só e ganha um número de fonte
+ *  nas diretivas #line, então um erro "1(12)" no log é a linha 12 do arquivo
+ *  1 (a tabela de números é impressa quando a compilação falha).
+ *  Além dos arquivos do disco existem includes registrados pelo código, como
+ *  "UniformBuffers.glsl" com os blocos de UniformBuffers.h.
+ *
+ *  Todos os arquivos lidos são observados pelo FileWatcher. Quando um muda,
+ *  update() pré-processa de novo e envia ao ShaderManager, que compila em
+ *  paralelo sem bloquear o frame. O programa em uso só é trocado depois de
+ *  um link bem-sucedido: com erro no shader o anterior continua na tela.
+ *
+ *  Samplers devem usar layout(binding = N): assim um programa recarregado já
+ *  nasce com as unidades de textura certas. Se precisar de configuração após
+ *  cada troca, compare version(id) com o valor do frame anterior.
+ *
+ *  Forma de uso
+ *  ------------
+ *  ShaderManager manager;
+ *  ShaderLibrary library(manager);
+ *  int phong = library.load("../assets/shaders/phong.vert", "../assets/shaders/phong.frag");
+ *  while (...)
+ *  {
+ *      library.update();
+ *      if (GLuint program = library.program(phong)) { glUseProgram(program); ... }
+ *  }
+ *  library.clear();
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+
+#include <glad/glad.h>
+
+#include "ShaderManager.h"
+#include "FileWatcher.h"
+
+class ShaderLibrary
+{
+public:
+    explicit ShaderLibrary(ShaderManager& manager);
+
+    // Conteúdo servido por #include "name" sem arquivo no disco
+    void addInclude(const std::string& name, const std::string& source);
+
+    // Lê, pré-processa e envia para compilação; retorna o id do programa
+    int load(const std::string& vertexPath, const std::string& fragmentPath,
+             const std::vector<std::string>& defines = {});
+
+    // Programa em uso (o anterior até a versão nova linkar); 0 antes do primeiro link
+    GLuint program(int id);
+    const ProgramReflection& reflection(int id) const { return programs[id].reflection; }
+
+    // Incrementa a cada troca de programa
+    int version(int id) const { return programs[id].version; }
+
+    // Uma vez por frame: recompila o que mudou e troca o que ficou pronto
+    void update();
+
+    // Apaga todos os programas (contexto ainda corrente)
+    void clear();
+
+    // Resolve os #include de path. sources recebe os nomes na ordem dos
+    // números de fonte usados nas diretivas #line.
+    bool preprocess(const std::string& path, std::string& source, std::vector<std::string>& sources);
+
+private:
+    struct Program
+    {
+        std::string vertexPath;
+        std::string fragmentPath;
+        std::vector<std::string> defines;
+        std::vector<std::string> vertexSources;
+        std::vector<std::string> fragmentSources;
+        std::set<std::string> files;          // arquivos observados (normalizados)
+        GLuint active = 0;
+        ProgramReflection reflection;
+        int pending = -1;                     // id no ShaderManager da versão compilando
+        bool dirty = false;                   // mudou de novo enquanto compilava
+        int version = 0;
+    };
+
+    bool preprocessFile(const std::string& path, std::string& out, std::vector<std::string>& sources,
+                        std::set<std::string>& included, bool topLevel);
+    void submit(Program& program);
+    void finish(Program& program);
+
+    ShaderManager& manager;
+    FileWatcher watcher;
+    std::map<std::string, std::string> includes;
+    std::vector<Program> programs;
+};
@@ -0,0 +1,111 @@
+/*
+ *  Compilação de shaders em paralelo, sem bloquear a thread de render
+ *
+ *  createProgram (Shader.h) consulta GL_COMPILE_STATUS/GL_LINK_STATUS logo
+ *  depois de cada chamada, o que obriga o driver a terminar a compilação ali
+ *  mesmo: os programas saem um de cada vez e a inicialização espera por todos.
+ *
+ *  O ShaderManager separa o pedido do resultado. submit() só dispara
+ *  glCompileShader/glLinkProgram e volta na hora; o status é consultado
+ *  depois, com GL_COMPLETION_STATUS_KHR, que não bloqueia. Com
+ *  GL_KHR_parallel_shader_compile (ou a ARB) o driver usa várias threads de
+ *  compilação (glMaxShaderCompilerThreadsKHR), e enquanto isso o programa
+ *  carrega texturas, malhas etc. Cada programa só é usado quando program()
+ *  deixa de retornar 0.
+ *
+ *  Sem a extensão o comportamento é o mesmo, mas a primeira consulta de
+ *  status bloqueia até aquele programa ficar pronto. Programas encontrados
+ *  no cache de binários (Shader.h) ficam prontos já no submit.
+ *
+ *  Forma de uso
+ *  ------------
+ *  ShaderManager shaders;                       // depois de loadGLExtensions
+ *  int phong = shaders.submit(vs, fs);
+ *  int sombra = shaders.submit(vsSombra, fsSombra);
+ *  ... carrega texturas e malhas ...
+ *  while (...)
+ *  {
+ *      shaders.poll();
+ *      if (GLuint program = shaders.program(phong)) { glUseProgram(program); ... }
+ *  }
+ *  shaders.clear();
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+
+#include <glad/glad.h>
+
+#include "UniformBuffers.h"
+
+class ShaderManager
+{
+public:
+    ShaderManager();
+    ~ShaderManager() = default;
+
+    // Dispara a compilação e o link sem esperar; retorna o id do programa
+    int submit(const char* vertexSource, const char* fragmentSource,
+               const std::vector<std::string>& defines = {});
+
+    // Atualiza todos os programas pendentes. Retorna true quando não resta nenhum.
+    bool poll();
+
+    // Não bloqueia se o driver tiver a extensão
+    bool isReady(int id);
+    bool failed(int id) const { return entries[id].state == Failed; }
+
+    // Programa linkado, ou 0 enquanto não estiver pronto (ou se falhou)
+    GLuint program(int id);
+
+    // Locations e blocos lidos uma vez, quando o programa ficou pronto
+    const ProgramReflection& reflection(int id) const { return entries[id].reflection; }
+
+    // Entrega o programa a quem chamou: clear() não o apaga mais.
+    // Bloqueia se ainda não estiver pronto; 0 se falhou.
+    GLuint release(int id);
+
+    // Libera o id (e apaga o programa, se ainda for do manager); o próximo
+    // submit reaproveita a entrada. Para quem recompila o mesmo programa
+    // várias vezes, como o hot reload do ShaderLibrary.
+    void remove(int id);
+
+    // Bloqueia até o programa (ou todos) terminar
+    GLuint wait(int id);
+    void waitAll();
+
+    bool parallel() const { return parallelCompile; }
+    int pendingCount() const;
+
+    // Apaga todos os programas (contexto ainda corrente)
+    void clear();
+
+private:
+    enum State { Linking, Ready, Failed, Free };
+
+    struct Entry
+    {
+        GLuint vertexShader = 0;
+        GLuint fragmentShader = 0;
+        GLuint program = 0;
+        State state = Linking;
+        bool cached = false;
+        uint64_t cacheKey = 0;
+        ProgramReflection reflection;
+    };
+
+    int store(const Entry& entry);
+    void update(Entry& entry, bool block);
+    void finish(Entry& entry);
+
+    std::vector<Entry> entries;
+    std::vector<int> freeIds;
+    bool parallelCompile = false;
+    bool useCache = false;
+    bool reported = true;
+    std::chrono::steady_clock::time_point firstSubmit;
+};
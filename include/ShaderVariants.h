@@ -0,0 +1,74 @@
+/*
+ *  Variantes de um shader escolhidas por bits de recurso
+ *
+ *  Um único par de arquivos (o "ubershader") é escrito com #ifdef para cada
+ *  recurso opcional. Cada combinação de bits é uma chave (VariantKey) que
+ *  vira uma lista de #define e um programa próprio, compilado uma vez e
+ *  guardado no cache por chave. Assim cada material roda um programa só com
+ *  o que usa, sem desvios mortos no shader: o número de luzes, por exemplo,
+ *  é uma constante e o laço é desenrolado pelo compilador.
+ *
+ *    FEATURE_TEXTURE       USE_TEXTURE       textura difusa na unidade 0
+ *    FEATURE_VERTEX_COLOR  USE_VERTEX_COLOR  cor por vértice (location 1)
+ *    FEATURE_NORMAL_MAP    USE_NORMAL_MAP    normal map na unidade 2
+ *    luzes (1..MAX_LIGHTS) LIGHT_COUNT n     primeiras n de lightPositions
+ *
+ *  prewarm() envia de uma vez as variantes declaradas, que compilam em
+ *  paralelo durante a carga. Uma chave fora do conjunto é compilada na
+ *  primeira vez que é pedida. Os programas vêm da ShaderLibrary, então
+ *  editar o arquivo recarrega todas as variantes.
+ *
+ *  Forma de uso
+ *  ------------
+ *  ShaderVariants phong(library, "phong.vert", "phong.frag");
+ *  phong.prewarm({ variantKey(FEATURE_TEXTURE, 1), variantKey(FEATURE_TEXTURE | FEATURE_NORMAL_MAP, 1) });
+ *  ...
+ *  VariantKey key = variantKey(material.normalMap ? FEATURE_TEXTURE | FEATURE_NORMAL_MAP : FEATURE_TEXTURE, 1);
+ *  if (GLuint program = phong.program(key)) { ... }
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+#include "ShaderLibrary.h"
+
+enum ShaderFeature : uint32_t
+{
+    FEATURE_TEXTURE      = 1u << 0,
+    FEATURE_VERTEX_COLOR = 1u << 1,
+    FEATURE_NORMAL_MAP   = 1u << 2,
+};
+
+// Bits 0..7 recursos, bits 8..11 número de luzes
+typedef uint32_t VariantKey;
+
+VariantKey variantKey(uint32_t features, int lightCount = 1);
+
+class ShaderVariants
+{
+public:
+    ShaderVariants(ShaderLibrary& library, const std::string& vertexPath, const std::string& fragmentPath);
+
+    // Envia todas as variantes para compilação sem esperar nenhuma
+    void prewarm(const std::vector<VariantKey>& keys);
+
+    // Programa da variante; 0 enquanto compila (a compilação começa na primeira chamada)
+    GLuint program(VariantKey key);
+
+    size_t size() const { return variants.size(); }
+
+    static std::vector<std::string> defines(VariantKey key);
+    static std::string describe(VariantKey key);   // ex.: "TEXTURE+NORMAL_MAP, 2 luzes"
+
+private:
+    int variant(VariantKey key);
+
+    ShaderLibrary& library;
+    std::string vertexPath;
+    std::string fragmentPath;
+    std::unordered_map<VariantKey, int> variants;   // chave -> id na ShaderLibrary
+};
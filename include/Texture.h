@@ -0,0 +1,64 @@
+/*
+ *  Carregamento de texturas e cache de samplers
+ *
+ *  As texturas são criadas com armazenamento imutável (glTextureStorage2D) e
+ *  preenchidas com DSA (glTextureSubImage2D), sem precisar vinculá-las para
+ *  editar. A filtragem e o wrap ficam em sampler objects compartilhados: cada
+ *  combinação de parâmetros é criada uma única vez (glCreateSamplers) e
+ *  reutilizada por todas as texturas, assim o driver valida o estado uma vez.
+ *
+ *  Em contextos sem OpenGL 4.5 cai para glTexImage2D + glGenSamplers.
+ *
+ *  Forma de uso
+ *  ------------
+ *  GLuint tex = loadTexture("../assets/tex/pixelWall.png");
+ *  GLuint sampler = getSampler(SamplerDesc());       // trilinear + repeat
+ *  bindTexture(0, tex, sampler);                      // unidade 0 (fora do loop)
+ *  ...
+ *  deleteSamplers();                                  // ao final
+ */
+
+#pragma once
+
+#include <glad/glad.h>
+
+struct SamplerDesc
+{
+    GLenum minFilter = GL_LINEAR_MIPMAP_LINEAR;
+    GLenum magFilter = GL_LINEAR;
+    GLenum wrapS = GL_REPEAT;
+    GLenum wrapT = GL_REPEAT;
+    float maxAnisotropy = 1.0f;
+
+    SamplerDesc() = default;
+    SamplerDesc(GLenum minF, GLenum magF, GLenum wrap = GL_REPEAT)
+        : minFilter(minF), magFilter(magF), wrapS(wrap), wrapT(wrap) {}
+
+    bool operator==(const SamplerDesc& o) const
+    {
+        return minFilter == o.minFilter && magFilter == o.magFilter &&
+               wrapS == o.wrapS && wrapT == o.wrapT && maxAnisotropy == o.maxAnisotropy;
+    }
+};
+
+// Carrega a imagem com stb_image e cria uma textura imutável com a cadeia
+// completa de mipmaps. Retorna 0 em caso de erro.
+GLuint loadTexture(const char* path, bool flipVertically = true);
+
+// Cria uma textura imutável a partir de pixels já carregados (1 a 4 canais)
+GLuint createTexture(int width, int height, int channels, const unsigned char* pixels, bool mipmaps = true);
+
+// Aloca armazenamento imutável (sem dados) com o número de níveis pedido
+GLuint allocateTexture(int width, int height, GLsizei levels, GLenum internalFormat);
+
+// Formatos de 8 bits por canal para 1 a 4 canais, e tamanho da cadeia de mipmaps
+void textureFormat(int channels, GLenum& internalFormat, GLenum& format);
+GLsizei mipLevelCount(int width, int height);
+
+// Sampler compartilhado para a combinação de parâmetros (criado na primeira chamada)
+GLuint getSampler(const SamplerDesc& desc = SamplerDesc());
+void deleteSamplers();
+
+// Vincula textura e sampler em uma unidade (glBindTextureUnit + glBindSampler),
+// pelo cache de GLState.h: não faz nada se os dois já estão na unidade
+void bindTexture(GLuint unit, GLuint texture, GLuint sampler);
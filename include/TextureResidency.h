@@ -0,0 +1,128 @@
+/*
+ *  Gerência de residência de texturas com orçamento de memória de vídeo
+ *
+ *  Cada textura carregada é registrada com o frame em que foi usada pela
+ *  última vez. Ao final de cada frame, se a soma das texturas residentes
+ *  passar do orçamento, as menos usadas recentemente (LRU) perdem primeiro
+ *  seus mips maiores (a textura é recriada a partir do nível seguinte) e,
+ *  quando já estão pequenas, são removidas por completo (passam a usar uma
+ *  textura 1x1 cinza no lugar). Quando uma textura rebaixada volta a ser
+ *  usada e há espaço no orçamento, o arquivo é decodificado de novo em uma
+ *  thread separada e a versão completa é enviada à GPU.
+ *
+ *  Como o nome OpenGL da textura muda ao rebaixar/restaurar, o código usa
+ *  um TextureHandle e pede o nome atual a cada frame (use ou bind).
+ *
+ *  Forma de uso
+ *  ------------
+ *  TextureResidency textures(64 * 1024 * 1024);   // orçamento de 64 MB
+ *  TextureHandle tex = textures.load("../assets/tex/pixelWall.png");
+ *  ...
+ *  // no loop:
+ *  textures.bind(0, tex, sampler);
+ *  ...desenho...
+ *  textures.endFrame();
+ *  ...
+ *  textures.clear();   // antes de glfwTerminate
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include <glad/glad.h>
+
+typedef int TextureHandle;
+const TextureHandle INVALID_TEXTURE = -1;
+
+class TextureResidency
+{
+public:
+    explicit TextureResidency(size_t budgetBytes = 256u * 1024u * 1024u);
+    ~TextureResidency();
+
+    TextureResidency(const TextureResidency&) = delete;
+    TextureResidency& operator=(const TextureResidency&) = delete;
+
+    void setBudget(size_t bytes) { budget = bytes; }
+    size_t getBudget() const { return budget; }
+    size_t residentBytes() const { return totalBytes; }
+
+    // Texturas menores que isso não perdem mais mips: são removidas inteiras
+    void setMinDimension(int pixels) { minDimension = pixels; }
+
+    TextureHandle load(const char* path, bool flipVertically = true);
+    void release(TextureHandle handle);
+
+    // Marca o uso neste frame e retorna o nome OpenGL atual
+    GLuint use(TextureHandle handle);
+
+    // use() + bindTexture (o cache de GLState.h só revincula se o nome na unidade mudou)
+    void bind(GLuint unit, TextureHandle handle, GLuint sampler);
+
+    // Aplica o orçamento e sobe texturas restauradas; chamar uma vez por frame
+    void endFrame();
+
+    // Libera todas as texturas (precisa do contexto OpenGL ainda ativo)
+    void clear();
+
+    void printStats() const;
+
+private:
+    struct Entry
+    {
+        std::string path;
+        bool flip = true;
+        bool alive = false;
+        GLuint texture = 0;          // 0 = removida (usa o placeholder)
+        int width = 0, height = 0;   // dimensões do nível 0 original
+        int channels = 4;
+        int droppedLevels = 0;       // mips do topo descartados
+        size_t bytes = 0;            // memória ocupada agora
+        size_t fullBytes = 0;        // memória com todos os mips
+        unsigned long long lastUsed = 0;
+        bool restoring = false;      // decodificação pendente na thread
+    };
+
+    // Cópia do caminho: a thread não lê entries, que load() pode realocar
+    struct RestoreRequest
+    {
+        TextureHandle handle;
+        std::string path;
+        bool flip;
+    };
+
+    struct Decoded
+    {
+        TextureHandle handle;
+        int width, height, channels;
+        unsigned char* pixels;
+    };
+
+    static size_t computeBytes(int width, int height, int channels, int droppedLevels);
+    void dropTopLevel(Entry& e);
+    void evict(Entry& e);
+    void requestRestore(TextureHandle handle);
+    void workerLoop();
+
+    std::vector<Entry> entries;
+    size_t budget;
+    size_t totalBytes = 0;
+    int minDimension = 64;
+    unsigned long long frame = 1;
+    GLuint placeholder = 0;
+
+    // Thread de decodificação (stb_image) para as restaurações
+    std::thread worker;
+    std::deque<RestoreRequest> restoreQueue;
+    std::vector<Decoded> decoded;
+    std::mutex mutex;
+    std::condition_variable cond;
+    bool stopping = false;
+};
@@ -0,0 +1,54 @@
+/*
+ *  Pool de threads para laços paralelos na CPU
+ *
+ *  As threads são criadas uma vez e ficam esperando trabalho. parallelFor
+ *  divide o intervalo em blocos que as threads (e a thread que chamou) vão
+ *  pegando de um contador atômico, então blocos mais caros não deixam as
+ *  outras threads paradas. A chamada só retorna quando todos terminarem.
+ *
+ *  Forma de uso
+ *  ------------
+ *  ThreadPool pool;                       // uma thread por núcleo
+ *  pool.parallelFor(0, height, [&](int y) { ...linha y... });
+ */
+
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+class ThreadPool
+{
+public:
+    // 0 = hardware_concurrency() - 1 threads extras (a thread que chama também trabalha)
+    explicit ThreadPool(unsigned int threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned int size() const { return (unsigned int)workers.size() + 1; }
+
+    // Executa body(i) para i em [begin, end), em blocos de grainSize índices
+    void parallelFor(int begin, int end, const std::function<void(int)>& body, int grainSize = 1);
+
+private:
+    void workerLoop();
+    void runChunks();
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake, done;
+    bool stopping = false;
+
+    // Trabalho atual (válido enquanto parallelFor está em andamento)
+    const std::function<void(int)>* job = nullptr;
+    int jobEnd = 0, jobGrain = 1;
+    std::atomic<int> next{ 0 };
+    unsigned long long generation = 0;
+    unsigned int pending = 0;   // threads que ainda não terminaram esta geração
+};
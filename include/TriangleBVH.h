@@ -0,0 +1,64 @@
+/*
+ *  BVH de triângulos para ray casting na CPU
+ *
+ *  Hierarquia de caixas alinhadas aos eixos construída com SAH em bins
+ *  (12 bins por eixo) e guardada em um vetor plano de nós. Os triângulos são
+ *  reordenados na ordem das folhas e guardados como (v0, e1, e2) para o teste
+ *  de Möller-Trumbore. A estrutura é somente leitura depois de construída,
+ *  então pode ser consultada por várias threads ao mesmo tempo.
+ *
+ *  Forma de uso
+ *  ------------
+ *  TriangleBVH bvh;
+ *  bvh.build(mesh);   // MeshData de ObjLoader.h
+ *  RayHit hit;
+ *  if (bvh.intersect(origem, direcao, 0.0f, 10.0f, hit)) ...hit.triangle, hit.u, hit.v...
+ */
+
+#pragma once
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+struct MeshData;
+
+struct RayHit
+{
+    float t;
+    int triangle;   // índice do triângulo na malha original (indices[3 * triangle])
+    float u, v;     // baricêntricas: p = (1 - u - v) * p0 + u * p1 + v * p2
+};
+
+class TriangleBVH
+{
+public:
+    void build(const std::vector<glm::vec3>& positions, const std::vector<unsigned int>& indices);
+    void build(const MeshData& mesh);
+
+    // Interseção mais próxima em [tMin, tMax]
+    bool intersect(const glm::vec3& origin, const glm::vec3& dir, float tMin, float tMax, RayHit& hit) const;
+
+    // Qualquer interseção em [tMin, tMax] (raios de sombra/oclusão)
+    bool occluded(const glm::vec3& origin, const glm::vec3& dir, float tMin, float tMax) const;
+
+    size_t nodeCount() const { return nodes.size(); }
+    size_t triangleCount() const { return triIndex.size(); }
+
+private:
+    struct Node
+    {
+        glm::vec3 bmin;
+        int leftOrFirst;   // folha: primeiro triângulo; interno: filho esquerdo (direito = +1)
+        glm::vec3 bmax;
+        int count;         // > 0 = folha
+    };
+
+    template <bool AnyHit>
+    bool traverse(const glm::vec3& origin, const glm::vec3& dir, float tMin, float tMax, RayHit& hit) const;
+
+    std::vector<Node> nodes;
+    std::vector<glm::vec3> v0, e1, e2;   // triângulos na ordem das folhas
+    std::vector<int> triIndex;           // ordem das folhas -> triângulo original
+    int maxDepth = 0;                    // dimensiona a pilha da travessia
+};
@@ -0,0 +1,123 @@
+/*
+ *  Uniform buffers (std140) para dados por frame e por objeto
+ *
+ *  Em vez de glGetUniformLocation + um glUniform* por matriz a cada frame,
+ *  os dados ficam em dois blocos uniform compartilhados por todos os shaders:
+ *
+ *    FrameUniforms  (binding 0) - view, projection, câmera e luzes; atualizado
+ *                                 uma vez por frame
+ *    ObjectUniforms (binding 1) - model e normal matrix de cada objeto; um
+ *                                 elemento por objeto no mesmo buffer,
+ *                                 selecionado com glBindBufferRange
+ *
+ *  A normal matrix (transpose(inverse(model))) é calculada uma vez por objeto
+ *  na CPU, e não mais em cada vértice no shader.
+ *
+ *  As structs C++ abaixo seguem o layout std140 dos blocos em
+ *  uniformBlocksGLSL: vec3 sempre como vec4 (std140 alinha vec3 em 16 bytes)
+ *  e a normal matrix como mat4 (mat3 ocupa 3 vec4 em std140 de qualquer forma).
+ *
+ *  reflectProgram lê uma vez, logo após o link, as localizações dos uniforms
+ *  soltos (samplers etc.) e liga os blocos conhecidos aos seus binding points.
+ *
+ *  Forma de uso
+ *  ------------
+ *  string vs = string("#version 450 core\n") + uniformBlocksGLSL + corpoDoShader;
+ *  ProgramReflection reflection = reflectProgram(program);
+ *  glUniform1i(reflection.location("texture1"), 0);
+ *
+ *  UniformBuffer frameUBO(sizeof(FrameUniforms), 1, FRAME_UNIFORMS_BINDING);
+ *  UniformBuffer objectUBO(sizeof(ObjectUniforms), numObjetos, OBJECT_UNIFORMS_BINDING);
+ *  ...
+ *  frameUBO.update(0, &frameData);
+ *  objectUBO.update(i, &objectData);   // objectData = objectUniforms(model)
+ *  objectUBO.bind(i);
+ *  glDrawArrays(...);
+ *  ...
+ *  objectUBO.clear();   // antes de glfwTerminate
+ *  frameUBO.clear();
+ */
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+const GLuint FRAME_UNIFORMS_BINDING = 0;
+const GLuint OBJECT_UNIFORMS_BINDING = 1;
+
+// Tamanho do array de luzes do bloco; quantas são usadas é decidido na
+// compilação (LIGHT_COUNT, ver ShaderVariants.h)
+const int MAX_LIGHTS = 4;
+
+struct FrameUniforms
+{
+    glm::mat4 view = glm::mat4(1.0f);
+    glm::mat4 projection = glm::mat4(1.0f);
+    glm::vec4 cameraPosition = glm::vec4(0.0f);    // xyz
+    glm::vec4 lightPositions[MAX_LIGHTS] = {};     // xyz
+    glm::vec4 ambientColor = glm::vec4(0.2f);
+    glm::vec4 diffuseColor = glm::vec4(0.5f);
+    glm::vec4 specularColor = glm::vec4(1.0f);     // rgb, w = shininess
+};
+
+struct ObjectUniforms
+{
+    glm::mat4 model;
+    glm::mat4 normalMatrix;
+};
+
+// Declarações GLSL dos dois blocos, para concatenar logo após o #version
+extern const char* const uniformBlocksGLSL;
+
+// model + normal matrix já calculada
+ObjectUniforms objectUniforms(const glm::mat4& model);
+
+// Buffer com 'count' elementos de 'size' bytes, cada um começando em um
+// múltiplo de GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT
+class UniformBuffer
+{
+public:
+    UniformBuffer(GLsizeiptr size, int count, GLuint binding);
+
+    UniformBuffer(const UniformBuffer&) = delete;
+    UniformBuffer& operator=(const UniformBuffer&) = delete;
+
+    void update(int index, const void* data);
+
+    // Liga o elemento ao binding point do bloco (pelo cache de GLState.h)
+    void bind(int index);
+
+    GLuint id() const { return buffer; }
+    GLuint bindingPoint() const { return binding; }
+
+    // Faixa do elemento, para vincular vários buffers de uma vez (glBindBuffersRange)
+    GLintptr offset(int index) const { return stride * index; }
+    GLsizeiptr elementSize() const { return size; }
+
+    // Apaga o buffer (contexto ainda corrente, antes de glfwTerminate)
+    void clear();
+
+private:
+    GLuint buffer = 0;
+    GLuint binding;
+    GLsizeiptr size;
+    GLsizeiptr stride;
+    int count;
+};
+
+// Uniforms e blocos de um programa, lidos uma vez depois do link
+struct ProgramReflection
+{
+    std::unordered_map<std::string, GLint> uniforms;       // nome -> location
+    std::unordered_map<std::string, GLuint> blockBindings; // bloco -> binding point
+
+    // -1 se o uniform não existe ou foi eliminado pelo compilador
+    GLint location(const std::string& name) const;
+};
+
+// Também liga FrameUniforms/ObjectUniforms aos binding points padrão
+ProgramReflection reflectProgram(GLuint program);
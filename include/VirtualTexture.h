@@ -0,0 +1,169 @@
+/*
+ *  Texturização virtual (virtual texturing) com streaming de tiles
+ *
+ *  Permite usar texturas muito maiores que a memória de vídeo: a imagem é
+ *  convertida para um arquivo em tiles (.vt) e somente os tiles realmente
+ *  visíveis ficam residentes em um cache físico na GPU.
+ *
+ *  Componentes:
+ *   - Arquivo .vt: cabeçalho + tiles RGBA8 de todos os níveis de mip, cada tile
+ *     com borda replicada (para filtragem bilinear sem costuras).
+ *   - Page table: textura GL_RGBA8UI com um texel por página virtual (e uma
+ *     mip por nível), que aponta para o slot do cache físico onde o tile está.
+ *   - Cache físico: textura RGBA8 com NxN slots de tiles, gerenciada por LRU.
+ *   - Passo de feedback: a cena é desenhada em baixa resolução com um shader
+ *     que escreve (página x, página y, mip) de cada pixel; o resultado é lido
+ *     de forma assíncrona (PBO) e vira a lista de tiles necessários.
+ *   - Threads de carga: leem os tiles do disco sem bloquear o loop de render.
+ *
+ *  Forma de uso
+ *  ------------
+ *  buildVirtualTexture("../assets/tex/terreno.png", "terreno.vt");   // offline, uma vez
+ *
+ *  VirtualTexture vt;
+ *  vt.open("terreno.vt");
+ *  ...
+ *  // no loop:
+ *  vt.beginFeedback(width, height);
+ *  //   desenha a cena com o programa de feedback (vtFeedbackFragmentSource)
+ *  vt.endFeedback();
+ *  vt.update();
+ *  vt.bind(0, 1);
+ *  vt.setUniforms(program, 0, 1);
+ *  //   desenha a cena com um shader que usa vtSampleGLSL
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <glad/glad.h>
+
+// Cabeçalho do arquivo .vt (seguido pelos tiles, mip 0 primeiro, linha a linha)
+struct VTFileHeader
+{
+    char     magic[4];      // "CGVT"
+    uint32_t version;
+    uint32_t width;         // dimensões da imagem original (mip 0)
+    uint32_t height;
+    uint32_t pagesX;        // páginas no mip 0 (potência de 2)
+    uint32_t pagesY;
+    uint32_t tileSize;      // pixels úteis por tile (sem a borda)
+    uint32_t border;        // borda replicada em cada lado do tile
+    uint32_t mipCount;
+    uint32_t reserved[3];
+};
+
+// Converte uma imagem comum (via stb_image, como o loadTexture dos exercícios)
+// para o formato em tiles. A imagem é estendida até um múltiplo potência de 2
+// do tamanho do tile replicando as bordas.
+bool buildVirtualTexture(const char* imagePath, const char* outPath, int tileSize = 128, int border = 4);
+
+// Fontes GLSL para os shaders que usam a textura virtual.
+// vtFeedbackFragmentSource: fragment shader completo do passo de feedback
+// (espera "in vec2 TexCoord"). vtSampleGLSL: função vtSample(uv) para ser
+// concatenada ao fragment shader da cena.
+extern const char* vtFeedbackFragmentSource;
+extern const char* vtSampleGLSL;
+
+class VirtualTexture
+{
+public:
+    VirtualTexture() = default;
+    ~VirtualTexture();
+
+    VirtualTexture(const VirtualTexture&) = delete;
+    VirtualTexture& operator=(const VirtualTexture&) = delete;
+
+    // cacheTilesPerSide: o cache físico terá cacheTilesPerSide^2 slots
+    bool open(const char* path, int cacheTilesPerSide = 32, int workerCount = 2);
+    void close();
+
+    // Passo de feedback: o FBO tem 1/feedbackDivisor da resolução da tela
+    void beginFeedback(int screenWidth, int screenHeight, int feedbackDivisor = 8);
+    void endFeedback();
+
+    // Envia à GPU até maxUploads tiles já carregados e atualiza a page table
+    void update(int maxUploads = 16);
+
+    void bind(GLuint pageTableUnit, GLuint cacheUnit) const;
+    void setUniforms(GLuint program, GLuint pageTableUnit, GLuint cacheUnit) const;
+    void setFeedbackUniforms(GLuint program) const;
+
+    int residentTiles() const { return (int)resident.size(); }
+    int pendingTiles() const { return (int)pending.size(); }
+    const VTFileHeader& info() const { return header; }
+
+private:
+    struct Slot
+    {
+        uint32_t page = UINT32_MAX;   // página que ocupa o slot (UINT32_MAX = livre)
+        uint64_t lastUsed = 0;        // último frame em que foi requisitado
+        bool pinned = false;          // mip mais grosso: nunca sai do cache
+    };
+
+    struct LoadedTile
+    {
+        uint32_t page;
+        std::vector<unsigned char> pixels;
+    };
+
+    uint32_t pageId(uint32_t mip, uint32_t x, uint32_t y) const;
+    void pageCoords(uint32_t id, uint32_t& mip, uint32_t& x, uint32_t& y) const;
+    uint32_t pagesAt(uint32_t mip, bool axisY) const;
+    size_t tileBytes() const;
+    uint64_t tileOffset(uint32_t page) const;
+
+    void requestPage(uint32_t page);
+    int acquireSlot();
+    void uploadTile(const LoadedTile& tile, int slot);
+    void rebuildPageTable();
+    void workerLoop();
+
+    VTFileHeader header = {};
+    std::string filePath;
+    std::vector<uint32_t> mipFirstPage;   // índice da primeira página de cada mip
+
+    // Recursos OpenGL
+    GLuint pageTableTex = 0;
+    GLuint cacheTex = 0;
+    GLuint feedbackFBO = 0;
+    GLuint feedbackColor = 0;
+    GLuint feedbackDepth = 0;
+    GLuint feedbackPBO[2] = { 0, 0 };
+    int feedbackW = 0, feedbackH = 0;
+    int feedbackDivisor = 8;
+    int pboIndex = 0;
+    bool pboHasData[2] = { false, false };
+    GLint savedViewport[4] = { 0, 0, 0, 0 };
+    GLint savedFBO = 0;
+
+    // Cache físico
+    int cacheTiles = 0;
+    std::vector<Slot> slots;
+    std::vector<int> freeSlots;
+    std::unordered_map<uint32_t, int> resident;      // página -> slot
+    std::unordered_set<uint32_t> pending;             // páginas pedidas às threads
+    bool readFailed = false;                          // já avisou de uma leitura que falhou
+    std::vector<uint32_t> pageTableData;             // entradas de todas as mips (CPU)
+    bool pageTableDirty = false;
+    uint64_t frame = 0;
+
+    // Threads de carga
+    std::vector<std::thread> workers;
+    std::deque<uint32_t> loadQueue;
+    std::vector<LoadedTile> loaded;
+    std::mutex queueMutex;
+    std::mutex loadedMutex;
+    std::condition_variable queueCond;
+    std::atomic<bool> stopping{ false };
+};
@@ -0,0 +1,227 @@
+/* GLReplay - Reprodução de um fluxo de chamadas OpenGL gravado (GLCapture.h)
+ *
+ * Uso: GLReplay arquivo.glcap [repetições]
+ *      (gravação: CG_GL_CAPTURE=m4.glcap CG_GL_CAPTURE_FRAMES=100-200 ./M4)
+ *
+ * Abre uma janela oculta do tamanho da gravada, com a mesma versão e perfil
+ * de contexto (core ou compatibilidade) da gravação, sem vsync, e executa as
+ * chamadas do arquivo o mais rápido possível. Os frames antes do intervalo
+ * medido (inicialização, aquecimento) são executados sem medir. Em cada
+ * frame medido são tomados dois tempos:
+ *   CPU   : da primeira chamada até a última (submissão ao driver)
+ *   total : até o fim do glFinish() no marcador de frame (CPU + GPU)
+ * Como a carga é exatamente a mesma a cada execução, os números comparam
+ * mudanças de driver, de máquina ou do próprio renderizador (gravando de
+ * novo) sem o ruído da simulação e da entrada.
+ *
+ * Chamadas não suportadas pela gravação são puladas e listadas no fim, assim
+ * como divergências de nomes de objetos (que indicam um replay inválido).
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+#include <cstdlib>
+#include <algorithm>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include "GLExtensions.h"
+#include "GLCapture.h"
+#include "GLDebug.h"
+
+using namespace std;
+
+struct FrameTiming
+{
+    uint32_t frame;
+    double cpuMs;
+    double totalMs;
+};
+
+static void printSummary(const char* label, vector<double> values)
+{
+    if (values.empty()) return;
+    sort(values.begin(), values.end());
+    double sum = 0.0;
+    for (double v : values) sum += v;
+    cout << label << ": mín " << values.front() << " | média " << sum / values.size()
+         << " | mediana " << values[values.size() / 2] << " | máx " << values.back() << " ms" << endl;
+}
+
+// Janela oculta com o contexto gravado; nullptr (e a janela destruída) se
+// não deu para criar, ou se o driver entregou uma versão mais antiga
+static GLFWwindow* createReplayWindow(const GLCaptureHeader& header)
+{
+    glfwDefaultWindowHints();
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    if (header.glMajor > 0)
+    {
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, header.glMajor);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, header.glMinor);
+    }
+    if (header.glMajor > 3 || (header.glMajor == 3 && header.glMinor >= 2))
+        glfwWindowHint(GLFW_OPENGL_PROFILE, header.coreProfile ? GLFW_OPENGL_CORE_PROFILE : GLFW_OPENGL_COMPAT_PROFILE);
+#ifdef __APPLE__
+    if (header.coreProfile) glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#endif
+    if (glDebugRequested()) glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GLFW_TRUE);
+
+    GLFWwindow* window = glfwCreateWindow(max(1, header.width), max(1, header.height), "GLReplay", nullptr, nullptr);
+    if (!window)
+    {
+        cout << "Falha ao criar um contexto OpenGL " << header.glMajor << "." << header.glMinor
+             << (header.coreProfile ? " core" : "") << endl;
+        return nullptr;
+    }
+    glfwMakeContextCurrent(window);
+    glfwSwapInterval(0);
+
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+    {
+        cout << "Failed to initialize GLAD" << endl;
+        glfwDestroyWindow(window);
+        return nullptr;
+    }
+    loadGLExtensions((GLADloadproc)glfwGetProcAddress);
+
+    GLint major = 0, minor = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &major);
+    glGetIntegerv(GL_MINOR_VERSION, &minor);
+    if (major < header.glMajor || (major == header.glMajor && minor < header.glMinor))
+    {
+        cout << "Contexto OpenGL " << major << "." << minor << " mais antigo que o gravado ("
+             << header.glMajor << "." << header.glMinor << ")" << endl;
+        glfwDestroyWindow(window);
+        return nullptr;
+    }
+    return window;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        cout << "Uso: GLReplay arquivo.glcap [repetições]" << endl;
+        return -1;
+    }
+    int repeats = argc > 2 ? max(1, atoi(argv[2])) : 1;
+
+    // O replay não deve gravar a si mesmo
+#ifdef _WIN32
+    _putenv("CG_GL_CAPTURE=");
+#else
+    unsetenv("CG_GL_CAPTURE");
+#endif
+
+    GLCaptureHeader header;
+    GLCaptureReader probe;
+    if (!probe.open(argv[1], header))
+    {
+        cout << "Arquivo de captura inválido: " << argv[1] << endl;
+        return -1;
+    }
+    cout << argv[1] << ": " << header.width << "x" << header.height << ", OpenGL " << header.glMajor << "."
+         << header.glMinor << (header.coreProfile ? " core" : "") << ", frames medidos " << header.firstFrame << "-"
+         << header.lastFrame << endl;
+
+    glfwInit();
+    GLFWwindow* window = createReplayWindow(header);
+    if (!window)
+    {
+        glfwTerminate();
+        return -1;
+    }
+    cout << "Renderer: " << glGetString(GL_RENDERER) << endl;
+
+    map<string, unsigned long long> skipped;
+    unsigned long long mismatches = 0;
+    vector<FrameTiming> timings;
+
+    // Cada repetição recria o contexto do zero: os nomes dos objetos só
+    // coincidem com os gravados num contexto novo
+    for (int pass = 0; pass < repeats; pass++)
+    {
+        if (pass > 0)
+        {
+            glfwDestroyWindow(window);
+            window = createReplayWindow(header);
+            if (!window)
+            {
+                glfwTerminate();
+                return -1;
+            }
+        }
+
+        GLCaptureReader reader;
+        reader.open(argv[1], header);
+        GLReplayer replayer(reader, header);
+
+        auto frameStart = chrono::steady_clock::now();
+        bool done = false;
+        while (!done)
+        {
+            uint32_t frame = 0;
+            switch (replayer.step(frame))
+            {
+            case GL_REPLAY_CALL:
+                break;
+            case GL_REPLAY_SKIPPED:
+                skipped[replayer.lastEntryName()]++;
+                break;
+            case GL_REPLAY_FRAME:
+                if (frame >= header.firstFrame)
+                {
+                    auto submitted = chrono::steady_clock::now();
+                    glFinish();
+                    auto finished = chrono::steady_clock::now();
+                    timings.push_back({ frame,
+                                        chrono::duration<double, milli>(submitted - frameStart).count(),
+                                        chrono::duration<double, milli>(finished - frameStart).count() });
+                }
+                else
+                    glFinish();
+                glfwSwapBuffers(window);
+                frameStart = chrono::steady_clock::now();
+                break;
+            case GL_REPLAY_END:
+                done = true;
+                break;
+            case GL_REPLAY_ERROR:
+                cout << "Erro no arquivo depois de " << replayer.lastEntryName() << endl;
+                done = true;
+                break;
+            }
+        }
+        mismatches += replayer.state().nameMismatches;
+    }
+
+    cout << "\nFrame: CPU (ms), total (ms)" << endl;
+    for (const FrameTiming& t : timings)
+        cout << "  " << t.frame << ": " << t.cpuMs << ", " << t.totalMs << endl;
+
+    vector<double> cpu, total;
+    for (const FrameTiming& t : timings)
+    {
+        cpu.push_back(t.cpuMs);
+        total.push_back(t.totalMs);
+    }
+    cout << "\n" << timings.size() << " frames medidos em " << repeats << " repetição(ões)" << endl;
+    printSummary("CPU", cpu);
+    printSummary("Total", total);
+
+    if (!skipped.empty())
+    {
+        cout << "Chamadas puladas (não suportadas pela gravação):" << endl;
+        for (const auto& entry : skipped)
+            cout << "  " << entry.first << ": " << entry.second << endl;
+    }
+    if (mismatches)
+        cout << "AVISO: " << mismatches << " nomes/locations diferentes dos gravados; o replay pode estar incorreto" << endl;
+
+    glfwTerminate();
+    return 0;
+}
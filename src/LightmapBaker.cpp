@@ -0,0 +1,68 @@
+/* LightmapBaker - Baker de lightmap (luz direta + uma rebatida) para cenas estáticas
+ *
+ * Uso: LightmapBaker [alvo.obj] [outros.obj ...] [--size N] [--samples N] [--light x y z]
+ *      (padrão: ../assets/Modelos3D/Suzanne.obj, 512, 128 raios, luz em (2, 2, 3))
+ *
+ * O primeiro .obj recebe o lightmap, usando as próprias coordenadas de
+ * textura como UVs do atlas (precisam estar sem sobreposição). Os demais
+ * .obj só fazem sombra e rebatem luz. Grava <alvo>_lightmap.png.
+ *
+ * As constantes de luz são as da Phong dos exercícios (ambiente 0.2,
+ * difusa 0.5), para o lightmap substituir a iluminação no shader.
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+
+#include <glm/glm.hpp>
+
+#include "ObjLoader.h"
+#include "Lightmap.h"
+
+using namespace std;
+
+int main(int argc, char** argv)
+{
+    vector<string> objPaths;
+    LightmapSettings settings;
+    settings.size = 512;
+    settings.ambient = glm::vec3(0.2f);
+    LightmapLight light = { glm::vec3(2.0f, 2.0f, 3.0f), glm::vec3(0.5f) };
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--size") == 0 && i + 1 < argc) settings.size = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--samples") == 0 && i + 1 < argc) settings.bounceSamples = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--light") == 0 && i + 3 < argc)
+        {
+            light.position.x = (float)atof(argv[++i]);
+            light.position.y = (float)atof(argv[++i]);
+            light.position.z = (float)atof(argv[++i]);
+        }
+        else objPaths.push_back(argv[i]);
+    }
+    if (objPaths.empty())
+        objPaths.push_back("../assets/Modelos3D/Suzanne.obj");
+
+    vector<LightmapSurface> scene(objPaths.size());
+    for (size_t i = 0; i < objPaths.size(); i++)
+        if (!loadOBJ(objPaths[i], scene[i].mesh))
+            return -1;
+
+    LightmapSurface& target = scene[0];
+    target.lightmapUVs.resize(target.mesh.vertices.size());
+    for (size_t i = 0; i < target.mesh.vertices.size(); i++)
+        target.lightmapUVs[i] = target.mesh.vertices[i].texCoord;
+
+    vector<glm::vec3> texels;
+    bakeLightmap(scene, 0, { light }, settings, texels);
+
+    string outPath = objPaths[0].substr(0, objPaths[0].find_last_of('.')) + "_lightmap.png";
+    if (!saveLightmap(outPath.c_str(), settings.size, texels))
+        return -1;
+    cout << "Gravado " << outPath << endl;
+    return 0;
+}
@@ -1,14 +1,39 @@
 // M2.cpp - Visualizador de cubo 3D com translação, rotação, escala e múltiplas instâncias
 // Adaptado por ChatGPT para Samuel com base no template da professora Rossana
+//
+// Dois caminhos de desenho, alternados com a tecla M:
+//   por cubo    : um glUniformMatrix4fv + um glDrawArrays por cubo
+//   instanciado : as matrizes de todos os cubos vão num buffer de vértices
+//                 (atributo por instância, glVertexAttribDivisor) atualizado
+//                 uma vez por frame, e um único glDrawArraysInstanced
+// "M2 bench" mede os dois caminhos de 1 a 1M cubos e sai.
+//
+// Antes de calcular as matrizes, os cubos fora da câmera são descartados
+// pelo frustum culling SIMD (FrustumCulling.h); F liga/desliga.
 
 #include <iostream>
+#include <iomanip>
 #include <vector>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#include "GLExtensions.h"
+#include "GLTrace.h"
+#include "GLDebug.h"
+#include "Shader.h"
+#include "ShaderBindings.h"   // gerado pelo ShaderReflect a partir dos shaders deste arquivo
+#include "GLState.h"
+#include "Frustum.h"
+#include "FrustumCulling.h"
+#include "ThreadPool.h"
+
 using namespace std;
 
 const GLuint WIDTH = 800, HEIGHT = 600;
@@ -20,15 +45,47 @@ bool rotateX = false, rotateY = false, rotateZ = false;
 
 // Instâncias de cubos
 vector<glm::vec3> cubePositions = { glm::vec3(0.0f) };
+bool instanced = true;
+bool culling = true;
+
+// Locais dos uniforms de cada programa
+struct CubeProgram
+{
+    GLuint program;
+    GLint modelLoc, viewLoc, projLoc;
+};
+
+// Buffer com uma mat4 por cubo (atributos 2..5 do VAO, divisor 1)
+struct InstanceBuffer
+{
+    GLuint buffer = 0;
+    size_t capacity = 0;   // em matrizes
+};
 
 void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods);
-GLuint setupShader();
+GLuint setupShader(bool instancedShader);
 GLuint setupGeometry();
+InstanceBuffer setupInstanceBuffer(GLuint VAO);
+CubeProgram cubeProgram(GLuint program);
+void computeModels(const vector<glm::vec3>& positions, float time, vector<glm::mat4>& models);
+void cullCubes(FrustumCuller& culler, SphereBoundsSoA& bounds, const vector<glm::vec3>& positions,
+               vector<glm::vec3>& visible);
+glm::mat4 cubeView();
+glm::mat4 cubeProjection();
+void drawCubes(const PipelineState& pipeline, const CubeProgram& program, InstanceBuffer& instances,
+               const vector<glm::mat4>& models, bool useInstancing);
+int runBenchmark(GLFWwindow* window, const PipelineState& pipeline, const CubeProgram& perCube,
+                 const CubeProgram& perInstance, InstanceBuffer& instances);
 
+// Com INSTANCED a matriz vem do atributo por instância em vez do uniform
 const GLchar* vertexShaderSource = "#version 450\n"
 "layout (location = 0) in vec3 position;\n"
 "layout (location = 1) in vec3 color;\n"
+"#ifdef INSTANCED\n"
+"layout (location = 2) in mat4 model;\n"
+"#else\n"
 "uniform mat4 model;\n"
+"#endif\n"
 "uniform mat4 view;\n"
 "uniform mat4 projection;\n"
 "out vec4 finalColor;\n"
@@ -46,56 +103,79 @@ const GLchar* fragmentShaderSource = "#version 450\n"
 "    color = finalColor;\n"
 "}\n\0";
 
-int main() {
+int main(int argc, char** argv) {
+    bool bench = argc > 1 && string(argv[1]) == "bench";
+
     glfwInit();
+    if (glDebugRequested()) glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GLFW_TRUE);
     GLFWwindow* window = glfwCreateWindow(WIDTH, HEIGHT, "Cubo 3D - M2", nullptr, nullptr);
     glfwMakeContextCurrent(window);
     glfwSetKeyCallback(window, key_callback);
+    if (bench) glfwSwapInterval(0);
 
     if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
         cerr << "Erro ao carregar GLAD" << endl;
         return -1;
     }
+    loadGLExtensions((GLADloadproc)glfwGetProcAddress);
 
-    glEnable(GL_DEPTH_TEST);
-
-    GLuint shaderProgram = setupShader();
+    GLuint shaderProgram = setupShader(false);
+    GLuint instancedProgram = setupShader(true);
     GLuint VAO = setupGeometry();
+    InstanceBuffer instances = setupInstanceBuffer(VAO);
+
+    // Programa, formato de vértice e depth test aplicados juntos; de um frame
+    // para o outro nada muda e o cache não repassa nenhuma dessas chamadas
+    PipelineDesc desc;
+    desc.program = shaderProgram;
+    desc.vertexArray = VAO;
+    PipelineState pipeline(desc);
+    CubeProgram perCube = cubeProgram(shaderProgram);
+    CubeProgram perInstance = cubeProgram(instancedProgram);
+    double lastReport = glfwGetTime();
 
-    GLint modelLoc = glGetUniformLocation(shaderProgram, "model");
-    GLint viewLoc = glGetUniformLocation(shaderProgram, "view");
-    GLint projLoc = glGetUniformLocation(shaderProgram, "projection");
+    if (bench) {
+        int result = runBenchmark(window, pipeline, perCube, perInstance, instances);
+        glfwTerminate();
+        return result;
+    }
 
+    vector<glm::mat4> models;
+    ThreadPool threads;
+    FrustumCuller culler(&threads);
+    SphereBoundsSoA bounds;
+    vector<glm::vec3> visiblePositions;
     while (!glfwWindowShouldClose(window)) {
         glfwPollEvents();
         glClearColor(1, 1, 1, 1);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-        glUseProgram(shaderProgram);
+        if (culling)
+            cullCubes(culler, bounds, cubePositions, visiblePositions);
+        else
+            visiblePositions = cubePositions;
+        computeModels(visiblePositions, (float)glfwGetTime(), models);
+        drawCubes(pipeline, instanced ? perInstance : perCube, instances, models, instanced);
 
-        glm::mat4 view = glm::translate(glm::mat4(1.0f), glm::vec3(0, 0, -5.0f));
-        glm::mat4 projection = glm::perspective(glm::radians(45.0f), (float)WIDTH / HEIGHT, 0.1f, 100.0f);
-        glUniformMatrix4fv(viewLoc, 1, GL_FALSE, glm::value_ptr(view));
-        glUniformMatrix4fv(projLoc, 1, GL_FALSE, glm::value_ptr(projection));
-
-        glBindVertexArray(VAO);
-        float time = glfwGetTime();
-
-        for (glm::vec3& pos : cubePositions) {
-            glm::mat4 model = glm::translate(glm::mat4(1.0f), pos + movement);
-            if (rotateX) model = glm::rotate(model, time, glm::vec3(1, 0, 0));
-            if (rotateY) model = glm::rotate(model, time, glm::vec3(0, 1, 0));
-            if (rotateZ) model = glm::rotate(model, time, glm::vec3(0, 0, 1));
-            model = glm::scale(model, glm::vec3(scale));
-            glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-            glDrawArrays(GL_TRIANGLES, 0, 36);
+        glState().endFrame();
+        if (glfwGetTime() - lastReport > 1.0)
+        {
+            glState().printStats();
+            if (culling)
+                cout << "Culling (" << cullingPathName(culler.path()) << "): " << visiblePositions.size() << "/"
+                     << cubePositions.size() << " cubos visíveis" << endl;
+            if (glTraceInstalled()) glTracePrintFrame();
+            if (glDebugInstalled()) glDebugPrintFrame();
+            lastReport = glfwGetTime();
         }
-
-        glBindVertexArray(0);
+        glTraceEndFrame();
         glfwSwapBuffers(window);
     }
 
+    glState().forgetVertexArray(VAO);
     glDeleteVertexArrays(1, &VAO);
+    glState().forgetBuffer(instances.buffer);
+    glDeleteBuffers(1, &instances.buffer);
     glfwTerminate();
     return 0;
 }
@@ -116,27 +196,150 @@ void key_callback(GLFWwindow* window, int key, int scancode, int action, int mod
         else if (key == GLFW_KEY_LEFT_BRACKET) scale *= 0.95f;
         else if (key == GLFW_KEY_RIGHT_BRACKET) scale *= 1.05f;
         else if (key == GLFW_KEY_C) cubePositions.push_back(glm::vec3(0));
+        else if (key == GLFW_KEY_F && action == GLFW_PRESS) {
+            culling = !culling;
+            cout << "Frustum culling " << (culling ? "ligado" : "desligado") << endl;
+        }
+        else if (key == GLFW_KEY_M && action == GLFW_PRESS) {
+            instanced = !instanced;
+            cout << "Desenho " << (instanced ? "instanciado" : "por cubo") << " (" << cubePositions.size()
+                 << " cubos)" << endl;
+        }
     }
 }
 
-GLuint setupShader() {
-    GLuint vs = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vs, 1, &vertexShaderSource, NULL);
-    glCompileShader(vs);
+GLuint setupShader(bool instancedShader) {
+    if (instancedShader)
+        return createProgram(vertexShaderSource, fragmentShaderSource, { "INSTANCED" });
+    return createProgram(vertexShaderSource, fragmentShaderSource);
+}
+
+CubeProgram cubeProgram(GLuint program) {
+    return { program, glGetUniformLocation(program, glsl::m2::uniformName::model),
+             glGetUniformLocation(program, glsl::m2::uniformName::view),
+             glGetUniformLocation(program, glsl::m2::uniformName::projection) };
+}
+
+void computeModels(const vector<glm::vec3>& positions, float time, vector<glm::mat4>& models) {
+    models.resize(positions.size());
+    for (size_t i = 0; i < positions.size(); i++) {
+        glm::mat4 model = glm::translate(glm::mat4(1.0f), positions[i] + movement);
+        if (rotateX) model = glm::rotate(model, time, glm::vec3(1, 0, 0));
+        if (rotateY) model = glm::rotate(model, time, glm::vec3(0, 1, 0));
+        if (rotateZ) model = glm::rotate(model, time, glm::vec3(0, 0, 1));
+        models[i] = glm::scale(model, glm::vec3(scale));
+    }
+}
+
+glm::mat4 cubeView() {
+    return glm::translate(glm::mat4(1.0f), glm::vec3(0, 0, -5.0f));
+}
+
+glm::mat4 cubeProjection() {
+    return glm::perspective(glm::radians(45.0f), (float)WIDTH / HEIGHT, 0.1f, 100.0f);
+}
+
+// Esfera de cada cubo (a rotação é em torno do centro: o raio não muda)
+void cullCubes(FrustumCuller& culler, SphereBoundsSoA& bounds, const vector<glm::vec3>& positions,
+               vector<glm::vec3>& visible) {
+    bounds.resize(positions.size());
+    float radius = 0.8660254f * scale;   // meia diagonal do cubo unitário
+    for (size_t i = 0; i < positions.size(); i++)
+        bounds.set(i, positions[i] + movement, radius);
+
+    visible.clear();
+    for (uint32_t i : culler.cull(extractFrustum(cubeProjection() * cubeView()), bounds))
+        visible.push_back(positions[i]);
+}
+
+void drawCubes(const PipelineState& pipeline, const CubeProgram& program, InstanceBuffer& instances,
+               const vector<glm::mat4>& models, bool useInstancing) {
+    glState().bindPipeline(pipeline.withProgram(program.program));
 
-    GLuint fs = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fs, 1, &fragmentShaderSource, NULL);
-    glCompileShader(fs);
+    glm::mat4 view = cubeView();
+    glm::mat4 projection = cubeProjection();
+    glUniformMatrix4fv(program.viewLoc, 1, GL_FALSE, glm::value_ptr(view));
+    glUniformMatrix4fv(program.projLoc, 1, GL_FALSE, glm::value_ptr(projection));
 
-    GLuint program = glCreateProgram();
-    glAttachShader(program, vs);
-    glAttachShader(program, fs);
-    glLinkProgram(program);
+    if (!useInstancing) {
+        for (const glm::mat4& model : models) {
+            glUniformMatrix4fv(program.modelLoc, 1, GL_FALSE, glm::value_ptr(model));
+            glDrawArrays(GL_TRIANGLES, 0, 36);
+        }
+        return;
+    }
+    if (models.empty()) return;
 
-    glDeleteShader(vs);
-    glDeleteShader(fs);
+    // Um envio por frame. glBufferData com o tamanho todo descarta o
+    // conteúdo anterior: o driver entrega memória nova em vez de esperar a
+    // GPU terminar o frame que ainda lê as matrizes antigas
+    glState().bindBuffer(GL_ARRAY_BUFFER, instances.buffer);
+    instances.capacity = max(instances.capacity, models.size());
+    glBufferData(GL_ARRAY_BUFFER, instances.capacity * sizeof(glm::mat4), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, models.size() * sizeof(glm::mat4), models.data());
+    glDrawArraysInstanced(GL_TRIANGLES, 0, 36, (GLsizei)models.size());
+}
+
+// Grade de n cubos cabendo na tela, girando em Y (as matrizes mudam todo frame)
+static void benchmarkScene(size_t n) {
+    size_t side = (size_t)ceil(cbrt((double)n));
+    float spacing = 3.0f / side;
+    cubePositions.clear();
+    for (size_t i = 0; i < n; i++) {
+        glm::vec3 cell((float)(i % side), (float)(i / side % side), (float)(i / (side * side)));
+        cubePositions.push_back((cell - glm::vec3((side - 1) * 0.5f)) * spacing);
+    }
+    scale = spacing * 0.5f;
+    movement = glm::vec3(0.0f);
+    rotateY = true;
+    rotateX = rotateZ = false;
+}
+
+struct BenchResult {
+    double cpuMs;     // cálculo das matrizes + submissão
+    double totalMs;   // até o fim do glFinish
+};
+
+static BenchResult benchmarkPath(GLFWwindow* window, const PipelineState& pipeline, const CubeProgram& program,
+                                 InstanceBuffer& instances, bool useInstancing, int frames) {
+    vector<glm::mat4> models;
+    BenchResult result = { 0.0, 0.0 };
+    for (int frame = -2; frame < frames; frame++) {   // 2 frames de aquecimento
+        auto start = chrono::steady_clock::now();
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        computeModels(cubePositions, frame * 0.01f, models);
+        drawCubes(pipeline, program, instances, models, useInstancing);
+        auto submitted = chrono::steady_clock::now();
+        glFinish();
+        auto finished = chrono::steady_clock::now();
+        glTraceEndFrame();
+        glfwSwapBuffers(window);
+        glfwPollEvents();
+        if (frame >= 0) {
+            result.cpuMs += chrono::duration<double, milli>(submitted - start).count();
+            result.totalMs += chrono::duration<double, milli>(finished - start).count();
+        }
+    }
+    result.cpuMs /= frames;
+    result.totalMs /= frames;
+    return result;
+}
 
-    return program;
+int runBenchmark(GLFWwindow* window, const PipelineState& pipeline, const CubeProgram& perCube,
+                 const CubeProgram& perInstance, InstanceBuffer& instances) {
+    cout << "Cubos | por cubo: CPU ms, total ms | instanciado: CPU ms, total ms | ganho (total)" << endl;
+    cout << fixed << setprecision(3);
+    for (size_t n = 1; n <= 1000000; n *= 10) {
+        benchmarkScene(n);
+        // Menos frames nos tamanhos grandes: 1M draws por cubo leva segundos por frame
+        int frames = (int)max<size_t>(3, min<size_t>(100, 1000000 / n));
+        BenchResult a = benchmarkPath(window, pipeline, perCube, instances, false, frames);
+        BenchResult b = benchmarkPath(window, pipeline, perInstance, instances, true, frames);
+        cout << setw(7) << n << " | " << a.cpuMs << ", " << a.totalMs << " | " << b.cpuMs << ", " << b.totalMs
+             << " | " << setprecision(1) << a.totalMs / b.totalMs << "x" << setprecision(3) << endl;
+        if (glfwWindowShouldClose(window)) break;
+    }
+    return 0;
 }
 
 GLuint setupGeometry() {
@@ -166,15 +369,37 @@ GLuint setupGeometry() {
     glGenVertexArrays(1, &VAO);
     glGenBuffers(1, &VBO);
     glBindVertexArray(VAO);
+    labelGLObject(GL_VERTEX_ARRAY, VAO, "cubo");
     glBindBuffer(GL_ARRAY_BUFFER, VBO);
     glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
 
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(glsl::m2::attrib::position, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(glsl::m2::attrib::position);
+    glVertexAttribPointer(glsl::m2::attrib::color, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
+    glEnableVertexAttribArray(glsl::m2::attrib::color);
 
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindVertexArray(0);
     return VAO;
 }
+
+InstanceBuffer setupInstanceBuffer(GLuint VAO) {
+    InstanceBuffer instances;
+    instances.capacity = 1;
+    glGenBuffers(1, &instances.buffer);
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, instances.buffer);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(glm::mat4), nullptr, GL_STREAM_DRAW);
+
+    // Uma mat4 ocupa 4 locations (uma coluna cada), avançando uma vez por instância
+    for (GLuint column = 0; column < 4; column++) {
+        GLuint location = glsl::m2::attrib::model + column;
+        glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void*)(column * sizeof(glm::vec4)));
+        glEnableVertexAttribArray(location);
+        glVertexAttribDivisor(location, 1);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+    return instances;
+}
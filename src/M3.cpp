@@ -9,15 +9,20 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
-#define STB_IMAGE_IMPLEMENTATION
-#include "stb_image.h"
+#include "GLExtensions.h"
+#include "GLTrace.h"
+#include "GLDebug.h"
+#include "Texture.h"
+#include "TextureResidency.h"
+#include "Shader.h"
+#include "UniformBuffers.h"
+#include "ShaderBindings.h"   // gerado pelo ShaderReflect a partir dos shaders deste arquivo
 
 using namespace std;
 
 void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods);
 GLuint setupShader();
 GLuint setupGeometry();
-GLuint loadTexture(const char* path);
 
 float angleX = 0.0f, angleY = 0.0f, angleZ = 0.0f;
 float scaleFactor = 1.0f;
@@ -25,6 +30,7 @@ float posX = 0.0f, posY = 0.0f, posZ = 0.0f;
 
 int main() {
     glfwInit();
+    if (glDebugRequested()) glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GLFW_TRUE);
     GLFWwindow* window = glfwCreateWindow(800, 800, "M3 - Cubo com Textura", nullptr, nullptr);
     glfwMakeContextCurrent(window);
     glfwSetKeyCallback(window, key_callback);
@@ -33,14 +39,25 @@ int main() {
         cout << "Erro ao inicializar GLAD" << endl;
         return -1;
     }
+    loadGLExtensions((GLADloadproc)glfwGetProcAddress);
 
     glEnable(GL_DEPTH_TEST);
+    TextureResidency textures(64 * 1024 * 1024);   // orçamento de 64 MB
     GLuint shaderProgram = setupShader();
     GLuint VAO = setupGeometry();
-    GLuint textureID = loadTexture("texturas/caixa.jpg");
+    TextureHandle texture = textures.load("texturas/caixa.jpg", false);
 
+    ProgramReflection reflection = reflectProgram(shaderProgram);
     glUseProgram(shaderProgram);
-    glUniform1i(glGetUniformLocation(shaderProgram, "texture1"), 0);
+    glUniform1i(reflection.location(glsl::m3::uniformName::texture1), 0);
+
+    // Sem câmera neste exercício: view e projection ficam identidade, enviadas uma vez
+    UniformBuffer frameUBO(sizeof(FrameUniforms), 1, FRAME_UNIFORMS_BINDING);
+    UniformBuffer objectUBO(sizeof(ObjectUniforms), 1, OBJECT_UNIFORMS_BINDING);
+    FrameUniforms frame;
+    frameUBO.update(0, &frame);
+
+    GLuint sampler = getSampler(SamplerDesc(GL_LINEAR, GL_LINEAR));
 
     while (!glfwWindowShouldClose(window)) {
         glfwPollEvents();
@@ -54,21 +71,27 @@ int main() {
         model = glm::rotate(model, angleZ, glm::vec3(0, 0, 1));
         model = glm::scale(model, glm::vec3(scaleFactor));
 
-        GLint modelLoc = glGetUniformLocation(shaderProgram, "model");
-        glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
+        ObjectUniforms object = objectUniforms(model);
+        objectUBO.update(0, &object);
 
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, textureID);
+        // Só revincula se a textura foi rebaixada/restaurada desde o último frame
+        textures.bind(0, texture, sampler);
 
         glBindVertexArray(VAO);
         glDrawArrays(GL_TRIANGLES, 0, 36);
         glBindVertexArray(0);
 
+        glTraceEndFrame();
         glfwSwapBuffers(window);
+        textures.endFrame();
     }
 
     glDeleteVertexArrays(1, &VAO);
     glDeleteProgram(shaderProgram);
+    objectUBO.clear();
+    frameUBO.clear();
+    textures.clear();
+    deleteSamplers();
     glfwTerminate();
     return 0;
 }
@@ -93,14 +116,13 @@ void key_callback(GLFWwindow* window, int key, int scancode, int action, int mod
 }
 
 GLuint setupShader() {
-    const char* vertexShaderSource = "#version 450 core\n"
+    string vertexShaderSource = string("#version 450 core\n") + uniformBlocksGLSL +
         "layout(location = 0) in vec3 position;\n"
         "layout(location = 1) in vec3 color;\n"
         "layout(location = 2) in vec2 texCoord;\n"
         "out vec2 TexCoord;\n"
-        "uniform mat4 model;\n"
         "void main() {\n"
-        "    gl_Position = model * vec4(position, 1.0);\n"
+        "    gl_Position = projection * view * model * vec4(position, 1.0);\n"
         "    TexCoord = texCoord;\n"
         "}\n";
 
@@ -112,23 +134,7 @@ GLuint setupShader() {
         "    color = texture(texture1, TexCoord);\n"
         "}\n";
 
-    GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertexShader, 1, &vertexShaderSource, nullptr);
-    glCompileShader(vertexShader);
-
-    GLuint fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragmentShader, 1, &fragmentShaderSource, nullptr);
-    glCompileShader(fragmentShader);
-
-    GLuint shaderProgram = glCreateProgram();
-    glAttachShader(shaderProgram, vertexShader);
-    glAttachShader(shaderProgram, fragmentShader);
-    glLinkProgram(shaderProgram);
-
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
-
-    return shaderProgram;
+    return createProgram(vertexShaderSource.c_str(), fragmentShaderSource);
 }
 
 GLuint setupGeometry() {
@@ -182,39 +188,17 @@ GLuint setupGeometry() {
     glGenBuffers(1, &VBO);
 
     glBindVertexArray(VAO);
+    labelGLObject(GL_VERTEX_ARRAY, VAO, "cubo");
     glBindBuffer(GL_ARRAY_BUFFER, VBO);
     glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
 
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
-    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(glsl::m3::attrib::position, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(glsl::m3::attrib::position);
+    glVertexAttribPointer(glsl::m3::attrib::color, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
+    glEnableVertexAttribArray(glsl::m3::attrib::color);
+    glVertexAttribPointer(glsl::m3::attrib::texCoord, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
+    glEnableVertexAttribArray(glsl::m3::attrib::texCoord);
 
     glBindVertexArray(0);
     return VAO;
 }
-
-GLuint loadTexture(const char* path) {
-    GLuint textureID;
-    glGenTextures(1, &textureID);
-    glBindTexture(GL_TEXTURE_2D, textureID);
-
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-    int width, height, nrChannels;
-    unsigned char* data = stbi_load(path, &width, &height, &nrChannels, 0);
-    if (data) {
-        GLenum format = nrChannels == 4 ? GL_RGBA : GL_RGB;
-        glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-        glGenerateMipmap(GL_TEXTURE_2D);
-    } else {
-        std::cout << "Erro ao carregar imagem: " << path << std::endl;
-    }
-    stbi_image_free(data);
-    return textureID;
-}
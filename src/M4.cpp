@@ -1,8 +1,19 @@
 /* M4 - Cubo texturizado com iluminação Phong
+ *
+ * Tecla L alterna entre a Phong por fragmento e a luz pré-calculada em um
+ * lightmap (texturas/caixa_lightmap.png, gerado na primeira execução).
+ * Os shaders estão em assets/shaders/m4_*; salvar um deles recompila e
+ * troca o programa sem reiniciar.
+ * A Phong é um ubershader com variantes: T liga/desliga a textura, C a cor
+ * por vértice, N o normal map (texturas/caixa_normal.png, se existir) e K
+ * alterna o número de luzes (1 a 4).
  * Samuel Pasquali - Computação Gráfica
  */
 
 #include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
@@ -10,24 +21,97 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
-#define STB_IMAGE_IMPLEMENTATION
-#include "stb_image.h"
+#include "GLExtensions.h"
+#include "GLTrace.h"
+#include "GLDebug.h"
+#include "GLState.h"
+#include "Texture.h"
+#include "TextureResidency.h"
+#include "Lightmap.h"
+#include "ShaderLibrary.h"
+#include "ShaderVariants.h"
+#include "UniformBuffers.h"
+#include "ShaderBindings.h"   // gerado pelo ShaderReflect a partir de assets/shaders
 
 using namespace std;
 
 void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods);
-GLuint setupShader();
 GLuint setupGeometry();
-GLuint loadTexture(const char* path);
+vector<glm::vec2> cubeLightmapUVs();
+bool bakeCubeLightmap(const char* path, const glm::vec3& lightPos);
 
 // Transformações globais (controle teclado)
 float angleX = 0.0f, angleY = 0.0f, angleZ = 0.0f;
 float scaleFactor = 1.0f;
 float posX = 0.0f, posY = 0.0f, posZ = 0.0f;
+bool useLightmap = false;
+
+// Recursos do material (cada combinação é uma variante da Phong)
+bool useTexture = true, useVertexColor = false, useNormalMap = true;
+int lightCount = 1;
+
+const char* LIGHTMAP_PATH = "texturas/caixa_lightmap.png";
+const char* NORMAL_MAP_PATH = "texturas/caixa_normal.png";
+const string SHADER_DIR = "../assets/shaders/";
+const int LIGHTMAP_SIZE = 256;
+
+// 6 faces x 2 triângulos; a ordem das faces define a célula delas no atlas do lightmap
+const float cubeVertices[] = {
+    // pos(x,y,z)    color(r,g,b)    texCoord(u,v)   normal(x,y,z)
+
+    // Back face
+    -0.5f, -0.5f, -0.5f,   1,0,0,   0.0f, 0.0f,    0.0f, 0.0f,-1.0f,
+     0.5f, -0.5f, -0.5f,   0,1,0,   1.0f, 0.0f,    0.0f, 0.0f,-1.0f,
+     0.5f,  0.5f, -0.5f,   0,0,1,   1.0f, 1.0f,    0.0f, 0.0f,-1.0f,
+     0.5f,  0.5f, -0.5f,   0,0,1,   1.0f, 1.0f,    0.0f, 0.0f,-1.0f,
+    -0.5f,  0.5f, -0.5f,   1,1,0,   0.0f, 1.0f,    0.0f, 0.0f,-1.0f,
+    -0.5f, -0.5f, -0.5f,   1,0,0,   0.0f, 0.0f,    0.0f, 0.0f,-1.0f,
+
+    // Front face
+    -0.5f, -0.5f,  0.5f,   1,0,1,   0.0f, 0.0f,    0.0f, 0.0f, 1.0f,
+     0.5f, -0.5f,  0.5f,   0,1,1,   1.0f, 0.0f,    0.0f, 0.0f, 1.0f,
+     0.5f,  0.5f,  0.5f,   1,1,1,   1.0f, 1.0f,    0.0f, 0.0f, 1.0f,
+     0.5f,  0.5f,  0.5f,   1,1,1,   1.0f, 1.0f,    0.0f, 0.0f, 1.0f,
+    -0.5f,  0.5f,  0.5f,   0,1,0,   0.0f, 1.0f,    0.0f, 0.0f, 1.0f,
+    -0.5f, -0.5f,  0.5f,   1,0,1,   0.0f, 0.0f,    0.0f, 0.0f, 1.0f,
+
+    // Left face
+    -0.5f,  0.5f,  0.5f,   0,0,1,   1.0f, 0.0f,   -1.0f, 0.0f, 0.0f,
+    -0.5f,  0.5f, -0.5f,   1,1,0,   1.0f, 1.0f,   -1.0f, 0.0f, 0.0f,
+    -0.5f, -0.5f, -0.5f,   1,0,1,   0.0f, 1.0f,   -1.0f, 0.0f, 0.0f,
+    -0.5f, -0.5f, -0.5f,   1,0,1,   0.0f, 1.0f,   -1.0f, 0.0f, 0.0f,
+    -0.5f, -0.5f,  0.5f,   0,1,1,   0.0f, 0.0f,   -1.0f, 0.0f, 0.0f,
+    -0.5f,  0.5f,  0.5f,   0,0,1,   1.0f, 0.0f,   -1.0f, 0.0f, 0.0f,
+
+    // Right face
+     0.5f,  0.5f,  0.5f,   1,0,0,   1.0f, 0.0f,    1.0f, 0.0f, 0.0f,
+     0.5f,  0.5f, -0.5f,   0,1,0,   1.0f, 1.0f,    1.0f, 0.0f, 0.0f,
+     0.5f, -0.5f, -0.5f,   0,0,1,   0.0f, 1.0f,    1.0f, 0.0f, 0.0f,
+     0.5f, -0.5f, -0.5f,   0,0,1,   0.0f, 1.0f,    1.0f, 0.0f, 0.0f,
+     0.5f, -0.5f,  0.5f,   1,1,0,   0.0f, 0.0f,    1.0f, 0.0f, 0.0f,
+     0.5f,  0.5f,  0.5f,   1,0,0,   1.0f, 0.0f,    1.0f, 0.0f, 0.0f,
+
+    // Bottom face
+    -0.5f, -0.5f, -0.5f,   0,1,0,   0.0f, 1.0f,    0.0f,-1.0f, 0.0f,
+     0.5f, -0.5f, -0.5f,   1,0,1,   1.0f, 1.0f,    0.0f,-1.0f, 0.0f,
+     0.5f, -0.5f,  0.5f,   0,0,1,   1.0f, 0.0f,    0.0f,-1.0f, 0.0f,
+     0.5f, -0.5f,  0.5f,   0,0,1,   1.0f, 0.0f,    0.0f,-1.0f, 0.0f,
+    -0.5f, -0.5f,  0.5f,   1,0,0,   0.0f, 0.0f,    0.0f,-1.0f, 0.0f,
+    -0.5f, -0.5f, -0.5f,   0,1,0,   0.0f, 1.0f,    0.0f,-1.0f, 0.0f,
+
+    // Top face
+    -0.5f,  0.5f, -0.5f,   1,0,1,   0.0f, 1.0f,    0.0f, 1.0f, 0.0f,
+     0.5f,  0.5f, -0.5f,   0,1,0,   1.0f, 1.0f,    0.0f, 1.0f, 0.0f,
+     0.5f,  0.5f,  0.5f,   0,0,1,   1.0f, 0.0f,    0.0f, 1.0f, 0.0f,
+     0.5f,  0.5f,  0.5f,   0,0,1,   1.0f, 0.0f,    0.0f, 1.0f, 0.0f,
+    -0.5f,  0.5f,  0.5f,   1,1,0,   0.0f, 0.0f,    0.0f, 1.0f, 0.0f,
+    -0.5f,  0.5f, -0.5f,   1,0,1,   0.0f, 1.0f,    0.0f, 1.0f, 0.0f
+};
 
 int main()
 {
     glfwInit();
+    if (glDebugRequested()) glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GLFW_TRUE);
     GLFWwindow* window = glfwCreateWindow(800, 800, "M4 - Cubo Texturizado com Phong", nullptr, nullptr);
     glfwMakeContextCurrent(window);
     glfwSetKeyCallback(window, key_callback);
@@ -37,31 +121,109 @@ int main()
         cout << "Erro ao inicializar GLAD" << endl;
         return -1;
     }
+    loadGLExtensions((GLADloadproc)glfwGetProcAddress);
+
+    // Orçamento de 64 MB para as texturas deste programa
+    TextureResidency textures(64 * 1024 * 1024);
+
+    // Os programas compilam no driver enquanto as texturas carregam e o
+    // lightmap é assado; até ficarem prontos o frame só limpa a tela.
+    // As variantes que as teclas alcançam com um toque já vão pré-compiladas.
+    ShaderManager shaders;
+    ShaderLibrary library(shaders);
+    ShaderVariants phong(library, SHADER_DIR + "m4_phong.vert", SHADER_DIR + "m4_phong.frag");
+    bool hasNormalMap = ifstream(NORMAL_MAP_PATH).is_open();
+    VariantKey baseKey = variantKey(FEATURE_TEXTURE, 1);
+    vector<VariantKey> prewarmKeys = {
+        baseKey,
+        variantKey(0, 1),
+        variantKey(FEATURE_TEXTURE | FEATURE_VERTEX_COLOR, 1),
+        variantKey(FEATURE_TEXTURE, 2),
+    };
+    if (hasNormalMap)
+        prewarmKeys.push_back(variantKey(FEATURE_TEXTURE | FEATURE_NORMAL_MAP, 1));
+    phong.prewarm(prewarmKeys);
+    int lightmapShader = library.load(SHADER_DIR + "m4_lightmap.vert", SHADER_DIR + "m4_lightmap.frag");
 
-    glEnable(GL_DEPTH_TEST);
-
-    GLuint shaderProgram = setupShader();
     GLuint VAO = setupGeometry();
-    GLuint textureID = loadTexture("texturas/caixa.jpg");  // Coloque a textura nesta pasta
+    TextureHandle texture = textures.load("texturas/caixa.jpg");  // Coloque a textura nesta pasta
+    TextureHandle normalMap = hasNormalMap ? textures.load(NORMAL_MAP_PATH) : INVALID_TEXTURE;
 
-    glUseProgram(shaderProgram);
-    glUniform1i(glGetUniformLocation(shaderProgram, "texture1"), 0);
+    GLuint sampler = getSampler(SamplerDesc(GL_LINEAR_MIPMAP_LINEAR, GL_LINEAR));
+    GLuint lightmapSampler = getSampler(SamplerDesc(GL_LINEAR, GL_LINEAR, GL_CLAMP_TO_EDGE));
 
     // Posição da luz e câmera
     glm::vec3 lightPos(1.2f, 1.0f, 2.0f);
     glm::vec3 viewPos(0.0f, 0.0f, 3.0f);
 
-    GLint lightPosLoc = glGetUniformLocation(shaderProgram, "lightPos");
-    GLint viewPosLoc = glGetUniformLocation(shaderProgram, "viewPos");
-    GLint ambientLoc = glGetUniformLocation(shaderProgram, "ambientColor");
-    GLint diffuseLoc = glGetUniformLocation(shaderProgram, "diffuseColor");
-    GLint specularLoc = glGetUniformLocation(shaderProgram, "specularColor");
-    GLint shininessLoc = glGetUniformLocation(shaderProgram, "shininess");
+    // Luz estática: o lightmap é assado uma vez (offline) e reaproveitado nas próximas execuções
+    if (!ifstream(LIGHTMAP_PATH).is_open())
+        bakeCubeLightmap(LIGHTMAP_PATH, lightPos);
+    TextureHandle lightmap = textures.load(LIGHTMAP_PATH);
+
+    // Luz e câmera não mudam: o bloco por frame recebe os mesmos valores que
+    // antes iam em seis glUniform* por frame
+    UniformBuffer frameUBO(sizeof(FrameUniforms), 1, FRAME_UNIFORMS_BINDING);
+    UniformBuffer objectUBO(sizeof(ObjectUniforms), 1, OBJECT_UNIFORMS_BINDING);
+    FrameUniforms frame;
+    frame.cameraPosition = glm::vec4(viewPos, 1.0f);
+    frame.lightPositions[0] = glm::vec4(lightPos, 1.0f);
+    frame.lightPositions[1] = glm::vec4(-1.5f, 1.0f, 1.5f, 1.0f);
+    frame.lightPositions[2] = glm::vec4(0.0f, -1.5f, 1.5f, 1.0f);
+    frame.lightPositions[3] = glm::vec4(1.5f, -0.5f, -1.5f, 1.0f);
+    frame.ambientColor = glm::vec4(0.2f, 0.2f, 0.2f, 1.0f);
+    frame.diffuseColor = glm::vec4(0.5f, 0.5f, 0.5f, 1.0f);
+    frame.specularColor = glm::vec4(1.0f, 1.0f, 1.0f, 32.0f);
+
+    // Os dois materiais diferem só no programa: o resto do pipeline é o mesmo
+    PipelineDesc desc;
+    desc.vertexArray = VAO;
+    const PipelineState cubePipeline(desc);
+
+    // Blocos por frame e por objeto em bindings consecutivos: um glBindBuffersRange
+    static_assert(OBJECT_UNIFORMS_BINDING == FRAME_UNIFORMS_BINDING + 1, "blocos fora de ordem");
+    const GLuint uboNames[] = { frameUBO.id(), objectUBO.id() };
+    const GLintptr uboOffsets[] = { frameUBO.offset(0), objectUBO.offset(0) };
+    const GLsizeiptr uboSizes[] = { frameUBO.elementSize(), objectUBO.elementSize() };
+
+    // Unidades 0..2 (texture1, lightmap, normalMap) vinculadas em lote; a que o
+    // programa não lê fica com 0 para não marcar a textura como usada
+    static_assert(glsl::m4_phong::sampler::texture1 == glsl::m4_lightmap::sampler::texture1,
+                  "texture1 em unidades diferentes nos shaders do M4");
+    const GLuint TEXTURE_UNITS = 3;
+    static_assert(glsl::m4_lightmap::sampler::lightmap < TEXTURE_UNITS &&
+                  glsl::m4_phong::sampler::normalMap < TEXTURE_UNITS, "unidade fora do lote");
+    GLuint unitSamplers[TEXTURE_UNITS] = {};
+    unitSamplers[glsl::m4_phong::sampler::texture1] = sampler;
+    unitSamplers[glsl::m4_lightmap::sampler::lightmap] = lightmapSampler;
+    unitSamplers[glsl::m4_phong::sampler::normalMap] = sampler;
+    VariantKey lastKey = 0;
+    double lastReport = glfwGetTime();
 
     while (!glfwWindowShouldClose(window))
     {
         glfwPollEvents();
 
+        // Troca os programas cujos arquivos mudaram e já linkaram
+        library.update();
+        GLuint lightmapProgram = library.program(lightmapShader);
+
+        // Só os recursos que o material tem de fato entram na variante
+        uint32_t features = 0;
+        if (useTexture && texture != INVALID_TEXTURE) features |= FEATURE_TEXTURE;
+        if (useVertexColor) features |= FEATURE_VERTEX_COLOR;
+        if (useNormalMap && normalMap != INVALID_TEXTURE) features |= FEATURE_NORMAL_MAP;
+        VariantKey key = variantKey(features, lightCount);
+        if (key != lastKey)
+        {
+            cout << "Variante: " << ShaderVariants::describe(key) << endl;
+            lastKey = key;
+        }
+
+        // Variante fora do conjunto pré-compilado: usa a base até ela ficar pronta
+        GLuint shaderProgram = phong.program(key);
+        if (!shaderProgram) shaderProgram = phong.program(baseKey);
+
         glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -72,28 +234,56 @@ int main()
         model = glm::rotate(model, angleZ, glm::vec3(0, 0, 1));
         model = glm::scale(model, glm::vec3(scaleFactor));
 
-        GLint modelLoc = glGetUniformLocation(shaderProgram, "model");
-        glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-
-        glUniform3fv(lightPosLoc, 1, glm::value_ptr(lightPos));
-        glUniform3fv(viewPosLoc, 1, glm::value_ptr(viewPos));
-        glUniform3f(ambientLoc, 0.2f, 0.2f, 0.2f);
-        glUniform3f(diffuseLoc, 0.5f, 0.5f, 0.5f);
-        glUniform3f(specularLoc, 1.0f, 1.0f, 1.0f);
-        glUniform1f(shininessLoc, 32.0f);
-
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, textureID);
-
-        glBindVertexArray(VAO);
+        frameUBO.update(0, &frame);
+        ObjectUniforms object = objectUniforms(model);
+        objectUBO.update(0, &object);
+
+        // Até o programa ficar pronto só a tela limpa é apresentada
+        bool lightmapped = useLightmap && lightmap != INVALID_TEXTURE;
+        if (!(lightmapped ? lightmapProgram : shaderProgram))
+        {
+            glTraceEndFrame();
+            glfwSwapBuffers(window);
+            textures.endFrame();
+            glState().endFrame();
+            continue;
+        }
+
+        // Luz já assada: uma busca no lightmap no lugar da Phong
+        GLuint unitTextures[TEXTURE_UNITS] = {};
+        unitTextures[glsl::m4_phong::sampler::texture1] = textures.use(texture);
+        if (lightmapped)
+            unitTextures[glsl::m4_lightmap::sampler::lightmap] = textures.use(lightmap);
+        else if (features & FEATURE_NORMAL_MAP)
+            unitTextures[glsl::m4_phong::sampler::normalMap] = textures.use(normalMap);
+
+        // Sem troca de material e sem textura rebaixada/restaurada, nada disso chega ao driver
+        glState().bindPipeline(cubePipeline.withProgram(lightmapped ? lightmapProgram : shaderProgram));
+        glState().bindTextures(0, TEXTURE_UNITS, unitTextures, unitSamplers);
+        glState().bindBuffersRange(GL_UNIFORM_BUFFER, FRAME_UNIFORMS_BINDING, 2, uboNames, uboOffsets, uboSizes);
         glDrawArrays(GL_TRIANGLES, 0, 36);
-        glBindVertexArray(0);
 
+        glTraceEndFrame();
         glfwSwapBuffers(window);
+        textures.endFrame();
+        glState().endFrame();
+        if (glfwGetTime() - lastReport > 1.0)
+        {
+            glState().printStats();
+            if (glTraceInstalled()) glTracePrintFrame();
+            if (glDebugInstalled()) glDebugPrintFrame();
+            lastReport = glfwGetTime();
+        }
     }
 
+    glState().forgetVertexArray(VAO);
     glDeleteVertexArrays(1, &VAO);
-    glDeleteProgram(shaderProgram);
+    library.clear();
+    shaders.clear();
+    objectUBO.clear();
+    frameUBO.clear();
+    textures.clear();
+    deleteSamplers();
     glfwTerminate();
     return 0;
 }
@@ -117,230 +307,82 @@ void key_callback(GLFWwindow* window, int key, int scancode, int action, int mod
 
         if (key == GLFW_KEY_LEFT_BRACKET) scaleFactor -= 0.1f;
         if (key == GLFW_KEY_RIGHT_BRACKET) scaleFactor += 0.1f;
-    }
-}
-
-GLuint setupShader()
-{
-    const char* vertexShaderSource = R\"(
-    #version 450 core
-    layout(location = 0) in vec3 position;
-    layout(location = 1) in vec3 color;
-    layout(location = 2) in vec2 texCoord;
-    layout(location = 3) in vec3 normal;
-
-    out vec2 TexCoord;
-    out vec3 Normal;
-    out vec3 FragPos;
-
-    uniform mat4 model;
-
-    void main()
-    {
-        vec4 worldPos = model * vec4(position, 1.0);
-        gl_Position = worldPos;
-        FragPos = vec3(worldPos);
-        Normal = mat3(transpose(inverse(model))) * normal;
-        TexCoord = texCoord;
-    }
-    )\"";
-
-    const char* fragmentShaderSource = R\"(
-    #version 450 core
-
-    in vec2 TexCoord;
-    in vec3 Normal;
-    in vec3 FragPos;
-
-    uniform sampler2D texture1;
-    uniform vec3 lightPos;
-    uniform vec3 viewPos;
-
-    uniform vec3 ambientColor;
-    uniform vec3 diffuseColor;
-    uniform vec3 specularColor;
-    uniform float shininess;
-
-    out vec4 color;
-
-    void main()
-    {
-        vec3 norm = normalize(Normal);
-        vec3 lightDir = normalize(lightPos - FragPos);
-        vec3 viewDir = normalize(viewPos - FragPos);
-        vec3 reflectDir = reflect(-lightDir, norm);
-
-        float diff = max(dot(norm, lightDir), 0.0);
-        float spec = pow(max(dot(viewDir, reflectDir), 0.0), shininess);
-
-        vec3 ambient = ambientColor * vec3(texture(texture1, TexCoord));
-        vec3 diffuse = diffuseColor * diff * vec3(texture(texture1, TexCoord));
-        vec3 specular = specularColor * spec;
-
-        vec3 result = ambient + diffuse + specular;
-        color = vec4(result, 1.0);
-    }
-    )\"";
-
-    GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertexShader, 1, &vertexShaderSource, nullptr);
-    glCompileShader(vertexShader);
 
-    GLint success;
-    char infoLog[512];
-    glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &success);
-    if (!success)
-    {
-        glGetShaderInfoLog(vertexShader, 512, NULL, infoLog);
-        cout << "Erro compilando Vertex Shader: " << infoLog << endl;
-    }
-
-    GLuint fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragmentShader, 1, &fragmentShaderSource, nullptr);
-    glCompileShader(fragmentShader);
-
-    glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &success);
-    if (!success)
-    {
-        glGetShaderInfoLog(fragmentShader, 512, NULL, infoLog);
-        cout << "Erro compilando Fragment Shader: " << infoLog << endl;
-    }
-
-    GLuint shaderProgram = glCreateProgram();
-    glAttachShader(shaderProgram, vertexShader);
-    glAttachShader(shaderProgram, fragmentShader);
-    glLinkProgram(shaderProgram);
-
-    glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
-    if (!success)
-    {
-        glGetProgramInfoLog(shaderProgram, 512, NULL, infoLog);
-        cout << "Erro linkando shader program: " << infoLog << endl;
+        if (key == GLFW_KEY_L && action == GLFW_PRESS) useLightmap = !useLightmap;
+        if (key == GLFW_KEY_T && action == GLFW_PRESS) useTexture = !useTexture;
+        if (key == GLFW_KEY_C && action == GLFW_PRESS) useVertexColor = !useVertexColor;
+        if (key == GLFW_KEY_N && action == GLFW_PRESS) useNormalMap = !useNormalMap;
+        if (key == GLFW_KEY_K && action == GLFW_PRESS) lightCount = lightCount % MAX_LIGHTS + 1;
     }
-
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
-
-    return shaderProgram;
 }
 
 GLuint setupGeometry()
 {
-    float vertices[] = {
-        // pos(x,y,z)    color(r,g,b)    texCoord(u,v)   normal(x,y,z)
-
-        // Back face
-        -0.5f, -0.5f, -0.5f,   1,0,0,   0.0f, 0.0f,    0.0f, 0.0f,-1.0f,
-         0.5f, -0.5f, -0.5f,   0,1,0,   1.0f, 0.0f,    0.0f, 0.0f,-1.0f,
-         0.5f,  0.5f, -0.5f,   0,0,1,   1.0f, 1.0f,    0.0f, 0.0f,-1.0f,
-         0.5f,  0.5f, -0.5f,   0,0,1,   1.0f, 1.0f,    0.0f, 0.0f,-1.0f,
-        -0.5f,  0.5f, -0.5f,   1,1,0,   0.0f, 1.0f,    0.0f, 0.0f,-1.0f,
-        -0.5f, -0.5f, -0.5f,   1,0,0,   0.0f, 0.0f,    0.0f, 0.0f,-1.0f,
-
-        // Front face
-        -0.5f, -0.5f,  0.5f,   1,0,1,   0.0f, 0.0f,    0.0f, 0.0f, 1.0f,
-         0.5f, -0.5f,  0.5f,   0,1,1,   1.0f, 0.0f,    0.0f, 0.0f, 1.0f,
-         0.5f,  0.5f,  0.5f,   1,1,1,   1.0f, 1.0f,    0.0f, 0.0f, 1.0f,
-         0.5f,  0.5f,  0.5f,   1,1,1,   1.0f, 1.0f,    0.0f, 0.0f, 1.0f,
-        -0.5f,  0.5f,  0.5f,   0,1,0,   0.0f, 1.0f,    0.0f, 0.0f, 1.0f,
-        -0.5f, -0.5f,  0.5f,   1,0,1,   0.0f, 0.0f,    0.0f, 0.0f, 1.0f,
-
-        // Left face
-        -0.5f,  0.5f,  0.5f,   0,0,1,   1.0f, 0.0f,   -1.0f, 0.0f, 0.0f,
-        -0.5f,  0.5f, -0.5f,   1,1,0,   1.0f, 1.0f,   -1.0f, 0.0f, 0.0f,
-        -0.5f, -0.5f, -0.5f,   1,0,1,   0.0f, 1.0f,   -1.0f, 0.0f, 0.0f,
-        -0.5f, -0.5f, -0.5f,   1,0,1,   0.0f, 1.0f,   -1.0f, 0.0f, 0.0f,
-        -0.5f, -0.5f,  0.5f,   0,1,1,   0.0f, 0.0f,   -1.0f, 0.0f, 0.0f,
-        -0.5f,  0.5f,  0.5f,   0,0,1,   1.0f, 0.0f,   -1.0f, 0.0f, 0.0f,
-
-        // Right face
-         0.5f,  0.5f,  0.5f,   1,0,0,   1.0f, 0.0f,    1.0f, 0.0f, 0.0f,
-         0.5f,  0.5f, -0.5f,   0,1,0,   1.0f, 1.0f,    1.0f, 0.0f, 0.0f,
-         0.5f, -0.5f, -0.5f,   0,0,1,   0.0f, 1.0f,    1.0f, 0.0f, 0.0f,
-         0.5f, -0.5f, -0.5f,   0,0,1,   0.0f, 1.0f,    1.0f, 0.0f, 0.0f,
-         0.5f, -0.5f,  0.5f,   1,1,0,   0.0f, 0.0f,    1.0f, 0.0f, 0.0f,
-         0.5f,  0.5f,  0.5f,   1,0,0,   1.0f, 0.0f,    1.0f, 0.0f, 0.0f,
-
-        // Bottom face
-        -0.5f, -0.5f, -0.5f,   0,1,0,   0.0f, 1.0f,    0.0f,-1.0f, 0.0f,
-         0.5f, -0.5f, -0.5f,   1,0,1,   1.0f, 1.0f,    0.0f,-1.0f, 0.0f,
-         0.5f, -0.5f,  0.5f,   0,0,1,   1.0f, 0.0f,    0.0f,-1.0f, 0.0f,
-         0.5f, -0.5f,  0.5f,   0,0,1,   1.0f, 0.0f,    0.0f,-1.0f, 0.0f,
-        -0.5f, -0.5f,  0.5f,   1,0,0,   0.0f, 0.0f,    0.0f,-1.0f, 0.0f,
-        -0.5f, -0.5f, -0.5f,   0,1,0,   0.0f, 1.0f,    0.0f,-1.0f, 0.0f,
-
-        // Top face
-        -0.5f,  0.5f, -0.5f,   1,0,1,   0.0f, 1.0f,    0.0f, 1.0f, 0.0f,
-         0.5f,  0.5f, -0.5f,   0,1,0,   1.0f, 1.0f,    0.0f, 1.0f, 0.0f,
-         0.5f,  0.5f,  0.5f,   0,0,1,   1.0f, 0.0f,    0.0f, 1.0f, 0.0f,
-         0.5f,  0.5f,  0.5f,   0,0,1,   1.0f, 0.0f,    0.0f, 1.0f, 0.0f,
-        -0.5f,  0.5f,  0.5f,   1,1,0,   0.0f, 0.0f,    0.0f, 1.0f, 0.0f,
-        -0.5f,  0.5f, -0.5f,   1,0,1,   0.0f, 1.0f,    0.0f, 1.0f, 0.0f
-    };
-
     GLuint VBO, VAO;
     glGenVertexArrays(1, &VAO);
     glGenBuffers(1, &VBO);
 
     glBindVertexArray(VAO);
+    labelGLObject(GL_VERTEX_ARRAY, VAO, "cubo");
 
     glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-    // posição
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 11 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-
-    // cor
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 11 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-
-    // texCoord
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 11 * sizeof(float), (void*)(6 * sizeof(float)));
-    glEnableVertexAttribArray(2);
-
-    // normal
-    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, 11 * sizeof(float), (void*)(8 * sizeof(float)));
-    glEnableVertexAttribArray(3);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(cubeVertices), cubeVertices, GL_STATIC_DRAW);
+
+    // posição, cor, texCoord e normal nas locations declaradas em m4_phong.vert
+    static_assert(sizeof(cubeVertices) == 36 * sizeof(glsl::m4_phong::Vertex),
+                  "cubeVertices não segue o layout de vértice de m4_phong.vert");
+    glsl::m4_phong::setupVertexAttributes();
+
+    // coordenadas do lightmap (buffer separado, geradas a partir das faces)
+    vector<glm::vec2> lightmapUVs = cubeLightmapUVs();
+    GLuint lightmapVBO;
+    glGenBuffers(1, &lightmapVBO);
+    glBindBuffer(GL_ARRAY_BUFFER, lightmapVBO);
+    glBufferData(GL_ARRAY_BUFFER, lightmapUVs.size() * sizeof(glm::vec2), lightmapUVs.data(), GL_STATIC_DRAW);
+    glVertexAttribPointer(glsl::m4_lightmap::attrib::lightmapCoord, 2, GL_FLOAT, GL_FALSE, sizeof(glm::vec2), (void*)0);
+    glEnableVertexAttribArray(glsl::m4_lightmap::attrib::lightmapCoord);
 
     glBindVertexArray(0);
     return VAO;
 }
 
-GLuint loadTexture(const char* path)
+vector<glm::vec2> cubeLightmapUVs()
 {
-    GLuint textureID;
-    glGenTextures(1, &textureID);
-
-    int width, height, nrChannels;
-    stbi_set_flip_vertically_on_load(true);
-    unsigned char* data = stbi_load(path, &width, &height, &nrChannels, 0);
-
-    if (data)
+    // As texCoords de cada face cobrem [0,1]² e se repetem entre as faces; no
+    // lightmap cada face ganha sua célula em um atlas 3x2, com margem de 2
+    // texels para a filtragem bilinear não misturar faces vizinhas
+    const float padU = 2.0f * 3.0f / LIGHTMAP_SIZE, padV = 2.0f * 2.0f / LIGHTMAP_SIZE;
+    vector<glm::vec2> uvs(36);
+    for (int i = 0; i < 36; i++)
     {
-        GLenum format = GL_RGB;
-        if (nrChannels == 1) format = GL_RED;
-        else if (nrChannels == 3) format = GL_RGB;
-        else if (nrChannels == 4) format = GL_RGBA;
-
-        glBindTexture(GL_TEXTURE_2D, textureID);
-        glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-        glGenerateMipmap(GL_TEXTURE_2D);
-
-        // Parâmetros da textura
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-        stbi_image_free(data);
+        int face = i / 6;
+        glm::vec2 t(cubeVertices[i * 11 + 6], cubeVertices[i * 11 + 7]);
+        uvs[i].x = (face % 3 + padU + t.x * (1.0f - 2.0f * padU)) / 3.0f;
+        uvs[i].y = (face / 3 + padV + t.y * (1.0f - 2.0f * padV)) / 2.0f;
     }
-    else
+    return uvs;
+}
+
+bool bakeCubeLightmap(const char* path, const glm::vec3& lightPos)
+{
+    // Cubo na pose inicial (model = identidade), com as mesmas constantes da Phong
+    vector<LightmapSurface> scene(1);
+    scene[0].lightmapUVs = cubeLightmapUVs();
+    for (int i = 0; i < 36; i++)
     {
-        cout << "Falha ao carregar textura: " << path << endl;
-        stbi_image_free(data);
+        MeshVertex v;
+        v.position = glm::vec3(cubeVertices[i * 11], cubeVertices[i * 11 + 1], cubeVertices[i * 11 + 2]);
+        v.texCoord = glm::vec2(cubeVertices[i * 11 + 6], cubeVertices[i * 11 + 7]);
+        v.normal = glm::vec3(cubeVertices[i * 11 + 8], cubeVertices[i * 11 + 9], cubeVertices[i * 11 + 10]);
+        scene[0].mesh.vertices.push_back(v);
+        scene[0].mesh.indices.push_back(i);
     }
 
-    return textureID;
+    LightmapSettings settings;
+    settings.size = LIGHTMAP_SIZE;
+    settings.ambient = glm::vec3(0.2f);
+
+    vector<glm::vec3> texels;
+    bakeLightmap(scene, 0, { { lightPos, glm::vec3(0.5f) } }, settings, texels);
+    return saveLightmap(path, settings.size, texels);
 }
@@ -11,77 +11,15 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
-using namespace std;
-
-// --- Câmera em Primeira Pessoa ---
-class Camera {
-public:
-    glm::vec3 Position;
-    glm::vec3 Front;
-    glm::vec3 Up;
-    glm::vec3 Right;
-    glm::vec3 WorldUp;
-
-    float Yaw;
-    float Pitch;
-
-    float MovementSpeed;
-    float MouseSensitivity;
-
-    Camera(glm::vec3 position, glm::vec3 up, float yaw, float pitch)
-        : Front(glm::vec3(0, 0, -1)), MovementSpeed(3.0f), MouseSensitivity(0.1f)
-    {
-        Position = position;
-        WorldUp = up;
-        Yaw = yaw;
-        Pitch = pitch;
-        updateCameraVectors();
-    }
-
-    glm::mat4 GetViewMatrix()
-    {
-        return glm::lookAt(Position, Position + Front, Up);
-    }
-
-    void ProcessKeyboard(char direction, float deltaTime)
-    {
-        float velocity = MovementSpeed * deltaTime;
-        if (direction == 'W') Position += Front * velocity;
-        if (direction == 'S') Position -= Front * velocity;
-        if (direction == 'A') Position -= Right * velocity;
-        if (direction == 'D') Position += Right * velocity;
-    }
-
-    void ProcessMouseMovement(float xoffset, float yoffset, bool constrainPitch = true)
-    {
-        xoffset *= MouseSensitivity;
-        yoffset *= MouseSensitivity;
-
-        Yaw += xoffset;
-        Pitch += yoffset;
-
-        if (constrainPitch)
-        {
-            if (Pitch > 89.0f) Pitch = 89.0f;
-            if (Pitch < -89.0f) Pitch = -89.0f;
-        }
-
-        updateCameraVectors();
-    }
+#include "GLExtensions.h"
+#include "GLTrace.h"
+#include "GLDebug.h"
+#include "Shader.h"
+#include "UniformBuffers.h"
+#include "ShaderBindings.h"   // gerado pelo ShaderReflect a partir dos shaders deste arquivo
+#include "Camera.h"
 
-private:
-    void updateCameraVectors()
-    {
-        glm::vec3 front;
-        front.x = cos(glm::radians(Yaw)) * cos(glm::radians(Pitch));
-        front.y = sin(glm::radians(Pitch));
-        front.z = sin(glm::radians(Yaw)) * cos(glm::radians(Pitch));
-        Front = glm::normalize(front);
-
-        Right = glm::normalize(glm::cross(Front, WorldUp));
-        Up = glm::normalize(glm::cross(Right, Front));
-    }
-};
+using namespace std;
 
 // --- Globals ---
 
@@ -89,15 +27,10 @@ const unsigned int WIDTH = 1000;
 const unsigned int HEIGHT = 1000;
 
 // Vertex Shader GLSL
-const char* vertexShaderSource = R"(
-#version 450 core
+string vertexShaderSource = string("#version 450 core\n") + uniformBlocksGLSL + R"(
 layout (location = 0) in vec3 position;
 layout (location = 1) in vec3 color;
 
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
-
 out vec3 fragColor;
 
 void main()
@@ -123,7 +56,6 @@ void main()
 void framebuffer_size_callback(GLFWwindow* window, int width, int height);
 void mouse_callback(GLFWwindow* window, double xposIn, double yposIn);
 void processInput(GLFWwindow* window, float deltaTime);
-unsigned int compileShader(GLenum type, const char* source);
 unsigned int createShaderProgram();
 
 unsigned int setupCube();
@@ -149,6 +81,7 @@ int main()
     glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
 #endif
 
+    if (glDebugRequested()) glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GLFW_TRUE);
     GLFWwindow* window = glfwCreateWindow(WIDTH, HEIGHT, "Camera FPS - Samuel", NULL, NULL);
     if (!window) {
         cout << "Failed to create GLFW window\n";
@@ -171,6 +104,7 @@ int main()
         cout << "Failed to initialize GLAD\n";
         return -1;
     }
+    loadGLExtensions((GLADloadproc)glfwGetProcAddress);
 
     // Compila e linka shaders
     unsigned int shaderProgram = createShaderProgram();
@@ -178,6 +112,15 @@ int main()
     // Configura geometria do cubo
     unsigned int cubeVAO = setupCube();
 
+    // view/projection uma vez por frame; o cubo fica parado, então o bloco
+    // dele é enviado uma vez só
+    UniformBuffer frameUBO(sizeof(FrameUniforms), 1, FRAME_UNIFORMS_BINDING);
+    UniformBuffer objectUBO(sizeof(ObjectUniforms), 1, OBJECT_UNIFORMS_BINDING);
+    FrameUniforms frame;
+    frame.projection = glm::perspective(glm::radians(45.0f), (float)WIDTH / HEIGHT, 0.1f, 100.0f);
+    ObjectUniforms object = objectUniforms(glm::mat4(1.0f));
+    objectUBO.update(0, &object);
+
     // Para controlar o tempo entre frames (movimento suave)
     float deltaTime = 0.0f;
     float lastFrame = 0.0f;
@@ -199,25 +142,17 @@ int main()
 
         glUseProgram(shaderProgram);
 
-        // Matrizes
-        glm::mat4 projection = glm::perspective(glm::radians(45.0f), (float)WIDTH / HEIGHT, 0.1f, 100.0f);
-        glm::mat4 view = camera.GetViewMatrix();
-        glm::mat4 model = glm::mat4(1.0f);
-
-        // Envia para o shader
-        GLint modelLoc = glGetUniformLocation(shaderProgram, "model");
-        GLint viewLoc = glGetUniformLocation(shaderProgram, "view");
-        GLint projLoc = glGetUniformLocation(shaderProgram, "projection");
-
-        glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-        glUniformMatrix4fv(viewLoc, 1, GL_FALSE, glm::value_ptr(view));
-        glUniformMatrix4fv(projLoc, 1, GL_FALSE, glm::value_ptr(projection));
+        // Matrizes da câmera, um único envio por frame
+        frame.view = camera.GetViewMatrix();
+        frame.cameraPosition = glm::vec4(camera.Position, 1.0f);
+        frameUBO.update(0, &frame);
 
         // Desenha cubo
         glBindVertexArray(cubeVAO);
         glDrawArrays(GL_TRIANGLES, 0, 36);
 
         // Troca buffers e processa eventos
+        glTraceEndFrame();
         glfwSwapBuffers(window);
         glfwPollEvents();
     }
@@ -225,6 +160,8 @@ int main()
     // Limpeza
     glDeleteVertexArrays(1, &cubeVAO);
     glDeleteProgram(shaderProgram);
+    objectUBO.clear();
+    frameUBO.clear();
 
     glfwTerminate();
     return 0;
@@ -271,46 +208,9 @@ void mouse_callback(GLFWwindow* window, double xposIn, double yposIn)
     camera.ProcessMouseMovement(xoffset, yoffset);
 }
 
-unsigned int compileShader(GLenum type, const char* source)
-{
-    unsigned int shader = glCreateShader(type);
-    glShaderSource(shader, 1, &source, nullptr);
-    glCompileShader(shader);
-
-    int success;
-    char infoLog[512];
-    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-    if (!success)
-    {
-        glGetShaderInfoLog(shader, 512, nullptr, infoLog);
-        cout << "ERROR: Shader compilation failed\n" << infoLog << endl;
-    }
-    return shader;
-}
-
 unsigned int createShaderProgram()
 {
-    unsigned int vertexShader = compileShader(GL_VERTEX_SHADER, vertexShaderSource);
-    unsigned int fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentShaderSource);
-
-    unsigned int program = glCreateProgram();
-    glAttachShader(program, vertexShader);
-    glAttachShader(program, fragmentShader);
-    glLinkProgram(program);
-
-    int success;
-    char infoLog[512];
-    glGetProgramiv(program, GL_LINK_STATUS, &success);
-    if (!success)
-    {
-        glGetProgramInfoLog(program, 512, nullptr, infoLog);
-        cout << "ERROR: Shader linking failed\n" << infoLog << endl;
-    }
-
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
-
-    return program;
+    return createProgram(vertexShaderSource.c_str(), fragmentShaderSource);
 }
 
 unsigned int setupCube()
@@ -366,16 +266,17 @@ unsigned int setupCube()
     glGenBuffers(1, &VBO);
 
     glBindVertexArray(VAO);
+    labelGLObject(GL_VERTEX_ARRAY, VAO, "cubos");
 
     glBindBuffer(GL_ARRAY_BUFFER, VBO);
     glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
 
     // posição
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(glsl::m5::attrib::position, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(glsl::m5::attrib::position);
     // cor
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(glsl::m5::attrib::color, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
+    glEnableVertexAttribArray(glsl::m5::attrib::color);
 
     glBindVertexArray(0);
 
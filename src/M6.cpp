@@ -1,5 +1,6 @@
 #include <iostream>
 #include <vector>
+#include <cstring>
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
@@ -8,61 +9,19 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
-using namespace std;
-
-// --- Câmera ---
-class Camera {
-public:
-    glm::vec3 Position, Front, Up, Right, WorldUp;
-    float Yaw, Pitch;
-    float MovementSpeed = 3.0f;
-    float MouseSensitivity = 0.1f;
-
-    Camera(glm::vec3 position, glm::vec3 up, float yaw, float pitch)
-        : Front(glm::vec3(0,0,-1))
-    {
-        Position = position; WorldUp = up;
-        Yaw = yaw; Pitch = pitch;
-        updateCameraVectors();
-    }
-
-    glm::mat4 GetViewMatrix() { return glm::lookAt(Position, Position + Front, Up); }
-
-    void ProcessKeyboard(char dir, float deltaTime)
-    {
-        float velocity = MovementSpeed * deltaTime;
-        if (dir == 'W') Position += Front * velocity;
-        if (dir == 'S') Position -= Front * velocity;
-        if (dir == 'A') Position -= Right * velocity;
-        if (dir == 'D') Position += Right * velocity;
-    }
-
-    void ProcessMouseMovement(float xoffset, float yoffset)
-    {
-        xoffset *= MouseSensitivity;
-        yoffset *= MouseSensitivity;
-
-        Yaw += xoffset;
-        Pitch += yoffset;
+#include "GLExtensions.h"
+#include "GLTrace.h"
+#include "GLDebug.h"
+#include "Shader.h"
+#include "GLState.h"
+#include "UniformBuffers.h"
+#include "ShaderBindings.h"   // gerado pelo ShaderReflect a partir dos shaders deste arquivo
+#include "RingBuffer.h"
+#include "Camera.h"
+#include "Frustum.h"
+#include "DynamicBVH.h"
 
-        if (Pitch > 89.0f) Pitch = 89.0f;
-        if (Pitch < -89.0f) Pitch = -89.0f;
-
-        updateCameraVectors();
-    }
-
-private:
-    void updateCameraVectors()
-    {
-        glm::vec3 front;
-        front.x = cos(glm::radians(Yaw)) * cos(glm::radians(Pitch));
-        front.y = sin(glm::radians(Pitch));
-        front.z = sin(glm::radians(Yaw)) * cos(glm::radians(Pitch));
-        Front = glm::normalize(front);
-        Right = glm::normalize(glm::cross(Front, WorldUp));
-        Up = glm::normalize(glm::cross(Right, Front));
-    }
-};
+using namespace std;
 
 // --- Objeto com trajetória ---
 class Objeto {
@@ -97,6 +56,12 @@ public:
                 position += movimento;
         }
     }
+
+    // Caixa do cubo unitário (-0.5..0.5) na posição e escala atuais
+    AABB caixa() const
+    {
+        return AABB(position - 0.5f * scale, position + 0.5f * scale);
+    }
 };
 
 // Globals
@@ -109,20 +74,19 @@ float deltaTime = 0.0f, lastFrame = 0.0f;
 
 Objeto cubo;
 
+// Índice da cena: o cubo anda pela trajetória e a folha dele é reajustada
+// (refit) a cada frame; o desenho sai da consulta de frustum
+DynamicBVH cena;
+
 GLFWwindow* window;
 
 // Shaders sources simples para cubo colorido
-const char* vertexShaderSource = R"(
-#version 450 core
+string vertexShaderSource = string("#version 450 core\n") + uniformBlocksGLSL + R"(
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aColor;
 
 out vec3 ourColor;
 
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
-
 void main()
 {
     gl_Position = projection * view * model * vec4(aPos, 1.0);
@@ -142,39 +106,9 @@ void main()
 )";
 
 // Funções utilitárias
-GLuint compileShader(GLenum type, const char* source)
-{
-    GLuint shader = glCreateShader(type);
-    glShaderSource(shader, 1, &source, nullptr);
-    glCompileShader(shader);
-    int success; char infoLog[512];
-    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-    if (!success)
-    {
-        glGetShaderInfoLog(shader, 512, nullptr, infoLog);
-        cout << "Erro compilando shader: " << infoLog << endl;
-    }
-    return shader;
-}
-
 GLuint createShaderProgram()
 {
-    GLuint vertexShader = compileShader(GL_VERTEX_SHADER, vertexShaderSource);
-    GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentShaderSource);
-    GLuint program = glCreateProgram();
-    glAttachShader(program, vertexShader);
-    glAttachShader(program, fragmentShader);
-    glLinkProgram(program);
-    int success; char infoLog[512];
-    glGetProgramiv(program, GL_LINK_STATUS, &success);
-    if (!success)
-    {
-        glGetProgramInfoLog(program, 512, nullptr, infoLog);
-        cout << "Erro linkando programa: " << infoLog << endl;
-    }
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
-    return program;
+    return createProgram(vertexShaderSource.c_str(), fragmentShaderSource);
 }
 
 GLuint setupCube()
@@ -206,6 +140,7 @@ GLuint setupCube()
     glGenBuffers(1, &EBO);
 
     glBindVertexArray(VAO);
+    labelGLObject(GL_VERTEX_ARRAY, VAO, "cubo");
     
     glBindBuffer(GL_ARRAY_BUFFER, VBO);
     glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
@@ -214,17 +149,39 @@ GLuint setupCube()
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
 
     // posição
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(glsl::m6::attrib::aPos, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(glsl::m6::attrib::aPos);
     // cor
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3*sizeof(float)));
-    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(glsl::m6::attrib::aColor, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3*sizeof(float)));
+    glEnableVertexAttribArray(glsl::m6::attrib::aColor);
 
     glBindVertexArray(0);
 
     return VAO;
 }
 
+// Linha da trajetória: mesmo formato de vértice do cubo (posição + cor),
+// lido do anel; cada frame desenha a partir do vértice onde foi escrito
+const GLsizei TRAJETORIA_STRIDE = 6 * sizeof(float);
+
+GLuint setupTrajetoria(GLuint ringBuffer)
+{
+    GLuint VAO;
+    glGenVertexArrays(1, &VAO);
+    glBindVertexArray(VAO);
+    labelGLObject(GL_VERTEX_ARRAY, VAO, "trajetória");
+
+    glBindBuffer(GL_ARRAY_BUFFER, ringBuffer);
+    glVertexAttribPointer(glsl::m6::attrib::aPos, 3, GL_FLOAT, GL_FALSE, TRAJETORIA_STRIDE, (void*)0);
+    glEnableVertexAttribArray(glsl::m6::attrib::aPos);
+    glVertexAttribPointer(glsl::m6::attrib::aColor, 3, GL_FLOAT, GL_FALSE, TRAJETORIA_STRIDE, (void*)(3*sizeof(float)));
+    glEnableVertexAttribArray(glsl::m6::attrib::aColor);
+
+    glBindVertexArray(0);
+    glState().invalidate();
+    return VAO;
+}
+
 // Callbacks e input
 void framebuffer_size_callback(GLFWwindow* window, int width, int height)
 {
@@ -295,6 +252,7 @@ int main()
     glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
 #endif
 
+    if (glDebugRequested()) glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GLFW_TRUE);
     window = glfwCreateWindow(WIDTH, HEIGHT, "Cubo com Trajetoria - Samuel", NULL, NULL);
     if (window == NULL)
     {
@@ -315,6 +273,7 @@ int main()
         cout << "Falha ao inicializar GLAD" << endl;
         return -1;
     }
+    loadGLExtensions((GLADloadproc)glfwGetProcAddress);
 
     GLuint shaderProgram = createShaderProgram();
     GLuint cubeVAO = setupCube();
@@ -323,6 +282,15 @@ int main()
 
     cubo.position = glm::vec3(0.0f);
     cubo.scale = glm::vec3(1.0f);
+    int cuboProxy = cena.insert(cubo.caixa(), 0);
+    vector<int> visiveis;
+
+    // Uniforms e a linha da trajetória vão para o anel a cada frame (memcpy,
+    // sem glBufferSubData); 3 frames em voo
+    RingBuffer ring(64 * 1024, 3, "M6 dados por frame");
+    GLuint trajetoriaVAO = setupTrajetoria(ring.buffer());
+    FrameUniforms frame;
+    frame.projection = glm::perspective(glm::radians(45.0f), (float)WIDTH/(float)HEIGHT, 0.1f, 100.0f);
 
     while(!glfwWindowShouldClose(window))
     {
@@ -333,6 +301,7 @@ int main()
         processInput(window);
 
         cubo.atualizar(deltaTime);
+        cena.refit(cuboProxy, cubo.caixa());
 
         // Render
         glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
@@ -340,33 +309,63 @@ int main()
 
         glUseProgram(shaderProgram);
 
-        // Matrizes
-        glm::mat4 projection = glm::perspective(glm::radians(45.0f), (float)WIDTH/(float)HEIGHT, 0.1f, 100.0f);
-        glm::mat4 view = camera.GetViewMatrix();
+        // Matrizes: câmera no bloco por frame, cubo e trajetória no bloco por objeto
+        ring.beginFrame();
+        frame.view = camera.GetViewMatrix();
+        frame.cameraPosition = glm::vec4(camera.Position, 1.0f);
+        RingAllocation frameData = ring.pushUniform(frame);
+
         glm::mat4 model = glm::mat4(1.0f);
         model = glm::translate(model, cubo.position);
         model = glm::scale(model, cubo.scale);
+        RingAllocation cuboData = ring.pushUniform(objectUniforms(model));
+        RingAllocation trajetoriaData = ring.pushUniform(objectUniforms(glm::mat4(1.0f)));
 
-        // Passa uniform
-        GLuint modelLoc = glGetUniformLocation(shaderProgram, "model");
-        GLuint viewLoc = glGetUniformLocation(shaderProgram, "view");
-        GLuint projLoc = glGetUniformLocation(shaderProgram, "projection");
+        // Pontos da trajetória (amarelo), alinhados ao tamanho do vértice
+        GLsizei pontos = (GLsizei)cubo.pontosTrajetoria.size();
+        RingAllocation vertices = ring.allocate(pontos * TRAJETORIA_STRIDE, TRAJETORIA_STRIDE);
+        if (vertices)
+        {
+            float* v = (float*)vertices.pointer;
+            for (const glm::vec3& p : cubo.pontosTrajetoria)
+            {
+                const float vertice[6] = { p.x, p.y, p.z, 1.0f, 0.9f, 0.2f };
+                memcpy(v, vertice, sizeof(vertice));
+                v += 6;
+            }
+        }
+        ring.flush();
+        glState().bindBufferRange(GL_UNIFORM_BUFFER, FRAME_UNIFORMS_BINDING, ring.buffer(), frameData.offset, frameData.size);
 
-        glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-        glUniformMatrix4fv(viewLoc, 1, GL_FALSE, glm::value_ptr(view));
-        glUniformMatrix4fv(projLoc, 1, GL_FALSE, glm::value_ptr(projection));
+        // Cubo fora da câmera (caixa fora do frustum) não é desenhado
+        cena.queryFrustum(extractFrustum(frame.projection * frame.view), visiveis);
+        if (!visiveis.empty())
+        {
+            glState().bindBufferRange(GL_UNIFORM_BUFFER, OBJECT_UNIFORMS_BINDING, ring.buffer(), cuboData.offset, cuboData.size);
+            glBindVertexArray(cubeVAO);
+            glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, 0);
+            glBindVertexArray(0);
+        }
 
-        glBindVertexArray(cubeVAO);
-        glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, 0);
-        glBindVertexArray(0);
+        if (vertices && pontos >= 2)
+        {
+            glState().bindBufferRange(GL_UNIFORM_BUFFER, OBJECT_UNIFORMS_BINDING, ring.buffer(), trajetoriaData.offset, trajetoriaData.size);
+            glBindVertexArray(trajetoriaVAO);
+            glDrawArrays(GL_LINE_LOOP, (GLint)(vertices.offset / TRAJETORIA_STRIDE), pontos);
+            glBindVertexArray(0);
+        }
+        ring.endFrame();
 
+        glTraceEndFrame();
         glfwSwapBuffers(window);
         glfwPollEvents();
     }
 
     // Cleanup
     glDeleteVertexArrays(1, &cubeVAO);
+    glDeleteVertexArrays(1, &trajetoriaVAO);
     glDeleteProgram(shaderProgram);
+    ring.clear();
 
     glfwTerminate();
     return 0;
@@ -0,0 +1,634 @@
+/* MultiDraw - Cena heterogênea desenhada com glMultiDrawElementsIndirect
+ *
+ * Uso: MultiDraw [objetos]   (padrão 100000)
+ *
+ * Cubos e Suzannes (duas resoluções) espalhados num volume, girando, cada um
+ * com um de 8 materiais. Todas as malhas ficam num MeshPool; os objetos são
+ * divididos em dois estados de pipeline (sólido com back-face culling e
+ * wireframe), e cada um vira um IndirectBatch: um comando indireto e um
+ * DrawData (model, material) por objeto, desenhados com uma chamada por
+ * pipeline.
+ *
+ * I alterna entre glMultiDrawElementsIndirect e um glDrawElementsIndirect
+ * por objeto (mesmos buffers, mesmo shader), para comparar o custo de CPU.
+ * Uma vez por segundo: tempo de montagem das listas, tempo de envio
+ * (upload + chamadas de desenho) e número de chamadas.
+ *
+ * C liga o frustum culling na GPU (GPUCulling.h): um compute shader por
+ * pipeline descarta os objetos fora da câmera e monta um comando por malha
+ * só com os visíveis, sem trabalho da CPU por objeto. O relatório mostra
+ * então quantos objetos sobraram.
+ *
+ * O liga/desliga a ordenação (RenderQueue.h): os objetos entram nas listas
+ * na ordem da chave (pipeline, material, malha, profundidade), agrupados
+ * por estado e da frente para trás dentro de cada grupo, em vez da ordem em
+ * que foram criados. O relatório mostra o tempo da ordenação e quantas
+ * trocas de material/malha sobraram.
+ *
+ * H, junto com C, liga o occlusion culling em duas fases (HiZPyramid.h):
+ * a cena vai para um framebuffer com profundidade em textura; primeiro
+ * saem os objetos visíveis no frame anterior, a profundidade deles vira uma
+ * pirâmide de máximos e um segundo cull testa a caixa de cada objeto contra
+ * ela, desenhando só os que apareceram agora. Numa cena densa a maior parte
+ * dos objetos dentro do frustum fica escondida; o relatório mostra quantos
+ * saíram em cada fase.
+ *
+ * R liga a gravação em várias threads (CommandBuffer.h): os objetos são
+ * divididos em blocos, e cada thread do ThreadPool faz o frustum culling,
+ * calcula as matrizes, escreve os DrawData direto no RingBuffer e grava os
+ * desenhos num CommandBuffer próprio. A thread da GL só executa os buffers,
+ * na ordem dos blocos (a mesma da fila ordenada), com um
+ * glDrawElementsInstancedBaseVertexBaseInstance por objeto visível. Tem
+ * precedência sobre I e C; o relatório mostra threads, comandos e bytes.
+ *
+ * M, junto com R, liga o occlusion culling na CPU (MaskedOcclusion.h):
+ * antes da gravação, os cubos sólidos maiores e mais próximos da câmera
+ * (até MAX_OCCLUDERS) são rasterizados num buffer de profundidade de baixa
+ * resolução, e cada thread testa a caixa do objeto contra ele depois do
+ * frustum culling; os escondidos nem chegam ao CommandBuffer. O relatório
+ * mostra oclusores, triângulos e o tempo da rasterização.
+ *
+ * Controles: WASD + mouse (câmera), Shift acelera, I alterna o modo,
+ * C liga/desliga o culling na GPU, H liga/desliga a oclusão (Hi-Z),
+ * O liga/desliga a ordenação, R liga/desliga a gravação em threads,
+ * M liga/desliga a oclusão na CPU, ESC sai.
+ */
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "GLExtensions.h"
+#include "GLState.h"
+#include "GLTrace.h"
+#include "GLDebug.h"
+#include "Shader.h"
+#include "UniformBuffers.h"
+#include "Camera.h"
+#include "MeshPool.h"
+#include "IndirectDraw.h"
+#include "GPUCulling.h"
+#include "HiZPyramid.h"
+#include "RenderQueue.h"
+#include "CommandBuffer.h"
+#include "RingBuffer.h"
+#include "ThreadPool.h"
+#include "MaskedOcclusion.h"
+#include "ObjLoader.h"
+#include "Frustum.h"
+#include "ShaderBindings.h"   // gerado pelo ShaderReflect a partir dos shaders deste arquivo
+
+using namespace std;
+
+const unsigned int WIDTH = 1280, HEIGHT = 720;
+const GLuint MATERIALS_BINDING = 1;
+const int MATERIAL_COUNT = 8;
+const float FAR_PLANE = 1000.0f;
+const int RECORD_CHUNK = 4096;   // objetos por CommandBuffer
+const size_t MAX_OCCLUDERS = 256;
+
+enum { PIPELINE_SOLID, PIPELINE_WIREFRAME, PIPELINE_COUNT };
+
+struct SceneObject
+{
+    int mesh;
+    int pipeline;
+    GLuint material;
+    glm::vec3 position;
+    glm::vec3 axis;
+    float scale;
+    float spin;   // rad/s
+};
+
+Camera camera(glm::vec3(0, 0, 5), glm::vec3(0, 1, 0), -90.0f, 0.0f);
+float deltaTime = 0.0f, lastFrame = 0.0f;
+bool multiDraw = true;
+bool gpuCulling = false;
+bool occlusionCulling = true;
+bool sortDraws = true;
+bool recordCommands = false;
+bool softwareOcclusion = true;
+
+string vertexShaderSource = string("#version 450 core\n") + uniformBlocksGLSL + drawDataGLSL +
+                            "#ifdef GPU_CULLING\n" + visibleObjectsGLSL + "#endif\n" + R"(
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+layout (location = 3) in uint drawId;   // DRAW_ID_LOCATION
+
+out vec3 worldNormal;
+flat out uint materialIndex;
+
+void main()
+{
+#ifdef GPU_CULLING
+    DrawData d = draws[visibleObjects[drawId]];
+#else
+    DrawData d = draws[drawId];
+#endif
+    gl_Position = projection * view * d.model * vec4(aPos, 1.0);
+    worldNormal = mat3(d.model) * aNormal;   // escala uniforme
+    materialIndex = d.material;
+}
+)";
+
+const char* fragmentShaderSource = R"(
+#version 450 core
+layout(std430, binding = 1) readonly buffer Materials
+{
+    vec4 materialColors[];
+};
+
+in vec3 worldNormal;
+flat in uint materialIndex;
+out vec4 FragColor;
+
+void main()
+{
+    float diffuse = max(dot(normalize(worldNormal), normalize(vec3(0.4, 1.0, 0.3))), 0.0);
+    FragColor = vec4(materialColors[materialIndex].rgb * (0.25 + 0.75 * diffuse), 1.0);
+}
+)";
+
+// O VAO vem do MeshPool, com as locations fixas dele
+static_assert(glsl::multidraw::attrib::aPos == 0 && glsl::multidraw::attrib::aNormal == 1 &&
+              glsl::multidraw::attrib::drawId == DRAW_ID_LOCATION, "shader fora do layout do MeshPool");
+
+vector<SceneObject> createScene(int count, int meshCount)
+{
+    mt19937 rng(1);
+    float extent = 3.0f * cbrt((float)count);
+    uniform_real_distribution<float> position(-extent * 0.5f, extent * 0.5f);
+    uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    uniform_real_distribution<float> scale(0.3f, 1.0f);
+
+    vector<SceneObject> objects(count);
+    for (SceneObject& o : objects)
+    {
+        o.mesh = (int)(rng() % meshCount);
+        o.pipeline = rng() % 10 == 0 ? PIPELINE_WIREFRAME : PIPELINE_SOLID;
+        o.material = rng() % MATERIAL_COUNT;
+        o.position = glm::vec3(position(rng), position(rng), position(rng));
+        glm::vec3 axis(unit(rng), unit(rng), unit(rng));
+        o.axis = glm::length(axis) > 0.01f ? glm::normalize(axis) : glm::vec3(0, 1, 0);
+        o.scale = scale(rng);
+        o.spin = unit(rng) * 2.0f;
+    }
+    return objects;
+}
+
+glm::mat4 objectModel(const SceneObject& o, float time)
+{
+    glm::mat4 model = glm::translate(glm::mat4(1.0f), o.position);
+    model = glm::rotate(model, o.spin * time, o.axis);
+    return glm::scale(model, glm::vec3(o.scale));
+}
+
+void framebuffer_size_callback(GLFWwindow* window, int width, int height)
+{
+    glViewport(0, 0, width, height);
+}
+
+void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods)
+{
+    if (action != GLFW_PRESS) return;
+    if (key == GLFW_KEY_ESCAPE)
+        glfwSetWindowShouldClose(window, true);
+    if (key == GLFW_KEY_I)
+    {
+        multiDraw = !multiDraw;
+        cout << "Modo: " << (multiDraw ? "glMultiDrawElementsIndirect" : "um glDrawElementsIndirect por objeto") << endl;
+    }
+    if (key == GLFW_KEY_C)
+    {
+        gpuCulling = !gpuCulling;
+        cout << "Culling na GPU: " << (gpuCulling ? "ligado" : "desligado") << endl;
+    }
+    if (key == GLFW_KEY_H)
+    {
+        occlusionCulling = !occlusionCulling;
+        cout << "Oclusão (Hi-Z, com C): " << (occlusionCulling ? "ligada" : "desligada") << endl;
+    }
+    if (key == GLFW_KEY_O)
+    {
+        sortDraws = !sortDraws;
+        cout << "Ordenação: " << (sortDraws ? "ligada" : "desligada") << endl;
+    }
+    if (key == GLFW_KEY_R)
+    {
+        recordCommands = !recordCommands;
+        cout << "Gravação em threads: " << (recordCommands ? "ligada" : "desligada") << endl;
+    }
+    if (key == GLFW_KEY_M)
+    {
+        softwareOcclusion = !softwareOcclusion;
+        cout << "Oclusão na CPU (com R): " << (softwareOcclusion ? "ligada" : "desligada") << endl;
+    }
+}
+
+void mouse_callback(GLFWwindow* window, double xposIn, double yposIn)
+{
+    float xpos = static_cast<float>(xposIn);
+    float ypos = static_cast<float>(yposIn);
+
+    static bool firstMouse = true;
+    static float lastX = WIDTH / 2.0f;
+    static float lastY = HEIGHT / 2.0f;
+
+    if (firstMouse)
+    {
+        lastX = xpos;
+        lastY = ypos;
+        firstMouse = false;
+    }
+
+    float xoffset = xpos - lastX;
+    float yoffset = lastY - ypos; // invert y
+    lastX = xpos;
+    lastY = ypos;
+
+    camera.ProcessMouseMovement(xoffset, yoffset);
+}
+
+void processInput(GLFWwindow* window)
+{
+    camera.MovementSpeed = glfwGetKey(window, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS ? 40.0f : 10.0f;
+    if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS)
+        camera.ProcessKeyboard('W', deltaTime);
+    if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS)
+        camera.ProcessKeyboard('S', deltaTime);
+    if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS)
+        camera.ProcessKeyboard('A', deltaTime);
+    if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS)
+        camera.ProcessKeyboard('D', deltaTime);
+}
+
+int main(int argc, char** argv)
+{
+    int objectCount = argc > 1 ? max(1, atoi(argv[1])) : 100000;
+
+    glfwInit();
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#ifdef __APPLE__
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#endif
+
+    if (glDebugRequested()) glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GLFW_TRUE);
+    GLFWwindow* window = glfwCreateWindow(WIDTH, HEIGHT, "MultiDraw Indirect - Samuel", NULL, NULL);
+    if (window == NULL)
+    {
+        cout << "Falha ao criar janela GLFW" << endl;
+        glfwTerminate();
+        return -1;
+    }
+    glfwMakeContextCurrent(window);
+    glfwSwapInterval(0);
+
+    glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
+    glfwSetKeyCallback(window, key_callback);
+    glfwSetCursorPosCallback(window, mouse_callback);
+    glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+    {
+        cout << "Falha ao inicializar GLAD" << endl;
+        return -1;
+    }
+    loadGLExtensions((GLADloadproc)glfwGetProcAddress);
+    if (!GLAD_GL_VERSION_4_3)
+    {
+        cout << "MultiDraw precisa de OpenGL 4.3 (shader storage buffers)" << endl;
+        glfwTerminate();
+        return -1;
+    }
+
+    MeshPool pool;
+    for (const char* name : { "Cube", "Suzanne", "SuzanneSubdiv1" })
+        pool.addOBJ(string("../assets/Modelos3D/") + name + ".obj");
+    if (pool.meshCount() == 0)
+    {
+        glfwTerminate();
+        return -1;
+    }
+    pool.upload();
+
+    GLuint shaderProgram = createProgram(vertexShaderSource.c_str(), fragmentShaderSource);
+    labelGLObject(GL_PROGRAM, shaderProgram, "MultiDraw");
+    GLuint culledProgram = createProgram(vertexShaderSource.c_str(), fragmentShaderSource, { "GPU_CULLING" });
+    labelGLObject(GL_PROGRAM, culledProgram, "MultiDraw GPU_CULLING");
+
+    PipelineDesc solid;
+    solid.program = shaderProgram;
+    solid.vertexArray = pool.vertexArray();
+    solid.raster.cullFace = true;
+    PipelineDesc wireframe = solid;
+    wireframe.raster.cullFace = false;
+    wireframe.raster.polygonMode = GL_LINE;
+    PipelineState pipelines[PIPELINE_COUNT] = { PipelineState(solid), PipelineState(wireframe) };
+    PipelineState culledPipelines[PIPELINE_COUNT] = { pipelines[0].withProgram(culledProgram),
+                                                      pipelines[1].withProgram(culledProgram) };
+    IndirectBatch batches[PIPELINE_COUNT] = { IndirectBatch(pool), IndirectBatch(pool) };
+    GPUCulling cullings[PIPELINE_COUNT] = { GPUCulling(pool), GPUCulling(pool) };
+    HiZPyramid hiz;
+
+    // Materiais: cores num storage buffer indexado por DrawData::material
+    glm::vec4 materials[MATERIAL_COUNT];
+    for (int i = 0; i < MATERIAL_COUNT; i++)
+        materials[i] = glm::vec4(0.35f + 0.65f * glm::abs(glm::vec3(sin(i * 1.7f), sin(i * 2.9f + 1.0f), sin(i * 0.9f + 2.0f))), 1.0f);
+    GLuint materialBuffer;
+    glGenBuffers(1, &materialBuffer);
+    glState().bindBuffer(GL_SHADER_STORAGE_BUFFER, materialBuffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(materials), materials, GL_STATIC_DRAW);
+    labelGLObject(GL_BUFFER, materialBuffer, "materiais");
+
+    vector<SceneObject> objects = createScene(objectCount, pool.meshCount());
+    for (GPUCulling& culling : cullings)
+        culling.enableOcclusion((GLuint)objects.size());
+    camera.Position = glm::vec3(0.0f, 0.0f, 1.5f * cbrt((float)objectCount) + 5.0f);
+    cout << objectCount << " objetos em " << PIPELINE_COUNT << " pipelines, " << pool.meshCount() << " malhas" << endl;
+
+    UniformBuffer frameUBO(sizeof(FrameUniforms), 1, FRAME_UNIFORMS_BINDING);
+    FrameUniforms frame;
+
+    RenderQueue queue;
+    queue.reserve(objects.size());
+
+    // Gravação em threads: um CommandBuffer por bloco de objetos, DrawData no
+    // anel (slot = posição na ordem de desenho, que vira o baseInstance)
+    ThreadPool threads;
+    vector<CommandBuffer> commandBuffers((objects.size() + RECORD_CHUNK - 1) / RECORD_CHUNK);
+    RingBuffer drawDataRing((GLsizeiptr)(objects.size() * sizeof(DrawData)) + 256, 3, "MultiDraw DrawData");
+    pool.reserveDrawIds((GLuint)objects.size());
+    const vector<const PipelineState*> pipelineTable = { &pipelines[PIPELINE_SOLID], &pipelines[PIPELINE_WIREFRAME] };
+    ReplayStats replayed;
+
+    // Oclusão na CPU: os oclusores são os cubos (malha 0 do pool)
+    MaskedOcclusion occlusion(&threads);
+    MeshData cubeData;
+    OccluderMesh cubeOccluder;
+    if (loadOBJ("../assets/Modelos3D/Cube.obj", cubeData))
+        cubeOccluder = OccluderMesh::fromMeshData(cubeData);
+    vector<pair<float, uint32_t>> occluderCandidates;
+    double occlusionMs = 0.0;
+
+    double buildMs = 0.0, submitMs = 0.0, sortMs = 0.0;
+    size_t stateChanges = 0;
+    GLuint visibleEarly = 0, visibleLate = 0;
+    int drawCalls = 0, frames = 0;
+    double lastReport = glfwGetTime();
+
+    while (!glfwWindowShouldClose(window))
+    {
+        float currentFrame = (float)glfwGetTime();
+        deltaTime = currentFrame - lastFrame;
+        lastFrame = currentFrame;
+
+        processInput(window);
+        bool report = currentFrame - lastReport >= 1.0;
+
+        int width, height;
+        glfwGetFramebufferSize(window, &width, &height);
+        frame.view = camera.GetViewMatrix();
+        frame.projection = glm::perspective(glm::radians(45.0f), (float)width / max(height, 1), 0.1f, FAR_PLANE);
+        frame.cameraPosition = glm::vec4(camera.Position, 1.0f);
+        glm::mat4 viewProjection = frame.projection * frame.view;
+
+        auto t0 = chrono::steady_clock::now();
+        if (sortDraws)
+        {
+            queue.clear();
+            for (uint32_t i = 0; i < objects.size(); i++)
+            {
+                const SceneObject& o = objects[i];
+                float depth = glm::dot(o.position - camera.Position, camera.Front) / FAR_PLANE;
+                queue.submit(makeRenderKey(0, false, o.pipeline, o.material, o.mesh, depth), i);
+            }
+            queue.sort();
+            sortMs += queue.lastSortMs();
+        }
+
+        RingAllocation drawData;
+        if (recordCommands)
+        {
+            // Cada bloco grava seus desenhos sem falar com a GL; slots de
+            // objetos descartados ficam sem uso
+            drawDataRing.beginFrame();
+            drawData = drawDataRing.allocateStorage((GLsizeiptr)(objects.size() * sizeof(DrawData)));
+            DrawData* slots = (DrawData*)drawData.pointer;
+            Frustum frustum = extractFrustum(viewProjection);
+
+            // Oclusores: cubos sólidos inteiros na frente da câmera, os que
+            // parecem maiores (escala / distância) primeiro
+            bool occlude = softwareOcclusion && !cubeOccluder.indices.empty();
+            if (occlude)
+            {
+                occlusion.clear();
+                occluderCandidates.clear();
+                const MeshRange& cube = pool.mesh(0);
+                for (uint32_t i = 0; i < objects.size(); i++)
+                {
+                    const SceneObject& o = objects[i];
+                    if (o.mesh != 0 || o.pipeline != PIPELINE_SOLID) continue;
+                    float radius = (glm::length(cube.center) + cube.radius) * o.scale;
+                    float depth = glm::dot(o.position - camera.Position, camera.Front);
+                    if (depth - radius < 1.0f || !sphereInFrustum(frustum, o.position, radius)) continue;
+                    occluderCandidates.push_back({ o.scale / depth, i });
+                }
+                if (occluderCandidates.size() > MAX_OCCLUDERS)
+                {
+                    nth_element(occluderCandidates.begin(), occluderCandidates.begin() + MAX_OCCLUDERS,
+                                occluderCandidates.end(), greater<pair<float, uint32_t>>());
+                    occluderCandidates.resize(MAX_OCCLUDERS);
+                }
+                for (const pair<float, uint32_t>& candidate : occluderCandidates)
+                    occlusion.addOccluder(cubeOccluder, viewProjection * objectModel(objects[candidate.second], currentFrame));
+                occlusion.rasterize();
+                occlusionMs += occlusion.lastRasterizeMs();
+            }
+
+            threads.parallelFor(0, (int)commandBuffers.size(), [&](int c) {
+                CommandBuffer& cmd = commandBuffers[c];
+                cmd.reset();
+                int pipeline = -1;
+                size_t end = min(objects.size(), (size_t)(c + 1) * RECORD_CHUNK);
+                for (size_t k = (size_t)c * RECORD_CHUNK; k < end; k++)
+                {
+                    uint32_t i = sortDraws ? queue.sorted()[k].index : (uint32_t)k;
+                    const SceneObject& o = objects[i];
+                    const MeshRange& r = pool.mesh(o.mesh);
+                    glm::mat4 model = objectModel(o, currentFrame);
+                    if (!sphereInFrustum(frustum, glm::vec3(model * glm::vec4(r.center, 1.0f)), r.radius * o.scale))
+                        continue;
+                    if (occlude && !occlusion.testBox(r.boundsMin, r.boundsMax, viewProjection * model))
+                        continue;
+                    slots[k] = { model, o.material, (GLuint)o.mesh, i, 0 };
+                    if (o.pipeline != pipeline)
+                    {
+                        cmd.bindPipeline(o.pipeline);
+                        pipeline = o.pipeline;
+                    }
+                    cmd.drawIndexed(r.indexCount, r.firstIndex, r.baseVertex, 1, (uint32_t)k);
+                }
+            });
+            if (sortDraws)
+                stateChanges = queue.execute([](uint32_t, uint32_t) {});
+        }
+        else
+        {
+            // Listas por pipeline: um comando e um DrawData por objeto
+            for (IndirectBatch& batch : batches)
+                batch.reset();
+            auto addObject = [&](uint32_t i) {
+                const SceneObject& o = objects[i];
+                batches[o.pipeline].add(o.mesh, objectModel(o, currentFrame), o.material, i);
+            };
+            if (sortDraws)
+                stateChanges = queue.execute([&](uint32_t i, uint32_t) { addObject(i); });
+            else
+                for (uint32_t i = 0; i < objects.size(); i++)
+                    addObject(i);
+        }
+        auto t1 = chrono::steady_clock::now();
+
+        // Oclusão: a cena vai para o framebuffer da pirâmide
+        bool hiZ = !recordCommands && gpuCulling && occlusionCulling && hiz.valid();
+        if (hiZ)
+        {
+            hiz.resize(width, height);
+            glBindFramebuffer(GL_FRAMEBUFFER, hiz.framebuffer());
+        }
+        glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        frameUBO.update(0, &frame);
+        glState().bindBufferRange(GL_SHADER_STORAGE_BUFFER, MATERIALS_BINDING, materialBuffer, 0, sizeof(materials));
+
+        int calls = 0;
+        if (recordCommands)
+        {
+            drawDataRing.flush();
+            glState().bindBufferRange(GL_SHADER_STORAGE_BUFFER, DRAW_DATA_BINDING, drawDataRing.buffer(),
+                                      drawData.offset, drawData.size);
+            replayed = ReplayStats();
+            for (const CommandBuffer& cmd : commandBuffers)
+            {
+                ReplayStats stats = replayCommands(cmd, pipelineTable);
+                replayed.commands += stats.commands;
+                replayed.draws += stats.draws;
+            }
+            drawDataRing.endFrame();
+            calls = (int)replayed.draws;
+        }
+        else
+        {
+            for (int p = 0; p < PIPELINE_COUNT; p++)
+            {
+                batches[p].upload();
+                if (gpuCulling && cullings[p].valid())
+                {
+                    cullings[p].cull(batches[p], viewProjection, hiZ ? CULL_EARLY : CULL_ALL);
+                    glState().bindPipeline(culledPipelines[p]);
+                    calls += cullings[p].draw();
+                    if (hiZ && report)
+                        visibleEarly += cullings[p].readVisibleCount();
+                }
+                else
+                {
+                    glState().bindPipeline(pipelines[p]);
+                    calls += batches[p].draw(multiDraw);
+                }
+            }
+            if (hiZ)
+            {
+                // Segunda fase: contra a profundidade dos oclusores
+                hiz.build();
+                for (int p = 0; p < PIPELINE_COUNT; p++)
+                {
+                    if (!cullings[p].valid()) continue;
+                    cullings[p].cull(batches[p], viewProjection, CULL_LATE, &hiz);
+                    glState().bindPipeline(culledPipelines[p]);
+                    calls += cullings[p].draw();
+                    if (report)
+                        visibleLate += cullings[p].readVisibleCount();
+                }
+                hiz.present();
+            }
+        }
+        auto t2 = chrono::steady_clock::now();
+
+        buildMs += chrono::duration<double, milli>(t1 - t0).count();
+        submitMs += chrono::duration<double, milli>(t2 - t1).count();
+        drawCalls = calls;
+        frames++;
+
+        if (report)
+        {
+            double now = glfwGetTime();
+            cout << (recordCommands ? "gravação em threads" : hiZ ? "culling GPU + Hi-Z" : gpuCulling ? "culling GPU" : multiDraw ? "multi-draw" : "por objeto") << " | "
+                 << frames / (now - lastReport) << " fps | " << drawCalls << " chamadas | montagem "
+                 << buildMs / frames << " ms | envio " << submitMs / frames << " ms";
+            if (sortDraws)
+                cout << " | ordenação " << sortMs / frames << " ms, " << stateChanges << " trocas";
+            if (recordCommands)
+            {
+                size_t bytes = 0;
+                for (const CommandBuffer& cmd : commandBuffers)
+                    bytes += cmd.bytes();
+                cout << " | " << threads.size() << " threads, " << replayed.commands << " comandos, " << bytes / 1024
+                     << " KB";
+                if (softwareOcclusion)
+                    cout << " | oclusão CPU " << occlusionMs / frames << " ms (" << cullingPathName(occlusion.path()) << "), "
+                         << occlusion.occluderCount() << " oclusores, " << occlusion.triangleCount() << " triângulos";
+            }
+            else if (hiZ)
+            {
+                cout << " | " << visibleEarly << " + " << visibleLate << "/" << objectCount << " visíveis (fase 1 + 2)";
+                visibleEarly = visibleLate = 0;
+            }
+            else if (gpuCulling)
+            {
+                GLuint visible = 0;
+                for (GPUCulling& culling : cullings)
+                    visible += culling.readVisibleCount();
+                cout << " | " << visible << "/" << objectCount << " visíveis";
+            }
+            cout << endl;
+            buildMs = submitMs = sortMs = occlusionMs = 0.0;
+            frames = 0;
+            lastReport = now;
+        }
+
+        glState().endFrame();
+        glTraceEndFrame();
+        glfwSwapBuffers(window);
+        glfwPollEvents();
+    }
+
+    for (IndirectBatch& batch : batches)
+        batch.clear();
+    for (GPUCulling& culling : cullings)
+        culling.clear();
+    hiz.clear();
+    glState().forgetBuffer(materialBuffer);
+    glDeleteBuffers(1, &materialBuffer);
+    frameUBO.clear();
+    drawDataRing.clear();
+    pool.clear();
+    glDeleteProgram(shaderProgram);
+    glDeleteProgram(culledProgram);
+
+    glfwTerminate();
+    return 0;
+}
@@ -0,0 +1,170 @@
+/* NormalBaker - Baker de normal map e oclusão ambiente (high-poly -> low-poly)
+ *
+ * Uso: NormalBaker [low.obj] [high.obj] [resolução] [distância]
+ *      (padrão: ../assets/Modelos3D/Suzanne.obj ../assets/Modelos3D/SuzanneSubdiv1.obj 1024)
+ *
+ * Para cada texel coberto pelas UVs da malha low-poly, lança raios a partir
+ * da superfície low-poly (nos dois sentidos da normal) até a malha high-poly
+ * e grava:
+ *   <low>_normal.png : normal da high-poly no espaço tangente da low-poly
+ *   <low>_ao.png     : oclusão ambiente da high-poly (raios no hemisfério)
+ *
+ * Sem janela/contexto OpenGL: tudo roda na CPU, uma linha do mapa por tarefa
+ * no ThreadPool. A distância máxima dos raios é, por padrão, 5% da diagonal
+ * da caixa envolvente da low-poly.
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+
+#include <glm/glm.hpp>
+
+#include "ObjLoader.h"
+#include "TriangleBVH.h"
+#include "ThreadPool.h"
+#include "BakeUtils.h"
+
+#include "stb_image_write.h"
+
+using namespace std;
+
+const int AO_SAMPLES = 64;
+const int DILATE_PASSES = 8;   // texels de margem ao redor das ilhas de UV
+
+glm::vec3 sampleHighNormal(const MeshData& high, const RayHit& hit);
+float bakeAO(const TriangleBVH& bvh, const glm::vec3& p, const glm::vec3& n, float distance, BakeRandom& rng);
+
+int main(int argc, char** argv)
+{
+    string lowPath = argc > 1 ? argv[1] : "../assets/Modelos3D/Suzanne.obj";
+    string highPath = argc > 2 ? argv[2] : "../assets/Modelos3D/SuzanneSubdiv1.obj";
+    int size = argc > 3 ? atoi(argv[3]) : 1024;
+
+    MeshData low, high;
+    if (!loadOBJ(lowPath, low) || !loadOBJ(highPath, high))
+        return -1;
+    computeTangents(low);
+    cout << "Low-poly: " << low.triangleCount() << " triângulos, high-poly: " << high.triangleCount() << endl;
+
+    glm::vec3 bmin(1e30f), bmax(-1e30f);
+    for (const MeshVertex& v : low.vertices)
+    {
+        bmin = glm::min(bmin, v.position);
+        bmax = glm::max(bmax, v.position);
+    }
+    float diagonal = glm::length(bmax - bmin);
+    float rayDistance = argc > 4 ? (float)atof(argv[4]) : 0.05f * diagonal;
+    float aoDistance = 0.15f * diagonal;
+    float epsilon = 1e-4f * diagonal;
+
+    auto start = chrono::steady_clock::now();
+
+    TriangleBVH bvh;
+    bvh.build(high);
+
+    vector<glm::vec2> uvs(low.vertices.size());
+    for (size_t i = 0; i < low.vertices.size(); i++)
+        uvs[i] = low.vertices[i].texCoord;
+    vector<TexelSample> texels;
+    rasterizeUVs(uvs, low.indices, size, texels);
+
+    vector<unsigned char> normalMap((size_t)size * size * 3);
+    vector<unsigned char> aoMap((size_t)size * size);
+    vector<unsigned char> mask((size_t)size * size, 0);
+    vector<int> missesPerRow(size, 0);
+
+    ThreadPool pool;
+    pool.parallelFor(0, size, [&](int y) {
+        for (int x = 0; x < size; x++)
+        {
+            size_t idx = (size_t)y * size + x;
+            const TexelSample& s = texels[idx];
+            if (s.triangle < 0) continue;
+
+            // Ponto, normal e tangente interpolados na low-poly
+            unsigned int i0 = low.indices[3 * s.triangle];
+            unsigned int i1 = low.indices[3 * s.triangle + 1];
+            unsigned int i2 = low.indices[3 * s.triangle + 2];
+            glm::vec3 p = s.b0 * low.vertices[i0].position + s.b1 * low.vertices[i1].position + s.b2 * low.vertices[i2].position;
+            glm::vec3 n = glm::normalize(s.b0 * low.vertices[i0].normal + s.b1 * low.vertices[i1].normal + s.b2 * low.vertices[i2].normal);
+            glm::vec4 tw = s.b0 * low.tangents[i0] + s.b1 * low.tangents[i1] + s.b2 * low.tangents[i2];
+            glm::vec3 t = glm::normalize(glm::vec3(tw) - n * glm::dot(n, glm::vec3(tw)));
+            glm::vec3 b = glm::cross(n, t) * (tw.w < 0.0f ? -1.0f : 1.0f);
+
+            // Raio para fora e para dentro; fica com a superfície mais próxima
+            RayHit outHit, inHit;
+            bool hitOut = bvh.intersect(p, n, 0.0f, rayDistance, outHit);
+            bool hitIn = bvh.intersect(p, -n, 0.0f, rayDistance, inHit);
+
+            glm::vec3 hn = n, hp = p;
+            if (hitOut || hitIn)
+            {
+                bool useOut = hitOut && (!hitIn || outHit.t <= inHit.t);
+                const RayHit& hit = useOut ? outHit : inHit;
+                hn = sampleHighNormal(high, hit);
+                hp = p + (useOut ? n : -n) * hit.t;
+            }
+            else
+            {
+                missesPerRow[y]++;
+            }
+
+            glm::vec3 ts(glm::dot(hn, t), glm::dot(hn, b), glm::dot(hn, n));
+            ts = glm::normalize(ts) * 0.5f + 0.5f;
+            normalMap[idx * 3 + 0] = (unsigned char)(ts.x * 255.0f + 0.5f);
+            normalMap[idx * 3 + 1] = (unsigned char)(ts.y * 255.0f + 0.5f);
+            normalMap[idx * 3 + 2] = (unsigned char)(ts.z * 255.0f + 0.5f);
+
+            BakeRandom rng((uint32_t)idx);
+            float ao = bakeAO(bvh, hp + hn * epsilon, hn, aoDistance, rng);
+            aoMap[idx] = (unsigned char)(ao * 255.0f + 0.5f);
+            mask[idx] = 1;
+        }
+    }, 4);
+
+    // Margem ao redor das ilhas para o filtro/mipmaps não puxarem o fundo
+    vector<unsigned char> aoMask = mask;
+    dilateTexels(normalMap, 3, mask, size, DILATE_PASSES);
+    dilateTexels(aoMap, 1, aoMask, size, DILATE_PASSES);
+
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    int misses = 0;
+    for (int m : missesPerRow) misses += m;
+    cout << "Bake " << size << "x" << size << " em " << seconds << " s com " << pool.size() << " threads"
+         << " (" << misses << " texels sem interseção)" << endl;
+
+    // Linha 0 do mapa é v = 0 (embaixo): inverte na gravação, como o loadTexture inverte na leitura
+    string base = lowPath.substr(0, lowPath.find_last_of('.'));
+    stbi_flip_vertically_on_write(1);
+    if (!stbi_write_png((base + "_normal.png").c_str(), size, size, 3, normalMap.data(), size * 3) ||
+        !stbi_write_png((base + "_ao.png").c_str(), size, size, 1, aoMap.data(), size))
+    {
+        cout << "Falha ao gravar os mapas em " << base << "_*.png" << endl;
+        return -1;
+    }
+    cout << "Gravados " << base << "_normal.png e " << base << "_ao.png" << endl;
+    return 0;
+}
+
+glm::vec3 sampleHighNormal(const MeshData& high, const RayHit& hit)
+{
+    const MeshVertex& a = high.vertices[high.indices[3 * hit.triangle]];
+    const MeshVertex& b = high.vertices[high.indices[3 * hit.triangle + 1]];
+    const MeshVertex& c = high.vertices[high.indices[3 * hit.triangle + 2]];
+    return glm::normalize((1.0f - hit.u - hit.v) * a.normal + hit.u * b.normal + hit.v * c.normal);
+}
+
+float bakeAO(const TriangleBVH& bvh, const glm::vec3& p, const glm::vec3& n, float distance, BakeRandom& rng)
+{
+    // Amostras com distribuição cosseno: a média já é a integral da oclusão
+    int unoccluded = 0;
+    for (int i = 0; i < AO_SAMPLES; i++)
+        if (!bvh.occluded(p, cosineSampleHemisphere(n, rng), 0.0f, distance))
+            unoccluded++;
+    return (float)unoccluded / AO_SAMPLES;
+}
@@ -0,0 +1,483 @@
+/* ShaderReflect - Gera ShaderBindings.h a partir da interface dos shaders
+ *
+ * Uso: ShaderReflect <saída.h> <shader.vert|.frag|exercicio.cpp ...>
+ *      (chamado pelo CMake a cada build para assets/shaders e os .cpp de src)
+ *
+ * Lê as declarações com posição fixa e gera, para cada par de arquivos com o
+ * mesmo nome (m4_phong.vert + m4_phong.frag -> glsl::m4_phong):
+ *
+ *   layout(location = N) in T nome;        (vertex)  attrib::nome = N
+ *                                                    struct Vertex intercalado na ordem das
+ *                                                    locations + setupVertexAttributes()
+ *   layout(binding = N) uniform samplerX nome;       sampler::nome = N
+ *   layout(location = N) uniform T nome;             uniform::nome = N
+ *   uniform T nome;  (sem layout)                    uniformName::nome = "nome"
+ *
+ * Nos .cpp são lidos os shaders embutidos: os literais ("..." e R"(...)")
+ * de cada instrução C++ são concatenados, e os que têm um void main formam
+ * um shader - de vértice se escreve gl_Position. Os shaders de um arquivo
+ * são um programa com o nome dele em minúsculas (M2.cpp -> glsl::m2). Trechos
+ * vindos de variáveis (uniformBlocksGLSL, drawDataGLSL) não são vistos; são
+ * blocos uniform/buffer, que não entram nos bindings de qualquer forma.
+ *
+ * O código C++ usa essas constantes no lugar de números repetidos à mão e de
+ * glGetUniformLocation: renomear ou remover algo no shader quebra a
+ * compilação de quem usa, em vez de falhar em silêncio na execução.
+ *
+ * Declarações dentro de #ifdef entram todas (o buffer de vértices precisa
+ * ter todos os atributos de todas as variantes). Uniforms soltos sem
+ * layout(location) entram só pelo nome, para glGetUniformLocation: a
+ * location ainda vem do runtime, mas um nome errado não compila. Atributos
+ * sem tipo correspondente na struct (mat4 por instância) geram só attrib::.
+ * O arquivo só é regravado se o conteúdo mudar, para não recompilar à toa;
+ * o CMake acompanha a execução por um arquivo de carimbo separado.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <regex>
+#include <algorithm>
+
+using namespace std;
+
+struct GLSLType
+{
+    const char* glsl;
+    const char* cpp;
+    int components;
+    const char* glType;
+    bool integer;
+};
+
+static const GLSLType attributeTypes[] = {
+    { "float", "float",      1, "GL_FLOAT", false },
+    { "vec2",  "glm::vec2",  2, "GL_FLOAT", false },
+    { "vec3",  "glm::vec3",  3, "GL_FLOAT", false },
+    { "vec4",  "glm::vec4",  4, "GL_FLOAT", false },
+    { "int",   "GLint",      1, "GL_INT", true },
+    { "ivec2", "glm::ivec2", 2, "GL_INT", true },
+    { "ivec3", "glm::ivec3", 3, "GL_INT", true },
+    { "ivec4", "glm::ivec4", 4, "GL_INT", true },
+    { "uint",  "GLuint",     1, "GL_UNSIGNED_INT", true },
+    { "uvec2", "glm::uvec2", 2, "GL_UNSIGNED_INT", true },
+    { "uvec3", "glm::uvec3", 3, "GL_UNSIGNED_INT", true },
+    { "uvec4", "glm::uvec4", 4, "GL_UNSIGNED_INT", true },
+};
+
+struct Declaration
+{
+    string name;
+    string type;
+    int slot;
+    string origin;   // arquivo:linha, para as mensagens
+};
+
+struct ShaderInterface
+{
+    map<int, Declaration> attributes;   // location -> atributo (ordenado)
+    map<string, Declaration> samplers;
+    map<string, Declaration> uniforms;
+    map<string, Declaration> names;     // uniforms/samplers sem posição fixa
+};
+
+// Um shader a ler: o texto e onde ele começa no arquivo de origem
+struct ShaderSource
+{
+    string text;
+    string path;
+    int firstLine;
+    bool vertexStage;
+};
+
+// Remove comentários e diretivas, mantendo as quebras de linha para os números de linha
+static string stripSource(const string& text)
+{
+    string out;
+    bool lineStart = true, directive = false;
+    for (size_t i = 0; i < text.size(); i++)
+    {
+        char c = text[i];
+        if (c == '/' && i + 1 < text.size() && text[i + 1] == '/')
+        {
+            while (i < text.size() && text[i] != '\n') i++;
+            c = '\n';
+        }
+        else if (c == '/' && i + 1 < text.size() && text[i + 1] == '*')
+        {
+            i += 2;
+            while (i + 1 < text.size() && !(text[i] == '*' && text[i + 1] == '/'))
+            {
+                if (text[i] == '\n') out += '\n';
+                i++;
+            }
+            i++;
+            out += ' ';
+            continue;
+        }
+
+        if (c == '\n')
+        {
+            out += '\n';
+            lineStart = true;
+            directive = false;
+            continue;
+        }
+        if (lineStart && c == '#') directive = true;
+        if (c != ' ' && c != '\t' && c != '\r') lineStart = false;
+        out += directive ? ' ' : c;
+    }
+    return out;
+}
+
+static int layoutValue(const string& layout, const char* key)
+{
+    smatch m;
+    regex pattern(string("\\b") + key + "\\s*=\\s*(\\d+)");
+    return regex_search(layout, m, pattern) ? stoi(m[1]) : -1;
+}
+
+static bool addDeclaration(map<string, Declaration>& table, const Declaration& decl, const char* kind)
+{
+    auto it = table.find(decl.name);
+    if (it != table.end() && (it->second.slot != decl.slot || it->second.type != decl.type))
+    {
+        cerr << decl.origin << ": " << kind << " '" << decl.name << "' difere de " << it->second.origin << endl;
+        return false;
+    }
+    table[decl.name] = decl;
+    return true;
+}
+
+static bool readFile(const string& path, string& text)
+{
+    ifstream file(path);
+    if (!file.is_open())
+    {
+        cerr << "Não foi possível abrir " << path << endl;
+        return false;
+    }
+    stringstream buffer;
+    buffer << file.rdbuf();
+    text = buffer.str();
+    return true;
+}
+
+static bool isIdentifierChar(char c)
+{
+    return isalnum((unsigned char)c) || c == '_';
+}
+
+// Junta os literais de string de cada instrução C++ (até ';', '{' ou '}') e
+// devolve os que formam um shader. Diretivas do pré-processador C++ (os
+// #include "...") ficam de fora para não grudar no literal seguinte.
+static vector<ShaderSource> embeddedShaders(const string& path, const string& code)
+{
+    vector<ShaderSource> shaders;
+    string literals;
+    int line = 1, literalLine = 1;
+    bool lineStart = true;
+
+    auto flush = [&]() {
+        if (literals.find("void main") != string::npos)
+            shaders.push_back({ literals, path, literalLine, literals.find("gl_Position") != string::npos });
+        literals.clear();
+    };
+
+    for (size_t i = 0; i < code.size(); i++)
+    {
+        char c = code[i];
+        if (c == '\n')
+        {
+            line++;
+            lineStart = true;
+            continue;
+        }
+        if (lineStart && c == '#')
+        {
+            while (i + 1 < code.size() && (code[i + 1] != '\n' || code[i] == '\\'))
+                if (code[++i] == '\n') line++;
+            continue;
+        }
+        if (c != ' ' && c != '\t' && c != '\r') lineStart = false;
+
+        if (c == '/' && i + 1 < code.size() && code[i + 1] == '/')
+        {
+            while (i + 1 < code.size() && code[i + 1] != '\n') i++;
+        }
+        else if (c == '/' && i + 1 < code.size() && code[i + 1] == '*')
+        {
+            size_t end = code.find("*/", i + 2);
+            if (end == string::npos) break;
+            line += (int)count(code.begin() + i, code.begin() + end, '\n');
+            i = end + 1;
+        }
+        else if (c == '\'')
+        {
+            for (i++; i < code.size() && code[i] != '\''; i++)
+                if (code[i] == '\\') i++;
+        }
+        else if (c == 'R' && i + 1 < code.size() && code[i + 1] == '"' && (i == 0 || !isIdentifierChar(code[i - 1])))
+        {
+            size_t open = code.find('(', i + 2);
+            if (open == string::npos) break;
+            string terminator = ")" + code.substr(i + 2, open - i - 2) + "\"";
+            size_t close = code.find(terminator, open);
+            if (close == string::npos) break;
+            if (literals.empty()) literalLine = line;
+            string body = code.substr(open + 1, close - open - 1);
+            literals += body;
+            line += (int)count(body.begin(), body.end(), '\n');
+            i = close + terminator.size() - 1;
+        }
+        else if (c == '"')
+        {
+            if (literals.empty()) literalLine = line;
+            for (i++; i < code.size() && code[i] != '"'; i++)
+            {
+                if (code[i] != '\\' || i + 1 == code.size())
+                {
+                    literals += code[i];
+                    continue;
+                }
+                char escaped = code[++i];
+                if (escaped == 'n') literals += '\n';
+                else if (escaped == 't') literals += '\t';
+                else if (escaped != '0') literals += escaped;   // "\0" só termina a string C
+            }
+        }
+        else if (c == ';' || c == '{' || c == '}')
+        {
+            flush();
+        }
+    }
+    flush();
+    return shaders;
+}
+
+static bool reflectSource(const ShaderSource& source, ShaderInterface& iface)
+{
+    const string& path = source.path;
+    bool vertexStage = source.vertexStage;
+    string text = stripSource(source.text);
+
+    // Uma declaração por ';' (qualificadores de interpolação/precisão opcionais)
+    static const regex declaration(
+        R"(^\s*(?:layout\s*\(([^)]*)\)\s*)?(?:(?:flat|smooth|noperspective|highp|mediump|lowp)\s+)*(in|uniform)\s+(\w+)\s+(\w+)\s*(\[[^\]]*\])?\s*$)");
+
+    bool ok = true;
+    size_t start = 0;
+    while (start < text.size())
+    {
+        size_t end = text.find(';', start);
+        if (end == string::npos) break;
+        string statement = text.substr(start, end - start);
+        size_t first = min(text.find_first_not_of(" \t\r\n", start), end);
+        int line = source.firstLine + (int)count(text.begin(), text.begin() + first, '\n');
+        start = end + 1;
+
+        // Blocos uniform { ... } terminam em '}' antes do ';': ficam de fora
+        size_t brace = statement.rfind('}');
+        if (brace != string::npos) statement = statement.substr(brace + 1);
+
+        smatch m;
+        if (!regex_match(statement, m, declaration)) continue;
+
+        string layout = m[1], storage = m[2], type = m[3], name = m[4];
+        Declaration decl = { name, type, -1, path + ":" + to_string(line) };
+
+        if (storage == "in")
+        {
+            if (!vertexStage) continue;   // varyings
+            decl.slot = layoutValue(layout, "location");
+            if (decl.slot < 0)
+            {
+                cerr << decl.origin << ": atributo '" << name << "' sem layout(location)" << endl;
+                ok = false;
+                continue;
+            }
+            auto it = iface.attributes.find(decl.slot);
+            if (it != iface.attributes.end() && it->second.name != name)
+            {
+                cerr << decl.origin << ": location " << decl.slot << " já usada por '" << it->second.name << "'" << endl;
+                ok = false;
+                continue;
+            }
+            iface.attributes[decl.slot] = decl;
+        }
+        else if (type.compare(0, 7, "sampler") == 0 || type.compare(0, 5, "image") == 0)
+        {
+            decl.slot = layoutValue(layout, "binding");
+            if (decl.slot < 0)
+                ok = addDeclaration(iface.names, decl, "uniform") && ok;
+            else
+                ok = addDeclaration(iface.samplers, decl, "sampler") && ok;
+        }
+        else
+        {
+            decl.slot = layoutValue(layout, "location");
+            if (decl.slot < 0)
+                ok = addDeclaration(iface.names, decl, "uniform") && ok;
+            else
+                ok = addDeclaration(iface.uniforms, decl, "uniform") && ok;
+        }
+    }
+    return ok;
+}
+
+static const GLSLType* findAttributeType(const string& glsl)
+{
+    for (const GLSLType& t : attributeTypes)
+        if (glsl == t.glsl) return &t;
+    return nullptr;
+}
+
+static bool writeProgram(ostream& out, const string& program, const ShaderInterface& iface)
+{
+    out << "namespace glsl { namespace " << program << " {\n\n";
+
+    if (!iface.attributes.empty())
+    {
+        out << "namespace attrib {\n";
+        for (const auto& a : iface.attributes)
+            out << "    const GLuint " << a.second.name << " = " << a.first << ";   // " << a.second.type << "\n";
+        out << "}\n\n";
+    }
+
+    auto unsupported = find_if(iface.attributes.begin(), iface.attributes.end(),
+                               [](const pair<const int, Declaration>& a) { return !findAttributeType(a.second.type); });
+    if (unsupported != iface.attributes.end())
+    {
+        // Matrizes ocupam várias locations e vêm de outro buffer (por instância)
+        out << "// Sem struct Vertex: " << unsupported->second.name << " (" << unsupported->second.type
+            << ") não é um atributo por vértice\n\n";
+    }
+    else if (!iface.attributes.empty())
+    {
+        out << "// Atributos intercalados na ordem das locations\n";
+        out << "struct Vertex\n{\n";
+        for (const auto& a : iface.attributes)
+            out << "    " << findAttributeType(a.second.type)->cpp << " " << a.second.name << ";\n";
+        out << "};\n\n";
+
+        out << "// Com o VBO de Vertex já vinculado em GL_ARRAY_BUFFER e o VAO corrente\n";
+        out << "inline void setupVertexAttributes()\n{\n";
+        for (const auto& a : iface.attributes)
+        {
+            const GLSLType* t = findAttributeType(a.second.type);
+            string offset = "(void*)offsetof(Vertex, " + a.second.name + ")";
+            if (t->integer)
+                out << "    glVertexAttribIPointer(" << a.first << ", " << t->components << ", " << t->glType
+                    << ", sizeof(Vertex), " << offset << ");\n";
+            else
+                out << "    glVertexAttribPointer(" << a.first << ", " << t->components << ", " << t->glType
+                    << ", GL_FALSE, sizeof(Vertex), " << offset << ");\n";
+            out << "    glEnableVertexAttribArray(" << a.first << ");\n";
+        }
+        out << "}\n\n";
+    }
+
+    if (!iface.samplers.empty())
+    {
+        out << "namespace sampler {\n";
+        for (const auto& s : iface.samplers)
+            out << "    const GLuint " << s.first << " = " << s.second.slot << ";   // " << s.second.type << "\n";
+        out << "}\n\n";
+    }
+
+    if (!iface.uniforms.empty())
+    {
+        out << "namespace uniform {\n";
+        for (const auto& u : iface.uniforms)
+            out << "    const GLint " << u.first << " = " << u.second.slot << ";   // " << u.second.type << "\n";
+        out << "}\n\n";
+    }
+
+    if (!iface.names.empty())
+    {
+        out << "namespace uniformName {\n";
+        for (const auto& u : iface.names)
+            out << "    const char* const " << u.first << " = \"" << u.first << "\";   // " << u.second.type << "\n";
+        out << "}\n\n";
+    }
+
+    out << "} }\n\n";
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        cerr << "Uso: ShaderReflect <saída.h> <shader.vert|.frag|exercicio.cpp ...>" << endl;
+        return 1;
+    }
+
+    // Arquivos com o mesmo nome-base formam um programa; um .cpp sozinho forma o seu
+    map<string, ShaderInterface> programs;
+    bool ok = true;
+    for (int i = 2; i < argc; i++)
+    {
+        string path = argv[i];
+        size_t slash = path.find_last_of("/\\");
+        size_t dot = path.find_last_of('.');
+        if (dot == string::npos || (slash != string::npos && dot < slash))
+        {
+            cerr << "Extensão desconhecida: " << path << endl;
+            ok = false;
+            continue;
+        }
+        string stem = path.substr(slash == string::npos ? 0 : slash + 1, dot - (slash == string::npos ? 0 : slash + 1));
+        string extension = path.substr(dot + 1);
+        for (char& c : stem)
+            c = isalnum((unsigned char)c) ? c : '_';
+
+        string text;
+        if (!readFile(path, text))
+        {
+            ok = false;
+            continue;
+        }
+        if (extension == "cpp")
+        {
+            vector<ShaderSource> shaders = embeddedShaders(path, text);
+            if (shaders.empty()) continue;
+            transform(stem.begin(), stem.end(), stem.begin(), [](char c) { return (char)tolower((unsigned char)c); });
+            for (const ShaderSource& shader : shaders)
+                ok = reflectSource(shader, programs[stem]) && ok;
+        }
+        else
+            ok = reflectSource({ text, path, 1, extension == "vert" }, programs[stem]) && ok;
+    }
+    if (!ok) return 1;
+
+    ostringstream out;
+    out << "// Gerado por ShaderReflect a partir de assets/shaders e src/*.cpp - não editar\n\n";
+    out << "#pragma once\n\n";
+    out << "#include <cstddef>\n\n";
+    out << "#include <glad/glad.h>\n";
+    out << "#include <glm/glm.hpp>\n\n";
+    for (const auto& program : programs)
+        if (!writeProgram(out, program.first, program.second))
+            return 1;
+
+    string outPath = argv[1];
+    ifstream previous(outPath);
+    stringstream old;
+    old << previous.rdbuf();
+    if (previous.is_open() && old.str() == out.str())
+        return 0;
+
+    ofstream file(outPath);
+    if (!file.is_open())
+    {
+        cerr << "Não foi possível gravar " << outPath << endl;
+        return 1;
+    }
+    file << out.str();
+    cout << "Gerado " << outPath << " (" << programs.size() << " programas)" << endl;
+    return 0;
+}
@@ -0,0 +1,229 @@
+/* VTViewer - Visualizador de textura virtual (streaming de tiles)
+ *
+ * Uso: VTViewer [imagem]   (padrão: ../assets/tex/pixelWall.png)
+ * Na primeira execução a imagem é convertida para <imagem>.vt
+ *
+ * Controles: W/S aproxima/afasta, A/D e I/J deslocam a câmera sobre o plano
+ */
+
+#include <iostream>
+#include <fstream>
+#include <string>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include "VirtualTexture.h"
+#include "GLExtensions.h"
+#include "GLTrace.h"
+#include "GLDebug.h"
+#include "Shader.h"
+#include "ShaderBindings.h"   // gerado pelo ShaderReflect a partir dos shaders deste arquivo
+
+using namespace std;
+
+const unsigned int WIDTH = 1000, HEIGHT = 800;
+
+glm::vec3 cameraPos(0.0f, 1.5f, 3.0f);
+
+const char* vertexShaderSource = R"(
+#version 450 core
+layout (location = 0) in vec3 position;
+layout (location = 2) in vec2 texCoord;
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+
+out vec2 TexCoord;
+
+void main()
+{
+    gl_Position = projection * view * model * vec4(position, 1.0);
+    TexCoord = texCoord;
+}
+)";
+
+const char* fragmentShaderHeader = "#version 450 core\n";
+
+const char* fragmentShaderMain = R"(
+in vec2 TexCoord;
+out vec4 FragColor;
+
+void main()
+{
+    FragColor = vtSample(TexCoord);
+}
+)";
+
+void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods);
+GLuint setupPlane();
+
+int main(int argc, char** argv)
+{
+    string imagePath = argc > 1 ? argv[1] : "../assets/tex/pixelWall.png";
+    string vtPath = imagePath + ".vt";
+
+    if (!ifstream(vtPath, ios::binary).is_open())
+    {
+        if (!buildVirtualTexture(imagePath.c_str(), vtPath.c_str()))
+            return -1;
+    }
+
+    glfwInit();
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#ifdef __APPLE__
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#endif
+
+    if (glDebugRequested()) glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GLFW_TRUE);
+    GLFWwindow* window = glfwCreateWindow(WIDTH, HEIGHT, "Textura Virtual", NULL, NULL);
+    if (!window)
+    {
+        cout << "Falha ao criar janela GLFW" << endl;
+        glfwTerminate();
+        return -1;
+    }
+    glfwMakeContextCurrent(window);
+    glfwSetKeyCallback(window, key_callback);
+
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+    {
+        cout << "Falha ao inicializar GLAD" << endl;
+        return -1;
+    }
+    loadGLExtensions((GLADloadproc)glfwGetProcAddress);
+
+    string sceneFS = string(fragmentShaderHeader) + vtSampleGLSL + fragmentShaderMain;
+    GLuint sceneProgram = createProgram(vertexShaderSource, sceneFS.c_str());
+    GLuint feedbackProgram = createProgram(vertexShaderSource, vtFeedbackFragmentSource);
+    GLuint planeVAO = setupPlane();
+
+    // Um .vt de versão antiga é gerado de novo
+    VirtualTexture vt;
+    if (!vt.open(vtPath.c_str()) &&
+        !(buildVirtualTexture(imagePath.c_str(), vtPath.c_str()) && vt.open(vtPath.c_str())))
+        return -1;
+
+    glEnable(GL_DEPTH_TEST);
+
+    namespace uniformName = glsl::vtviewer::uniformName;
+    GLint sceneModelLoc = glGetUniformLocation(sceneProgram, uniformName::model);
+    GLint sceneViewLoc = glGetUniformLocation(sceneProgram, uniformName::view);
+    GLint sceneProjLoc = glGetUniformLocation(sceneProgram, uniformName::projection);
+    GLint fbModelLoc = glGetUniformLocation(feedbackProgram, uniformName::model);
+    GLint fbViewLoc = glGetUniformLocation(feedbackProgram, uniformName::view);
+    GLint fbProjLoc = glGetUniformLocation(feedbackProgram, uniformName::projection);
+
+    // Plano grande no chão, com a textura virtual cobrindo toda a área
+    glm::mat4 model = glm::scale(glm::mat4(1.0f), glm::vec3(20.0f));
+    glm::mat4 projection = glm::perspective(glm::radians(45.0f), (float)WIDTH / HEIGHT, 0.05f, 200.0f);
+
+    double lastReport = glfwGetTime();
+
+    while (!glfwWindowShouldClose(window))
+    {
+        glfwPollEvents();
+
+        int width, height;
+        glfwGetFramebufferSize(window, &width, &height);
+        glm::mat4 view = glm::lookAt(cameraPos, cameraPos + glm::vec3(0.0f, -0.6f, -1.0f), glm::vec3(0, 1, 0));
+
+        // 1) Passo de feedback em baixa resolução: quais páginas/mips estão visíveis
+        vt.beginFeedback(width, height);
+        glUseProgram(feedbackProgram);
+        vt.setFeedbackUniforms(feedbackProgram);
+        glUniformMatrix4fv(fbModelLoc, 1, GL_FALSE, glm::value_ptr(model));
+        glUniformMatrix4fv(fbViewLoc, 1, GL_FALSE, glm::value_ptr(view));
+        glUniformMatrix4fv(fbProjLoc, 1, GL_FALSE, glm::value_ptr(projection));
+        glBindVertexArray(planeVAO);
+        glDrawArrays(GL_TRIANGLES, 0, 6);
+        vt.endFeedback();
+
+        // 2) Sobe os tiles que as threads já leram do disco
+        vt.update();
+
+        // 3) Cena normal, amostrando pela page table
+        glViewport(0, 0, width, height);
+        glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        glUseProgram(sceneProgram);
+        vt.bind(0, 1);
+        vt.setUniforms(sceneProgram, 0, 1);
+        glUniformMatrix4fv(sceneModelLoc, 1, GL_FALSE, glm::value_ptr(model));
+        glUniformMatrix4fv(sceneViewLoc, 1, GL_FALSE, glm::value_ptr(view));
+        glUniformMatrix4fv(sceneProjLoc, 1, GL_FALSE, glm::value_ptr(projection));
+        glDrawArrays(GL_TRIANGLES, 0, 6);
+        glBindVertexArray(0);
+
+        if (glfwGetTime() - lastReport > 1.0)
+        {
+            cout << "Tiles residentes: " << vt.residentTiles() << "  pendentes: " << vt.pendingTiles() << endl;
+            lastReport = glfwGetTime();
+        }
+
+        glTraceEndFrame();
+        glfwSwapBuffers(window);
+    }
+
+    vt.close();
+    glDeleteVertexArrays(1, &planeVAO);
+    glDeleteProgram(sceneProgram);
+    glDeleteProgram(feedbackProgram);
+    glfwTerminate();
+    return 0;
+}
+
+void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods)
+{
+    if (action == GLFW_PRESS || action == GLFW_REPEAT)
+    {
+        if (key == GLFW_KEY_ESCAPE) glfwSetWindowShouldClose(window, true);
+
+        if (key == GLFW_KEY_W) cameraPos.y = glm::max(0.05f, cameraPos.y * 0.9f);
+        if (key == GLFW_KEY_S) cameraPos.y *= 1.1f;
+        if (key == GLFW_KEY_A) cameraPos.x -= 0.1f * cameraPos.y;
+        if (key == GLFW_KEY_D) cameraPos.x += 0.1f * cameraPos.y;
+        if (key == GLFW_KEY_I) cameraPos.z -= 0.1f * cameraPos.y;
+        if (key == GLFW_KEY_J) cameraPos.z += 0.1f * cameraPos.y;
+    }
+}
+
+GLuint setupPlane()
+{
+    float vertices[] = {
+        // pos                // texCoord
+        -0.5f, 0.0f,  0.5f,   0.0f, 0.0f,
+         0.5f, 0.0f,  0.5f,   1.0f, 0.0f,
+         0.5f, 0.0f, -0.5f,   1.0f, 1.0f,
+         0.5f, 0.0f, -0.5f,   1.0f, 1.0f,
+        -0.5f, 0.0f, -0.5f,   0.0f, 1.0f,
+        -0.5f, 0.0f,  0.5f,   0.0f, 0.0f,
+    };
+
+    GLuint VBO, VAO;
+    glGenVertexArrays(1, &VAO);
+    glGenBuffers(1, &VBO);
+
+    glBindVertexArray(VAO);
+    labelGLObject(GL_VERTEX_ARRAY, VAO, "terreno");
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+
+    // posição
+    glVertexAttribPointer(glsl::vtviewer::attrib::position, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(glsl::vtviewer::attrib::position);
+    // texCoord
+    glVertexAttribPointer(glsl::vtviewer::attrib::texCoord, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
+    glEnableVertexAttribArray(glsl::vtviewer::attrib::texCoord);
+
+    glBindVertexArray(0);
+    return VAO;
+}